@@ -43,6 +43,16 @@ struct logfile_context_t
 
     JRB varnames;
     int resolved;
+
+    /* annotations in the text buffer, updated in place when the marker moves */
+    GArray *anno;
+    GtkTextMark *time_start, *time_end;
+};
+
+struct anno_range_t
+{
+    GtkTextMark *start, *end;
+    JRB node;
 };
 
 struct text_find_t
@@ -691,8 +701,24 @@ void log_text_prelight(GtkWidget *text, gpointer font, char *str)
                                      NULL);
 }
 
-/* lxt2 iteration handling... (lxt2 doesn't have a direct "value at" function) */
-static JRB lx2vals = NULL;
+/* lxt2 and fst iteration handling: all the values at the marker are collected in one pass over
+ * the blocks, keyed by handle (lxt2 doesn't have a direct "value at" function, and fst's decodes
+ * the block again for every handle) */
+static JRB anno_vals = NULL;
+
+static void anno_vals_set(int facidx, const char *value)
+{
+    JRB node = jrb_find_int(anno_vals, facidx);
+    Jval jv;
+
+    if (node) {
+        free(node->val.s);
+        node->val.s = strdup(value);
+    } else {
+        jv.s = strdup(value);
+        jrb_insert_int(anno_vals, facidx, jv);
+    }
+}
 
 static void lx2_iter_fn(struct lxt2_rd_trace **lt,
                         lxtint64_t *pnt_time,
@@ -702,19 +728,360 @@ static void lx2_iter_fn(struct lxt2_rd_trace **lt,
     (void)lt;
 
     if (*pnt_time <= (lxtint64_t)anno_ctx->marker) {
-        JRB node = jrb_find_int(lx2vals, *pnt_facidx);
-        Jval jv;
+        anno_vals_set(*pnt_facidx, *pnt_value);
+    }
+}
+
+static void fst_iter_fn(void *user_data,
+                        uint64_t pnt_time,
+                        fstHandle pnt_facidx,
+                        const unsigned char *pnt_value)
+{
+    (void)user_data;
+
+    if (pnt_time <= (uint64_t)anno_ctx->marker) {
+        anno_vals_set(pnt_facidx, (const char *)pnt_value);
+    }
+}
+
+/* FST scope -> variables map, built once on the first annotation and kept for the lifetime
+ * of the dump so opening a design unit doesn't walk the whole hierarchy again */
+struct fst_scope_var_t
+{
+    char *name;
+    fstHandle handle;
+};
+
+static GHashTable *fst_scope_vars = NULL;
+
+static void fst_scope_var_clear(gpointer data)
+{
+    struct fst_scope_var_t *v = data;
+
+    g_free(v->name);
+}
+
+static GArray *fst_get_scope_vars(const char *scope)
+{
+    if (!fst_scope_vars) {
+        struct fstHier *h;
+        const char *scp_nam = NULL;
+        fstHandle fh = 0;
+
+        fst_scope_vars =
+            g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_array_unref);
+
+        fstReaderIterateHierRewind(fst);
+        fstReaderResetScope(fst);
+
+        while ((h = fstReaderIterateHier(fst))) {
+            switch (h->htyp) {
+                case FST_HT_SCOPE:
+                    fstReaderPushScope(fst, h->u.scope.name, NULL);
+                    break;
+                case FST_HT_UPSCOPE:
+                    fstReaderPopScope(fst);
+                    break;
+                case FST_HT_VAR: {
+                    struct fst_scope_var_t v;
+                    GArray *vars;
+
+                    if (!h->u.var.is_alias)
+                        fh++;
+
+                    scp_nam = fstReaderGetCurrentFlatScope(fst);
+                    vars = g_hash_table_lookup(fst_scope_vars, scp_nam);
+                    if (!vars) {
+                        vars = g_array_new(FALSE, FALSE, sizeof(struct fst_scope_var_t));
+                        g_array_set_clear_func(vars, fst_scope_var_clear);
+                        g_hash_table_insert(fst_scope_vars, g_strdup(scp_nam), vars);
+                    }
+
+                    v.name = g_strdup(h->u.var.name);
+                    v.handle = h->u.var.is_alias ? h->u.var.handle : fh;
+                    g_array_append_val(vars, v);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    return g_hash_table_lookup(fst_scope_vars, scope);
+}
+
+/* fetches the values at the marker for all resolved variables of a context */
+static void anno_update_values(struct logfile_context_t *ctx)
+{
+    JRB varnames = ctx->varnames;
+    JRB node;
+
+    jrb_traverse(node, varnames)
+    {
+        free(node->val2.v);
+        node->val2.v = NULL;
+    }
+
+    if (vzt) {
+        jrb_traverse(node, varnames)
+        {
+            if (node->val.i >= 0) {
+                char *rc = vzt_rd_value(vzt, anno_ctx->marker, node->val.i);
+                struct jrb_chain *jvc = node->jval_chain;
+                char first_char = rc ? rc[0] : '?';
+
+                if (!jvc) {
+                    if (rc) {
+                        node->val2.v = hexify(strdup(rc));
+                    } else {
+                        node->val2.v = NULL;
+                    }
+                } else {
+                    char *rc2;
+                    int len = rc ? strlen(rc) : 0;
+                    int iter = 1;
+
+                    while (jvc) {
+                        rc = vzt_rd_value(vzt, anno_ctx->marker, jvc->val.i);
+                        len += (rc ? strlen(rc) : 0);
+                        iter++;
+                        jvc = jvc->next;
+                    }
+
+                    if (iter == len) {
+                        int pos = 1;
+                        jvc = node->jval_chain;
+                        rc2 = calloc(1, len + 1);
+                        rc2[0] = first_char;
+
+                        while (jvc) {
+                            char *rcv = vzt_rd_value(vzt, anno_ctx->marker, jvc->val.i);
+                            rc2[pos++] = *rcv;
+                            jvc = jvc->next;
+                        }
+
+                        node->val2.v = hexify(strdup(rc2));
+                        free(rc2);
+                    } else {
+                        node->val2.v = NULL;
+                    }
+                }
+            } else {
+                node->val2.v = NULL;
+            }
+        }
+    } else if (fst || lx2) {
+        /* other contexts may have changed the mask since this one was resolved */
+        if (fst) {
+            fstReaderClrFacProcessMaskAll(fst);
+        } else {
+            lxt2_rd_clr_fac_process_mask_all(lx2);
+        }
+        jrb_traverse(node, varnames)
+        {
+            struct jrb_chain *jvc;
 
-        if (node) {
-            free(node->val.s);
-            node->val.s = strdup(*pnt_value);
+            if (node->val.i >= 0) {
+                if (fst) {
+                    fstReaderSetFacProcessMask(fst, node->val.i);
+                } else {
+                    lxt2_rd_set_fac_process_mask(lx2, node->val.i);
+                }
+            }
+            for (jvc = node->jval_chain; jvc; jvc = jvc->next) {
+                if (fst) {
+                    fstReaderSetFacProcessMask(fst, jvc->val.i);
+                } else {
+                    lxt2_rd_set_fac_process_mask(lx2, jvc->val.i);
+                }
+            }
+        }
+
+        /* one pass over the block holding the marker for all the handles */
+        anno_vals = make_jrb();
+        if (fst) {
+            fstReaderSetUnlimitedTimeRange(fst);
+            fstReaderSetLimitTimeRange(fst, anno_ctx->marker, anno_ctx->marker);
+            fstReaderIterBlocks(fst, fst_iter_fn, NULL, NULL);
         } else {
-            jv.s = strdup(*pnt_value);
-            jrb_insert_int(lx2vals, *pnt_facidx, jv);
+            lxt2_rd_unlimit_time_range(lx2);
+            lxt2_rd_limit_time_range(lx2, anno_ctx->marker, anno_ctx->marker);
+            lxt2_rd_iter_blocks(lx2, lx2_iter_fn, NULL);
         }
+
+        jrb_traverse(node, varnames)
+        {
+            struct jrb_chain *jvc = node->jval_chain;
+
+            if (node->val.i >= 0) {
+                JRB srch = jrb_find_int(anno_vals, node->val.i);
+                char *rc = srch ? srch->val.s : NULL;
+                char first_char = rc ? rc[0] : '?';
+
+                if (!jvc) {
+                    if (rc) {
+                        node->val2.v = hexify(strdup(rc));
+                    } else {
+                        node->val2.v = NULL;
+                    }
+                } else {
+                    char *rc2;
+                    int len = rc ? strlen(rc) : 0;
+                    int iter = 1;
+
+                    while (jvc) {
+                        srch = jrb_find_int(anno_vals, jvc->val.i);
+                        rc = srch ? srch->val.s : NULL;
+                        len += (rc ? strlen(rc) : 0);
+                        iter++;
+                        jvc = jvc->next;
+                    }
+
+                    if (iter == len) {
+                        int pos = 1;
+                        jvc = node->jval_chain;
+                        rc2 = calloc(1, len + 1);
+                        rc2[0] = first_char;
+
+                        while (jvc) {
+                            srch = jrb_find_int(anno_vals, jvc->val.i);
+                            rc = srch->val.s;
+                            rc2[pos++] = *rc;
+                            jvc = jvc->next;
+                        }
+
+                        node->val2.v = hexify(strdup(rc2));
+                        free(rc2);
+                    } else {
+                        node->val2.v = NULL;
+                    }
+                }
+            } else {
+                node->val2.v = NULL;
+            }
+        }
+
+        jrb_traverse(node, anno_vals)
+        {
+            if (node->val.s)
+                free(node->val.s);
+        }
+        jrb_free_tree(anno_vals);
+        anno_vals = NULL;
+    }
+}
+
+static void anno_clear(struct logfile_context_t *ctx, GtkTextBuffer *buffer)
+{
+    guint i;
+
+    if (ctx->anno) {
+        for (i = 0; i < ctx->anno->len; i++) {
+            struct anno_range_t *r = &g_array_index(ctx->anno, struct anno_range_t, i);
+
+            gtk_text_buffer_delete_mark(buffer, r->start);
+            gtk_text_buffer_delete_mark(buffer, r->end);
+        }
+        g_array_free(ctx->anno, TRUE);
+        ctx->anno = NULL;
+    }
+
+    if (ctx->time_start) {
+        gtk_text_buffer_delete_mark(buffer, ctx->time_start);
+        gtk_text_buffer_delete_mark(buffer, ctx->time_end);
+        ctx->time_start = ctx->time_end = NULL;
     }
 }
 
+/* replaces the text between two marks, inserting with the tags of log_text() or
+ * log_text_bold() */
+static void anno_replace(struct text_find_t *t,
+                         GtkTextMark *start,
+                         GtkTextMark *end,
+                         const char *str,
+                         gboolean bold)
+{
+    GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(t->text));
+    GtkTextIter st_iter, en_iter;
+
+    gtk_text_buffer_get_iter_at_mark(buffer, &st_iter, start);
+    gtk_text_buffer_get_iter_at_mark(buffer, &en_iter, end);
+    gtk_text_buffer_delete(buffer, &st_iter, &en_iter);
+
+    if (bold) {
+        gtk_text_buffer_insert_with_tags(buffer,
+                                         &st_iter,
+                                         str,
+                                         -1,
+                                         t->bold_tag,
+                                         t->mono_tag,
+                                         t->size_tag,
+                                         t->fwht_tag,
+                                         t->blue_tag,
+                                         NULL);
+    } else {
+        gtk_text_buffer_insert_with_tags(buffer,
+                                         &st_iter,
+                                         str,
+                                         -1,
+                                         t->mono_tag,
+                                         t->size_tag,
+                                         NULL);
+    }
+
+    /* all marks have left gravity, so the end mark stayed in front of the new text */
+    gtk_text_buffer_move_mark(buffer, end, &st_iter);
+}
+
+/* updates the marker time and the annotated values of a text without rebuilding it, returns
+ * FALSE if the set of annotated identifiers changed and a full rebuild is required */
+static gboolean anno_update_in_place(struct text_find_t *t)
+{
+    struct logfile_context_t *ctx = t->ctx;
+    JRB node;
+    guint i;
+    int old_count = 0, new_count = 0;
+
+    if (!ctx->anno || !ctx->time_start || !anno_ctx->marker_set) {
+        return FALSE;
+    }
+
+    jrb_traverse(node, ctx->varnames)
+    {
+        if (node->val2.v)
+            old_count++;
+    }
+
+    anno_update_values(ctx);
+
+    jrb_traverse(node, ctx->varnames)
+    {
+        if (node->val2.v)
+            new_count++;
+    }
+
+    if (old_count != new_count) {
+        return FALSE;
+    }
+
+    for (i = 0; i < ctx->anno->len; i++) {
+        if (!g_array_index(ctx->anno, struct anno_range_t, i).node->val2.v) {
+            return FALSE;
+        }
+    }
+
+    anno_replace(t, ctx->time_start, ctx->time_end, anno_ctx->time_string, FALSE);
+
+    for (i = 0; i < ctx->anno->len; i++) {
+        struct anno_range_t *r = &g_array_index(ctx->anno, struct anno_range_t, i);
+
+        anno_replace(t, r->start, r->end, r->node->val2.v, TRUE);
+    }
+
+    return TRUE;
+}
+
 // When double-clicking an identifier in logfile.
 // Try to interpert it as a sub-module of the current module.
 // If such module exist. Open it in a new tab.
@@ -960,7 +1327,9 @@ gboolean update_ctx_when_idle(gpointer textview_or_dummy)
         }
 
         if (t->window) {
-            if ((!t->ctx->display_mode) || (textview_or_dummy)) {
+            if (!textview_or_dummy && anno_update_in_place(t)) {
+                /* only the annotations changed */
+            } else if ((!t->ctx->display_mode) || (textview_or_dummy)) {
                 GtkTextIter st_iter, en_iter;
 
                 GtkAdjustment *vadj = gtk_scrollable_get_vadjustment(GTK_SCROLLABLE(t->text));
@@ -1038,6 +1407,8 @@ static void destroy_callback(GtkButton* widget)
 
         if (ctx->title)
             free(ctx->title);
+        if (ctx->anno)
+            g_array_free(ctx->anno, TRUE);
 
         /* Avoid dereferencing null pointers. */
         if (varnames == NULL)
@@ -1189,6 +1560,9 @@ void bwlogbox_2(struct logfile_context_t *ctx,
     char *design_unit = t->item;
     int s_line = t->s_line;
     int e_line = t->e_line;
+    GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(text));
+
+    anno_clear(ctx, buffer);
 
     handle = fopen(default_text, "rb");
     if (!handle) {
@@ -1253,11 +1627,12 @@ void bwlogbox_2(struct logfile_context_t *ctx,
         sprintf(buf, " occupies lines %d - %d.\n", s_line, e_line);
         log_text(text, NULL, buf);
         if (anno_ctx) {
-            sprintf(buf,
-                    "Marker time for '%s' is %s.\n",
-                    anno_ctx->aet_name,
-                    anno_ctx->marker_set ? anno_ctx->time_string : "not set");
+            sprintf(buf, "Marker time for '%s' is ", anno_ctx->aet_name);
             log_text(text, NULL, buf);
+            ctx->time_start = gtk_text_buffer_create_mark(buffer, NULL, &iterx, TRUE);
+            log_text(text, NULL, anno_ctx->marker_set ? anno_ctx->time_string : "not set");
+            ctx->time_end = gtk_text_buffer_create_mark(buffer, NULL, &iterx, TRUE);
+            log_text(text, NULL, ".\n");
         }
 
         log_text(text, NULL, "\n");
@@ -1271,6 +1646,7 @@ void bwlogbox_2(struct logfile_context_t *ctx,
         JRB varnames = NULL;
         JRB node;
         int numvars = 0;
+        GArray *anno = NULL;
 
         /* build up list of potential variables in this module */
         if (!display_mode && !ctx->varnames) {
@@ -1303,12 +1679,8 @@ void bwlogbox_2(struct logfile_context_t *ctx,
 
             /*************************/
             if (fst) {
-                int numfacs = fstReaderGetVarCount(fst);
-                int i;
-                const char *scp_nam = NULL;
-                fstHandle fh = 0;
-                int new_scope_encountered = 1;
-                int good_scope = 0;
+                GArray *vars;
+                guint i;
 
                 if (ctx->varnames)
                     goto skip_resolved_fst;
@@ -1317,83 +1689,33 @@ void bwlogbox_2(struct logfile_context_t *ctx,
                 {
                     node->val.i = -1;
                 }
-                fstReaderIterateHierRewind(fst);
-                fstReaderResetScope(fst);
 
-                for (i = 0; i < numfacs; i++) {
-                    struct fstHier *h;
-
-                    new_scope_encountered = 0;
-                    while ((h = fstReaderIterateHier(fst))) {
-                        int do_brk = 0;
-                        switch (h->htyp) {
-                            case FST_HT_SCOPE:
-                                scp_nam = fstReaderPushScope(fst, h->u.scope.name, NULL);
-                                new_scope_encountered = 1;
-                                break;
-                            case FST_HT_UPSCOPE:
-                                scp_nam = fstReaderPopScope(fst);
-                                new_scope_encountered = 1;
-                                break;
-                            case FST_HT_VAR:
-                                scp_nam = fstReaderGetCurrentFlatScope(fst);
-                                if (!h->u.var.is_alias)
-                                    fh++;
-                                do_brk = 1;
-                                break;
-                            default:
-                                break;
-                        }
-                        if (do_brk)
-                            break;
-                    }
-                    if (!h)
-                        break;
+                vars = fst_get_scope_vars(title);
+                for (i = 0; vars && i < vars->len; i++) {
+                    struct fst_scope_var_t *v = &g_array_index(vars, struct fst_scope_var_t, i);
 
-                    if (!new_scope_encountered) {
-                        if (!good_scope) {
-                            continue;
-                        }
-                    } else {
-                        good_scope = !strcmp(scp_nam, title);
-                    }
-
-                    if (!good_scope) {
-                        if (resolved == numvars) {
-                            break;
-                        }
-                    } else {
-                        jrb_traverse(node, varnames)
+                    jrb_traverse(node, varnames)
+                    {
+                        if (node->val.i < 0) {
+                            if (!fst_alpha_strcmpeq(v->name, node->key.s)) {
+                                resolved++;
+                                node->val.i = v->handle;
+                            }
+                        } else /* bitblasted */
                         {
-                            if (node->val.i < 0) {
-                                if (!fst_alpha_strcmpeq(h->u.var.name, node->key.s)) {
-                                    resolved++;
-                                    if (h->u.var.is_alias) {
-                                        node->val.i = h->u.var.handle;
-                                    } else {
-                                        node->val.i = fh;
-                                    }
-                                }
-                            } else /* bitblasted */
-                            {
-                                if (!fst_alpha_strcmpeq(h->u.var.name, node->key.s)) {
-                                    struct jrb_chain *jvc = node->jval_chain;
-                                    if (jvc) {
-                                        while (jvc->next)
-                                            jvc = jvc->next;
-                                        jvc->next = calloc(1, sizeof(struct jrb_chain));
+                            if (!fst_alpha_strcmpeq(v->name, node->key.s)) {
+                                struct jrb_chain *jvc = node->jval_chain;
+                                if (jvc) {
+                                    while (jvc->next)
                                         jvc = jvc->next;
-                                    } else {
-                                        jvc = calloc(1, sizeof(struct jrb_chain));
-                                        node->jval_chain = jvc;
-                                    }
-
-                                    if (h->u.var.is_alias) {
-                                        jvc->val.i = h->u.var.is_alias;
-                                    } else {
-                                        jvc->val.i = fh;
-                                    }
+                                    jvc->next = calloc(1, sizeof(struct jrb_chain));
+                                    jvc = jvc->next;
+                                } else {
+                                    jvc = calloc(1, sizeof(struct jrb_chain));
+                                    node->jval_chain = jvc;
                                 }
+
+                                jvc->val.i = v->handle;
                             }
                         }
                     }
@@ -1404,69 +1726,6 @@ void bwlogbox_2(struct logfile_context_t *ctx,
             skip_resolved_fst:
                 varnames = ctx->varnames;
                 resolved = ctx->resolved;
-
-                jrb_traverse(node, varnames)
-                {
-                    if (node->val.i >= 0) {
-                        char rcb[65537];
-                        char *rc;
-                        struct jrb_chain *jvc = node->jval_chain;
-                        char first_char;
-
-                        rc = fstReaderGetValueFromHandleAtTime(fst,
-                                                               anno_ctx->marker,
-                                                               node->val.i,
-                                                               rcb);
-                        first_char = rc ? rc[0] : '?';
-
-                        if (!jvc) {
-                            if (rc) {
-                                node->val2.v = hexify(strdup(rc));
-                            } else {
-                                node->val2.v = NULL;
-                            }
-                        } else {
-                            char *rc2;
-                            int len = rc ? strlen(rc) : 0;
-                            int iter = 1;
-
-                            while (jvc) {
-                                fstReaderGetValueFromHandleAtTime(fst,
-                                                                  anno_ctx->marker,
-                                                                  jvc->val.i,
-                                                                  rc);
-                                len +=
-                                    (rc ? strlen(rc) : 0); /* scan-build : possible null pointer */
-                                iter++;
-                                jvc = jvc->next;
-                            }
-
-                            if (iter == len) {
-                                int pos = 1;
-                                jvc = node->jval_chain;
-                                rc2 = calloc(1, len + 1);
-                                rc2[0] = first_char;
-
-                                while (jvc) {
-                                    char rcv[65537];
-                                    fstReaderGetValueFromHandleAtTime(fst,
-                                                                      anno_ctx->marker,
-                                                                      jvc->val.i,
-                                                                      rcv);
-                                    rc2[pos++] = *rcv;
-                                    jvc = jvc->next;
-                                }
-
-                                node->val2.v = hexify(strdup(rc2));
-                                free(rc2);
-                            } else {
-                                node->val2.v = NULL;
-                            }
-                        }
-                    } else {
-                        node->val2.v = NULL;
-                    }
-                }
             }
             /*************************/
             else if (vzt) {
@@ -1554,54 +1813,6 @@ void bwlogbox_2(struct logfile_context_t *ctx,
             skip_resolved_vzt:
                 varnames = ctx->varnames;
                 resolved = ctx->resolved;
-
-                jrb_traverse(node, varnames)
-                {
-                    if (node->val.i >= 0) {
-                        char *rc = vzt_rd_value(vzt, anno_ctx->marker, node->val.i);
-                        struct jrb_chain *jvc = node->jval_chain;
-                        char first_char = rc ? rc[0] : '?';
-
-                        if (!jvc) {
-                            if (rc) {
-                                node->val2.v = hexify(strdup(rc));
-                            } else {
-                                node->val2.v = NULL;
-                            }
-                        } else {
-                            char *rc2;
-                            int len = rc ? strlen(rc) : 0;
-                            int iter = 1;
-
-                            while (jvc) {
-                                rc = vzt_rd_value(vzt, anno_ctx->marker, jvc->val.i);
-                                len += (rc ? strlen(rc) : 0);
-                                iter++;
-                                jvc = jvc->next;
-                            }
-
-                            if (iter == len) {
-                                int pos = 1;
-                                jvc = node->jval_chain;
-                                rc2 = calloc(1, len + 1);
-                                rc2[0] = first_char;
-
-                                while (jvc) {
-                                    char *rcv = vzt_rd_value(vzt, anno_ctx->marker, jvc->val.i);
-                                    rc2[pos++] = *rcv;
-                                    jvc = jvc->next;
-                                }
-
-                                node->val2.v = hexify(strdup(rc2));
-                                free(rc2);
-                            } else {
-                                node->val2.v = NULL;
-                            }
-                        }
-                    } else {
-                        node->val2.v = NULL;
-                    }
-                }
             }
             /******/
             else if (lx2) {
@@ -1695,73 +1906,11 @@ void bwlogbox_2(struct logfile_context_t *ctx,
             skip_resolved_lxt2:
                 varnames = ctx->varnames;
                 resolved = ctx->resolved;
-
-                lx2vals = make_jrb();
-                lxt2_rd_unlimit_time_range(lx2);
-                lxt2_rd_limit_time_range(lx2, anno_ctx->marker, anno_ctx->marker);
-                lxt2_rd_iter_blocks(lx2, lx2_iter_fn, NULL);
-
-                jrb_traverse(node, varnames)
-                {
-                    struct jrb_chain *jvc = node->jval_chain;
-
-                    if (node->val.i >= 0) {
-                        JRB srch = jrb_find_int(lx2vals, node->val.i);
-                        char *rc = srch ? srch->val.s : NULL;
-                        char first_char = rc ? rc[0] : '?';
-
-                        if (!jvc) {
-                            if (rc) {
-                                node->val2.v = hexify(strdup(rc));
-                            } else {
-                                node->val2.v = NULL;
-                            }
-                        } else {
-                            char *rc2;
-                            int len = rc ? strlen(rc) : 0;
-                            int iter = 1;
-
-                            while (jvc) {
-                                srch = jrb_find_int(lx2vals, jvc->val.i);
-                                rc = srch ? srch->val.s : NULL;
-                                len += (rc ? strlen(rc) : 0);
-                                iter++;
-                                jvc = jvc->next;
-                            }
-
-                            if (iter == len) {
-                                int pos = 1;
-                                jvc = node->jval_chain;
-                                rc2 = calloc(1, len + 1);
-                                rc2[0] = first_char;
-
-                                while (jvc) {
-                                    srch = jrb_find_int(lx2vals, jvc->val.i);
-                                    rc = srch->val.s;
-                                    rc2[pos++] = *rc;
-                                    jvc = jvc->next;
-                                }
-
-                                node->val2.v = hexify(strdup(rc2));
-                                free(rc2);
-                            } else {
-                                node->val2.v = NULL;
-                            }
-                        }
-                    } else {
-                        node->val2.v = NULL;
-                    }
-                }
-
-                jrb_traverse(node, lx2vals)
-                {
-                    if (node->val.s)
-                        free(node->val.s);
-                }
-                jrb_free_tree(lx2vals);
-                lx2vals = NULL;
             }
+
             if (resolved > 0) {
+                anno_update_values(ctx);
+                anno = g_array_new(FALSE, FALSE, sizeof(struct anno_range_t));
                 w = wlog_head;
                 while (w) {
                     if ((w->line_no >= s_line) && (w->line_no <= e_line)) {
@@ -1770,9 +1919,17 @@ void bwlogbox_2(struct logfile_context_t *ctx,
                             {
                                 node = jrb_find_str(varnames, w->text);
                                 if ((node) && (node->val2.v)) {
+                                    struct anno_range_t r;
+
                                     log_text(text, fontx, w->text);
                                     log_text_bold(text, fontx, "[");
+                                    r.node = node;
+                                    r.start =
+                                        gtk_text_buffer_create_mark(buffer, NULL, &iterx, TRUE);
                                     log_text_bold(text, fontx, node->val2.v);
+                                    r.end =
+                                        gtk_text_buffer_create_mark(buffer, NULL, &iterx, TRUE);
+                                    g_array_append_val(anno, r);
                                     log_text_bold(text, fontx, "]");
                                     goto iter_free;
                                 }
@@ -1805,6 +1962,7 @@ void bwlogbox_2(struct logfile_context_t *ctx,
                 }
                 free(pnt);
                 /* wlog_head = */ wlog_curr = NULL;
+                ctx->anno = anno;
                 goto free_vars;
             }
         }
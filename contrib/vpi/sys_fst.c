@@ -23,6 +23,11 @@ $fstdumpfile check=sys_dumpfile_compiletf call=sys_dumpfile_calltf acc+=r:*
 $fstdumpvars check=sys_dumpvars_compiletf call=sys_dumpvars_calltf acc+=r:*
 $fstdumpoff  check=sys_dumpoff_compiletf  call=sys_dumpoff_calltf  acc+=r:*
 
+
+Asynchronous mode: compile with -DFST_DUMPER_ASYNC and link with -lpthread.
+The simulator thread then only copies raw values into a buffer, a writer
+thread formats them and feeds the FST writer.
+
  */
 
 #include  <vpi_user.h>
@@ -34,6 +39,9 @@ $fstdumpoff  check=sys_dumpoff_compiletf  call=sys_dumpoff_calltf  acc+=r:*
 #include  <time.h>
 #include  <inttypes.h>
 #include  "fstapi.h"
+#ifdef FST_DUMPER_ASYNC
+#include  <pthread.h>
+#endif
 
 struct fst_info {
     struct fst_info *dump_chain;
@@ -41,6 +49,7 @@ struct fst_info {
     s_vpi_value     value;
 
     fstHandle       fstSym;
+    int             size;
     unsigned        is_real:1;
     unsigned        is_changed:1;
 };
@@ -71,6 +80,287 @@ timerec_to_time64(s_vpi_time * vt)
 }
 
 
+#ifdef FST_DUMPER_ASYNC
+
+/*
+ * double buffered value capture: the simulator thread appends records to
+ * the fill buffer, once it is large enough it is handed over to the writer
+ * thread, which formats the values and emits them while the simulator
+ * continues into the other buffer.
+ *
+ * a record is a kind/sym header followed by its payload:
+ *   FST_ASYNC_TIME  uint64_t time
+ *   FST_ASYNC_REAL  double
+ *   FST_ASYNC_VEC   uint32_t size, then aval/bval pairs (vpiVectorVal)
+ */
+#define FST_ASYNC_TIME		(0)
+#define FST_ASYNC_REAL		(1)
+#define FST_ASYNC_VEC		(2)
+
+#define FST_ASYNC_BUF_SIZ	(4 * 1024 * 1024)
+
+struct fst_async_buf {
+    unsigned char  *data;
+    size_t          len;
+    size_t          alloc;
+};
+
+static struct fst_async_buf async_bufs[2];
+static struct fst_async_buf *async_fill = NULL;
+static struct fst_async_buf *async_pending = NULL;
+static int      async_quit = 0;
+static int      async_running = 0;
+
+static pthread_t async_thread;
+static pthread_mutex_t async_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_cond = PTHREAD_COND_INITIALIZER;
+
+
+static unsigned char *
+async_reserve(size_t len)
+{
+    struct fst_async_buf *b = async_fill;
+    unsigned char  *pnt;
+
+    if (b->len + len > b->alloc) {
+	while (b->len + len > b->alloc) {
+	    b->alloc = b->alloc ? b->alloc * 2 : FST_ASYNC_BUF_SIZ;
+	}
+	b->data = realloc(b->data, b->alloc);
+    }
+
+    pnt = b->data + b->len;
+    b->len += len;
+    return (pnt);
+}
+
+
+static void
+async_put_header(uint32_t kind, uint32_t sym, size_t payload, unsigned char **pnt)
+{
+    unsigned char  *p = async_reserve(2 * sizeof(uint32_t) + payload);
+
+    memcpy(p, &kind, sizeof(uint32_t));
+    memcpy(p + sizeof(uint32_t), &sym, sizeof(uint32_t));
+    *pnt = p + 2 * sizeof(uint32_t);
+}
+
+
+static void
+async_emit_time(uint64_t tim)
+{
+    unsigned char  *p;
+
+    async_put_header(FST_ASYNC_TIME, 0, sizeof(uint64_t), &p);
+    memcpy(p, &tim, sizeof(uint64_t));
+}
+
+
+static void
+async_capture(struct fst_info *a_info)
+{
+    s_vpi_value     value;
+    unsigned char  *p;
+
+    if (!a_info->is_real) {
+	uint32_t        size = a_info->size;
+	uint32_t        words = (size + 31) / 32;
+
+	value.format = vpiVectorVal;
+	vpi_get_value(a_info->item, &value);
+
+	async_put_header(FST_ASYNC_VEC, a_info->fstSym,
+			 sizeof(uint32_t) + words * sizeof(s_vpi_vecval), &p);
+	memcpy(p, &size, sizeof(uint32_t));
+	memcpy(p + sizeof(uint32_t), value.value.vector,
+	       words * sizeof(s_vpi_vecval));
+    } else {
+	double          d;
+
+	value.format = vpiRealVal;
+	vpi_get_value(a_info->item, &value);
+	d = value.value.real;
+
+	async_put_header(FST_ASYNC_REAL, a_info->fstSym, sizeof(double), &p);
+	memcpy(p, &d, sizeof(double));
+    }
+}
+
+
+/* hands the fill buffer to the writer thread, waits if it is still busy */
+static void
+async_flush(void)
+{
+    if (!async_fill->len)
+	return;
+
+    pthread_mutex_lock(&async_mutex);
+    while (async_pending)
+	pthread_cond_wait(&async_cond, &async_mutex);
+
+    async_pending = async_fill;
+    async_fill = (async_fill == &async_bufs[0]) ? &async_bufs[1] : &async_bufs[0];
+    async_fill->len = 0;
+
+    pthread_cond_broadcast(&async_cond);
+    pthread_mutex_unlock(&async_mutex);
+}
+
+
+static void
+async_write_buf(struct fst_async_buf *b, char **str, uint32_t *str_len)
+{
+    unsigned char  *p = b->data;
+    unsigned char  *end = b->data + b->len;
+
+    while (p < end) {
+	uint32_t        kind,
+	                sym;
+
+	memcpy(&kind, p, sizeof(uint32_t));
+	memcpy(&sym, p + sizeof(uint32_t), sizeof(uint32_t));
+	p += 2 * sizeof(uint32_t);
+
+	if (kind == FST_ASYNC_TIME) {
+	    uint64_t        tim;
+
+	    memcpy(&tim, p, sizeof(uint64_t));
+	    p += sizeof(uint64_t);
+	    fstWriterEmitTimeChange(ctx, tim);
+	} else if (kind == FST_ASYNC_REAL) {
+	    double          d;
+
+	    memcpy(&d, p, sizeof(double));
+	    p += sizeof(double);
+	    fstWriterEmitValueChange(ctx, sym, &d);
+	} else {
+	    uint32_t        size,
+	                    i;
+	    s_vpi_vecval    vec;
+
+	    memcpy(&size, p, sizeof(uint32_t));
+	    p += sizeof(uint32_t);
+
+	    if (size + 1 > *str_len) {
+		*str_len = size + 1;
+		*str = realloc(*str, *str_len);
+	    }
+
+	    /* msb first, ab: 00=0, 10=1, 11=X, 01=Z */
+	    for (i = 0; i < size; i++) {
+		uint32_t        bit = size - 1 - i;
+		uint32_t        a,
+		                bb;
+
+		if (!i || ((bit & 31) == 31)) {
+		    memcpy(&vec, p + (bit / 32) * sizeof(s_vpi_vecval),
+			   sizeof(s_vpi_vecval));
+		}
+
+		a = ((uint32_t) vec.aval >> (bit & 31)) & 1;
+		bb = ((uint32_t) vec.bval >> (bit & 31)) & 1;
+		(*str)[i] = bb ? (a ? 'x' : 'z') : (a ? '1' : '0');
+	    }
+	    (*str)[size] = 0;
+
+	    p += ((size + 31) / 32) * sizeof(s_vpi_vecval);
+	    fstWriterEmitValueChange(ctx, sym, *str);
+	}
+    }
+}
+
+
+static void    *
+async_writer(void *arg)
+{
+    char           *str = NULL;
+    uint32_t        str_len = 0;
+
+    (void) arg;
+
+    pthread_mutex_lock(&async_mutex);
+    for (;;) {
+	struct fst_async_buf *b;
+
+	while (!async_pending && !async_quit)
+	    pthread_cond_wait(&async_cond, &async_mutex);
+
+	if (!async_pending)
+	    break;
+
+	b = async_pending;
+	pthread_mutex_unlock(&async_mutex);
+
+	async_write_buf(b, &str, &str_len);
+
+	pthread_mutex_lock(&async_mutex);
+	async_pending = NULL;
+	pthread_cond_broadcast(&async_cond);
+    }
+    pthread_mutex_unlock(&async_mutex);
+
+    free(str);
+    return (NULL);
+}
+
+
+static void
+async_start(void)
+{
+    /* $fstdumpvars may be called again in the same timestep */
+    if (async_running)
+	return;
+
+    async_fill = &async_bufs[0];
+    async_fill->len = 0;
+    async_pending = NULL;
+    async_quit = 0;
+
+    async_running = !pthread_create(&async_thread, NULL, async_writer, NULL);
+}
+
+
+static void
+async_stop(void)
+{
+    int             i;
+
+    if (!async_running)
+	return;
+
+    async_flush();
+
+    pthread_mutex_lock(&async_mutex);
+    async_quit = 1;
+    pthread_cond_broadcast(&async_cond);
+    pthread_mutex_unlock(&async_mutex);
+
+    pthread_join(async_thread, NULL);
+    async_running = 0;
+
+    for (i = 0; i < 2; i++) {
+	free(async_bufs[i].data);
+	async_bufs[i].data = NULL;
+	async_bufs[i].len = async_bufs[i].alloc = 0;
+    }
+}
+
+#endif
+
+
+static void
+emit_time_change(uint64_t now64)
+{
+#ifdef FST_DUMPER_ASYNC
+    if (async_running) {
+	async_emit_time(now64);
+	return;
+    }
+#endif
+    fstWriterEmitTimeChange(ctx, now64);
+}
+
+
 static int
 dump_header_pending(void)
 {
@@ -91,11 +381,16 @@ variable_cb_rosync(p_cb_data cause)
 
    if((now64 > prev64) || (!now64))
 	{
-	fstWriterEmitTimeChange(ctx, now64);
+	emit_time_change(now64);
     	prev64 = now64;
 	}
 
     while (a_info) {
+#ifdef FST_DUMPER_ASYNC
+	if (async_running) {
+	    async_capture(a_info);
+	} else
+#endif
 	if (!a_info->is_real) {
 	    value.value.str = NULL;
 	    value.format = vpiBinStrVal;
@@ -119,6 +414,12 @@ variable_cb_rosync(p_cb_data cause)
     }
 
     fst_dump_list = NULL;
+
+#ifdef FST_DUMPER_ASYNC
+    if (async_running && (async_fill->len >= FST_ASYNC_BUF_SIZ)) {
+	async_flush();
+    }
+#endif
     return (0);
 
 }
@@ -218,6 +519,9 @@ end_of_sim_cb(p_cb_data cause)
 {
     if (ctx) 	
 	{
+#ifdef FST_DUMPER_ASYNC
+	async_stop();
+#endif
 	fstWriterClose(ctx);
 	ctx = NULL;
 	prev64 = 0;
@@ -236,7 +540,7 @@ uint64_t        now64 = timerec_to_time64(tim);
 
 if(now64 > prev64)
 	{
-	fstWriterEmitTimeChange(ctx, now64);
+	emit_time_change(now64);
 	prev64 = now64;
 	}
 
@@ -513,6 +817,7 @@ draw_module_type(vpiHandle item, int typ)
 	}
 
 	info->item = net;
+	info->size = siz;
 	info->is_changed = 1;
 
 	info->dump_chain = fst_dump_list;
@@ -762,6 +1067,9 @@ sys_dumpvars_calltf(char *name)
 	fstWriterSetTimescale(ctx, prec);
 	fstWriterEmitTimeChange(ctx, 0);
 
+#ifdef FST_DUMPER_ASYNC
+	async_start();
+#endif
 	install_rosync_cb();
     }
 
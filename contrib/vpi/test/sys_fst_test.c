@@ -0,0 +1,386 @@
+/*
+
+Stub VPI harness for sys_fst.c: checks that FST_DUMPER_ASYNC emits the same
+sequence of time and value changes as the synchronous dumper.
+
+The simulator is replaced by a handful of fake nets (scalars, vectors wider
+than 32 bits with x and z in every word, a real) and the FST writer by stubs
+which log every emitted change.  The same random value changes are dumped
+once synchronously and once through the writer thread, enough of them to
+hand several buffers over, then both logs are compared.  both runs start
+with two $fstdumpvars calls in the same timestep.
+
+to compile/run under LINUX, with fstapi.h from libfst on the include path
+(only its declarations are used):
+
+cc -O2 -I.. -I/path/to/libfst -o sys_fst_test sys_fst_test.c -lpthread
+./sys_fst_test
+
+ */
+
+#define FST_DUMPER_ASYNC
+
+#include  <stdarg.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <inttypes.h>
+#include  "fstapi.h"
+
+/*
+ * FST writer stubs: the declarations of fstapi.h are already seen, so
+ * sys_fst.c calls these instead of the writer.
+ */
+static void     stub_emit_time(uint64_t tim);
+static void     stub_emit_value(fstHandle sym, const void *val);
+
+#define fstWriterCreate(nam, use_compressed_hier) ((struct fstContext *) &stub_ctx)
+#define fstWriterSetPackType(c, typ) ((void) 0)
+#define fstWriterSetDate(c, dat) ((void) 0)
+#define fstWriterSetVersion(c, vers) ((void) 0)
+#define fstWriterSetTimescale(c, ts) ((void) 0)
+#define fstWriterSetScope(c, typ, nam, comp) ((void) 0)
+#define fstWriterSetUpscope(c) ((void) 0)
+#define fstWriterSetSourceStem(c, path, line, use_realpath) ((void) 0)
+#define fstWriterSetSourceInstantiationStem(c, path, line, use_realpath) ((void) 0)
+#define fstWriterCreateVar(c, vt, vd, len, nam, alias) ((fstHandle) 0)
+#define fstWriterEmitTimeChange(c, tim) stub_emit_time(tim)
+#define fstWriterEmitValueChange(c, sym, val) stub_emit_value(sym, val)
+#define fstWriterClose(c) ((void) 0)
+
+static int      stub_ctx;
+
+#include  "../sys_fst.c"
+
+/*************************************************/
+
+#define NUM_NETS	(7)
+#define NUM_STEPS	(200000)
+
+struct fake_net {
+    int             size;
+    int             is_real;
+    s_vpi_vecval    vec[4];	/* up to 128 bits, word 0 holds bits 31..0 */
+    double          real;
+    struct fst_info *info;
+};
+
+static struct fake_net nets[NUM_NETS] = {
+    {1}, {8}, {32}, {33}, {70}, {96}, {64, 1}
+};
+
+struct emit_log {
+    char           *buf;
+    size_t          len;
+    size_t          alloc;
+};
+
+static struct emit_log *cur_log = NULL;
+static uint32_t rnd_state;
+
+
+static          uint32_t
+rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 8);
+}
+
+
+static void
+log_printf(const char *fmt, ...)
+{
+    va_list         ap;
+    int             n;
+
+    for (;;) {
+	va_start(ap, fmt);
+	n = vsnprintf(cur_log->buf + cur_log->len, cur_log->alloc - cur_log->len, fmt, ap);
+	va_end(ap);
+
+	if ((size_t) n < cur_log->alloc - cur_log->len)
+	    break;
+
+	cur_log->alloc = cur_log->alloc ? cur_log->alloc * 2 : 1024 * 1024;
+	cur_log->buf = realloc(cur_log->buf, cur_log->alloc);
+    }
+
+    cur_log->len += n;
+}
+
+
+static void
+stub_emit_time(uint64_t tim)
+{
+    log_printf("#%" PRIu64 "\n", tim);
+}
+
+
+static void
+stub_emit_value(fstHandle sym, const void *val)
+{
+    if (nets[sym - 1].is_real) {
+	double          d;
+
+	memcpy(&d, val, sizeof(double));
+	log_printf("r%.17g %u\n", d, (unsigned) sym);
+    } else {
+	log_printf("b%s %u\n", (const char *) val, (unsigned) sym);
+    }
+}
+
+
+/*
+ * VPI stubs, only the value and callback routines are reached from the
+ * dumper callbacks driven below.
+ */
+void
+vpi_get_value(vpiHandle expr, p_vpi_value value_p)
+{
+    static char     str[129];
+    struct fake_net *net = (struct fake_net *) expr;
+    int             i;
+
+    switch (value_p->format) {
+    case vpiRealVal:
+	value_p->value.real = net->real;
+	break;
+
+    case vpiVectorVal:
+	value_p->value.vector = net->vec;
+	break;
+
+    case vpiBinStrVal:
+	for (i = 0; i < net->size; i++) {
+	    int             bit = net->size - 1 - i;
+	    int             a = (net->vec[bit / 32].aval >> (bit & 31)) & 1;
+	    int             b = (net->vec[bit / 32].bval >> (bit & 31)) & 1;
+
+	    str[i] = "01zx"[(b << 1) | a];
+	}
+	str[net->size] = 0;
+	value_p->value.str = str;
+	break;
+
+    default:
+	fprintf(stderr, "sys_fst_test: unexpected value format %d\n", value_p->format);
+	exit(1);
+    }
+}
+
+vpiHandle
+vpi_register_cb(p_cb_data cb_data_p)
+{
+    (void) cb_data_p;
+    return (NULL);
+}
+
+PLI_INT32
+vpi_free_object(vpiHandle object)
+{
+    (void) object;
+    return (0);
+}
+
+PLI_INT32
+vpi_get(PLI_INT32 property, vpiHandle object)
+{
+    (void) property;
+    (void) object;
+    return (0);
+}
+
+PLI_BYTE8      *
+vpi_get_str(PLI_INT32 property, vpiHandle object)
+{
+    (void) property;
+    (void) object;
+    return ("stub");
+}
+
+vpiHandle
+vpi_handle(PLI_INT32 type, vpiHandle refHandle)
+{
+    (void) type;
+    (void) refHandle;
+    return (NULL);
+}
+
+vpiHandle
+vpi_iterate(PLI_INT32 type, vpiHandle refHandle)
+{
+    (void) type;
+    (void) refHandle;
+    return (NULL);
+}
+
+vpiHandle
+vpi_scan(vpiHandle iterator)
+{
+    (void) iterator;
+    return (NULL);
+}
+
+vpiHandle
+vpi_register_systf(p_vpi_systf_data systf_data_p)
+{
+    (void) systf_data_p;
+    return (NULL);
+}
+
+PLI_INT32
+vpi_mcd_printf(PLI_UINT32 mcd, PLI_BYTE8 * format,...)
+{
+    (void) mcd;
+    (void) format;
+    return (0);
+}
+
+PLI_INT32
+vpi_printf(PLI_BYTE8 * format,...)
+{
+    (void) format;
+    return (0);
+}
+
+PLI_INT32
+vpi_control(PLI_INT32 operation,...)
+{
+    (void) operation;
+    return (0);
+}
+
+PLI_BYTE8      *
+acc_product_version(void)
+{
+    return ("stub");
+}
+
+/*************************************************/
+
+/* random bits, one in four of them unknown or high impedance */
+static void
+random_vector(struct fake_net *net)
+{
+    int             words = (net->size + 31) / 32;
+    int             i;
+
+    for (i = 0; i < words; i++) {
+	uint32_t        a = (rnd() << 16) ^ rnd();
+	uint32_t        b = ((rnd() << 16) ^ rnd()) & ((rnd() << 16) ^ rnd());
+	uint32_t        mask = ((i == words - 1) && (net->size & 31)) ?
+	    ((1U << (net->size & 31)) - 1) : 0xffffffffU;
+
+	net->vec[i].aval = (PLI_INT32) (a & mask);
+	net->vec[i].bval = (PLI_INT32) (b & mask);
+    }
+}
+
+
+static void
+run(struct emit_log *log, int async)
+{
+    int             i,
+                    t;
+
+    cur_log = log;
+    rnd_state = 1;
+
+    /*
+     * $fstdumpvars twice in the same timestep, as a testbench may do: the
+     * writer thread must only be started once.  the synchronous run stops
+     * it again right away.
+     */
+    ctx = fstWriterCreate("stub.fst", 1);
+    prev64 = 0;
+    dump_is_off = 0;
+    dumpvars_status = 0;
+    fst_dump_list = NULL;
+
+    sys_dumpvars_calltf("$fstdumpvars");
+    sys_dumpvars_calltf("$fstdumpvars");
+    if (!async) {
+	async_stop();
+    }
+    dumpvars_status = 2;
+
+    for (i = 0; i < NUM_NETS; i++) {
+	nets[i].info = calloc(1, sizeof(struct fst_info));
+	nets[i].info->item = (vpiHandle) & nets[i];
+	nets[i].info->fstSym = i + 1;
+	nets[i].info->size = nets[i].size;
+	nets[i].info->is_real = nets[i].is_real;
+    }
+
+    if (async && !async_running) {
+	fprintf(stderr, "sys_fst_test: could not start the writer thread\n");
+	exit(1);
+    }
+
+    for (t = 0; t < NUM_STEPS; t++) {
+	s_cb_data       cause;
+	s_vpi_time      tim;
+
+	for (i = 0; i < NUM_NETS; i++) {
+	    s_cb_data       cb;
+
+	    if (t && (rnd() & 1))
+		continue;
+
+	    if (nets[i].is_real) {
+		nets[i].real = (double) (int32_t) rnd() / 3.0;
+	    } else {
+		random_vector(&nets[i]);
+	    }
+
+	    memset(&cb, 0, sizeof(cb));
+	    cb.user_data = (PLI_BYTE8 *) nets[i].info;
+	    variable_cb(&cb);
+	}
+
+	memset(&tim, 0, sizeof(tim));
+	tim.type = vpiSimTime;
+	tim.low = t * 10;
+
+	memset(&cause, 0, sizeof(cause));
+	cause.time = &tim;
+	variable_cb_rosync(&cause);
+    }
+
+    end_of_sim_cb(NULL);
+
+    for (i = 0; i < NUM_NETS; i++) {
+	free(nets[i].info);
+    }
+}
+
+
+int
+main(void)
+{
+    struct emit_log sync_log = {NULL, 0, 0};
+    struct emit_log async_log = {NULL, 0, 0};
+    size_t          i;
+    int             line = 1;
+
+    run(&sync_log, 0);
+    run(&async_log, 1);
+
+    for (i = 0; (i < sync_log.len) && (i < async_log.len); i++) {
+	if (sync_log.buf[i] != async_log.buf[i])
+	    break;
+	if (sync_log.buf[i] == '\n')
+	    line++;
+    }
+
+    if ((i != sync_log.len) || (i != async_log.len)) {
+	fprintf(stderr, "sys_fst_test: async emit sequence differs at line %d\n", line);
+	return (1);
+    }
+
+    printf("sys_fst_test: %d lines, %zu bytes match\n", line - 1, sync_log.len);
+
+    free(sync_log.buf);
+    free(async_log.buf);
+    return (0);
+}
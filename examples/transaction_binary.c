@@ -0,0 +1,362 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * transaction filter using the binary protocol, see src/ttrans_frame.h for the frame layout.
+ * every value change of the first bit vector becomes a transaction labelled with its value
+ * in hex, marker A is set on the first change.
+ *
+ * to compile: gcc -o transaction_binary transaction_binary.c
+ * then in this directory run: gtkwave transaction.gtkw
+ * and select transaction_binary as the transaction filter of a trace.  the filter accepts the
+ * binary protocol gtkwave offers with the first trace.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define REQUEST "$comment protocol binary 1 $end\n"
+#define ACCEPT "$protocol binary 1\n"
+#define FRAME_MAX_SIZE (64 * 1024 * 1024)
+
+/* values of GwBit as sent in 'V' frames */
+enum
+{
+    BIT_0 = 0,
+    BIT_1 = 3,
+    BIT_H = 4,
+    BIT_L = 7
+};
+
+enum
+{
+    KIND_BITS,
+    KIND_REAL,
+    KIND_STRING
+};
+
+struct signal
+{
+    uint32_t seqn;
+    int kind;
+    uint32_t width;
+};
+
+struct cursor
+{
+    const unsigned char *pnt;
+    const unsigned char *end;
+};
+
+struct out_frame
+{
+    unsigned char *buf;
+    size_t len;
+    size_t siz;
+    unsigned char typ;
+};
+
+static const unsigned char *get(struct cursor *c, uint32_t len)
+{
+    const unsigned char *pnt = c->pnt;
+
+    if ((uint32_t)(c->end - c->pnt) < len) {
+        fprintf(stderr, "transaction_binary: truncated frame\n");
+        exit(1);
+    }
+
+    c->pnt += len;
+    return pnt;
+}
+
+static uint64_t get_le(struct cursor *c, int len)
+{
+    const unsigned char *pnt = get(c, len);
+    uint64_t v = 0;
+    int i;
+
+    for (i = len - 1; i >= 0; i--) {
+        v = (v << 8) | pnt[i];
+    }
+    return v;
+}
+
+static const char *get_str(struct cursor *c, uint32_t *len)
+{
+    *len = (uint32_t)get_le(c, 4);
+    return (const char *)get(c, *len);
+}
+
+/* returns the frame type, or zero at the end of the stream */
+static int read_frame(unsigned char **payload, uint32_t *len)
+{
+    unsigned char hdr[8];
+    struct cursor c;
+
+    if (fread(hdr, 1, sizeof(hdr), stdin) != sizeof(hdr)) {
+        return 0;
+    }
+
+    c.pnt = hdr + 4;
+    c.end = hdr + 8;
+    *len = (uint32_t)get_le(&c, 4);
+    if (*len > FRAME_MAX_SIZE) {
+        return 0;
+    }
+
+    *payload = realloc(*payload, *len ? *len : 1);
+    if (*len && (fread(*payload, 1, *len, stdin) != *len)) {
+        return 0;
+    }
+
+    return hdr[0];
+}
+
+static void put(struct out_frame *f, const void *data, size_t len)
+{
+    if (f->len + len > f->siz) {
+        f->siz = (f->len + len) * 2;
+        f->buf = realloc(f->buf, f->siz);
+    }
+    memcpy(f->buf + f->len, data, len);
+    f->len += len;
+}
+
+static void put_le(struct out_frame *f, uint64_t v, int len)
+{
+    unsigned char b[8];
+    int i;
+
+    for (i = 0; i < len; i++) {
+        b[i] = (unsigned char)(v >> (8 * i));
+    }
+    put(f, b, len);
+}
+
+static void put_str(struct out_frame *f, const char *s)
+{
+    put_le(f, strlen(s), 4);
+    put(f, s, strlen(s));
+}
+
+static void frame_begin(struct out_frame *f, unsigned char typ)
+{
+    static const unsigned char hdr[8] = {0};
+
+    f->typ = typ;
+    f->len = 0;
+    put(f, hdr, sizeof(hdr));
+}
+
+static void frame_flush(struct out_frame *f)
+{
+    uint32_t len = (uint32_t)(f->len - 8);
+    int i;
+
+    f->buf[0] = f->typ;
+    for (i = 0; i < 4; i++) {
+        f->buf[4 + i] = (unsigned char)(len >> (8 * i));
+    }
+    fwrite(f->buf, 1, f->len, stdout);
+}
+
+/* formats the packed bits as hex, nibbles with unknown bits become x */
+static void format_hex(const unsigned char *packed, uint32_t width, char *out)
+{
+    uint32_t digits = (width + 3) / 4;
+    uint32_t d;
+
+    for (d = 0; d < digits; d++) {
+        int val = 0;
+        int unknown = 0;
+        uint32_t i;
+
+        for (i = 0; i < 4; i++) {
+            /* bit index from the MSB, the top nibble may be partial */
+            int64_t bit = (int64_t)width - 4 * (int64_t)(digits - d) + i;
+            int b;
+
+            val <<= 1;
+            if (bit < 0) {
+                continue;
+            }
+
+            b = (bit & 1) ? (packed[bit / 2] & 15) : (packed[bit / 2] >> 4);
+            if ((b == BIT_1) || (b == BIT_H)) {
+                val |= 1;
+            } else if ((b != BIT_0) && (b != BIT_L)) {
+                unknown = 1;
+            }
+        }
+
+        out[d] = unknown ? 'x' : "0123456789ABCDEF"[val];
+    }
+    out[digits] = 0;
+}
+
+int main(void)
+{
+    char line[1025];
+    unsigned char *payload = NULL;
+    struct signal *sigs = NULL;
+    struct out_frame out = {0};
+
+    /* the first trace is textual and starts with the offer, accept it and skip the trace */
+    if (!fgets(line, sizeof(line), stdin) || strcmp(line, REQUEST)) {
+        fprintf(stderr, "transaction_binary: gtkwave did not offer the binary protocol\n");
+        return 1;
+    }
+
+    fputs(ACCEPT, stdout);
+    fflush(stdout);
+
+    while (!strstr(line, "data_end")) {
+        if (!fgets(line, sizeof(line), stdin)) {
+            return 1;
+        }
+    }
+
+    for (;;) {
+        uint32_t sig_count = 0;
+        uint64_t max_time = 0;
+        uint32_t trace_seqn = 0;
+        uint32_t trace_width = 0;
+        int have_trace = 0;
+        int first_change = 1;
+        char name[256] = "Values";
+        char *hex = NULL;
+        int typ;
+        uint32_t len;
+
+        frame_begin(&out, 'T');
+
+        while ((typ = read_frame(&payload, &len)) && (typ != 'E')) {
+            struct cursor c = {payload, payload + len};
+
+            if (typ == 'H') {
+                const char *s;
+                uint32_t slen;
+                uint32_t i;
+
+                get_le(&c, 1); /* time dimension */
+                get_le(&c, 8); /* timescale */
+                get_le(&c, 8); /* timezero */
+                get_le(&c, 8); /* min time */
+                max_time = get_le(&c, 8);
+                s = get_str(&c, &slen);
+                snprintf(name, sizeof(name), "%.*s (hex)", (int)slen, s);
+                get_str(&c, &slen); /* args */
+
+                sig_count = (uint32_t)get_le(&c, 4);
+                sigs = realloc(sigs, (sig_count ? sig_count : 1) * sizeof(struct signal));
+                for (i = 0; i < sig_count; i++) {
+                    sigs[i].seqn = (uint32_t)get_le(&c, 4);
+                    sigs[i].kind = (int)get_le(&c, 1);
+                    sigs[i].width = (uint32_t)get_le(&c, 4);
+                    get_str(&c, &slen);
+
+                    if (!have_trace && (sigs[i].kind == KIND_BITS)) {
+                        have_trace = 1;
+                        trace_seqn = sigs[i].seqn;
+                        trace_width = sigs[i].width;
+                    }
+                }
+
+                hex = realloc(hex, trace_width / 4 + 2);
+            } else if (typ == 'V') {
+                while (c.pnt < c.end) {
+                    uint64_t tim = get_le(&c, 8);
+                    uint32_t seqn = (uint32_t)get_le(&c, 4);
+                    struct signal *sig = NULL;
+                    uint32_t i;
+
+                    for (i = 0; i < sig_count; i++) {
+                        if (sigs[i].seqn == seqn) {
+                            sig = &sigs[i];
+                            break;
+                        }
+                    }
+                    if (!sig) {
+                        fprintf(stderr, "transaction_binary: unknown signal %u\n", seqn);
+                        return 1;
+                    }
+
+                    if (sig->kind == KIND_REAL) {
+                        get(&c, 8);
+                    } else if (sig->kind == KIND_STRING) {
+                        uint32_t slen;
+                        get_str(&c, &slen);
+                    } else {
+                        const unsigned char *packed = get(&c, (sig->width + 1) / 2);
+
+                        if (have_trace && (seqn == trace_seqn)) {
+                            char label[300];
+
+                            format_hex(packed, trace_width, hex);
+                            snprintf(label, sizeof(label), "?darkgreen?%s", hex);
+                            put_le(&out, tim, 8);
+                            put_str(&out, label);
+
+                            if (first_change) {
+                                struct out_frame marker = {0};
+
+                                frame_begin(&marker, 'M');
+                                put_le(&marker, 0, 4); /* marker A */
+                                put_le(&marker, tim, 8);
+                                put_str(&marker, "First change");
+                                frame_flush(&marker);
+                                free(marker.buf);
+                                first_change = 0;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!typ) {
+            break; /* gtkwave went away */
+        }
+
+        /* an empty transaction closes the last one */
+        put_le(&out, max_time, 8);
+        put_str(&out, "");
+        frame_flush(&out);
+
+        frame_begin(&out, 'N');
+        put_str(&out, name);
+        frame_flush(&out);
+
+        frame_begin(&out, 'F');
+        frame_flush(&out);
+        fflush(stdout);
+
+        free(hex);
+        hex = NULL;
+    }
+
+    free(sigs);
+    free(payload);
+    free(out.buf);
+
+    return 0;
+}
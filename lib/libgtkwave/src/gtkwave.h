@@ -14,6 +14,7 @@
 #include "gw-color-theme.h"
 #include "gw-hist-ent.h"
 #include "gw-hist-ent-factory.h"
+#include "gw-hist-cursor.h"
 #include "gw-vector-ent.h"
 #include "gw-node.h"
 #include "gw-fac.h"
@@ -31,6 +32,7 @@
 #include "gw-enum-filter-list.h"
 #include "gw-dump-file.h"
 #include "gw-dump-file-builder.h"
+#include "gw-load-stats.h"
 #include "gw-loader.h"
 #include "gw-ghw-loader.h"
 #include "gw-ghw-file.h"
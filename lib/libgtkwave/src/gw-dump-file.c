@@ -1,6 +1,8 @@
 #include "gw-dump-file.h"
 #include "gw-enums.h"
 #include "gw-string-table.h"
+#include "gw-hist-cursor.h"
+#include "gw-node.h"
 
 // clang-format off
 G_DEFINE_QUARK(gw-dump-file-error-quark, gw_dump_file_error)
@@ -25,8 +27,32 @@ typedef struct
     gboolean has_supplemental_vartypes;
     gboolean has_escaped_names;
     gboolean uses_vhdl_component_format;
+
+    GwLoadStats *load_stats;
+
+    // Imported traces which can be evicted, most recently used first.
+    gsize memory_budget;
+    gsize memory_usage;
+    GQueue tracked;
+    GHashTable *tracked_links; // GwNode* -> GList* in tracked
 } GwDumpFilePrivate;
 
+typedef struct
+{
+    GwNode *node;
+    gsize size;
+    gpointer lazy;
+    GDestroyNotify lazy_destroy;
+} TrackedTrace;
+
+static void tracked_trace_free(TrackedTrace *trace)
+{
+    if (trace->lazy_destroy != NULL) {
+        trace->lazy_destroy(trace->lazy);
+    }
+    g_free(trace);
+}
+
 G_DEFINE_TYPE_WITH_PRIVATE(GwDumpFile, gw_dump_file, G_TYPE_OBJECT)
 
 enum
@@ -46,6 +72,7 @@ enum
     PROP_HAS_SUPPLEMENTAL_VARTYPES,
     PROP_HAS_ESCAPED_NAMES,
     PROP_USES_VHDL_COMPONENT_FORMAT,
+    PROP_LOAD_STATS,
     N_PROPERTIES,
 };
 
@@ -65,6 +92,31 @@ static void gw_dump_file_dispose(GObject *object)
     G_OBJECT_CLASS(gw_dump_file_parent_class)->dispose(object);
 }
 
+static void gw_dump_file_finalize(GObject *object)
+{
+    GwDumpFile *self = GW_DUMP_FILE(object);
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    if (priv->load_stats != NULL) {
+        // The statistics are only complete after all traces have been imported.
+        const gchar *stats_file = g_getenv("GW_LOAD_STATS_FILE");
+        if (stats_file != NULL && *stats_file != '\0') {
+            GError *error = NULL;
+            if (!gw_load_stats_append_json(priv->load_stats, stats_file, &error)) {
+                g_warning("%s", error->message);
+                g_error_free(error);
+            }
+        }
+
+        g_object_unref(priv->load_stats);
+    }
+
+    g_queue_clear_full(&priv->tracked, (GDestroyNotify)tracked_trace_free);
+    g_hash_table_unref(priv->tracked_links);
+
+    G_OBJECT_CLASS(gw_dump_file_parent_class)->finalize(object);
+}
+
 static void gw_dump_file_set_property(GObject *object,
                                       guint property_id,
                                       const GValue *value,
@@ -176,6 +228,10 @@ static void gw_dump_file_set_property(GObject *object,
             priv->uses_vhdl_component_format = g_value_get_boolean(value);
             break;
 
+        case PROP_LOAD_STATS:
+            gw_dump_file_set_load_stats(self, g_value_get_object(value));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -250,6 +306,10 @@ static void gw_dump_file_get_property(GObject *object,
             g_value_set_boolean(value, gw_dump_file_get_uses_vhdl_component_format(self));
             break;
 
+        case PROP_LOAD_STATS:
+            g_value_set_object(value, gw_dump_file_get_load_stats(self));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -261,6 +321,7 @@ static void gw_dump_file_class_init(GwDumpFileClass *klass)
     GObjectClass *object_class = G_OBJECT_CLASS(klass);
 
     object_class->dispose = gw_dump_file_dispose;
+    object_class->finalize = gw_dump_file_finalize;
     object_class->set_property = gw_dump_file_set_property;
     object_class->get_property = gw_dump_file_get_property;
 
@@ -374,12 +435,22 @@ static void gw_dump_file_class_init(GwDumpFileClass *klass)
                              FALSE,
                              G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+    properties[PROP_LOAD_STATS] =
+        g_param_spec_object("load-stats",
+                            NULL,
+                            NULL,
+                            GW_TYPE_LOAD_STATS,
+                            G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
     g_object_class_install_properties(object_class, N_PROPERTIES, properties);
 }
 
 static void gw_dump_file_init(GwDumpFile *self)
 {
-    (void)self;
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    g_queue_init(&priv->tracked);
+    priv->tracked_links = g_hash_table_new(g_direct_hash, g_direct_equal);
 }
 
 /**
@@ -400,7 +471,30 @@ gboolean gw_dump_file_import_traces(GwDumpFile *self, GwNode **nodes, GError **e
         return TRUE;
     }
 
-    return GW_DUMP_FILE_GET_CLASS(self)->import_traces(self, nodes, error);
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    if (priv->load_stats != NULL) {
+        gw_load_stats_begin_phase(priv->load_stats, GW_LOAD_PHASE_IMPORT);
+    }
+
+    // Requesting an already imported trace counts as a use.
+    if (priv->tracked.length > 0) {
+        for (GwNode **iter = nodes; *iter != NULL; iter++) {
+            GList *link = g_hash_table_lookup(priv->tracked_links, *iter);
+            if (link != NULL) {
+                g_queue_unlink(&priv->tracked, link);
+                g_queue_push_head_link(&priv->tracked, link);
+            }
+        }
+    }
+
+    gboolean ret = GW_DUMP_FILE_GET_CLASS(self)->import_traces(self, nodes, error);
+
+    if (priv->load_stats != NULL) {
+        gw_load_stats_end_phase(priv->load_stats, GW_LOAD_PHASE_IMPORT);
+    }
+
+    return ret;
 }
 
 /**
@@ -431,14 +525,387 @@ gboolean gw_dump_file_import_all(GwDumpFile *self, GError **error)
     }
     g_ptr_array_add(nodes, NULL);
 
-    gboolean ret =
-        GW_DUMP_FILE_GET_CLASS(self)->import_traces(self, (GwNode **)nodes->pdata, error);
+    gboolean ret = gw_dump_file_import_traces(self, (GwNode **)nodes->pdata, error);
 
     g_ptr_array_free(nodes, TRUE);
 
     return ret;
 }
 
+// Imports the nodes which don't have a history yet in a single import_traces call and builds
+// the harrays needed for time lookups.
+static gboolean import_for_lookup(GwDumpFile *self, GwNode **nodes, GError **error)
+{
+    GPtrArray *missing = g_ptr_array_new();
+
+    for (GwNode **iter = nodes; *iter != NULL; iter++) {
+        if ((*iter)->mv.mvlfac != NULL) {
+            g_ptr_array_add(missing, *iter);
+        }
+    }
+
+    gboolean ret = TRUE;
+    if (missing->len > 0) {
+        g_ptr_array_add(missing, NULL);
+        ret = gw_dump_file_import_traces(self, (GwNode **)missing->pdata, error);
+    }
+
+    g_ptr_array_free(missing, TRUE);
+
+    if (ret) {
+        for (GwNode **iter = nodes; *iter != NULL; iter++) {
+            gw_node_build_harray(*iter);
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * gw_dump_file_get_values_at:
+ * @self: A #GwDumpFile.
+ * @nodes: (array zero-terminated=1): The nodes to look up.
+ * @time: The time.
+ * @out: (array) (out caller-allocates): One entry per node in @nodes.
+ * @error: A location for a #GError, or %NULL.
+ *
+ * Stores the history entry which is in effect at @time for every node in @nodes. Nodes which
+ * haven't been imported yet are imported together in a single pass over the dump file.
+ *
+ * Returns: %TRUE on success
+ */
+gboolean gw_dump_file_get_values_at(GwDumpFile *self,
+                                    GwNode **nodes,
+                                    GwTime time,
+                                    GwHistEnt **out,
+                                    GError **error)
+{
+    g_return_val_if_fail(GW_IS_DUMP_FILE(self), FALSE);
+    g_return_val_if_fail(nodes != NULL, FALSE);
+    g_return_val_if_fail(out != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (!import_for_lookup(self, nodes, error)) {
+        return FALSE;
+    }
+
+    for (guint i = 0; nodes[i] != NULL; i++) {
+        GwHistCursor cursor;
+
+        gw_hist_cursor_init_node(&cursor, nodes[i]);
+        gw_hist_cursor_seek(&cursor, time);
+        out[i] = gw_hist_cursor_get_hist_ent(&cursor);
+    }
+
+    return TRUE;
+}
+
+typedef struct
+{
+    GwNode *node;
+    gint index;
+    guint order;
+} ChangeCursor;
+
+static inline GwTime change_cursor_time(const ChangeCursor *cursor)
+{
+    return cursor->node->harray[cursor->index]->time;
+}
+
+static inline gboolean change_cursor_less(const ChangeCursor *a, const ChangeCursor *b)
+{
+    GwTime time_a = change_cursor_time(a);
+    GwTime time_b = change_cursor_time(b);
+
+    return time_a < time_b || (time_a == time_b && a->order < b->order);
+}
+
+static void change_heap_sift_down(ChangeCursor *heap, guint len, guint pos)
+{
+    for (;;) {
+        guint smallest = pos;
+        guint left = 2 * pos + 1;
+        guint right = left + 1;
+
+        if (left < len && change_cursor_less(&heap[left], &heap[smallest])) {
+            smallest = left;
+        }
+        if (right < len && change_cursor_less(&heap[right], &heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+
+        ChangeCursor tmp = heap[pos];
+        heap[pos] = heap[smallest];
+        heap[smallest] = tmp;
+        pos = smallest;
+    }
+}
+
+/**
+ * gw_dump_file_iter_changes:
+ * @self: A #GwDumpFile.
+ * @nodes: (array zero-terminated=1): The nodes to iterate over.
+ * @start: The start time.
+ * @end: The end time (inclusive).
+ * @func: (scope call): The function to call for every history entry.
+ * @user_data: User data passed to @func.
+ * @error: A location for a #GError, or %NULL.
+ *
+ * Calls @func with the history entry which is in effect at @start for every node, followed
+ * by all transitions up to and including @end. The entries of all nodes are merged into a
+ * single stream in time order, entries with the same time are reported in the order of
+ * @nodes. Nodes which haven't been imported yet are imported together in a single pass over
+ * the dump file.
+ *
+ * Returns: %TRUE on success
+ */
+gboolean gw_dump_file_iter_changes(GwDumpFile *self,
+                                   GwNode **nodes,
+                                   GwTime start,
+                                   GwTime end,
+                                   GwDumpFileChangeFunc func,
+                                   gpointer user_data,
+                                   GError **error)
+{
+    g_return_val_if_fail(GW_IS_DUMP_FILE(self), FALSE);
+    g_return_val_if_fail(nodes != NULL, FALSE);
+    g_return_val_if_fail(func != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    if (!import_for_lookup(self, nodes, error)) {
+        return FALSE;
+    }
+
+    // The last two entries of every history mark its end.
+    end = MIN(end, GW_TIME_MAX - 2);
+
+    guint len = g_strv_length((gchar **)nodes);
+    ChangeCursor *heap = g_new(ChangeCursor, len);
+
+    for (guint i = 0; i < len; i++) {
+        GwHistCursor cursor;
+
+        gw_hist_cursor_init_node(&cursor, nodes[i]);
+
+        heap[i].node = nodes[i];
+        heap[i].index = gw_hist_cursor_seek(&cursor, start);
+        heap[i].order = i;
+    }
+
+    // The initial entries may lie before start, report them in node order first.
+    gboolean keep_going = TRUE;
+    for (guint i = 0; i < len && keep_going; i++) {
+        keep_going = func(heap[i].node, heap[i].node->harray[heap[i].index], user_data);
+    }
+
+    guint heap_len = 0;
+    for (guint i = 0; i < len; i++) {
+        ChangeCursor cursor = heap[i];
+
+        cursor.index++;
+        if (cursor.index < cursor.node->numhist && change_cursor_time(&cursor) <= end) {
+            heap[heap_len++] = cursor;
+        }
+    }
+    for (guint i = heap_len / 2; i > 0; i--) {
+        change_heap_sift_down(heap, heap_len, i - 1);
+    }
+
+    while (keep_going && heap_len > 0) {
+        ChangeCursor *top = &heap[0];
+
+        keep_going = func(top->node, top->node->harray[top->index], user_data);
+
+        top->index++;
+        if (top->index >= top->node->numhist || change_cursor_time(top) > end) {
+            heap[0] = heap[--heap_len];
+        }
+        change_heap_sift_down(heap, heap_len, 0);
+    }
+
+    g_free(heap);
+
+    return TRUE;
+}
+
+/**
+ * gw_dump_file_set_memory_budget:
+ * @self: A #GwDumpFile.
+ * @budget: The budget in bytes, or 0 for no limit.
+ *
+ * Sets the amount of memory the imported histories may use before
+ * gw_dump_file_trim_memory() starts to evict them. Only traces imported while a budget is
+ * set can be evicted, setting the budget to 0 makes all imported traces permanent.
+ */
+void gw_dump_file_set_memory_budget(GwDumpFile *self, gsize budget)
+{
+    g_return_if_fail(GW_IS_DUMP_FILE(self));
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    priv->memory_budget = budget;
+
+    if (budget == 0) {
+        g_queue_clear_full(&priv->tracked, (GDestroyNotify)tracked_trace_free);
+        g_hash_table_remove_all(priv->tracked_links);
+        priv->memory_usage = 0;
+    }
+}
+
+/**
+ * gw_dump_file_get_memory_budget:
+ * @self: A #GwDumpFile.
+ *
+ * Returns: The memory budget in bytes, or 0 if there is no limit.
+ */
+gsize gw_dump_file_get_memory_budget(GwDumpFile *self)
+{
+    g_return_val_if_fail(GW_IS_DUMP_FILE(self), 0);
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    return priv->memory_budget;
+}
+
+/**
+ * gw_dump_file_get_memory_usage:
+ * @self: A #GwDumpFile.
+ *
+ * Returns: The estimated size in bytes of the histories which can be evicted.
+ */
+gsize gw_dump_file_get_memory_usage(GwDumpFile *self)
+{
+    g_return_val_if_fail(GW_IS_DUMP_FILE(self), 0);
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    return priv->memory_usage;
+}
+
+static void remove_tracked_link(GwDumpFilePrivate *priv, GList *link)
+{
+    TrackedTrace *trace = link->data;
+
+    g_hash_table_remove(priv->tracked_links, trace->node);
+    g_queue_delete_link(&priv->tracked, link);
+    priv->memory_usage -= trace->size;
+}
+
+/**
+ * gw_dump_file_trim_memory:
+ * @self: A #GwDumpFile.
+ * @in_use: (nullable) (scope call): A function which tells which nodes are still referenced.
+ * @user_data: User data passed to @in_use.
+ *
+ * Evicts the least recently imported or requested histories until the memory usage fits
+ * into the budget. Evicted nodes return to their state before the import and are imported
+ * again by the next gw_dump_file_import_traces() call which requests them. Nodes for which
+ * @in_use returns %TRUE are kept.
+ *
+ * Returns: The number of evicted traces.
+ */
+guint gw_dump_file_trim_memory(GwDumpFile *self, GwDumpFileInUseFunc in_use, gpointer user_data)
+{
+    g_return_val_if_fail(GW_IS_DUMP_FILE(self), 0);
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+    GwDumpFileClass *klass = GW_DUMP_FILE_GET_CLASS(self);
+
+    if (priv->memory_budget == 0 || klass->evict_trace == NULL) {
+        return 0;
+    }
+
+    guint evicted = 0;
+    GList *link = priv->tracked.tail;
+
+    while (link != NULL && priv->memory_usage > priv->memory_budget) {
+        GList *prev = link->prev;
+        TrackedTrace *trace = link->data;
+
+        if (in_use == NULL || !in_use(trace->node, user_data)) {
+            remove_tracked_link(priv, link);
+
+            // The lazy data is handed back to the subclass.
+            klass->evict_trace(self, trace->node, trace->lazy);
+            g_free(trace);
+            evicted++;
+        }
+
+        link = prev;
+    }
+
+    return evicted;
+}
+
+/**
+ * gw_dump_file_track_trace:
+ * @self: A #GwDumpFile.
+ * @node: A node which has just been imported.
+ * @size: The estimated size of the history in bytes.
+ * @lazy: The data needed to import @node again.
+ * @lazy_destroy: (nullable): A function to free @lazy if @node is never evicted.
+ *
+ * Makes @node a candidate for eviction. This is meant to be called by subclasses which
+ * implement evict_trace(), @lazy is passed to evict_trace() when the trace is evicted.
+ * If no memory budget is set, @lazy is freed right away.
+ */
+void gw_dump_file_track_trace(GwDumpFile *self,
+                              GwNode *node,
+                              gsize size,
+                              gpointer lazy,
+                              GDestroyNotify lazy_destroy)
+{
+    g_return_if_fail(GW_IS_DUMP_FILE(self));
+    g_return_if_fail(node != NULL);
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    if (priv->memory_budget == 0) {
+        if (lazy_destroy != NULL) {
+            lazy_destroy(lazy);
+        }
+        return;
+    }
+
+    gw_dump_file_untrack_trace(self, node);
+
+    TrackedTrace *trace = g_new(TrackedTrace, 1);
+    trace->node = node;
+    trace->size = size;
+    trace->lazy = lazy;
+    trace->lazy_destroy = lazy_destroy;
+
+    g_queue_push_head(&priv->tracked, trace);
+    g_hash_table_insert(priv->tracked_links, node, priv->tracked.head);
+    priv->memory_usage += size;
+}
+
+/**
+ * gw_dump_file_untrack_trace:
+ * @self: A #GwDumpFile.
+ * @node: A node.
+ *
+ * Makes the history of @node permanent, for example because another node shares it.
+ */
+void gw_dump_file_untrack_trace(GwDumpFile *self, GwNode *node)
+{
+    g_return_if_fail(GW_IS_DUMP_FILE(self));
+    g_return_if_fail(node != NULL);
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    GList *link = g_hash_table_lookup(priv->tracked_links, node);
+    if (link != NULL) {
+        TrackedTrace *trace = link->data;
+
+        remove_tracked_link(priv, link);
+        tracked_trace_free(trace);
+    }
+}
+
 /**
  * gw_dump_file_get_tree:
  * @self: A #GwDumpFile.
@@ -875,3 +1342,43 @@ GPtrArray *gw_dump_file_find_symbols(GwDumpFile *self, const gchar *pattern, GEr
 
     return symbols;
 }
+
+/**
+ * gw_dump_file_set_load_stats:
+ * @self: A #GwDumpFile.
+ * @stats: (nullable): The load statistics.
+ *
+ * Sets the statistics which were collected while loading the file. Time spent importing
+ * traces is added to @stats.
+ *
+ * If the `GW_LOAD_STATS_FILE` environment variable is set, the statistics are appended to
+ * that file as a JSON line when the dump file is destroyed.
+ */
+void gw_dump_file_set_load_stats(GwDumpFile *self, GwLoadStats *stats)
+{
+    g_return_if_fail(GW_IS_DUMP_FILE(self));
+    g_return_if_fail(stats == NULL || GW_IS_LOAD_STATS(stats));
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    if (g_set_object(&priv->load_stats, stats)) {
+        g_object_notify_by_pspec(G_OBJECT(self), properties[PROP_LOAD_STATS]);
+    }
+}
+
+/**
+ * gw_dump_file_get_load_stats:
+ * @self: A #GwDumpFile.
+ *
+ * Returns the statistics which were collected while loading the file.
+ *
+ * Returns: (transfer none) (nullable): The load statistics.
+ */
+GwLoadStats *gw_dump_file_get_load_stats(GwDumpFile *self)
+{
+    g_return_val_if_fail(GW_IS_DUMP_FILE(self), NULL);
+
+    GwDumpFilePrivate *priv = gw_dump_file_get_instance_private(self);
+
+    return priv->load_stats;
+}
@@ -9,6 +9,8 @@
 #include "gw-facs.h"
 #include "gw-enum-filter-list.h"
 #include "gw-string-table.h"
+#include "gw-load-stats.h"
+#include "gw-hist-ent.h"
 
 G_BEGIN_DECLS
 
@@ -31,11 +33,56 @@ struct _GwDumpFileClass
 
     gboolean (*import_traces)(GwDumpFile *self, GwNode **nodes, GError **error);
     guint (*get_enum_filter_for_node)(GwDumpFile *self, GwNode *node);
+    void (*evict_trace)(GwDumpFile *self, GwNode *node, gpointer lazy);
 };
 
 gboolean gw_dump_file_import_traces(GwDumpFile *self, GwNode **nodes, GError **error);
 gboolean gw_dump_file_import_all(GwDumpFile *self, GError **error);
 
+/**
+ * GwDumpFileChangeFunc:
+ * @node: The node the history entry belongs to.
+ * @hist_ent: The history entry.
+ * @user_data: The user data passed to gw_dump_file_iter_changes().
+ *
+ * Returns: %TRUE to continue the iteration, %FALSE to stop it.
+ */
+typedef gboolean (*GwDumpFileChangeFunc)(GwNode *node, GwHistEnt *hist_ent, gpointer user_data);
+
+gboolean gw_dump_file_get_values_at(GwDumpFile *self,
+                                    GwNode **nodes,
+                                    GwTime time,
+                                    GwHistEnt **out,
+                                    GError **error);
+gboolean gw_dump_file_iter_changes(GwDumpFile *self,
+                                   GwNode **nodes,
+                                   GwTime start,
+                                   GwTime end,
+                                   GwDumpFileChangeFunc func,
+                                   gpointer user_data,
+                                   GError **error);
+
+/**
+ * GwDumpFileInUseFunc:
+ * @node: An imported node.
+ * @user_data: The user data passed to gw_dump_file_trim_memory().
+ *
+ * Returns: %TRUE if the history of @node is still referenced and must not be evicted.
+ */
+typedef gboolean (*GwDumpFileInUseFunc)(GwNode *node, gpointer user_data);
+
+void gw_dump_file_set_memory_budget(GwDumpFile *self, gsize budget);
+gsize gw_dump_file_get_memory_budget(GwDumpFile *self);
+gsize gw_dump_file_get_memory_usage(GwDumpFile *self);
+guint gw_dump_file_trim_memory(GwDumpFile *self, GwDumpFileInUseFunc in_use, gpointer user_data);
+
+void gw_dump_file_track_trace(GwDumpFile *self,
+                              GwNode *node,
+                              gsize size,
+                              gpointer lazy,
+                              GDestroyNotify lazy_destroy);
+void gw_dump_file_untrack_trace(GwDumpFile *self, GwNode *node);
+
 GwTree *gw_dump_file_get_tree(GwDumpFile *self);
 GwFacs *gw_dump_file_get_facs(GwDumpFile *self);
 GwBlackoutRegions *gw_dump_file_get_blackout_regions(GwDumpFile *self);
@@ -55,6 +102,9 @@ gboolean gw_dump_file_has_supplemental_vartypes(GwDumpFile *self);
 gboolean gw_dump_file_has_escaped_names(GwDumpFile *self);
 gboolean gw_dump_file_get_uses_vhdl_component_format(GwDumpFile *self);
 
+void gw_dump_file_set_load_stats(GwDumpFile *self, GwLoadStats *stats);
+GwLoadStats *gw_dump_file_get_load_stats(GwDumpFile *self);
+
 GwSymbol *gw_dump_file_lookup_symbol(GwDumpFile *self, const gchar *name);
 GPtrArray *gw_dump_file_find_symbols(GwDumpFile *self, const gchar *pattern, GError **error);
 
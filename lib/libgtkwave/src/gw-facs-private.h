@@ -0,0 +1,7 @@
+#pragma once
+
+#include "gw-facs.h"
+
+// Always takes the threaded path of gw_facs_sort(), regardless of the array size and the number
+// of processors. Only meant for tests.
+void gw_facs_sort_parallel(GwFacs *self, guint num_runs);
@@ -1,11 +1,14 @@
 #include "gw-facs.h"
+#include "gw-facs-private.h"
 #include "gw-util.h"
+#include <string.h>
 
 struct _GwFacs
 {
     GObject parent_instance;
 
     GPtrArray *facs;
+    GStringChunk *names;
 };
 
 G_DEFINE_TYPE(GwFacs, gw_facs, G_TYPE_OBJECT)
@@ -25,6 +28,7 @@ static void gw_facs_finalize(GObject *object)
     if (self->facs != NULL) {
         g_ptr_array_free(self->facs, TRUE);
     }
+    g_clear_pointer(&self->names, g_string_chunk_free);
 
     G_OBJECT_CLASS(gw_facs_parent_class)->finalize(object);
 }
@@ -128,6 +132,25 @@ guint gw_facs_get_length(GwFacs *self)
     return self->facs->len;
 }
 
+/**
+ * gw_facs_take_names:
+ * @self: A #GwFacs.
+ * @names: (transfer full): The storage the symbol names were allocated from.
+ *
+ * Loaders store the flattened names of all symbols back to back in a single #GStringChunk
+ * instead of allocating each of them separately. This hands the chunk over to @self, which frees
+ * it when it is finalized. The names of the symbols' nodes point into the chunk as well, so @self
+ * has to outlive the symbols and nodes, which the #GwDumpFile holding @self ensures. Reordering
+ * @self with gw_facs_sort() or gw_facs_order_from_tree() keeps the chunk.
+ */
+void gw_facs_take_names(GwFacs *self, GStringChunk *names)
+{
+    g_return_if_fail(GW_IS_FACS(self));
+    g_return_if_fail(self->names == NULL);
+
+    self->names = names;
+}
+
 // TODO: remove
 GwSymbol **gw_facs_get_array(GwFacs *self)
 {
@@ -179,14 +202,142 @@ static int sigcmp(const void *v1, const void *v2)
     return gw_signal_name_compare(a1->name, a2->name);
 }
 
+static gint sigcmp_data(gconstpointer v1, gconstpointer v2, gpointer user_data)
+{
+    (void)user_data;
+
+    return sigcmp(v1, v2);
+}
+
+// Below this size the thread startup costs more than it saves.
+#define PARALLEL_SORT_MIN_LENGTH (64 * 1024)
+#define PARALLEL_SORT_MAX_RUNS 16
+
+typedef struct
+{
+    gpointer *src;
+    gpointer *dst;
+    guint start;
+    guint mid;
+    guint end;
+} SortRun;
+
+static gpointer sort_run(gpointer data)
+{
+    SortRun *run = data;
+
+    // g_qsort_with_data is a stable merge sort, like the one used by g_ptr_array_sort
+    g_qsort_with_data(run->src + run->start,
+                      run->end - run->start,
+                      sizeof(gpointer),
+                      sigcmp_data,
+                      NULL);
+
+    return NULL;
+}
+
+static gpointer merge_runs(gpointer data)
+{
+    SortRun *run = data;
+    guint i = run->start;
+    guint j = run->mid;
+    guint k = run->start;
+
+    // take from the left run on ties to keep the merge stable
+    while (i < run->mid && j < run->end) {
+        if (sigcmp(&run->src[j], &run->src[i]) < 0) {
+            run->dst[k++] = run->src[j++];
+        } else {
+            run->dst[k++] = run->src[i++];
+        }
+    }
+    while (i < run->mid) {
+        run->dst[k++] = run->src[i++];
+    }
+    while (j < run->end) {
+        run->dst[k++] = run->src[j++];
+    }
+
+    return NULL;
+}
+
+static void run_parallel(GThreadFunc func, SortRun *runs, guint count)
+{
+    GThread *threads[PARALLEL_SORT_MAX_RUNS];
+
+    for (guint i = 1; i < count; i++) {
+        threads[i] = g_thread_new("gw-facs-sort", func, &runs[i]);
+    }
+    func(&runs[0]);
+    for (guint i = 1; i < count; i++) {
+        g_thread_join(threads[i]);
+    }
+}
+
+// Sorts runs of the array on separate threads and merges them pairwise. Since both steps are
+// stable the result is identical to a single g_ptr_array_sort.
+static void parallel_sort(GPtrArray *array, guint num_runs)
+{
+    guint len = array->len;
+    gpointer *buffers[2] = {array->pdata, g_new(gpointer, len)};
+    gint current = 0;
+    SortRun runs[PARALLEL_SORT_MAX_RUNS];
+    guint bounds[PARALLEL_SORT_MAX_RUNS + 1];
+
+    for (guint i = 0; i <= num_runs; i++) {
+        bounds[i] = (guint)((guint64)len * i / num_runs);
+    }
+
+    for (guint i = 0; i < num_runs; i++) {
+        runs[i] = (SortRun){.src = buffers[0], .start = bounds[i], .end = bounds[i + 1]};
+    }
+    run_parallel(sort_run, runs, num_runs);
+
+    for (guint width = 1; width < num_runs; width *= 2) {
+        guint count = 0;
+
+        for (guint i = 0; i < num_runs; i += 2 * width) {
+            guint mid = MIN(i + width, num_runs);
+            guint end = MIN(i + 2 * width, num_runs);
+
+            runs[count++] = (SortRun){
+                .src = buffers[current],
+                .dst = buffers[!current],
+                .start = bounds[i],
+                .mid = bounds[mid],
+                .end = bounds[end],
+            };
+        }
+
+        run_parallel(merge_runs, runs, count);
+        current = !current;
+    }
+
+    if (current != 0) {
+        memcpy(buffers[0], buffers[1], len * sizeof(gpointer));
+    }
+    g_free(buffers[1]);
+}
+
 void gw_facs_sort(GwFacs *self)
 {
     g_return_if_fail(GW_IS_FACS(self));
 
-    // TODO: Check which sorting algorithm is used by Glib. The original code
-    // used a custom heapsort for some platforms, because quicksort can be very
-    // slow if the facs are already sorted.
-    g_ptr_array_sort(self->facs, sigcmp);
+    guint num_runs = MIN(g_get_num_processors(), PARALLEL_SORT_MAX_RUNS);
+
+    if (self->facs->len < PARALLEL_SORT_MIN_LENGTH || num_runs < 2) {
+        g_ptr_array_sort(self->facs, sigcmp);
+    } else {
+        parallel_sort(self->facs, num_runs);
+    }
+}
+
+void gw_facs_sort_parallel(GwFacs *self, guint num_runs)
+{
+    g_return_if_fail(GW_IS_FACS(self));
+    g_return_if_fail(num_runs >= 2 && num_runs <= PARALLEL_SORT_MAX_RUNS);
+
+    parallel_sort(self->facs, num_runs);
 }
 
 static int compar_facs(const void *key, const void *v2)
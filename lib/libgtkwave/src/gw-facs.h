@@ -16,6 +16,7 @@ GwSymbol *gw_facs_get(GwFacs *self, guint index);
 const GwSymbol *gw_facs_get_const(GwFacs *self, guint index);
 
 guint gw_facs_get_length(GwFacs *self);
+void gw_facs_take_names(GwFacs *self, GStringChunk *names);
 GwSymbol **gw_facs_get_array(GwFacs *self);
 
 void gw_facs_order_from_tree(GwFacs *self, GwTree *tree);
@@ -31,6 +31,14 @@ struct _GwFstFile
 
     GwLx2Entry *fst_table;
 
+    // Handles selected for the next import, one bit per handle - 1. Imports only visit the
+    // words between import_mask_lo and import_mask_hi instead of asking the reader about
+    // every handle.
+    guint64 *import_mask;
+    guint import_mask_lo;
+    guint import_mask_hi;
+    guint import_count;
+
     GwFac *mvlfacs;
     fstHandle *mvlfacs_rvs_alias;
 
@@ -44,6 +52,8 @@ struct _GwFstFile
 
     GwHistEntFactory *hist_ent_factory;
 
+    guint64 transition_count;
+
     gboolean preserve_glitches;
     gboolean preserve_glitches_real;
 };
@@ -9,6 +9,7 @@ G_DEFINE_TYPE(GwFstFile, gw_fst_file, GW_TYPE_DUMP_FILE)
 static void gw_fst_file_import_trace(GwFstFile *self, GwNode *np);
 static void gw_fst_file_set_fac_process_mask(GwFstFile *self, GwNode *np);
 static void gw_fst_file_import_masked(GwFstFile *self);
+static void gw_fst_file_evict_trace(GwDumpFile *dump_file, GwNode *np, gpointer lazy);
 
 static void gw_fst_file_dispose(GObject *object)
 {
@@ -24,6 +25,7 @@ static void gw_fst_file_finalize(GObject *object)
     GwFstFile *self = GW_FST_FILE(object);
 
     g_clear_pointer(&self->fst_reader, fstReaderClose);
+    g_clear_pointer(&self->import_mask, g_free);
     g_clear_pointer(&self->subvar_jrb, jrb_free_tree);
     g_clear_pointer(&self->synclock_jrb, jrb_free_tree);
     g_clear_pointer(&self->enum_nptrs_jrb, jrb_free_tree);
@@ -41,8 +43,24 @@ static gboolean gw_fst_file_import_traces(GwDumpFile *dump_file, GwNode **nodes,
 
         gw_fst_file_set_fac_process_mask(self, node);
     }
+
+    guint64 transition_count = self->transition_count;
     gw_fst_file_import_masked(self);
 
+    // Aliases whose target was imported in the same pass still point to their fac.
+    for (GwNode **iter = nodes; *iter != NULL; iter++) {
+        GwNode *node = *iter;
+
+        if (node->mv.mvlfac != NULL && (node->mv.mvlfac->flags & GW_FAC_FLAG_ALIAS)) {
+            gw_fst_file_import_trace(self, node);
+        }
+    }
+
+    GwLoadStats *stats = gw_dump_file_get_load_stats(dump_file);
+    if (stats != NULL) {
+        gw_load_stats_add_transitions(stats, self->transition_count - transition_count);
+    }
+
     return TRUE;
 }
 
@@ -69,6 +87,7 @@ static void gw_fst_file_class_init(GwFstFileClass *klass)
 
     dump_file_class->import_traces = gw_fst_file_import_traces;
     dump_file_class->get_enum_filter_for_node = gw_fst_file_get_enum_filter_for_node;
+    dump_file_class->evict_trace = gw_fst_file_evict_trace;
 }
 
 static void gw_fst_file_init(GwFstFile *self)
@@ -119,6 +138,8 @@ static void fst_callback2(void *user_callback_data_pointer,
     GwLx2Entry *l2e = &self->fst_table[facidx];
     GwFac *f = &self->mvlfacs[facidx];
 
+    self->transition_count++;
+
     // TODO: report progress
     // self->busycnt++;
     // if (self->busycnt == WAVE_BUSY_ITER) {
@@ -271,11 +292,79 @@ static void fst_callback(void *user_callback_data_pointer,
     fst_callback2(user_callback_data_pointer, tim, txidx, value, 0);
 }
 
+/*
+ * vector and string values are allocated separately, doubles are stored in the entry itself
+ */
+static inline gboolean fst_hist_ent_has_vector(GwHistEnt *h, GwFac *f)
+{
+    if (h->flags & GW_HIST_ENT_FLAG_STRING) {
+        return TRUE;
+    }
+
+    return f->len > 1 && !(h->flags & GW_HIST_ENT_FLAG_REAL);
+}
+
+/*
+ * makes a freshly imported trace a candidate for eviction, see gw_dump_file_trim_memory()
+ */
+static void fst_track_trace(GwFstFile *self, GwNode *np, GwFac *f)
+{
+    if (gw_dump_file_get_memory_budget(GW_DUMP_FILE(self)) == 0) {
+        return;
+    }
+
+    gsize size = sizeof(GwHistEnt) * np->numhist;
+    for (GwHistEnt *h = np->head.next; h != NULL; h = h->next) {
+        if (fst_hist_ent_has_vector(h, f) && h->v.h_vector != NULL) {
+            size += (h->flags & GW_HIST_ENT_FLAG_STRING) ? strlen(h->v.h_vector) + 1 : f->len;
+        }
+    }
+    size += sizeof(GwHistEnt *) * np->numhist; /* harray */
+
+    gw_dump_file_track_trace(GW_DUMP_FILE(self), np, size, f, NULL);
+}
+
+static void gw_fst_file_evict_trace(GwDumpFile *dump_file, GwNode *np, gpointer lazy)
+{
+    GwFstFile *self = GW_FST_FILE(dump_file);
+    GwFac *f = lazy;
+
+    // the frontcap at -1 shares its vector with the entry at GW_TIME_MAX - 1
+    GwHistEnt *frontcap = np->head.next;
+
+    GwHistEnt *h = np->head.next;
+    while (h != NULL) {
+        GwHistEnt *next = h->next;
+
+        if (h != frontcap && fst_hist_ent_has_vector(h, f)) {
+            g_free(h->v.h_vector);
+        }
+        gw_hist_ent_factory_free(self->hist_ent_factory, h);
+
+        h = next;
+    }
+
+    if (f->len > 1 && !(f->flags & (GW_FAC_FLAG_DOUBLE | GW_FAC_FLAG_STRING))) {
+        g_free(np->head.v.h_vector);
+    }
+
+    memset(&np->head, 0, sizeof(GwHistEnt));
+    np->head.time = -1;
+    np->head.v.h_val = GW_BIT_X;
+    np->curr = NULL;
+    g_clear_pointer(&np->harray, g_free);
+    np->numhist = 0;
+    np->mv.mvlfac = f;
+}
+
 /*
  * this is the black magic that handles aliased signals...
  */
-static void fst_resolver(GwNode *np, GwNode *resolve)
+static void fst_resolver(GwFstFile *self, GwNode *np, GwNode *resolve)
 {
+    // the alias shares the history, which therefore can't be evicted anymore
+    gw_dump_file_untrack_trace(GW_DUMP_FILE(self), resolve);
+
     np->extvals = resolve->extvals;
     np->msi = resolve->msi;
     np->lsi = resolve->lsi;
@@ -310,7 +399,7 @@ static void gw_fst_file_import_trace(GwFstFile *self, GwNode *np)
         np = self->mvlfacs[txidx].working_node;
 
         if (!(f = np->mv.mvlfac)) {
-            fst_resolver(nold, np);
+            fst_resolver(self, nold, np);
             return; /* already imported */
         }
     }
@@ -407,8 +496,10 @@ static void gw_fst_file_import_trace(GwFstFile *self, GwNode *np)
     np->curr = histent_tail;
     np->mv.mvlfac = NULL; /* it's imported and cached so we can forget it's an mvlfac now */
 
+    fst_track_trace(self, np, f);
+
     if (nold != np) {
-        fst_resolver(nold, np);
+        fst_resolver(self, nold, np);
     }
 }
 
@@ -498,7 +589,7 @@ static void gw_fst_file_set_fac_process_mask(GwFstFile *self, GwNode *np)
         np = self->mvlfacs[txidx].working_node;
 
         if (!(np->mv.mvlfac)) {
-            fst_resolver(nold, np);
+            fst_resolver(self, nold, np);
             return; /* already imported */
         }
     }
@@ -514,24 +605,48 @@ static void gw_fst_file_set_fac_process_mask(GwFstFile *self, GwNode *np)
 
     /* check here for array height in future */
     {
-        fstReaderSetFacProcessMask(self->fst_reader, self->mvlfacs[txidx].node_alias + 1);
+        guint bit = self->mvlfacs[txidx].node_alias;
+        guint word = bit / 64;
+
+        if (self->import_mask == NULL) {
+            self->import_mask = g_new0(guint64, self->fst_maxhandle / 64 + 1);
+            self->import_mask_lo = G_MAXUINT;
+            self->import_mask_hi = 0;
+        }
+
+        if (!(self->import_mask[word] & (G_GUINT64_CONSTANT(1) << (bit % 64)))) {
+            self->import_mask[word] |= G_GUINT64_CONSTANT(1) << (bit % 64);
+            self->import_mask_lo = MIN(self->import_mask_lo, word);
+            self->import_mask_hi = MAX(self->import_mask_hi, word);
+            self->import_count++;
+        }
+
+        fstReaderSetFacProcessMask(self->fst_reader, bit + 1);
         self->fst_table[txidx].np = np;
     }
 }
 
+static inline guint lowest_set_bit(guint64 word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    guint bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
 static void gw_fst_file_import_masked(GwFstFile *self)
 {
     unsigned int txidxi;
     int i, cnt;
     GwHistEnt *htempx = NULL;
 
-    cnt = 0;
-    for (txidxi = 0; txidxi < self->fst_maxhandle; txidxi++) {
-        if (fstReaderGetFacProcessMask(self->fst_reader, txidxi + 1)) {
-            cnt++;
-        }
-    }
-
+    cnt = self->import_count;
     if (!cnt) {
         return;
     }
@@ -548,8 +663,14 @@ static void gw_fst_file_import_masked(GwFstFile *self)
     // TODO: report progress
     // set_window_idle(NULL);
 
-    for (txidxi = 0; txidxi < self->fst_maxhandle; txidxi++) {
-        if (fstReaderGetFacProcessMask(self->fst_reader, txidxi + 1)) {
+    for (guint word = self->import_mask_lo; word <= self->import_mask_hi; word++) {
+        guint64 bits = self->import_mask[word];
+        self->import_mask[word] = 0;
+
+        while (bits != 0) {
+            txidxi = word * 64 + lowest_set_bit(bits);
+            bits &= bits - 1;
+
             int txidx = self->mvlfacs_rvs_alias[txidxi];
             GwHistEnt *htemp, *histent_tail;
             GwFac *f = &self->mvlfacs[txidx];
@@ -638,9 +759,14 @@ static void gw_fst_file_import_masked(GwFstFile *self)
 
             np->curr = histent_tail;
             np->mv.mvlfac = NULL; /* it's imported and cached so we can forget it's an mvlfac now */
+            fst_track_trace(self, np, f);
             fstReaderClrFacProcessMask(self->fst_reader, txidxi + 1);
         }
     }
+
+    self->import_mask_lo = G_MAXUINT;
+    self->import_mask_hi = 0;
+    self->import_count = 0;
 }
 
 gchar *gw_fst_file_get_subvar(GwFstFile *self, gint index)
@@ -3,6 +3,7 @@
 #include "gw-fst-file-private.h"
 #include "gw-util.h"
 #include <fstapi.h>
+#include <glib/gstdio.h>
 
 static GwTreeKind fst_scope_type_to_gw_tree_kind(enum fstScopeType scope_type);
 static GwVarType fst_var_to_gw_var_type(struct fstHierVar *var_type);
@@ -669,6 +670,14 @@ static GwDumpFile *gw_fst_loader_load(GwLoader *loader, const char *fname, GErro
     int f_name_build_buf_len = 128;
     char *f_name_build_buf = g_malloc(f_name_build_buf_len + 1);
 
+    GwLoadStats *stats = gw_loader_get_stats(loader);
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_HEADER);
+
+    GStatBuf st;
+    if (g_stat(fname, &st) == 0) {
+        gw_load_stats_add_bytes(stats, st.st_size);
+    }
+
     self->fst_reader = fstReaderOpen(fname);
     if (self->fst_reader == NULL) {
         // TODO: report more detailed errors
@@ -676,6 +685,7 @@ static GwDumpFile *gw_fst_loader_load(GwLoader *loader, const char *fname, GErro
                     GW_DUMP_FILE_ERROR,
                     GW_DUMP_FILE_ERROR_UNKNOWN,
                     "Failed to open FST file");
+        gw_load_stats_end_phase(stats, GW_LOAD_PHASE_HEADER);
         return NULL;
     }
 
@@ -704,11 +714,15 @@ static GwDumpFile *gw_fst_loader_load(GwLoader *loader, const char *fname, GErro
     guint64 numfacs = fstReaderGetVarCount(self->fst_reader);
 
     GwFacs *facs = gw_facs_new(numfacs);
+    GStringChunk *names = g_string_chunk_new(64 * 1024);
     GwSymbol *sym_block = g_new0(GwSymbol, numfacs);
     GwNode *node_block = g_new0(GwNode, numfacs);
     self->mvlfacs = g_new0(GwFac, numfacs);
     self->mvlfacs_rvs_alias = g_new0(fstHandle, numfacs);
 
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_HEADER);
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_SYMBOLS);
+
     fprintf(stderr, FST_RDLOAD "Processing %lu facs.\n", numfacs);
     // TODO: update splash
     // /* SPLASH */ splash_sync(1, 5);
@@ -869,6 +883,11 @@ static GwDumpFile *gw_fst_loader_load(GwLoader *loader, const char *fname, GErro
             }
         }
 
+        // Keep the names back to back instead of in one allocation each.
+        gchar *name = s->name;
+        s->name = g_string_chunk_insert(names, name);
+        g_free(name);
+
         // Get the node name by stripping off the prefix.
         const gchar *node_name;
         if (name_prefix_len > 0) {
@@ -918,6 +937,8 @@ static GwDumpFile *gw_fst_loader_load(GwLoader *loader, const char *fname, GErro
         s->n = n;
     }
 
+    gw_facs_take_names(facs, names);
+
     if (nnam) {
         g_free(nnam);
         nnam = NULL;
@@ -947,6 +968,8 @@ static GwDumpFile *gw_fst_loader_load(GwLoader *loader, const char *fname, GErro
 
     gw_string_table_freeze(self->component_names);
 
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_SYMBOLS);
+
     fprintf(stderr,
             FST_RDLOAD "Built %d signal%s and %d alias%s.\n",
             numvars,
@@ -963,14 +986,18 @@ static GwDumpFile *gw_fst_loader_load(GwLoader *loader, const char *fname, GErro
 
     fprintf(stderr, FST_RDLOAD "Sorting facility hierarchy tree.\n");
 
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_TREE);
     GwTreeNode *root = gw_tree_builder_build(self->tree_builder);
     GwTree *tree = gw_tree_new(root);
     gw_tree_graft(tree, self->terminals_chain);
     gw_tree_sort(tree);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_TREE);
 
     // TODO: update splash
     // /* SPLASH */ splash_sync(4, 5);
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_FACS_SORT);
     gw_facs_order_from_tree(facs, tree);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_FACS_SORT);
 
     // TODO: update splash
     // /* SPLASH */ splash_sync(5, 5);
@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <libghw.h>
 #include <gtkwave.h>
 #include "gw-ghw-loader.h"
@@ -26,6 +27,7 @@ struct _GwGhwLoader
     char *fac_name;
     int fac_name_len;
     int fac_name_max;
+    GStringChunk *fac_names;
     gboolean warned;
 
     GSList *sym_chain;
@@ -33,6 +35,7 @@ struct _GwGhwLoader
     GwFacs *facs;
     GwTreeNode *treeroot;
     GwTime max_time;
+    guint64 transition_count;
 
     GwHistEntFactory *hist_ent_factory;
 };
@@ -843,7 +846,7 @@ static void set_fac_name_1(GwGhwLoader *self, GwTreeNode *t)
         if (t->t_which >= 0) {
             GwSymbol *s = self->sym_chain->data;
 
-            s->name = g_strdup(self->fac_name);
+            s->name = g_string_chunk_insert(self->fac_names, self->fac_name);
             size_t nxp_idx = (size_t)t->t_which;
             if (nxp_idx > self->h->nbr_sigs)
                 ghw_error_exit();
@@ -875,7 +878,10 @@ static void set_fac_name(GwGhwLoader *self)
 
     self->fac_name_len = 3;
     memcpy(self->fac_name, "top", 4);
+
+    self->fac_names = g_string_chunk_new(64 * 1024);
     set_fac_name_1(self, self->treeroot);
+    gw_facs_take_names(self->facs, g_steal_pointer(&self->fac_names));
 }
 
 static void add_history(GwGhwLoader *self, GwNode *n, int sig_num)
@@ -891,6 +897,8 @@ static void add_history(GwGhwLoader *self, GwNode *n, int sig_num)
         return;
     }
 
+    self->transition_count++;
+
     switch (sig_type->kind) {
         case ghdl_rtik_type_i32:
         case ghdl_rtik_type_i64:
@@ -1166,6 +1174,14 @@ GwDumpFile *gw_ghw_loader_load(GwLoader *loader, const gchar *fname, GError **er
     //     GLOBALS->hier_delimeter = '.';
     // }
 
+    GwLoadStats *stats = gw_loader_get_stats(loader);
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_HEADER);
+
+    GStatBuf st;
+    if (g_stat(fname, &st) == 0) {
+        gw_load_stats_add_bytes(stats, st.st_size);
+    }
+
     handle.flag_verbose = 0;
     if ((rc = ghw_open(&handle, fname)) < 0) {
         g_set_error(error,
@@ -1194,13 +1210,23 @@ GwDumpFile *gw_ghw_loader_load(GwLoader *loader, const gchar *fname, GError **er
         self->nxp[ui] = g_new0(GwNode, 1);
     }
 
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_HEADER);
+
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_TREE);
     self->treeroot = build_hierarchy(self, handle.hie);
     /* GHW does not contains a 'top' name.
        FIXME: should use basename of the file.  */
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_TREE);
 
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_SYMBOLS);
     create_facs(self);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_SYMBOLS);
+
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_VALUE_CHANGES);
     read_traces(self);
     add_tail(self);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_VALUE_CHANGES);
+    gw_load_stats_add_transitions(stats, self->transition_count);
 
     set_fac_name(self);
 
@@ -1234,9 +1260,11 @@ GwDumpFile *gw_ghw_loader_load(GwLoader *loader, const gchar *fname, GError **er
 
     ghw_close(&handle);
 
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_FACS_SORT);
     rechain_facs(self); /* vectorize bitblasted nets */
     ghw_sortfacs(self); /* sort nets as ghw is unsorted ... also fix hier tree (it should really be
                        built *after* facs are sorted!) */
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_FACS_SORT);
 
 #if 0
  treedebug(GLOBALS->treeroot,"");
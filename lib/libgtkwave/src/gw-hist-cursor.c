@@ -0,0 +1,158 @@
+#include "gw-hist-cursor.h"
+#include "gw-node.h"
+#include "gw-bit-vector.h"
+
+void gw_hist_cursor_init_node(GwHistCursor *self, GwNode *node)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(node != NULL);
+    g_return_if_fail(node->harray != NULL);
+
+    self->node = node;
+    self->vector = NULL;
+    self->count = node->numhist;
+    self->index = 1;
+}
+
+void gw_hist_cursor_init_vector(GwHistCursor *self, GwBitVector *vector)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(vector != NULL);
+
+    self->node = NULL;
+    self->vector = vector;
+    self->count = vector->numregions;
+    self->index = 1;
+}
+
+GwTime gw_hist_cursor_get_time(const GwHistCursor *self, gint index)
+{
+    if (self->vector != NULL) {
+        return self->vector->vectors[index]->time;
+    } else {
+        return self->node->harray[index]->time;
+    }
+}
+
+// Finds the last index in [lo, hi] with a time <= time, or lo - 1 if there is none.
+static gint search_range(const GwHistCursor *self, gint lo, gint hi, GwTime time)
+{
+    gint pos = lo - 1;
+
+    while (lo <= hi) {
+        gint mid = lo + (hi - lo) / 2;
+
+        if (gw_hist_cursor_get_time(self, mid) <= time) {
+            pos = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return pos;
+}
+
+// Applies the same rules as the original bsearch based lookup: times before the
+// start of the history map to index 1 and entries sharing the same timestamp
+// (non-RoSync dumper glitches) resolve to the last one.
+static gint finish_seek(GwHistCursor *self, gint pos)
+{
+    if (pos < 0 || gw_hist_cursor_get_time(self, pos) < GW_TIME_CONSTANT(0)) {
+        pos = 1;
+    }
+
+    while (pos + 1 < self->count &&
+           gw_hist_cursor_get_time(self, pos) == gw_hist_cursor_get_time(self, pos + 1)) {
+        pos++;
+    }
+
+    self->index = pos;
+
+    return pos;
+}
+
+/**
+ * gw_hist_cursor_seek:
+ * @self: A #GwHistCursor.
+ * @time: The time to look up.
+ *
+ * Positions the cursor on the entry which is in effect at @time using a
+ * binary search over the whole history.
+ *
+ * Returns: The index of the entry.
+ */
+gint gw_hist_cursor_seek(GwHistCursor *self, GwTime time)
+{
+    g_return_val_if_fail(self != NULL, -1);
+
+    return finish_seek(self, search_range(self, 0, self->count - 1, time));
+}
+
+/**
+ * gw_hist_cursor_seek_near:
+ * @self: A #GwHistCursor.
+ * @time: The time to look up.
+ *
+ * Like gw_hist_cursor_seek(), but starts from the position of the previous
+ * lookup and gallops outwards. Monotone scans over a history therefore cost
+ * O(log d) per call, where d is the distance to the previous position.
+ *
+ * Returns: The index of the entry.
+ */
+gint gw_hist_cursor_seek_near(GwHistCursor *self, GwTime time)
+{
+    g_return_val_if_fail(self != NULL, -1);
+
+    gint index = CLAMP(self->index, 0, self->count - 1);
+    gint step = 1;
+
+    if (gw_hist_cursor_get_time(self, index) <= time) {
+        gint lo = index;
+        gint hi = index + step;
+
+        while (hi < self->count && gw_hist_cursor_get_time(self, hi) <= time) {
+            lo = hi;
+            step *= 2;
+            hi = lo + step;
+        }
+        hi = MIN(hi, self->count - 1);
+
+        return finish_seek(self, search_range(self, lo, hi, time));
+    } else {
+        gint hi = index;
+        gint lo = index - step;
+
+        while (lo >= 0 && gw_hist_cursor_get_time(self, lo) > time) {
+            hi = lo;
+            step *= 2;
+            lo = hi - step;
+        }
+        lo = MAX(lo, 0);
+
+        return finish_seek(self, search_range(self, lo, hi, time));
+    }
+}
+
+gint gw_hist_cursor_get_index(const GwHistCursor *self)
+{
+    g_return_val_if_fail(self != NULL, -1);
+
+    return self->index;
+}
+
+GwHistEnt *gw_hist_cursor_get_hist_ent(const GwHistCursor *self)
+{
+    g_return_val_if_fail(self != NULL, NULL);
+    g_return_val_if_fail(self->node != NULL, NULL);
+
+    return self->node->harray[self->index];
+}
+
+GwVectorEnt *gw_hist_cursor_get_vector_ent(const GwHistCursor *self)
+{
+    g_return_val_if_fail(self != NULL, NULL);
+    g_return_val_if_fail(self->vector != NULL, NULL);
+
+    return self->vector->vectors[self->index];
+}
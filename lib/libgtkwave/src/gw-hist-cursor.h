@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glib.h>
+#include "gw-types.h"
+#include "gw-time.h"
+#include "gw-hist-ent.h"
+#include "gw-vector-ent.h"
+
+G_BEGIN_DECLS
+
+// Reentrant time lookup into the harray of a GwNode or the vectors of a GwBitVector.
+// All state lives in the cursor itself, so independent cursors can be used from
+// different threads on the same (read only) history.
+typedef struct
+{
+    GwNode *node;
+    GwBitVector *vector;
+    gint count;
+    gint index; /* position of the entry returned by the last seek */
+} GwHistCursor;
+
+void gw_hist_cursor_init_node(GwHistCursor *self, GwNode *node);
+void gw_hist_cursor_init_vector(GwHistCursor *self, GwBitVector *vector);
+
+gint gw_hist_cursor_seek(GwHistCursor *self, GwTime time);
+gint gw_hist_cursor_seek_near(GwHistCursor *self, GwTime time);
+
+gint gw_hist_cursor_get_index(const GwHistCursor *self);
+GwTime gw_hist_cursor_get_time(const GwHistCursor *self, gint index);
+GwHistEnt *gw_hist_cursor_get_hist_ent(const GwHistCursor *self);
+GwVectorEnt *gw_hist_cursor_get_vector_ent(const GwHistCursor *self);
+
+G_END_DECLS
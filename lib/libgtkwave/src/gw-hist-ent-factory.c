@@ -1,4 +1,5 @@
 #include "gw-hist-ent-factory.h"
+#include <string.h>
 
 #define BLOCK_SIZE (64 * 1024)
 #define HIST_ENTS_PER_BLOCK (BLOCK_SIZE / sizeof(GwHistEnt))
@@ -10,6 +11,9 @@ struct _GwHistEntFactory
     GPtrArray *blocks;
     GwHistEnt *current_block;
     gint next_index;
+
+    // entries returned by gw_hist_ent_factory_free(), linked through their next field
+    GwHistEnt *free_list;
 };
 
 G_DEFINE_TYPE(GwHistEntFactory, gw_hist_ent_factory, G_TYPE_OBJECT)
@@ -44,6 +48,14 @@ GwHistEnt *gw_hist_ent_factory_alloc(GwHistEntFactory *self)
 {
     g_return_val_if_fail(GW_IS_HIST_ENT_FACTORY(self), NULL);
 
+    if (self->free_list != NULL) {
+        GwHistEnt *h = self->free_list;
+        self->free_list = h->next;
+        memset(h, 0, sizeof(GwHistEnt));
+
+        return h;
+    }
+
     if (self->next_index == HIST_ENTS_PER_BLOCK || self->blocks->len == 0) {
         self->current_block = g_malloc0(BLOCK_SIZE);
 
@@ -56,4 +68,58 @@ GwHistEnt *gw_hist_ent_factory_alloc(GwHistEntFactory *self)
     self->next_index++;
 
     return h;
-}
\ No newline at end of file
+}
+
+/**
+ * gw_hist_ent_factory_free:
+ * @self: A #GwHistEntFactory.
+ * @hist_ent: A #GwHistEnt allocated by @self or a factory merged into it.
+ *
+ * Returns @hist_ent to @self, which hands it out again on the next call to
+ * gw_hist_ent_factory_alloc(). The memory is only released when @self is
+ * destroyed.
+ */
+void gw_hist_ent_factory_free(GwHistEntFactory *self, GwHistEnt *hist_ent)
+{
+    g_return_if_fail(GW_IS_HIST_ENT_FACTORY(self));
+    g_return_if_fail(hist_ent != NULL);
+
+    hist_ent->next = self->free_list;
+    self->free_list = hist_ent;
+}
+
+/**
+ * gw_hist_ent_factory_merge:
+ * @self: A #GwHistEntFactory.
+ * @other: The #GwHistEntFactory to take the blocks from.
+ *
+ * Transfers the ownership of all blocks allocated by @other to @self, which
+ * keeps the history entries alive after @other is destroyed.
+ *
+ * @other starts a new block for its next allocation.
+ */
+void gw_hist_ent_factory_merge(GwHistEntFactory *self, GwHistEntFactory *other)
+{
+    g_return_if_fail(GW_IS_HIST_ENT_FACTORY(self));
+    g_return_if_fail(GW_IS_HIST_ENT_FACTORY(other));
+    g_return_if_fail(self != other);
+
+    if (other->blocks->len == 0) {
+        return;
+    }
+
+    // keep the current block of self at the end, so its remaining entries are still used
+    GwHistEnt *current_block = NULL;
+    if (self->blocks->len > 0) {
+        current_block = g_ptr_array_steal_index(self->blocks, self->blocks->len - 1);
+    }
+
+    g_ptr_array_extend_and_steal(self->blocks, g_steal_pointer(&other->blocks));
+    other->blocks = g_ptr_array_new_with_free_func(g_free);
+    other->current_block = NULL;
+    other->next_index = 0;
+
+    if (current_block != NULL) {
+        g_ptr_array_add(self->blocks, current_block);
+    }
+}
@@ -11,5 +11,7 @@ G_DECLARE_FINAL_TYPE(GwHistEntFactory, gw_hist_ent_factory, GW, HIST_ENT_FACTORY
 GwHistEntFactory *gw_hist_ent_factory_new(void);
 
 GwHistEnt *gw_hist_ent_factory_alloc(GwHistEntFactory *self);
+void gw_hist_ent_factory_free(GwHistEntFactory *self, GwHistEnt *hist_ent);
+void gw_hist_ent_factory_merge(GwHistEntFactory *self, GwHistEntFactory *other);
 
 G_END_DECLS
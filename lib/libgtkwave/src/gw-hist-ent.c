@@ -0,0 +1,129 @@
+#include "gw-hist-ent.h"
+#include "gw-vector-ent.h"
+#include <string.h>
+
+// Packed vectors use the same encodings as GwVectorEnt.
+G_STATIC_ASSERT((guint)GW_HIST_ENT_FLAG_PACKED_1 == (guint)GW_VECTOR_ENT_FLAG_PACKED_1);
+G_STATIC_ASSERT((guint)GW_HIST_ENT_FLAG_PACKED_2 == (guint)GW_VECTOR_ENT_FLAG_PACKED_2);
+
+/**
+ * gw_hist_ent_set_vector:
+ * @self: A GwHistEnt of a vector node.
+ * @bits: The values, one GwBit per position.
+ * @nbits: The number of positions.
+ *
+ * Stores a copy of @bits in h_vector using the most compact encoding, see
+ * gw_vector_ent_choose_packing(). Any previous h_vector is not freed. Unpacked vectors are
+ * NUL terminated.
+ */
+void gw_hist_ent_set_vector(GwHistEnt *self, const guint8 *bits, gsize nbits)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(bits != NULL);
+
+    guint8 packing = gw_vector_ent_choose_packing(bits, nbits);
+    gsize size = gw_vector_ent_get_storage_size(packing, nbits);
+
+    guint8 *vector = g_malloc(size + 1);
+    gw_vector_ent_pack_bits(vector, packing, bits, nbits);
+    vector[size] = 0;
+
+    self->v.h_vector = (char *)vector;
+    self->flags = (self->flags & ~GW_HIST_ENT_FLAG_PACKED) | packing;
+}
+
+/**
+ * gw_hist_ent_get_vector_size:
+ * @self: A GwHistEnt of a vector node.
+ * @nbits: The number of positions.
+ *
+ * Returns: The number of bytes used by the values in h_vector.
+ */
+gsize gw_hist_ent_get_vector_size(const GwHistEnt *self, gsize nbits)
+{
+    g_return_val_if_fail(self != NULL, 0);
+
+    return gw_vector_ent_get_storage_size(self->flags & GW_HIST_ENT_FLAG_PACKED, nbits);
+}
+
+/**
+ * gw_hist_ent_vector_equal:
+ * @self: A GwHistEnt of a vector node.
+ * @other: Another GwHistEnt of the same node.
+ * @nbits: The number of positions.
+ *
+ * Returns: %TRUE if both entries have a vector with the same values.
+ */
+gboolean gw_hist_ent_vector_equal(const GwHistEnt *self, const GwHistEnt *other, gsize nbits)
+{
+    g_return_val_if_fail(self != NULL, FALSE);
+    g_return_val_if_fail(other != NULL, FALSE);
+
+    if (self->v.h_vector == NULL || other->v.h_vector == NULL) {
+        return self->v.h_vector == other->v.h_vector;
+    }
+
+    guint8 packing = self->flags & GW_HIST_ENT_FLAG_PACKED;
+    if (packing == (other->flags & GW_HIST_ENT_FLAG_PACKED)) {
+        return memcmp(self->v.h_vector,
+                      other->v.h_vector,
+                      gw_vector_ent_get_storage_size(packing, nbits)) == 0;
+    }
+
+    guint8 *a = NULL;
+    guint8 *b = NULL;
+    gboolean equal = memcmp(gw_hist_ent_get_bits(self, nbits, &a),
+                            gw_hist_ent_get_bits(other, nbits, &b),
+                            nbits) == 0;
+    g_free(a);
+    g_free(b);
+
+    return equal;
+}
+
+/**
+ * gw_hist_ent_unpack_vector:
+ * @self: A GwHistEnt of a vector node with a non-%NULL h_vector.
+ * @bits: (out): Buffer for @count values.
+ * @offset: The first position to expand.
+ * @count: The number of positions to expand.
+ *
+ * Expands positions [@offset, @offset + @count) of h_vector to one GwBit per position.
+ */
+void gw_hist_ent_unpack_vector(const GwHistEnt *self, guint8 *bits, gsize offset, gsize count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(self->v.h_vector != NULL);
+
+    gw_vector_ent_unpack_bits((const guint8 *)self->v.h_vector,
+                              self->flags & GW_HIST_ENT_FLAG_PACKED,
+                              bits,
+                              offset,
+                              count);
+}
+
+/**
+ * gw_hist_ent_get_bits:
+ * @self: A GwHistEnt of a vector node.
+ * @nbits: The number of positions.
+ * @storage: (out): Set to a newly allocated buffer if @self needs to be unpacked, otherwise
+ * left unchanged. Free with g_free().
+ *
+ * Returns: The values of @self, one GwBit per position and NUL terminated, or %NULL if the
+ * entry has no vector.
+ */
+const guint8 *gw_hist_ent_get_bits(const GwHistEnt *self, gsize nbits, guint8 **storage)
+{
+    g_return_val_if_fail(self != NULL, NULL);
+    g_return_val_if_fail(storage != NULL, NULL);
+
+    if (self->v.h_vector == NULL || !(self->flags & GW_HIST_ENT_FLAG_PACKED)) {
+        return (const guint8 *)self->v.h_vector;
+    }
+
+    *storage = g_malloc(nbits + 1);
+    gw_hist_ent_unpack_vector(self, *storage, 0, nbits);
+    (*storage)[nbits] = 0;
+
+    return *storage;
+}
@@ -32,4 +32,18 @@ typedef enum
     GW_HIST_ENT_FLAG_GLITCH = 1 << 0,
     GW_HIST_ENT_FLAG_REAL = 1 << 1,
     GW_HIST_ENT_FLAG_STRING = 1 << 2,
+    GW_HIST_ENT_FLAG_PACKED_1 = 1 << 3, /* h_vector holds 1 bit per position, 0/1 only */
+    GW_HIST_ENT_FLAG_PACKED_2 = 1 << 4, /* h_vector holds 2 bits per position, 0/X/Z/1 only */
 } GwHistEntFlag;
+
+#define GW_HIST_ENT_FLAG_PACKED (GW_HIST_ENT_FLAG_PACKED_1 | GW_HIST_ENT_FLAG_PACKED_2)
+
+G_BEGIN_DECLS
+
+void gw_hist_ent_set_vector(GwHistEnt *self, const guint8 *bits, gsize nbits);
+gsize gw_hist_ent_get_vector_size(const GwHistEnt *self, gsize nbits);
+gboolean gw_hist_ent_vector_equal(const GwHistEnt *self, const GwHistEnt *other, gsize nbits);
+void gw_hist_ent_unpack_vector(const GwHistEnt *self, guint8 *bits, gsize offset, gsize count);
+const guint8 *gw_hist_ent_get_bits(const GwHistEnt *self, gsize nbits, guint8 **storage);
+
+G_END_DECLS
@@ -0,0 +1,431 @@
+#include "gw-load-stats.h"
+#include "gw-enums.h"
+#include <stdio.h>
+#include <errno.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/**
+ * GwLoadStats:
+ *
+ * Timing and size statistics collected while a dump file is loaded.
+ *
+ * Loaders record the time spent in each #GwLoadPhase together with the number of bytes read
+ * and the number of value changes seen. The "phase-finished" signal can be used to report
+ * progress while a file is being loaded.
+ */
+
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 33)
+#define GW_LOAD_STATS_HAVE_MALLINFO2
+#endif
+#endif
+
+typedef struct
+{
+    gint64 start;
+    gint64 elapsed;
+    gint64 heap_start;
+    gint64 allocated;
+    gboolean running;
+} GwLoadPhaseStats;
+
+struct _GwLoadStats
+{
+    GObject parent_instance;
+
+    gchar *path;
+    GwLoadPhaseStats phases[GW_LOAD_PHASE_COUNT];
+    guint64 bytes;
+    guint64 transitions;
+};
+
+G_DEFINE_TYPE(GwLoadStats, gw_load_stats, G_TYPE_OBJECT)
+
+enum
+{
+    PROP_PATH = 1,
+    PROP_BYTES,
+    PROP_TRANSITIONS,
+    N_PROPERTIES,
+};
+
+enum
+{
+    PHASE_FINISHED,
+    N_SIGNALS,
+};
+
+static GParamSpec *properties[N_PROPERTIES];
+static guint signals[N_SIGNALS];
+
+static const gchar *PHASE_NAMES[GW_LOAD_PHASE_COUNT] = {
+    "header",
+    "value_changes",
+    "symbols",
+    "facs_sort",
+    "tree",
+    "import",
+};
+
+static gint64 get_heap_size(void)
+{
+#ifdef GW_LOAD_STATS_HAVE_MALLINFO2
+    struct mallinfo2 info = mallinfo2();
+    return (gint64)(info.uordblks + info.hblkhd);
+#else
+    return 0;
+#endif
+}
+
+static void gw_load_stats_finalize(GObject *object)
+{
+    GwLoadStats *self = GW_LOAD_STATS(object);
+
+    g_free(self->path);
+
+    G_OBJECT_CLASS(gw_load_stats_parent_class)->finalize(object);
+}
+
+static void gw_load_stats_set_property(GObject *object,
+                                       guint property_id,
+                                       const GValue *value,
+                                       GParamSpec *pspec)
+{
+    GwLoadStats *self = GW_LOAD_STATS(object);
+
+    switch (property_id) {
+        case PROP_PATH:
+            gw_load_stats_set_path(self, g_value_get_string(value));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void gw_load_stats_get_property(GObject *object,
+                                       guint property_id,
+                                       GValue *value,
+                                       GParamSpec *pspec)
+{
+    GwLoadStats *self = GW_LOAD_STATS(object);
+
+    switch (property_id) {
+        case PROP_PATH:
+            g_value_set_string(value, gw_load_stats_get_path(self));
+            break;
+
+        case PROP_BYTES:
+            g_value_set_uint64(value, gw_load_stats_get_bytes(self));
+            break;
+
+        case PROP_TRANSITIONS:
+            g_value_set_uint64(value, gw_load_stats_get_transitions(self));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void gw_load_stats_class_init(GwLoadStatsClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+
+    object_class->finalize = gw_load_stats_finalize;
+    object_class->set_property = gw_load_stats_set_property;
+    object_class->get_property = gw_load_stats_get_property;
+
+    properties[PROP_PATH] =
+        g_param_spec_string("path",
+                            NULL,
+                            NULL,
+                            NULL,
+                            G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    properties[PROP_BYTES] = g_param_spec_uint64("bytes",
+                                                 NULL,
+                                                 NULL,
+                                                 0,
+                                                 G_MAXUINT64,
+                                                 0,
+                                                 G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+    properties[PROP_TRANSITIONS] = g_param_spec_uint64("transitions",
+                                                       NULL,
+                                                       NULL,
+                                                       0,
+                                                       G_MAXUINT64,
+                                                       0,
+                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(object_class, N_PROPERTIES, properties);
+
+    /**
+     * GwLoadStats::phase-finished:
+     * @stats: The #GwLoadStats.
+     * @phase: The #GwLoadPhase that was finished.
+     * @seconds: The total time spent in @phase.
+     *
+     * Emitted every time a load phase ends.
+     */
+    signals[PHASE_FINISHED] = g_signal_new("phase-finished",
+                                           G_TYPE_FROM_CLASS(klass),
+                                           G_SIGNAL_RUN_LAST,
+                                           0,
+                                           NULL,
+                                           NULL,
+                                           NULL,
+                                           G_TYPE_NONE,
+                                           2,
+                                           GW_TYPE_LOAD_PHASE,
+                                           G_TYPE_DOUBLE);
+}
+
+static void gw_load_stats_init(GwLoadStats *self)
+{
+    (void)self;
+}
+
+GwLoadStats *gw_load_stats_new(void)
+{
+    return g_object_new(GW_TYPE_LOAD_STATS, NULL);
+}
+
+void gw_load_stats_set_path(GwLoadStats *self, const gchar *path)
+{
+    g_return_if_fail(GW_IS_LOAD_STATS(self));
+
+    if (g_strcmp0(self->path, path) != 0) {
+        g_free(self->path);
+        self->path = g_strdup(path);
+
+        g_object_notify_by_pspec(G_OBJECT(self), properties[PROP_PATH]);
+    }
+}
+
+const gchar *gw_load_stats_get_path(GwLoadStats *self)
+{
+    g_return_val_if_fail(GW_IS_LOAD_STATS(self), NULL);
+
+    return self->path;
+}
+
+/**
+ * gw_load_stats_begin_phase:
+ * @self: A #GwLoadStats.
+ * @phase: The phase.
+ *
+ * Starts timing @phase. A phase can be entered multiple times, the elapsed times are summed.
+ */
+void gw_load_stats_begin_phase(GwLoadStats *self, GwLoadPhase phase)
+{
+    g_return_if_fail(GW_IS_LOAD_STATS(self));
+    g_return_if_fail(phase < GW_LOAD_PHASE_COUNT);
+
+    GwLoadPhaseStats *p = &self->phases[phase];
+    if (p->running) {
+        return;
+    }
+
+    p->running = TRUE;
+    p->heap_start = get_heap_size();
+    p->start = g_get_monotonic_time();
+}
+
+/**
+ * gw_load_stats_end_phase:
+ * @self: A #GwLoadStats.
+ * @phase: The phase.
+ *
+ * Stops timing @phase and emits #GwLoadStats::phase-finished. Does nothing if @phase
+ * isn't running.
+ */
+void gw_load_stats_end_phase(GwLoadStats *self, GwLoadPhase phase)
+{
+    g_return_if_fail(GW_IS_LOAD_STATS(self));
+    g_return_if_fail(phase < GW_LOAD_PHASE_COUNT);
+
+    GwLoadPhaseStats *p = &self->phases[phase];
+    if (!p->running) {
+        return;
+    }
+
+    p->elapsed += g_get_monotonic_time() - p->start;
+    p->allocated += get_heap_size() - p->heap_start;
+    p->running = FALSE;
+
+    g_signal_emit(self,
+                  signals[PHASE_FINISHED],
+                  0,
+                  phase,
+                  gw_load_stats_get_phase_time(self, phase));
+}
+
+/**
+ * gw_load_stats_get_phase_time:
+ * @self: A #GwLoadStats.
+ * @phase: The phase.
+ *
+ * Returns: The time spent in @phase in seconds.
+ */
+gdouble gw_load_stats_get_phase_time(GwLoadStats *self, GwLoadPhase phase)
+{
+    g_return_val_if_fail(GW_IS_LOAD_STATS(self), 0.0);
+    g_return_val_if_fail(phase < GW_LOAD_PHASE_COUNT, 0.0);
+
+    return self->phases[phase].elapsed / (gdouble)G_USEC_PER_SEC;
+}
+
+/**
+ * gw_load_stats_get_phase_allocated:
+ * @self: A #GwLoadStats.
+ * @phase: The phase.
+ *
+ * Returns the change of the heap size while @phase was running. This is only available on
+ * glibc, other platforms always return 0.
+ *
+ * Returns: The heap growth in bytes, which is negative if more memory was freed than allocated.
+ */
+gint64 gw_load_stats_get_phase_allocated(GwLoadStats *self, GwLoadPhase phase)
+{
+    g_return_val_if_fail(GW_IS_LOAD_STATS(self), 0);
+    g_return_val_if_fail(phase < GW_LOAD_PHASE_COUNT, 0);
+
+    return self->phases[phase].allocated;
+}
+
+void gw_load_stats_add_bytes(GwLoadStats *self, guint64 bytes)
+{
+    g_return_if_fail(GW_IS_LOAD_STATS(self));
+
+    if (bytes == 0) {
+        return;
+    }
+
+    self->bytes += bytes;
+
+    g_object_notify_by_pspec(G_OBJECT(self), properties[PROP_BYTES]);
+}
+
+guint64 gw_load_stats_get_bytes(GwLoadStats *self)
+{
+    g_return_val_if_fail(GW_IS_LOAD_STATS(self), 0);
+
+    return self->bytes;
+}
+
+void gw_load_stats_add_transitions(GwLoadStats *self, guint64 transitions)
+{
+    g_return_if_fail(GW_IS_LOAD_STATS(self));
+
+    if (transitions == 0) {
+        return;
+    }
+
+    self->transitions += transitions;
+
+    g_object_notify_by_pspec(G_OBJECT(self), properties[PROP_TRANSITIONS]);
+}
+
+guint64 gw_load_stats_get_transitions(GwLoadStats *self)
+{
+    g_return_val_if_fail(GW_IS_LOAD_STATS(self), 0);
+
+    return self->transitions;
+}
+
+/**
+ * gw_load_stats_to_json:
+ * @self: A #GwLoadStats.
+ *
+ * Serializes the statistics into a single line JSON object.
+ *
+ * Returns: (transfer full): The JSON string.
+ */
+gchar *gw_load_stats_to_json(GwLoadStats *self)
+{
+    g_return_val_if_fail(GW_IS_LOAD_STATS(self), NULL);
+
+    GString *str = g_string_new("{\"path\":");
+
+    if (self->path != NULL) {
+        g_string_append_c(str, '"');
+        for (const gchar *c = self->path; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                g_string_append_printf(str, "\\%c", *c);
+            } else if ((guchar)*c < 0x20) {
+                g_string_append_printf(str, "\\u%04x", (guchar)*c);
+            } else {
+                g_string_append_c(str, *c);
+            }
+        }
+        g_string_append_c(str, '"');
+    } else {
+        g_string_append(str, "null");
+    }
+
+    g_string_append_printf(str,
+                           ",\"bytes\":%" G_GUINT64_FORMAT ",\"transitions\":%" G_GUINT64_FORMAT
+                           ",\"phases\":{",
+                           self->bytes,
+                           self->transitions);
+
+    for (guint i = 0; i < GW_LOAD_PHASE_COUNT; i++) {
+        gchar seconds[G_ASCII_DTOSTR_BUF_SIZE];
+        g_ascii_formatd(seconds, sizeof(seconds), "%.6f", gw_load_stats_get_phase_time(self, i));
+
+        g_string_append_printf(str,
+                               "%s\"%s\":{\"seconds\":%s,\"allocated\":%" G_GINT64_FORMAT "}",
+                               i > 0 ? "," : "",
+                               PHASE_NAMES[i],
+                               seconds,
+                               self->phases[i].allocated);
+    }
+
+    g_string_append(str, "}}");
+
+    return g_string_free(str, FALSE);
+}
+
+/**
+ * gw_load_stats_append_json:
+ * @self: A #GwLoadStats.
+ * @filename: The file to append to.
+ * @error: The return location for a #GError or %NULL.
+ *
+ * Appends the statistics as a single JSON line to @filename, which is created if it doesn't
+ * exist.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean gw_load_stats_append_json(GwLoadStats *self, const gchar *filename, GError **error)
+{
+    g_return_val_if_fail(GW_IS_LOAD_STATS(self), FALSE);
+    g_return_val_if_fail(filename != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    FILE *f = fopen(filename, "a");
+    if (f == NULL) {
+        gint saved_errno = errno;
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(saved_errno),
+                    "Failed to open %s: %s",
+                    filename,
+                    g_strerror(saved_errno));
+        return FALSE;
+    }
+
+    gchar *json = gw_load_stats_to_json(self);
+    fprintf(f, "%s\n", json);
+    g_free(json);
+
+    fclose(f);
+
+    return TRUE;
+}
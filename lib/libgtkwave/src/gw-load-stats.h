@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+typedef enum
+{
+    GW_LOAD_PHASE_HEADER,
+    GW_LOAD_PHASE_VALUE_CHANGES,
+    GW_LOAD_PHASE_SYMBOLS,
+    GW_LOAD_PHASE_FACS_SORT,
+    GW_LOAD_PHASE_TREE,
+    GW_LOAD_PHASE_IMPORT,
+} GwLoadPhase;
+
+#define GW_LOAD_PHASE_COUNT (GW_LOAD_PHASE_IMPORT + 1)
+
+#define GW_TYPE_LOAD_STATS (gw_load_stats_get_type())
+G_DECLARE_FINAL_TYPE(GwLoadStats, gw_load_stats, GW, LOAD_STATS, GObject)
+
+GwLoadStats *gw_load_stats_new(void);
+
+void gw_load_stats_set_path(GwLoadStats *self, const gchar *path);
+const gchar *gw_load_stats_get_path(GwLoadStats *self);
+
+void gw_load_stats_begin_phase(GwLoadStats *self, GwLoadPhase phase);
+void gw_load_stats_end_phase(GwLoadStats *self, GwLoadPhase phase);
+gdouble gw_load_stats_get_phase_time(GwLoadStats *self, GwLoadPhase phase);
+gint64 gw_load_stats_get_phase_allocated(GwLoadStats *self, GwLoadPhase phase);
+
+void gw_load_stats_add_bytes(GwLoadStats *self, guint64 bytes);
+guint64 gw_load_stats_get_bytes(GwLoadStats *self);
+void gw_load_stats_add_transitions(GwLoadStats *self, guint64 transitions);
+guint64 gw_load_stats_get_transitions(GwLoadStats *self);
+
+gchar *gw_load_stats_to_json(GwLoadStats *self);
+gboolean gw_load_stats_append_json(GwLoadStats *self, const gchar *filename, GError **error);
+
+G_END_DECLS
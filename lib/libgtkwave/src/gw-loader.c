@@ -8,6 +8,8 @@ typedef struct
 
     gchar hierarchy_delimiter;
 
+    GwLoadStats *stats;
+
     gboolean already_used;
 } GwLoaderPrivate;
 
@@ -19,11 +21,22 @@ enum
     PROP_PRESERVE_GLITCHES_REAL,
     PROP_AUTOCOALESCE,
     PROP_HIERARCHY_DELIMITER,
+    PROP_STATS,
     N_PROPERTIES,
 };
 
 static GParamSpec *properties[N_PROPERTIES];
 
+static void gw_loader_dispose(GObject *object)
+{
+    GwLoader *self = GW_LOADER(object);
+    GwLoaderPrivate *priv = gw_loader_get_instance_private(self);
+
+    g_clear_object(&priv->stats);
+
+    G_OBJECT_CLASS(gw_loader_parent_class)->dispose(object);
+}
+
 static void gw_loader_set_property(GObject *object,
                                    guint property_id,
                                    const GValue *value,
@@ -78,6 +91,10 @@ static void gw_loader_get_property(GObject *object,
             g_value_set_uchar(value, gw_loader_get_hierarchy_delimiter(self));
             break;
 
+        case PROP_STATS:
+            g_value_set_object(value, gw_loader_get_stats(self));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -88,6 +105,7 @@ static void gw_loader_class_init(GwLoaderClass *klass)
 {
     GObjectClass *object_class = G_OBJECT_CLASS(klass);
 
+    object_class->dispose = gw_loader_dispose;
     object_class->set_property = gw_loader_set_property;
     object_class->get_property = gw_loader_get_property;
 
@@ -122,6 +140,12 @@ static void gw_loader_class_init(GwLoaderClass *klass)
                            '.',
                            G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
 
+    properties[PROP_STATS] = g_param_spec_object("stats",
+                                                 NULL,
+                                                 NULL,
+                                                 GW_TYPE_LOAD_STATS,
+                                                 G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
     g_object_class_install_properties(object_class, N_PROPERTIES, properties);
 }
 
@@ -131,6 +155,7 @@ static void gw_loader_init(GwLoader *self)
 
     priv->autocoalesce = TRUE;
     priv->hierarchy_delimiter = '.';
+    priv->stats = gw_load_stats_new();
 }
 
 /**
@@ -154,10 +179,17 @@ GwDumpFile *gw_loader_load(GwLoader *self, const gchar *path, GError **error)
     g_return_val_if_fail(!priv->already_used, NULL);
 
     g_return_val_if_fail(GW_LOADER_GET_CLASS(self)->load != NULL, NULL);
+
+    gw_load_stats_set_path(priv->stats, path);
+
     GwDumpFile *file = GW_LOADER_GET_CLASS(self)->load(self, path, error);
 
     priv->already_used = TRUE;
 
+    if (file != NULL) {
+        gw_dump_file_set_load_stats(file, priv->stats);
+    }
+
     return file;
 }
 
@@ -254,3 +286,21 @@ gchar gw_loader_get_hierarchy_delimiter(GwLoader *self)
 
     return priv->hierarchy_delimiter;
 }
+
+/**
+ * gw_loader_get_stats:
+ * @self: A #GwLoader.
+ *
+ * Returns the load statistics. The statistics are filled in by gw_loader_load() and are passed
+ * on to the loaded #GwDumpFile, which adds the time spent importing traces.
+ *
+ * Returns: (transfer none): The load statistics.
+ */
+GwLoadStats *gw_loader_get_stats(GwLoader *self)
+{
+    g_return_val_if_fail(GW_IS_LOADER(self), NULL);
+
+    GwLoaderPrivate *priv = gw_loader_get_instance_private(self);
+
+    return priv->stats;
+}
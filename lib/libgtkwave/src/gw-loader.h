@@ -2,6 +2,7 @@
 
 #include <glib-object.h>
 #include "gw-dump-file.h"
+#include "gw-load-stats.h"
 
 G_BEGIN_DECLS
 
@@ -25,5 +26,6 @@ void gw_loader_set_autocoalesce(GwLoader *self, gboolean autocoalesce);
 gboolean gw_loader_is_autocoalesce(GwLoader *self);
 void gw_loader_set_hierarchy_delimiter(GwLoader *self, gchar delimiter);
 gchar gw_loader_get_hierarchy_delimiter(GwLoader *self);
+GwLoadStats *gw_loader_get_stats(GwLoader *self);
 
 G_END_DECLS
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 #include "gw-node.h"
 #include "gw-bit.h"
 
@@ -9,6 +10,207 @@ void gw_expand_info_free(GwExpandInfo *self) {
     g_free(self);
 }
 
+typedef struct
+{
+    GwHistEnt *ents; /* entries after head, linked once the transpose is done */
+    gint count;
+    gint allocated;
+    guint8 value;
+} TransposeOutput;
+
+static void init_char_to_bit(guint8 table[256])
+{
+    for (gint i = 0; i < 256; i++) {
+        table[i] = i; /* leave val alone as it's been converted already.. */
+    }
+
+    table['0'] = GW_BIT_0;
+    table['1'] = GW_BIT_1;
+    table['x'] = table['X'] = GW_BIT_X;
+    table['z'] = table['Z'] = GW_BIT_Z;
+    table['h'] = table['H'] = GW_BIT_H;
+    table['l'] = table['L'] = GW_BIT_L;
+    table['u'] = table['U'] = GW_BIT_U;
+    table['w'] = table['W'] = GW_BIT_W;
+    table['-'] = GW_BIT_DASH;
+}
+
+static void transpose_append(TransposeOutput *out, GwTime time, guint8 value)
+{
+    if (out->count == out->allocated) {
+        out->allocated = MAX(16, out->allocated * 2);
+        out->ents = g_renew(GwHistEnt, out->ents, out->allocated);
+    }
+
+    GwHistEnt *h = &out->ents[out->count++];
+    memset(h, 0, sizeof(GwHistEnt));
+    h->v.h_val = value;
+    h->time = time;
+
+    out->value = value;
+}
+
+// Returns positions [first_bit, first_bit + count) of the vector of h, packed vectors are
+// expanded into scratch.
+static const guint8 *transpose_get_bits(GwHistEnt *h, gint first_bit, gint count, guint8 *scratch)
+{
+    if (!(h->flags & GW_HIST_ENT_FLAG_PACKED)) {
+        return (const guint8 *)h->v.h_vector + first_bit;
+    }
+
+    gw_hist_ent_unpack_vector(h, scratch, first_bit, count);
+    return scratch;
+}
+
+static void transpose_finish(TransposeOutput *out, GwNode *node)
+{
+    GwHistEnt *ents = out->count > 0 ? g_renew(GwHistEnt, out->ents, out->count) : NULL;
+
+    if (ents == NULL) {
+        g_free(out->ents);
+    }
+
+    node->numhist = out->count + 1;
+    node->harray = g_new(GwHistEnt *, node->numhist);
+    node->harray[0] = &node->head;
+    node->curr = &node->head;
+
+    for (gint i = 0; i < out->count; i++) {
+        node->curr->next = &ents[i];
+        node->curr = &ents[i];
+        node->harray[i + 1] = &ents[i];
+    }
+    node->curr->next = NULL;
+}
+
+/**
+ * gw_node_transpose_history:
+ * @self: A GwNode with a vector history and harray.
+ * @outputs: (array length=count): Empty nodes which receive the scalar histories.
+ * @first_bit: The index into h_vector of the bit stored in @outputs[0].
+ * @count: The number of outputs.
+ * @start: The first time with valid vector data.
+ * @end: The last time with valid vector data.
+ *
+ * Splits the history of @self into one history per bit in a single walk over harray, keeping
+ * only the entries where the bit changes. Entries outside of [@start, @end] are stored as X.
+ *
+ * The entries after the head of each output are allocated as one block, which is pointed to by
+ * harray[1]. Release it with g_free() together with harray.
+ */
+void gw_node_transpose_history(GwNode *self,
+                               GwNode **outputs,
+                               gint first_bit,
+                               gint count,
+                               GwTime start,
+                               GwTime end)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(self->harray != NULL);
+    g_return_if_fail(outputs != NULL);
+    g_return_if_fail(count > 0);
+
+    guint8 char_to_bit[256];
+    init_char_to_bit(char_to_bit);
+
+    TransposeOutput *out = g_new0(TransposeOutput, count);
+    const guint8 *prev = NULL; /* last in range vector, NULL after an out of range entry */
+    guint8 *scratch[2] = {g_malloc(count), g_malloc(count)}; /* alternate, prev may use one */
+
+    for (gint i = 0; i < self->numhist; i++) {
+        GwHistEnt *h = self->harray[i];
+
+        gboolean in_range = h->time >= start && h->time <= end && h->v.h_vector != NULL;
+
+        if (i == 0) {
+            // the first entry ends up in the head embedded in each output node
+            const guint8 *vec =
+                in_range ? transpose_get_bits(h, first_bit, count, scratch[0]) : NULL;
+
+            for (gint j = 0; j < count; j++) {
+                guint8 value = vec != NULL ? char_to_bit[vec[j]] : GW_BIT_X; /* 'x' */
+                outputs[j]->head.v.h_val = value;
+                outputs[j]->head.time = h->time;
+                out[j].value = value;
+            }
+            prev = vec;
+        } else if (!in_range) {
+            for (gint j = 0; j < count; j++) {
+                transpose_append(&out[j], h->time, GW_BIT_X);
+            }
+            prev = NULL;
+        } else {
+            const guint8 *vec = transpose_get_bits(h, first_bit, count, scratch[i & 1]);
+
+            for (gint j = 0; j < count; j++) {
+                // bits whose raw value did not change since the last vector cannot produce an
+                // entry, skip over them a word at a time
+                if (prev != NULL) {
+                    while (j + 8 <= count && memcmp(vec + j, prev + j, 8) == 0) {
+                        j += 8;
+                    }
+                    if (j >= count) {
+                        break;
+                    }
+                    if (vec[j] == prev[j]) {
+                        continue;
+                    }
+                }
+
+                guint8 value = char_to_bit[vec[j]];
+                if (out[j].value != value) {
+                    transpose_append(&out[j], h->time, value);
+                }
+            }
+            prev = vec;
+        }
+    }
+
+    for (gint j = 0; j < count; j++) {
+        transpose_finish(&out[j], outputs[j]);
+    }
+
+    g_free(scratch[0]);
+    g_free(scratch[1]);
+    g_free(out);
+}
+
+/**
+ * gw_node_build_harray:
+ * @self: A GwNode.
+ *
+ * Fills in the harray and numhist fields from the history list, which is required for time
+ * lookups with #GwHistCursor. Does nothing if the node already has a harray.
+ */
+void gw_node_build_harray(GwNode *self)
+{
+    g_return_if_fail(self != NULL);
+
+    if (self->harray != NULL) {
+        return;
+    }
+
+    GwHistEnt *histpnt = &(self->head);
+    int histcount = 0;
+
+    while (histpnt) {
+        histcount++;
+        histpnt = histpnt->next;
+    }
+
+    self->numhist = histcount;
+
+    GwHistEnt **harray = g_new(GwHistEnt *, histcount);
+    self->harray = harray;
+
+    histpnt = &(self->head);
+    for (int i = 0; i < histcount; i++) {
+        *harray = histpnt;
+        harray++;
+        histpnt = histpnt->next;
+    }
+}
+
 GwExpandInfo *gw_node_expand(GwNode *self)
 {
     g_return_val_if_fail(self != NULL, NULL);
@@ -94,27 +296,7 @@ GwExpandInfo *gw_node_expand(GwNode *self)
     memcpy(nam, namex, offset);
 
     // make quick array lookup for aet display--normally this is done in addnode
-    if (self->harray == NULL) {
-        GwHistEnt *histpnt = &(self->head);
-        int histcount = 0;
-
-        while (histpnt) {
-            histcount++;
-            histpnt = histpnt->next;
-        }
-
-        self->numhist = histcount;
-
-        GwHistEnt **harray = g_new(GwHistEnt *, histcount);
-        self->harray = harray;
-
-        histpnt = &(self->head);
-        for (i = 0; i < histcount; i++) {
-            *harray = histpnt;
-            harray++;
-            histpnt = histpnt->next;
-        }
-    }
+    gw_node_build_harray(self);
 
     GwHistEnt *h = &(self->head);
     while (h) {
@@ -157,86 +339,7 @@ GwExpandInfo *gw_node_expand(GwNode *self)
         narray[i]->expansion = exp1; /* can be safely deleted if expansion set like here */
     }
 
-    for (i = 0; i < self->numhist; i++) {
-        h = self->harray[i];
-        if (h->time < 0 || h->time >= GW_TIME_MAX - 1) {
-            for (gint j = 0; j < width; j++) {
-                if (narray[j]->curr) {
-                    GwHistEnt *htemp = g_new0(GwHistEnt, 1);
-                    htemp->v.h_val = GW_BIT_X; /* 'x' */
-                    htemp->time = h->time;
-                    narray[j]->curr->next = htemp;
-                    narray[j]->curr = htemp;
-                } else {
-                    narray[j]->head.v.h_val = GW_BIT_X; /* 'x' */
-                    narray[j]->head.time = h->time;
-                    narray[j]->curr = &(narray[j]->head);
-                }
-
-                narray[j]->numhist++;
-            }
-        } else {
-            for (gint j = 0; j < width; j++) {
-                unsigned char val = h->v.h_vector[j];
-                switch (val) {
-                    case '0':
-                        val = GW_BIT_0;
-                        break;
-                    case '1':
-                        val = GW_BIT_1;
-                        break;
-                    case 'x':
-                    case 'X':
-                        val = GW_BIT_X;
-                        break;
-                    case 'z':
-                    case 'Z':
-                        val = GW_BIT_Z;
-                        break;
-                    case 'h':
-                    case 'H':
-                        val = GW_BIT_H;
-                        break;
-                    case 'l':
-                    case 'L':
-                        val = GW_BIT_L;
-                        break;
-                    case 'u':
-                    case 'U':
-                        val = GW_BIT_U;
-                        break;
-                    case 'w':
-                    case 'W':
-                        val = GW_BIT_W;
-                        break;
-                    case '-':
-                        val = GW_BIT_DASH;
-                        break;
-                    default:
-                        break; /* leave val alone as it's been converted already.. */
-                }
-
-                // curr will have been established already by 'x' at time: -1
-                if (narray[j]->curr->v.h_val != val) {
-                    GwHistEnt *htemp = g_new0(GwHistEnt, 1);
-                    htemp->v.h_val = val;
-                    htemp->time = h->time;
-                    narray[j]->curr->next = htemp;
-                    narray[j]->curr = htemp;
-                    narray[j]->numhist++;
-                }
-            }
-        }
-    }
-
-    for (i = 0; i < width; i++) {
-        narray[i]->harray = g_new0(GwHistEnt *, narray[i]->numhist);
-        GwHistEnt *htemp = &(narray[i]->head);
-        for (gint j = 0; j < narray[i]->numhist; j++) {
-            narray[i]->harray[j] = htemp;
-            htemp = htemp->next;
-        }
-    }
+    gw_node_transpose_history(self, narray, 0, width, 0, GW_TIME_MAX - 2);
 
     return rc;
 }
@@ -69,4 +69,11 @@ struct _GwNode
 #pragma pack(pop)
 #endif
 
+void gw_node_build_harray(GwNode *self);
 GwExpandInfo *gw_node_expand(GwNode *self);
+void gw_node_transpose_history(GwNode *self,
+                               GwNode **outputs,
+                               gint first_bit,
+                               gint count,
+                               GwTime start,
+                               GwTime end);
@@ -15,6 +15,7 @@ struct _GwTrace
     char *asciivalue; /* value that marker points to */
     char *transaction_args; /* for TR_TTRANSLATED traces */
     GwTime asciitime; /* time this value corresponds with */
+    guint value_generation; /* asciivalue is stale if this differs from the viewer's generation */
     GwTime shift; /* offset added to all entries in the trace */
     GwTime shift_drag; /* cached initial offset for CTRL+LMB drag on highlighted */
 
@@ -35,6 +36,12 @@ struct _GwTrace
     int t_filter; /* transaction process filter */
     int e_filter; /* enum filter (from FST) */
 
+    int name_width; /* pixel widths of the name and the value in the signal pane */
+    int value_width;
+    guint name_hash; /* hashes of the measured strings, to skip measuring them again */
+    guint value_hash;
+    guint width_epoch; /* signal pane width computation that includes this trace */
+
     unsigned int t_color; /* trace color index */
     unsigned char t_fpdecshift; /* for fixed point decimal */
 
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "gw-tree.h"
+
+// Always takes the threaded path of gw_tree_sort(), regardless of the tree size and the number
+// of processors. Only meant for tests.
+void gw_tree_sort_parallel(GwTree *self, guint num_threads);
@@ -1,4 +1,5 @@
 #include "gw-tree.h"
+#include "gw-tree-private.h"
 #include "gw-util.h"
 
 struct _GwTree
@@ -104,11 +105,78 @@ static int tree_qsort_cmp(const void *v1, const void *v2)
     return gw_signal_name_compare(t2->name, t1->name); /* because list must be in rvs */
 }
 
+// Subtrees below this depth are sorted as separate tasks when the tree is large enough.
+#define PARALLEL_SORT_MAX_DEPTH 3
+#define PARALLEL_SORT_MIN_NODES (64 * 1024)
+
+typedef struct
+{
+    GThreadPool *pool;
+    GMutex mutex;
+    GCond cond;
+    gint pending;
+} TreeSortContext;
+
+typedef struct
+{
+    GwTreeNode *parent;
+    gint depth;
+} TreeSortTask;
+
 static void gw_tree_sort_recursive(GwTree *self,
                                    GwTreeNode *t,
                                    GwTreeNode *p,
                                    GwTreeNode ***tm,
-                                   int *tm_siz)
+                                   int *tm_siz,
+                                   TreeSortContext *ctx,
+                                   gint depth);
+
+static void sort_children(GwTreeNode *it,
+                          GwTreeNode ***tm,
+                          int *tm_siz,
+                          TreeSortContext *ctx,
+                          gint depth)
+{
+    if (ctx != NULL && depth < PARALLEL_SORT_MAX_DEPTH) {
+        // sibling lists are disjoint, so every subtree can be sorted independently
+        TreeSortTask *task = g_new(TreeSortTask, 1);
+        task->parent = it;
+        task->depth = depth + 1;
+
+        g_mutex_lock(&ctx->mutex);
+        ctx->pending++;
+        g_mutex_unlock(&ctx->mutex);
+
+        g_thread_pool_push(ctx->pool, task, NULL);
+    } else {
+        gw_tree_sort_recursive(NULL, it->child, it, tm, tm_siz, ctx, depth + 1);
+    }
+}
+
+static void sort_task(gpointer data, gpointer user_data)
+{
+    TreeSortTask *task = data;
+    TreeSortContext *ctx = user_data;
+    GwTreeNode **tm = NULL;
+    int tm_siz = 0;
+
+    gw_tree_sort_recursive(NULL, task->parent->child, task->parent, &tm, &tm_siz, ctx, task->depth);
+    g_free(tm);
+    g_free(task);
+
+    g_mutex_lock(&ctx->mutex);
+    ctx->pending--;
+    g_cond_signal(&ctx->cond);
+    g_mutex_unlock(&ctx->mutex);
+}
+
+static void gw_tree_sort_recursive(GwTree *self,
+                                   GwTreeNode *t,
+                                   GwTreeNode *p,
+                                   GwTreeNode ***tm,
+                                   int *tm_siz,
+                                   TreeSortContext *ctx,
+                                   gint depth)
 {
     GwTreeNode *it;
     GwTreeNode **srt;
@@ -153,13 +221,52 @@ static void gw_tree_sort_recursive(GwTree *self,
         it = srt[0];
         for (i = 0; i < cnt; i++) {
             if (it->child) {
-                gw_tree_sort_recursive(self, it->child, it, tm, tm_siz);
+                sort_children(it, tm, tm_siz, ctx, depth);
             }
             it = it->next;
         }
     } else if (t->child) {
-        gw_tree_sort_recursive(self, t->child, t, tm, tm_siz);
+        sort_children(t, tm, tm_siz, ctx, depth);
+    }
+}
+
+static gint count_nodes(GwTreeNode *t, gint limit)
+{
+    gint count = 0;
+
+    for (; t != NULL && count < limit; t = t->next) {
+        count++;
+        if (t->child != NULL) {
+            count += count_nodes(t->child, limit - count);
+        }
     }
+
+    return count;
+}
+
+static void sort_parallel(GwTree *self, guint num_threads)
+{
+    GwTreeNode **tm = NULL;
+    int tm_siz = 0;
+
+    TreeSortContext ctx = {0};
+    g_mutex_init(&ctx.mutex);
+    g_cond_init(&ctx.cond);
+    ctx.pool = g_thread_pool_new(sort_task, &ctx, num_threads, FALSE, NULL);
+
+    gw_tree_sort_recursive(self, self->root, NULL, &tm, &tm_siz, &ctx, 0);
+
+    g_mutex_lock(&ctx.mutex);
+    while (ctx.pending > 0) {
+        g_cond_wait(&ctx.cond, &ctx.mutex);
+    }
+    g_mutex_unlock(&ctx.mutex);
+
+    g_thread_pool_free(ctx.pool, FALSE, TRUE);
+    g_mutex_clear(&ctx.mutex);
+    g_cond_clear(&ctx.cond);
+
+    g_free(tm);
 }
 
 void gw_tree_sort(GwTree *self)
@@ -170,12 +277,28 @@ void gw_tree_sort(GwTree *self)
         return;
     }
 
-    GwTreeNode **tm = NULL;
-    int tm_siz = 0;
+    guint num_threads = g_get_num_processors();
 
-    gw_tree_sort_recursive(self, self->root, NULL, &tm, &tm_siz);
+    if (num_threads < 2 ||
+        count_nodes(self->root, PARALLEL_SORT_MIN_NODES) < PARALLEL_SORT_MIN_NODES) {
+        GwTreeNode **tm = NULL;
+        int tm_siz = 0;
 
-    g_free(tm);
+        gw_tree_sort_recursive(self, self->root, NULL, &tm, &tm_siz, NULL, 0);
+        g_free(tm);
+    } else {
+        sort_parallel(self, num_threads);
+    }
+}
+
+void gw_tree_sort_parallel(GwTree *self, guint num_threads)
+{
+    g_return_if_fail(GW_IS_TREE(self));
+    g_return_if_fail(num_threads > 0);
+
+    if (self->root != NULL) {
+        sort_parallel(self, num_threads);
+    }
 }
 
 void gw_tree_graft(GwTree *self, GwTreeNode *graft_chain)
@@ -0,0 +1,716 @@
+#include "gw-vcd-cache.h"
+#include "gw-vcd-file-private.h"
+#include "gw-vlist.h"
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <errno.h>
+
+/*
+ * The VCD cache stores the state of a GwVcdFile right after it has been loaded: the sorted
+ * facs, the hierarchy tree and the raw (possibly compressed) vlist blocks of the time table and
+ * of every signal. Reading it back only copies these blocks out of the mapped file, the VCD
+ * file itself is never parsed. Traces are still imported from the vlists on demand.
+ *
+ * All values are stored in host byte order, a cache written on a different architecture is
+ * rejected by the byte order check in the header.
+ */
+
+#define CACHE_MAGIC "GWVCDCHE"
+#define CACHE_VERSION 1
+#define CACHE_BYTE_ORDER 0x01020304
+#define CACHE_DIGEST_CHUNK_SIZE (64 * 1024)
+#define CACHE_MAX_TREE_DEPTH 4096
+
+/* key */
+
+static gboolean update_digest(GChecksum *checksum, FILE *f, gsize length)
+{
+    guint8 *buf = g_malloc(CACHE_DIGEST_CHUNK_SIZE);
+    gsize rd = fread(buf, 1, MIN(length, CACHE_DIGEST_CHUNK_SIZE), f);
+
+    g_checksum_update(checksum, buf, rd);
+    g_free(buf);
+
+    return rd == MIN(length, CACHE_DIGEST_CHUNK_SIZE);
+}
+
+/*
+ * Hashing the complete dump would take almost as long as parsing it, so only the head and the
+ * tail of the file are hashed. Together with the size and the modification time this catches
+ * regenerated dumps as well as dumps that were appended to.
+ */
+gboolean gw_vcd_cache_key_init(GwVcdCacheKey *key, const gchar *dump_path)
+{
+    GStatBuf st;
+
+    memset(key, 0, sizeof(GwVcdCacheKey));
+
+    if (g_stat(dump_path, &st) != 0 || !S_ISREG(st.st_mode)) {
+        return FALSE;
+    }
+
+    FILE *f = g_fopen(dump_path, "rb");
+    if (f == NULL) {
+        return FALSE;
+    }
+
+    key->size = st.st_size;
+    key->mtime = st.st_mtime;
+
+    GChecksum *checksum = g_checksum_new(G_CHECKSUM_SHA256);
+    gboolean ok = update_digest(checksum, f, key->size);
+
+    if (ok && key->size > CACHE_DIGEST_CHUNK_SIZE) {
+        guint64 tail = MIN(key->size - CACHE_DIGEST_CHUNK_SIZE, CACHE_DIGEST_CHUNK_SIZE);
+        ok = fseeko(f, key->size - tail, SEEK_SET) == 0 && update_digest(checksum, f, tail);
+    }
+
+    gsize digest_len = sizeof(key->digest);
+    g_checksum_get_digest(checksum, key->digest, &digest_len);
+    g_checksum_free(checksum);
+
+    fclose(f);
+
+    return ok;
+}
+
+/**
+ * gw_vcd_cache_get_paths:
+ * @dump_path: The VCD file path.
+ *
+ * Returns the locations where the cache for @dump_path is looked for, in order of preference.
+ * The first one is next to the dump, the second one is inside the user cache directory and is
+ * used when the directory of the dump isn't writable.
+ *
+ * Returns: (transfer full): The cache paths.
+ */
+GPtrArray *gw_vcd_cache_get_paths(const gchar *dump_path)
+{
+    GPtrArray *paths = g_ptr_array_new_with_free_func(g_free);
+
+    g_ptr_array_add(paths, g_strconcat(dump_path, ".gwcache", NULL));
+
+    gchar *absolute_path = g_canonicalize_filename(dump_path, NULL);
+    gchar *hash = g_compute_checksum_for_string(G_CHECKSUM_SHA256, absolute_path, -1);
+    gchar *basename = g_strconcat(hash, ".gwcache", NULL);
+
+    g_ptr_array_add(paths, g_build_filename(g_get_user_cache_dir(), "gtkwave", basename, NULL));
+
+    g_free(basename);
+    g_free(hash);
+    g_free(absolute_path);
+
+    return paths;
+}
+
+/* writer */
+
+typedef struct
+{
+    FILE *f;
+    GHashTable *symbol_indices;
+    GHashTable *node_indices;
+} CacheWriter;
+
+static void write_raw(CacheWriter *w, const void *data, gsize len)
+{
+    if (len > 0) {
+        fwrite(data, 1, len, w->f);
+    }
+}
+
+static void write_u8(CacheWriter *w, guint8 value)
+{
+    write_raw(w, &value, sizeof(value));
+}
+
+static void write_u32(CacheWriter *w, guint32 value)
+{
+    write_raw(w, &value, sizeof(value));
+}
+
+static void write_i32(CacheWriter *w, gint32 value)
+{
+    write_raw(w, &value, sizeof(value));
+}
+
+static void write_i64(CacheWriter *w, gint64 value)
+{
+    write_raw(w, &value, sizeof(value));
+}
+
+static void write_string(CacheWriter *w, const gchar *str)
+{
+    guint32 len = strlen(str);
+
+    write_u32(w, len);
+    write_raw(w, str, len);
+}
+
+static void write_key(CacheWriter *w, const GwVcdCacheKey *key)
+{
+    write_raw(w, CACHE_MAGIC, strlen(CACHE_MAGIC));
+    write_u32(w, CACHE_VERSION);
+    write_u32(w, CACHE_BYTE_ORDER);
+    write_i64(w, key->size);
+    write_i64(w, key->mtime);
+    write_raw(w, key->digest, sizeof(key->digest));
+    write_u8(w, key->hierarchy_delimiter);
+    write_u8(w, key->autocoalesce);
+    write_u8(w, key->prepacked);
+}
+
+// Compressed blocks are stored as they are, a negative offset marks them as compressed.
+static void write_vlist(CacheWriter *w, GwVlist *vlist)
+{
+    guint32 count = 0;
+    for (GwVlist *iter = vlist; iter != NULL; iter = iter->next) {
+        count++;
+    }
+    write_u32(w, count);
+
+    for (GwVlist *iter = vlist; iter != NULL; iter = iter->next) {
+        guint32 payload_size;
+        if ((gint)iter->offset < 0) {
+            payload_size = sizeof(guint) + *(guint *)(iter + 1);
+        } else {
+            payload_size = iter->offset * iter->element_size;
+        }
+
+        write_u32(w, iter->size);
+        write_u32(w, iter->offset);
+        write_u32(w, iter->element_size);
+        write_u32(w, payload_size);
+        write_raw(w, iter + 1, payload_size);
+    }
+}
+
+static gint32 lookup_index(GHashTable *indices, gconstpointer key)
+{
+    gpointer value;
+
+    if (key == NULL || !g_hash_table_lookup_extended(indices, key, NULL, &value)) {
+        return -1;
+    }
+
+    return GPOINTER_TO_INT(value);
+}
+
+static void write_blackout_region(GwTime start, GwTime end, gpointer user_data)
+{
+    CacheWriter *w = user_data;
+
+    write_i64(w, start);
+    write_i64(w, end);
+}
+
+static void write_tree(CacheWriter *w, const GwTreeNode *t)
+{
+    for (; t != NULL; t = t->next) {
+        write_u8(w, 1);
+        write_u8(w, t->kind);
+        write_i32(w, t->t_which);
+        write_u32(w, t->t_stem);
+        write_u32(w, t->t_istem);
+        write_string(w, t->name);
+
+        write_tree(w, t->child);
+    }
+
+    write_u8(w, 0);
+}
+
+static void write_file(CacheWriter *w, GwVcdFile *file, const GwVcdCacheKey *key)
+{
+    GwDumpFile *dump_file = GW_DUMP_FILE(file);
+    GwTimeRange *time_range = gw_dump_file_get_time_range(dump_file);
+    GwBlackoutRegions *blackout_regions = gw_dump_file_get_blackout_regions(dump_file);
+    GwFacs *facs = gw_dump_file_get_facs(dump_file);
+    guint numfacs = gw_facs_get_length(facs);
+
+    write_key(w, key);
+
+    write_i64(w, gw_dump_file_get_time_scale(dump_file));
+    write_i32(w, gw_dump_file_get_time_dimension(dump_file));
+    write_i64(w, gw_time_range_get_start(time_range));
+    write_i64(w, gw_time_range_get_end(time_range));
+    write_i64(w, gw_dump_file_get_global_time_offset(dump_file));
+    write_u8(w, gw_dump_file_has_escaped_names(dump_file));
+    write_i64(w, file->start_time);
+    write_i64(w, file->end_time);
+
+    write_u32(w, gw_blackout_regions_length(blackout_regions));
+    gw_blackout_regions_foreach(blackout_regions, write_blackout_region, w);
+
+    write_vlist(w, file->time_vlist);
+
+    for (guint i = 0; i < numfacs; i++) {
+        GwSymbol *s = gw_facs_get(facs, i);
+
+        g_hash_table_insert(w->symbol_indices, s, GINT_TO_POINTER(i));
+        g_hash_table_insert(w->node_indices, s->n, GINT_TO_POINTER(i));
+    }
+
+    write_u32(w, numfacs);
+    for (guint i = 0; i < numfacs; i++) {
+        GwSymbol *s = gw_facs_get(facs, i);
+        GwNode *n = s->n;
+
+        write_string(w, s->name);
+        write_i32(w, lookup_index(w->symbol_indices, s->vec_root));
+        write_i32(w, lookup_index(w->symbol_indices, s->vec_chain));
+
+        write_i32(w, n->msi);
+        write_i32(w, n->lsi);
+        write_i32(w, n->numhist);
+        write_u8(w, n->vartype);
+        write_u8(w, n->vardt);
+        write_u8(w, n->vardir);
+        write_u8(w, n->extvals);
+
+        // Aliases point to the node they share their value changes with until imported.
+        write_i32(w, lookup_index(w->node_indices, n->curr));
+
+        write_vlist(w, n->mv.mvlfac_vlist);
+    }
+
+    write_tree(w, gw_tree_get_root_const(gw_dump_file_get_tree(dump_file)));
+}
+
+/**
+ * gw_vcd_cache_write:
+ * @file: A freshly loaded #GwVcdFile, before any traces were imported.
+ * @cache_path: The cache file path.
+ * @key: The key of the dump @file was loaded from.
+ * @error: The return location for a #GError or %NULL.
+ *
+ * Writes the cache for @file. The cache is written to a temporary file first and renamed
+ * into place, readers never see a partially written cache.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean gw_vcd_cache_write(GwVcdFile *file,
+                            const gchar *cache_path,
+                            const GwVcdCacheKey *key,
+                            GError **error)
+{
+    g_return_val_if_fail(GW_IS_VCD_FILE(file), FALSE);
+    g_return_val_if_fail(cache_path != NULL, FALSE);
+    g_return_val_if_fail(key != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    gchar *dir = g_path_get_dirname(cache_path);
+    g_mkdir_with_parents(dir, 0755);
+    g_free(dir);
+
+    gchar *tmp_path = g_strconcat(cache_path, ".tmp", NULL);
+
+    CacheWriter w = {0};
+    w.f = g_fopen(tmp_path, "wb");
+    if (w.f == NULL) {
+        gint saved_errno = errno;
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(saved_errno),
+                    "Failed to create %s: %s",
+                    tmp_path,
+                    g_strerror(saved_errno));
+        g_free(tmp_path);
+        return FALSE;
+    }
+
+    w.symbol_indices = g_hash_table_new(g_direct_hash, g_direct_equal);
+    w.node_indices = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    write_file(&w, file, key);
+
+    g_hash_table_destroy(w.symbol_indices);
+    g_hash_table_destroy(w.node_indices);
+
+    gboolean ok = !ferror(w.f);
+    ok = (fclose(w.f) == 0) && ok;
+    ok = ok && g_rename(tmp_path, cache_path) == 0;
+
+    if (!ok) {
+        gint saved_errno = errno;
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(saved_errno),
+                    "Failed to write %s: %s",
+                    cache_path,
+                    g_strerror(saved_errno));
+        g_unlink(tmp_path);
+    }
+
+    g_free(tmp_path);
+
+    return ok;
+}
+
+/* reader */
+
+typedef struct
+{
+    const guint8 *pos;
+    const guint8 *end;
+    gboolean error;
+    GString *scratch;
+} CacheReader;
+
+static gboolean read_raw(CacheReader *r, void *data, gsize len)
+{
+    if (r->error || (gsize)(r->end - r->pos) < len) {
+        r->error = TRUE;
+        memset(data, 0, len);
+        return FALSE;
+    }
+
+    memcpy(data, r->pos, len);
+    r->pos += len;
+
+    return TRUE;
+}
+
+static guint8 read_u8(CacheReader *r)
+{
+    guint8 value;
+    read_raw(r, &value, sizeof(value));
+    return value;
+}
+
+static guint32 read_u32(CacheReader *r)
+{
+    guint32 value;
+    read_raw(r, &value, sizeof(value));
+    return value;
+}
+
+static gint32 read_i32(CacheReader *r)
+{
+    gint32 value;
+    read_raw(r, &value, sizeof(value));
+    return value;
+}
+
+static gint64 read_i64(CacheReader *r)
+{
+    gint64 value;
+    read_raw(r, &value, sizeof(value));
+    return value;
+}
+
+// Returns a pointer to a temporary copy of the string which is valid until the next call.
+static const gchar *read_string(CacheReader *r, guint32 *len)
+{
+    *len = read_u32(r);
+
+    if (r->error || (gsize)(r->end - r->pos) < *len) {
+        r->error = TRUE;
+        *len = 0;
+        return "";
+    }
+
+    g_string_truncate(r->scratch, 0);
+    g_string_append_len(r->scratch, (const gchar *)r->pos, *len);
+    r->pos += *len;
+
+    return r->scratch->str;
+}
+
+static gboolean read_key(CacheReader *r, const GwVcdCacheKey *key)
+{
+    gchar magic[sizeof(CACHE_MAGIC) - 1];
+    guint8 digest[sizeof(key->digest)];
+
+    read_raw(r, magic, sizeof(magic));
+    if (memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0) {
+        return FALSE;
+    }
+
+    if (read_u32(r) != CACHE_VERSION || read_u32(r) != CACHE_BYTE_ORDER) {
+        return FALSE;
+    }
+
+    gboolean match = (guint64)read_i64(r) == key->size;
+    match = read_i64(r) == key->mtime && match;
+    read_raw(r, digest, sizeof(digest));
+    match = memcmp(digest, key->digest, sizeof(digest)) == 0 && match;
+    match = read_u8(r) == key->hierarchy_delimiter && match;
+    match = read_u8(r) == key->autocoalesce && match;
+    match = read_u8(r) == key->prepacked && match;
+
+    return match && !r->error;
+}
+
+static GwVlist *read_vlist(CacheReader *r)
+{
+    guint32 count = read_u32(r);
+    GwVlist *head = NULL;
+    GwVlist **link = &head;
+
+    for (guint32 i = 0; i < count && !r->error; i++) {
+        guint32 size = read_u32(r);
+        guint32 offset = read_u32(r);
+        guint32 element_size = read_u32(r);
+        guint32 payload_size = read_u32(r);
+
+        gboolean valid = element_size > 0 && (gsize)(r->end - r->pos) >= payload_size;
+        if ((gint)offset >= 0) {
+            valid = valid && (guint64)offset * element_size == payload_size;
+        } else if (valid) {
+            guint compressed_size = 0;
+            valid = payload_size >= sizeof(guint);
+            if (valid) {
+                memcpy(&compressed_size, r->pos, sizeof(guint));
+            }
+            valid = valid && compressed_size == payload_size - sizeof(guint);
+        }
+        if (!valid) {
+            r->error = TRUE;
+            break;
+        }
+
+        GwVlist *block = g_malloc(sizeof(GwVlist) + payload_size);
+        block->next = NULL;
+        block->size = size;
+        block->offset = offset;
+        block->element_size = element_size;
+        read_raw(r, block + 1, payload_size);
+
+        *link = block;
+        link = &block->next;
+    }
+
+    if (r->error) {
+        gw_vlist_destroy(head);
+        return NULL;
+    }
+
+    return head;
+}
+
+static GwTreeNode *read_tree(CacheReader *r, guint numfacs, guint depth)
+{
+    GwTreeNode *head = NULL;
+    GwTreeNode *tail = NULL;
+
+    if (depth > CACHE_MAX_TREE_DEPTH) {
+        r->error = TRUE;
+        return NULL;
+    }
+
+    while (!r->error && read_u8(r) == 1) {
+        guint8 kind = read_u8(r);
+        gint32 t_which = read_i32(r);
+        guint32 t_stem = read_u32(r);
+        guint32 t_istem = read_u32(r);
+        guint32 len;
+        const gchar *name = read_string(r, &len);
+
+        if (t_which >= (gint32)numfacs) {
+            r->error = TRUE;
+            break;
+        }
+
+        GwTreeNode *t = gw_tree_node_new(kind, name);
+        t->t_which = t_which;
+        t->t_stem = t_stem;
+        t->t_istem = t_istem;
+
+        if (tail != NULL) {
+            tail->next = t;
+        } else {
+            head = t;
+        }
+        tail = t;
+
+        t->child = read_tree(r, numfacs, depth + 1);
+    }
+
+    if (r->error) {
+        gw_tree_node_free(head);
+        return NULL;
+    }
+
+    return head;
+}
+
+static gboolean read_index(CacheReader *r, guint numfacs, gint32 *index)
+{
+    *index = read_i32(r);
+
+    if (*index < -1 || *index >= (gint32)numfacs) {
+        r->error = TRUE;
+    }
+
+    return !r->error;
+}
+
+static GwVcdFile *read_file(CacheReader *r, const GwVcdCacheKey *key)
+{
+    if (!read_key(r, key)) {
+        return NULL;
+    }
+
+    GwTime time_scale = read_i64(r);
+    GwTimeDimension time_dimension = read_i32(r);
+    GwTime min_time = read_i64(r);
+    GwTime max_time = read_i64(r);
+    GwTime global_time_offset = read_i64(r);
+    gboolean has_escaped_names = read_u8(r);
+    GwTime start_time = read_i64(r);
+    GwTime end_time = read_i64(r);
+
+    if (time_scale < 1 || time_scale > 100) {
+        return NULL;
+    }
+
+    GwBlackoutRegions *blackout_regions = gw_blackout_regions_new();
+    guint32 blackout_count = read_u32(r);
+    for (guint32 i = 0; i < blackout_count && !r->error; i++) {
+        GwTime start = read_i64(r);
+        GwTime end = read_i64(r);
+        gw_blackout_regions_add(blackout_regions, start, end);
+    }
+
+    GwVlist *time_vlist = read_vlist(r);
+    guint32 numfacs = read_u32(r);
+
+    // Every fac needs at least a few bytes, reject counts that can't possibly fit.
+    if (r->error || time_vlist == NULL || numfacs > (gsize)(r->end - r->pos)) {
+        gw_vlist_destroy(time_vlist);
+        g_object_unref(blackout_regions);
+        return NULL;
+    }
+
+    GwFacs *facs = gw_facs_new(numfacs);
+    GStringChunk *names = g_string_chunk_new(64 * 1024);
+    GwSymbol *sym_block = g_new0(GwSymbol, numfacs);
+    GwNode *node_block = g_new0(GwNode, numfacs);
+    gint32 *links = g_new(gint32, 3 * numfacs);
+
+    for (guint32 i = 0; i < numfacs && !r->error; i++) {
+        GwSymbol *s = &sym_block[i];
+        GwNode *n = &node_block[i];
+        guint32 len;
+        const gchar *name = read_string(r, &len);
+
+        s->name = g_string_chunk_insert_len(names, name, len);
+        s->n = n;
+
+        read_index(r, numfacs, &links[3 * i + 0]);
+        read_index(r, numfacs, &links[3 * i + 1]);
+
+        n->nname = s->name;
+        n->head.time = -2;
+        n->head.v.h_val = GW_BIT_X;
+        n->msi = read_i32(r);
+        n->lsi = read_i32(r);
+        n->numhist = read_i32(r);
+        n->vartype = read_u8(r);
+        n->vardt = read_u8(r);
+        n->vardir = read_u8(r);
+        n->extvals = read_u8(r);
+
+        read_index(r, numfacs, &links[3 * i + 2]);
+
+        n->mv.mvlfac_vlist = read_vlist(r);
+
+        gw_facs_set(facs, i, s);
+    }
+
+    GwTreeNode *root = NULL;
+    if (!r->error) {
+        root = read_tree(r, numfacs, 0);
+    }
+
+    if (r->error) {
+        for (guint32 i = 0; i < numfacs; i++) {
+            gw_vlist_destroy(node_block[i].mv.mvlfac_vlist);
+        }
+        g_free(links);
+        g_free(node_block);
+        g_free(sym_block);
+        g_string_chunk_free(names);
+        g_object_unref(facs);
+        gw_vlist_destroy(time_vlist);
+        g_object_unref(blackout_regions);
+        return NULL;
+    }
+
+    for (guint32 i = 0; i < numfacs; i++) {
+        if (links[3 * i + 0] >= 0) {
+            sym_block[i].vec_root = &sym_block[links[3 * i + 0]];
+        }
+        if (links[3 * i + 1] >= 0) {
+            sym_block[i].vec_chain = &sym_block[links[3 * i + 1]];
+        }
+        if (links[3 * i + 2] >= 0) {
+            node_block[i].curr = (GwHistEnt *)&node_block[links[3 * i + 2]];
+        }
+    }
+    g_free(links);
+
+    gw_facs_take_names(facs, names);
+
+    GwTree *tree = gw_tree_new(root);
+    GwTimeRange *time_range = gw_time_range_new(min_time, max_time);
+
+    // clang-format off
+    GwVcdFile *file = g_object_new(GW_TYPE_VCD_FILE,
+                                   "tree", tree,
+                                   "facs", facs,
+                                   "blackout-regions", blackout_regions,
+                                   "time-scale", time_scale,
+                                   "time-dimension", time_dimension,
+                                   "time-range", time_range,
+                                   "global-time-offset", global_time_offset,
+                                   "has-escaped-names", has_escaped_names,
+                                   NULL);
+    // clang-format on
+
+    file->start_time = start_time;
+    file->end_time = end_time;
+    file->time_vlist = time_vlist;
+    file->is_prepacked = key->prepacked;
+
+    g_object_unref(tree);
+    g_object_unref(facs);
+    g_object_unref(blackout_regions);
+    g_object_unref(time_range);
+
+    return file;
+}
+
+/**
+ * gw_vcd_cache_read:
+ * @cache_path: The cache file path.
+ * @key: The key of the dump which should be loaded.
+ *
+ * Loads a #GwVcdFile from a cache written by gw_vcd_cache_write(). Missing, stale and
+ * corrupt caches are all treated as a cache miss.
+ *
+ * Returns: (transfer full) (nullable): The loaded file or %NULL.
+ */
+GwVcdFile *gw_vcd_cache_read(const gchar *cache_path, const GwVcdCacheKey *key)
+{
+    g_return_val_if_fail(cache_path != NULL, NULL);
+    g_return_val_if_fail(key != NULL, NULL);
+
+    GMappedFile *mapped = g_mapped_file_new(cache_path, FALSE, NULL);
+    if (mapped == NULL) {
+        return NULL;
+    }
+
+    CacheReader r = {0};
+    r.pos = (const guint8 *)g_mapped_file_get_contents(mapped);
+    r.end = r.pos + g_mapped_file_get_length(mapped);
+    r.scratch = g_string_new(NULL);
+
+    GwVcdFile *file = r.pos != NULL ? read_file(&r, key) : NULL;
+
+    g_string_free(r.scratch, TRUE);
+    g_mapped_file_unref(mapped);
+
+    return file;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "gw-vcd-file.h"
+
+typedef struct
+{
+    guint64 size;
+    gint64 mtime;
+    guint8 digest[32];
+    guint8 hierarchy_delimiter;
+    guint8 autocoalesce;
+    guint8 prepacked;
+} GwVcdCacheKey;
+
+gboolean gw_vcd_cache_key_init(GwVcdCacheKey *key, const gchar *dump_path);
+GPtrArray *gw_vcd_cache_get_paths(const gchar *dump_path);
+
+GwVcdFile *gw_vcd_cache_read(const gchar *cache_path, const GwVcdCacheKey *key);
+gboolean gw_vcd_cache_write(GwVcdFile *file,
+                            const gchar *cache_path,
+                            const GwVcdCacheKey *key,
+                            GError **error);
@@ -10,6 +10,10 @@ struct _GwVcdFile
     GwVlist *time_vlist;
     gboolean is_prepacked;
 
+    // Scaled times of all time_vlist entries, built on the first import.
+    GwTime *time_table;
+    guint time_table_size;
+
     GwTime start_time;
     GwTime end_time;
 
@@ -5,21 +5,250 @@
 
 G_DEFINE_TYPE(GwVcdFile, gw_vcd_file, GW_TYPE_DUMP_FILE)
 
-static void gw_vcd_file_import_trace(GwVcdFile *self, GwNode *np);
+static void gw_vcd_file_import_trace(GwVcdFile *self, GwHistEntFactory *factory, GwNode *np);
+static guint32 gw_vcd_file_import_vlist(GwVcdFile *self,
+                                        GwHistEntFactory *factory,
+                                        GwNode *np,
+                                        GwVlist *vlist);
+static void gw_vcd_file_evict_trace(GwDumpFile *dump_file, GwNode *np, gpointer lazy);
+
+// Imports are split across threads when at least this many traces are requested.
+#define PARALLEL_IMPORT_MIN_NODES 64
+#define PARALLEL_IMPORT_MAX_THREADS 16
+
+typedef struct
+{
+    GwNode *node;
+    GwVlist *vlist;
+    GwVlist *lazy_vlist; // copy of vlist kept for reimports after an eviction
+    guint32 width;
+} ImportTask;
+
+// Everything needed to import an evicted trace again.
+typedef struct
+{
+    GwVlist *vlist;
+    guint32 width; // values wider than one bit are stored as separately allocated vectors
+} LazyTrace;
+
+static void lazy_trace_free(LazyTrace *lazy)
+{
+    gw_vlist_destroy(lazy->vlist);
+    g_free(lazy);
+}
+
+typedef struct
+{
+    GwVcdFile *file;
+    GArray *tasks;
+    gint next_task;
+} ImportContext;
+
+typedef struct
+{
+    ImportContext *ctx;
+    GwHistEntFactory *factory;
+} ImportWorker;
+
+static gpointer import_worker(gpointer data)
+{
+    ImportWorker *worker = data;
+    ImportContext *ctx = worker->ctx;
+
+    // every trace only touches its own node and vlist, the time table is read only
+    for (;;) {
+        guint i = g_atomic_int_add(&ctx->next_task, 1);
+        if (i >= ctx->tasks->len) {
+            break;
+        }
+
+        ImportTask *task = &g_array_index(ctx->tasks, ImportTask, i);
+        task->width = gw_vcd_file_import_vlist(ctx->file, worker->factory, task->node, task->vlist);
+    }
+
+    return NULL;
+}
+
+static void gw_vcd_file_import_parallel(GwVcdFile *self, GArray *tasks, guint num_threads)
+{
+    ImportContext ctx = {.file = self, .tasks = tasks};
+    ImportWorker workers[PARALLEL_IMPORT_MAX_THREADS];
+    GThread *threads[PARALLEL_IMPORT_MAX_THREADS];
+
+    for (guint i = 0; i < num_threads; i++) {
+        workers[i].ctx = &ctx;
+        workers[i].factory = gw_hist_ent_factory_new();
+    }
+
+    for (guint i = 1; i < num_threads; i++) {
+        threads[i] = g_thread_new("gw-vcd-import", import_worker, &workers[i]);
+    }
+    import_worker(&workers[0]);
+    for (guint i = 1; i < num_threads; i++) {
+        g_thread_join(threads[i]);
+    }
+
+    // the history entries must live as long as the file
+    for (guint i = 0; i < num_threads; i++) {
+        gw_hist_ent_factory_merge(self->hist_ent_factory, workers[i].factory);
+        g_object_unref(workers[i].factory);
+    }
+}
+
+// Expands the time vlist into a contiguous array of scaled times, which is
+// shared by all trace imports. The vlist isn't needed afterwards.
+static void gw_vcd_file_build_time_table(GwVcdFile *self)
+{
+    if (self->time_table != NULL || self->time_vlist == NULL) {
+        return;
+    }
+
+    GwTime time_scale = gw_dump_file_get_time_scale(GW_DUMP_FILE(self));
+    guint size = gw_vlist_size(self->time_vlist);
+
+    self->time_table = g_new(GwTime, MAX(size, 1));
+    self->time_table_size = size;
+
+    for (guint i = 0; i < size; i++) {
+        GwTime *t = gw_vlist_locate(self->time_vlist, i);
+        self->time_table[i] = *t * time_scale;
+    }
+
+    g_clear_pointer(&self->time_vlist, gw_vlist_destroy);
+}
+
+static inline const GwTime *gw_vcd_file_lookup_time(GwVcdFile *self, guint time_idx)
+{
+    guint idx = time_idx ? time_idx - 1 : 0;
+
+    return idx < self->time_table_size ? &self->time_table[idx] : NULL;
+}
+
+static inline gboolean hist_ent_has_vector(GwHistEnt *h, guint32 width)
+{
+    if (h->flags & GW_HIST_ENT_FLAG_STRING) {
+        return TRUE;
+    }
+
+    return width > 1 && !(h->flags & GW_HIST_ENT_FLAG_REAL);
+}
+
+// Makes a freshly imported trace a candidate for eviction, see gw_dump_file_trim_memory().
+static void gw_vcd_file_track_trace(GwVcdFile *self, ImportTask *task)
+{
+    GwNode *np = task->node;
+
+    gsize size = sizeof(GwHistEnt);
+    gint count = 1;
+    for (GwHistEnt *h = np->head.next; h != NULL; h = h->next) {
+        size += sizeof(GwHistEnt);
+        if (hist_ent_has_vector(h, task->width) && h->v.h_vector != NULL) {
+            size += (h->flags & GW_HIST_ENT_FLAG_STRING)
+                        ? strlen(h->v.h_vector) + 1
+                        : gw_hist_ent_get_vector_size(h, task->width) + 1;
+        }
+        count++;
+    }
+    size += sizeof(GwHistEnt *) * count; /* harray */
+
+    LazyTrace *lazy = g_new(LazyTrace, 1);
+    lazy->vlist = g_steal_pointer(&task->lazy_vlist);
+    lazy->width = task->width;
+
+    // the copy of the vlist is held for as long as the trace is tracked
+    size += sizeof(LazyTrace) + gw_vlist_copy_size(lazy->vlist);
+
+    gw_dump_file_track_trace(GW_DUMP_FILE(self),
+                             np,
+                             size,
+                             lazy,
+                             (GDestroyNotify)lazy_trace_free);
+}
+
+static void gw_vcd_file_evict_trace(GwDumpFile *dump_file, GwNode *np, gpointer lazy)
+{
+    GwVcdFile *self = GW_VCD_FILE(dump_file);
+    LazyTrace *lazy_trace = lazy;
+
+    GwHistEnt *h = np->head.next;
+    while (h != NULL) {
+        GwHistEnt *next = h->next;
+
+        if (hist_ent_has_vector(h, lazy_trace->width)) {
+            g_free(h->v.h_vector);
+        }
+        gw_hist_ent_factory_free(self->hist_ent_factory, h);
+
+        h = next;
+    }
+
+    np->head.next = NULL;
+    np->curr = NULL;
+    g_clear_pointer(&np->harray, g_free);
+    np->numhist = 0;
+    np->mv.mvlfac_vlist = lazy_trace->vlist;
+
+    g_free(lazy_trace);
+}
 
 static gboolean gw_vcd_file_import_traces(GwDumpFile *dump_file, GwNode **nodes, GError **error)
 {
     GwVcdFile *self = GW_VCD_FILE(dump_file);
     (void)error;
 
+    gw_vcd_file_build_time_table(self);
+
+    gboolean evictable = gw_dump_file_get_memory_budget(dump_file) > 0;
+
+    // Take the vlists in request order, which also drops duplicate nodes. Aliases refer to
+    // another node's history and are resolved afterwards.
+    GArray *tasks = g_array_new(FALSE, FALSE, sizeof(ImportTask));
+    GPtrArray *aliases = g_ptr_array_new();
+
     for (GwNode **iter = nodes; *iter != NULL; iter++) {
         GwNode *node = *iter;
 
-        if (node->mv.mvlfac_vlist != NULL) {
-            gw_vcd_file_import_trace(self, node);
+        if (node->mv.mvlfac_vlist == NULL) {
+            continue;
+        }
+
+        if (node->curr != NULL) {
+            g_ptr_array_add(aliases, node);
+        } else {
+            ImportTask task = {node, g_steal_pointer(&node->mv.mvlfac_vlist), NULL, 0};
+            if (evictable) {
+                task.lazy_vlist = gw_vlist_copy(task.vlist);
+            }
+            g_array_append_val(tasks, task);
+        }
+    }
+
+    guint num_threads = MIN(g_get_num_processors(), PARALLEL_IMPORT_MAX_THREADS);
+    num_threads = MIN(num_threads, tasks->len / (PARALLEL_IMPORT_MIN_NODES / 2));
+
+    if (num_threads < 2) {
+        for (guint i = 0; i < tasks->len; i++) {
+            ImportTask *task = &g_array_index(tasks, ImportTask, i);
+            task->width =
+                gw_vcd_file_import_vlist(self, self->hist_ent_factory, task->node, task->vlist);
+        }
+    } else {
+        gw_vcd_file_import_parallel(self, tasks, num_threads);
+    }
+
+    if (evictable) {
+        for (guint i = 0; i < tasks->len; i++) {
+            gw_vcd_file_track_trace(self, &g_array_index(tasks, ImportTask, i));
         }
     }
 
+    for (guint i = 0; i < aliases->len; i++) {
+        gw_vcd_file_import_trace(self, self->hist_ent_factory, aliases->pdata[i]);
+    }
+
+    g_ptr_array_free(aliases, TRUE);
+    g_array_free(tasks, TRUE);
+
     return TRUE;
 }
 
@@ -32,14 +261,26 @@ static void gw_vcd_file_dispose(GObject *object)
     G_OBJECT_CLASS(gw_vcd_file_parent_class)->dispose(object);
 }
 
+static void gw_vcd_file_finalize(GObject *object)
+{
+    GwVcdFile *self = GW_VCD_FILE(object);
+
+    g_clear_pointer(&self->time_vlist, gw_vlist_destroy);
+    g_clear_pointer(&self->time_table, g_free);
+
+    G_OBJECT_CLASS(gw_vcd_file_parent_class)->finalize(object);
+}
+
 static void gw_vcd_file_class_init(GwVcdFileClass *klass)
 {
     GObjectClass *object_class = G_OBJECT_CLASS(klass);
     GwDumpFileClass *dump_file_class = GW_DUMP_FILE_CLASS(klass);
 
     object_class->dispose = gw_vcd_file_dispose;
+    object_class->finalize = gw_vcd_file_finalize;
 
     dump_file_class->import_traces = gw_vcd_file_import_traces;
+    dump_file_class->evict_trace = gw_vcd_file_evict_trace;
 }
 
 static void gw_vcd_file_init(GwVcdFile *self)
@@ -47,10 +288,14 @@ static void gw_vcd_file_init(GwVcdFile *self)
     self->hist_ent_factory = gw_hist_ent_factory_new();
 }
 
-static void add_histent_string(GwVcdFile *self, GwTime tim, GwNode *n, const char *str)
+static void add_histent_string(GwVcdFile *self,
+                               GwHistEntFactory *factory,
+                               GwTime tim,
+                               GwNode *n,
+                               const char *str)
 {
     if (!n->curr) {
-        GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+        GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
         he->flags = (GW_HIST_ENT_FLAG_STRING | GW_HIST_ENT_FLAG_REAL);
         he->time = -1;
         he->v.h_vector = NULL;
@@ -72,7 +317,7 @@ static void add_histent_string(GwVcdFile *self, GwTime tim, GwNode *n, const cha
             n->curr->flags |= GW_HIST_ENT_FLAG_GLITCH; /* set the glitch flag */
         }
     } else {
-        GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+        GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
         he->flags = (GW_HIST_ENT_FLAG_STRING | GW_HIST_ENT_FLAG_REAL);
         he->time = tim;
         he->v.h_vector = g_strdup(str);
@@ -82,10 +327,14 @@ static void add_histent_string(GwVcdFile *self, GwTime tim, GwNode *n, const cha
     }
 }
 
-static void add_histent_real(GwVcdFile *self, GwTime tim, GwNode *n, gdouble value)
+static void add_histent_real(GwVcdFile *self,
+                             GwHistEntFactory *factory,
+                             GwTime tim,
+                             GwNode *n,
+                             gdouble value)
 {
     if (!n->curr) {
-        GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+        GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
         he->flags = GW_HIST_ENT_FLAG_REAL;
         he->time = -1;
         he->v.h_double = strtod("NaN", NULL);
@@ -108,7 +357,7 @@ static void add_histent_real(GwVcdFile *self, GwTime tim, GwNode *n, gdouble val
                 n->curr->flags |= GW_HIST_ENT_FLAG_GLITCH; /* set the glitch flag */
             }
         } else {
-            GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+            GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
             he->flags = GW_HIST_ENT_FLAG_REAL;
             he->time = tim;
             he->v.h_double = value;
@@ -118,10 +367,15 @@ static void add_histent_real(GwVcdFile *self, GwTime tim, GwNode *n, gdouble val
     }
 }
 
-static void add_histent_vector(GwVcdFile *self, GwTime tim, GwNode *n, guint8 *vector, guint len)
+static void add_histent_vector(GwVcdFile *self,
+                               GwHistEntFactory *factory,
+                               GwTime tim,
+                               GwNode *n,
+                               const guint8 *bits,
+                               guint len)
 {
     if (!n->curr) {
-        GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+        GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
         he->time = -1;
         he->v.h_vector = NULL;
 
@@ -129,8 +383,12 @@ static void add_histent_vector(GwVcdFile *self, GwTime tim, GwNode *n, guint8 *v
         n->head.next = he;
     }
 
-    if ((n->curr->v.h_vector && vector && memcmp(n->curr->v.h_vector, vector, len) != 0) ||
-        (tim == self->start_time) || (!n->curr->v.h_vector) ||
+    // the vector is packed up front, so the comparison with the previous value can work on
+    // the packed bytes
+    GwHistEnt value = {0};
+    gw_hist_ent_set_vector(&value, bits, len);
+
+    if (!gw_hist_ent_vector_equal(n->curr, &value, len) || (tim == self->start_time) ||
         (self->preserve_glitches)) /* same region == go skip */
     {
         if (n->curr->time == tim) {
@@ -142,28 +400,34 @@ static void add_histent_vector(GwVcdFile *self, GwTime tim, GwNode *n, guint8 *v
             //              gw_bit_to_char(n->curr->v.h_val),
             //              ch));
             g_free(n->curr->v.h_vector);
-            n->curr->v.h_vector = vector; /* we have a glitch! */
+            n->curr->v.h_vector = value.v.h_vector; /* we have a glitch! */
+            n->curr->flags = (n->curr->flags & ~GW_HIST_ENT_FLAG_PACKED) | value.flags;
 
             if (!(n->curr->flags & GW_HIST_ENT_FLAG_GLITCH)) {
                 n->curr->flags |= GW_HIST_ENT_FLAG_GLITCH; /* set the glitch flag */
             }
         } else {
-            GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+            GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
             he->time = tim;
-            he->v.h_vector = vector;
+            he->v.h_vector = value.v.h_vector;
+            he->flags = value.flags;
 
             n->curr->next = he;
             n->curr = he;
         }
     } else {
-        g_free(vector);
+        g_free(value.v.h_vector);
     }
 }
 
-static void add_histent_scalar(GwVcdFile *self, GwTime tim, GwNode *n, GwBit bit)
+static void add_histent_scalar(GwVcdFile *self,
+                               GwHistEntFactory *factory,
+                               GwTime tim,
+                               GwNode *n,
+                               GwBit bit)
 {
     if (!n->curr) {
-        GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+        GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
         he->time = -1;
         he->v.h_val = GW_BIT_X;
 
@@ -189,7 +453,7 @@ static void add_histent_scalar(GwVcdFile *self, GwTime tim, GwNode *n, GwBit bit
                 n->curr->flags |= GW_HIST_ENT_FLAG_GLITCH; /* set the glitch flag */
             }
         } else {
-            GwHistEnt *he = gw_hist_ent_factory_alloc(self->hist_ent_factory);
+            GwHistEnt *he = gw_hist_ent_factory_alloc(factory);
             he->time = tim;
             he->v.h_val = bit;
 
@@ -202,9 +466,11 @@ static void add_histent_scalar(GwVcdFile *self, GwTime tim, GwNode *n, GwBit bit
     }
 }
 
-static void gw_vcd_file_import_trace_scalar(GwVcdFile *self, GwNode *np, GwVlistReader *reader)
+static void gw_vcd_file_import_trace_scalar(GwVcdFile *self,
+                                            GwHistEntFactory *factory,
+                                            GwNode *np,
+                                            GwVlistReader *reader)
 {
-    GwTime time_scale = gw_dump_file_get_time_scale(GW_DUMP_FILE(self));
     unsigned int time_idx = 0;
 
     static const GwBit EXTRA_VALUES[] =
@@ -225,41 +491,42 @@ static void gw_vcd_file_import_trace_scalar(GwVcdFile *self, GwNode *np, GwVlist
         }
         time_idx += delta;
 
-        GwTime *curtime_pnt = gw_vlist_locate(self->time_vlist, time_idx ? time_idx - 1 : 0);
+        const GwTime *curtime_pnt = gw_vcd_file_lookup_time(self, time_idx);
         if (!curtime_pnt) {
             g_error("malformed bitwise signal data for '%s' after time_idx = %d",
                     np->nname,
                     time_idx - delta);
         }
 
-        GwTime t = *curtime_pnt * time_scale;
-        add_histent_scalar(self, t, np, bit);
+        GwTime t = *curtime_pnt;
+        add_histent_scalar(self, factory, t, np, bit);
     }
 
-    add_histent_scalar(self, GW_TIME_MAX - 1, np, GW_BIT_X);
-    add_histent_scalar(self, GW_TIME_MAX, np, GW_BIT_Z);
+    add_histent_scalar(self, factory, GW_TIME_MAX - 1, np, GW_BIT_X);
+    add_histent_scalar(self, factory, GW_TIME_MAX, np, GW_BIT_Z);
 }
 
 static void gw_vcd_file_import_trace_vector(GwVcdFile *self,
+                                            GwHistEntFactory *factory,
                                             GwNode *np,
                                             GwVlistReader *reader,
                                             guint32 len)
 {
-    GwTime time_scale = gw_dump_file_get_time_scale(GW_DUMP_FILE(self));
     unsigned int time_idx = 0;
     guint8 *sbuf = g_malloc(len + 1);
+    guint8 *vector = g_malloc(len); /* sbuf extended to the full width */
 
     while (!gw_vlist_reader_is_done(reader)) {
         guint delta = gw_vlist_reader_read_uv32(reader);
         time_idx += delta;
 
-        GwTime *curtime_pnt = gw_vlist_locate(self->time_vlist, time_idx ? time_idx - 1 : 0);
+        const GwTime *curtime_pnt = gw_vcd_file_lookup_time(self, time_idx);
         if (!curtime_pnt) {
             g_error("malformed 'b' signal data for '%s' after time_idx = %d",
                     np->nname,
                     time_idx - delta);
         }
-        GwTime t = *curtime_pnt * time_scale;
+        GwTime t = *curtime_pnt;
 
         guint32 dst_len = 0;
         for (;;) {
@@ -287,9 +554,8 @@ static void gw_vcd_file_import_trace_vector(GwVcdFile *self,
         }
 
         if (len == 1) {
-            add_histent_scalar(self, t, np, sbuf[0]);
+            add_histent_scalar(self, factory, t, np, sbuf[0]);
         } else {
-            guint8 *vector = g_malloc(len + 1);
             if (dst_len < len) {
                 GwBit extend = (sbuf[0] == GW_BIT_1) ? GW_BIT_0 : sbuf[0];
                 memset(vector, extend, len - dst_len);
@@ -298,31 +564,30 @@ static void gw_vcd_file_import_trace_vector(GwVcdFile *self,
                 memcpy(vector, sbuf, len);
             }
 
-            vector[len] = 0;
-            add_histent_vector(self, t, np, vector, len);
+            add_histent_vector(self, factory, t, np, vector, len);
         }
     }
 
     if (len == 1) {
-        add_histent_scalar(self, GW_TIME_MAX - 1, np, GW_BIT_X);
-        add_histent_scalar(self, GW_TIME_MAX, np, GW_BIT_Z);
+        add_histent_scalar(self, factory, GW_TIME_MAX - 1, np, GW_BIT_X);
+        add_histent_scalar(self, factory, GW_TIME_MAX, np, GW_BIT_Z);
     } else {
-        guint8 *x = g_malloc0(len);
-        memset(x, GW_BIT_X, len);
-
-        guint8 *z = g_malloc0(len);
-        memset(z, GW_BIT_Z, len);
+        memset(vector, GW_BIT_X, len);
+        add_histent_vector(self, factory, GW_TIME_MAX - 1, np, vector, len);
 
-        add_histent_vector(self, GW_TIME_MAX - 1, np, x, len);
-        add_histent_vector(self, GW_TIME_MAX, np, z, len);
+        memset(vector, GW_BIT_Z, len);
+        add_histent_vector(self, factory, GW_TIME_MAX, np, vector, len);
     }
 
+    g_free(vector);
     g_free(sbuf);
 }
 
-static void gw_vcd_file_import_trace_real(GwVcdFile *self, GwNode *np, GwVlistReader *reader)
+static void gw_vcd_file_import_trace_real(GwVcdFile *self,
+                                          GwHistEntFactory *factory,
+                                          GwNode *np,
+                                          GwVlistReader *reader)
 {
-    GwTime time_scale = gw_dump_file_get_time_scale(GW_DUMP_FILE(self));
     unsigned int time_idx = 0;
 
     while (!gw_vlist_reader_is_done(reader)) {
@@ -331,64 +596,65 @@ static void gw_vcd_file_import_trace_real(GwVcdFile *self, GwNode *np, GwVlistRe
         delta = gw_vlist_reader_read_uv32(reader);
         time_idx += delta;
 
-        GwTime *curtime_pnt = gw_vlist_locate(self->time_vlist, time_idx ? time_idx - 1 : 0);
+        const GwTime *curtime_pnt = gw_vcd_file_lookup_time(self, time_idx);
         if (!curtime_pnt) {
             g_error("malformed 'r' signal data for '%s' after time_idx = %d\n",
                     np->nname,
                     time_idx - delta);
         }
-        GwTime t = *curtime_pnt * time_scale;
+        GwTime t = *curtime_pnt;
 
         const gchar *str = gw_vlist_reader_read_string(reader);
 
         gdouble value = 0.0;
         sscanf(str, "%lg", &value);
 
-        add_histent_real(self, t, np, value);
+        add_histent_real(self, factory, t, np, value);
     }
 
-    add_histent_real(self, GW_TIME_MAX - 1, np, 1.0);
-    add_histent_real(self, GW_TIME_MAX, np, 0.0);
+    add_histent_real(self, factory, GW_TIME_MAX - 1, np, 1.0);
+    add_histent_real(self, factory, GW_TIME_MAX, np, 0.0);
 }
 
-static void gw_vcd_file_import_trace_string(GwVcdFile *self, GwNode *np, GwVlistReader *reader)
+static void gw_vcd_file_import_trace_string(GwVcdFile *self,
+                                            GwHistEntFactory *factory,
+                                            GwNode *np,
+                                            GwVlistReader *reader)
 {
-    GwTime time_scale = gw_dump_file_get_time_scale(GW_DUMP_FILE(self));
     unsigned int time_idx = 0;
 
     while (!gw_vlist_reader_is_done(reader)) {
         unsigned int delta = gw_vlist_reader_read_uv32(reader);
         time_idx += delta;
 
-        GwTime *curtime_pnt = gw_vlist_locate(self->time_vlist, time_idx ? time_idx - 1 : 0);
+        const GwTime *curtime_pnt = gw_vcd_file_lookup_time(self, time_idx);
         if (!curtime_pnt) {
             g_error("malformed 's' signal data for '%s' after time_idx = %d",
                     np->nname,
                     time_idx - delta);
         }
-        GwTime t = *curtime_pnt * time_scale;
+        GwTime t = *curtime_pnt;
 
         const gchar *str = gw_vlist_reader_read_string(reader);
-        add_histent_string(self, t, np, str);
+        add_histent_string(self, factory, t, np, str);
     }
 
-    add_histent_string(self, GW_TIME_MAX - 1, np, "UNDEF");
-    add_histent_string(self, GW_TIME_MAX, np, "");
+    add_histent_string(self, factory, GW_TIME_MAX - 1, np, "UNDEF");
+    add_histent_string(self, factory, GW_TIME_MAX, np, "");
 }
 
-static void gw_vcd_file_import_trace(GwVcdFile *self, GwNode *np)
+// Returns the width of the imported values, values wider than one bit are stored as vectors.
+static guint32 gw_vcd_file_import_vlist(GwVcdFile *self,
+                                        GwHistEntFactory *factory,
+                                        GwNode *np,
+                                        GwVlist *vlist)
 {
     guint32 len = 1;
     guint32 vlist_type;
 
-    if (np->mv.mvlfac_vlist == NULL) {
-        return;
-    }
-
-    gw_vlist_uncompress(&np->mv.mvlfac_vlist);
+    gw_vlist_uncompress(&vlist);
 
-    GwVlistReader *reader =
-        gw_vlist_reader_new(g_steal_pointer(&np->mv.mvlfac_vlist), self->is_prepacked);
+    GwVlistReader *reader = gw_vlist_reader_new(vlist, self->is_prepacked);
 
     if (gw_vlist_reader_is_done(reader)) {
         len = 1;
@@ -427,13 +693,13 @@ static void gw_vcd_file_import_trace(GwVcdFile *self, GwNode *np)
     }
 
     if (vlist_type == '0') {
-        gw_vcd_file_import_trace_scalar(self, np, reader);
+        gw_vcd_file_import_trace_scalar(self, factory, np, reader);
     } else if (vlist_type == 'B') {
-        gw_vcd_file_import_trace_vector(self, np, reader, len);
+        gw_vcd_file_import_trace_vector(self, factory, np, reader, len);
     } else if (vlist_type == 'R') {
-        gw_vcd_file_import_trace_real(self, np, reader);
+        gw_vcd_file_import_trace_real(self, factory, np, reader);
     } else if (vlist_type == 'S') {
-        gw_vcd_file_import_trace_string(self, np, reader);
+        gw_vcd_file_import_trace_string(self, factory, np, reader);
     } else if (vlist_type == '!') /* error in loading */
     {
         GwNode *n2 = (GwNode *)np->curr;
@@ -441,17 +707,31 @@ static void gw_vcd_file_import_trace(GwVcdFile *self, GwNode *np)
         if ((n2) &&
             (n2 != np)) /* keep out any possible infinite recursion from corrupt pointer bugs */
         {
-            gw_vcd_file_import_trace(self, n2);
+            gw_vcd_file_import_trace(self, factory, n2);
+
+            // the alias shares the history, which therefore can't be evicted anymore
+            gw_dump_file_untrack_trace(GW_DUMP_FILE(self), n2);
 
             g_clear_object(&reader);
 
             np->head = n2->head;
             np->curr = n2->curr;
-            return;
+            return 1;
         }
 
         g_error("Error in decompressing vlist for '%s'", np->nname);
     }
 
     g_clear_object(&reader);
+
+    return vlist_type == 'B' ? len : 1;
+}
+
+static void gw_vcd_file_import_trace(GwVcdFile *self, GwHistEntFactory *factory, GwNode *np)
+{
+    if (np->mv.mvlfac_vlist == NULL) {
+        return;
+    }
+
+    gw_vcd_file_import_vlist(self, factory, np, g_steal_pointer(&np->mv.mvlfac_vlist));
 }
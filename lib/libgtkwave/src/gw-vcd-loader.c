@@ -1,6 +1,7 @@
 #include "gw-vcd-loader.h"
 #include "gw-vcd-file.h"
 #include "gw-vcd-file-private.h"
+#include "gw-vcd-cache.h"
 #include "gw-util.h"
 #include "gw-hash.h"
 #include "vcd-keywords.h"
@@ -67,6 +68,7 @@ struct _GwVcdLoader
     unsigned int time_vlist_count;
 
     off_t vcdbyteno;
+    guint64 value_change_count;
     char *vcdbuf;
     char *vst;
     char *vend;
@@ -120,12 +122,14 @@ struct _GwVcdLoader
 
     GwTreeNode *terminals_chain;
     GwTreeBuilder *tree_builder;
+    GStringChunk *symbol_names;
 
     char *module_tree;
     int module_len_tree;
 
     gboolean has_escaped_names;
     guint warning_filesize;
+    gboolean use_cache;
 };
 
 G_DEFINE_TYPE(GwVcdLoader, gw_vcd_loader, GW_TYPE_LOADER)
@@ -135,6 +139,7 @@ enum
     PROP_VLIST_PREPACK = 1,
     PROP_VLIST_COMPRESSION_LEVEL,
     PROP_WARNING_FILESIZE,
+    PROP_USE_CACHE,
     N_PROPERTIES,
 };
 
@@ -361,6 +366,10 @@ static void create_sorted_table(GwVcdLoader *self)
     struct vcdsymbol **pnt;
     unsigned int vcd_distance;
 
+    GwLoadStats *stats = gw_loader_get_stats(GW_LOADER(self));
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_HEADER);
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_VALUE_CHANGES);
+
     g_clear_pointer(&self->symbols_sorted, g_free);
     g_clear_pointer(&self->symbols_indexed, g_free);
 
@@ -401,7 +410,7 @@ static GwSymbol *symadd(GwVcdLoader *self, char *name, int hv)
 {
     GwSymbol *s = g_new0(GwSymbol, 1);
 
-    strcpy(s->name = g_malloc(strlen(name) + 1), name);
+    s->name = g_string_chunk_insert(self->symbol_names, name);
     s->sym_next = self->sym_hash[hv];
     self->sym_hash[hv] = s;
 
@@ -1807,6 +1816,7 @@ static void vcd_parse_string(GwVcdLoader *self)
             *tt = tim;
             self->time_vlist_count = 1;
         }
+        self->value_change_count++;
         parse_valuechange(self);
     }
 }
@@ -1935,6 +1945,9 @@ static void vcd_build_symbols(GwVcdLoader *self)
     //     int ss_len, longest = 0;
     // #endif
 
+    // only a parsed file needs the names, a cache hit brings its own
+    self->symbol_names = g_string_chunk_new(64 * 1024);
+
     gchar delimiter = gw_loader_get_hierarchy_delimiter(GW_LOADER(self));
 
     v = self->vcdsymroot;
@@ -2208,6 +2221,7 @@ static void vcd_cleanup(GwVcdLoader *self)
 static GwFacs *vcd_sortfacs(GwVcdLoader *self)
 {
     GwFacs *facs = gw_facs_new(self->numfacs);
+    gw_facs_take_names(facs, g_steal_pointer(&self->symbol_names));
 
     GSList *iter = self->sym_chain;
     for (guint i = 0; i < self->numfacs; i++) {
@@ -2442,10 +2456,68 @@ static void gw_vcd_loader_finalize(GObject *object)
     GwVcdLoader *self = GW_VCD_LOADER(object);
 
     g_free(self->sym_hash);
+    g_clear_pointer(&self->symbol_names, g_string_chunk_free);
 
     G_OBJECT_CLASS(gw_vcd_loader_parent_class)->finalize(object);
 }
 
+static gboolean vcd_cache_key_init(GwVcdLoader *self, GwVcdCacheKey *key, const gchar *fname)
+{
+    if (!self->use_cache || strcmp("-vcd", fname) == 0 || g_str_has_suffix(fname, ".gz") ||
+        g_str_has_suffix(fname, ".zip")) {
+        return FALSE;
+    }
+
+    if (!gw_vcd_cache_key_init(key, fname)) {
+        return FALSE;
+    }
+
+    key->hierarchy_delimiter = gw_loader_get_hierarchy_delimiter(GW_LOADER(self));
+    key->autocoalesce = gw_loader_is_autocoalesce(GW_LOADER(self));
+    key->prepacked = self->vlist_prepack;
+
+    return TRUE;
+}
+
+static GwVcdFile *vcd_cache_read(const gchar *fname, const GwVcdCacheKey *key)
+{
+    GPtrArray *paths = gw_vcd_cache_get_paths(fname);
+    GwVcdFile *file = NULL;
+
+    for (guint i = 0; i < paths->len && file == NULL; i++) {
+        const gchar *path = g_ptr_array_index(paths, i);
+
+        file = gw_vcd_cache_read(path, key);
+        if (file != NULL) {
+            fprintf(stderr, "VCDLOAD | Using cache '%s'.\n", path);
+        }
+    }
+
+    g_ptr_array_free(paths, TRUE);
+
+    return file;
+}
+
+static void vcd_cache_write(GwVcdFile *file, const gchar *fname, const GwVcdCacheKey *key)
+{
+    GPtrArray *paths = gw_vcd_cache_get_paths(fname);
+
+    for (guint i = 0; i < paths->len; i++) {
+        const gchar *path = g_ptr_array_index(paths, i);
+        GError *error = NULL;
+
+        if (gw_vcd_cache_write(file, path, key, &error)) {
+            fprintf(stderr, "VCDLOAD | Wrote cache '%s'.\n", path);
+            break;
+        }
+
+        fprintf(stderr, "VCDLOAD | %s\n", error->message);
+        g_error_free(error);
+    }
+
+    g_ptr_array_free(paths, TRUE);
+}
+
 static GwDumpFile *gw_vcd_loader_load(GwLoader *loader, const gchar *fname, GError **error)
 {
     g_return_val_if_fail(fname != NULL, NULL);
@@ -2455,6 +2527,27 @@ static GwDumpFile *gw_vcd_loader_load(GwLoader *loader, const gchar *fname, GErr
 
     errno = 0; /* reset in case it's set for some reason */
 
+    GwVcdCacheKey cache_key;
+    gboolean use_cache = vcd_cache_key_init(self, &cache_key, fname);
+    if (use_cache) {
+        GwLoadStats *stats = gw_loader_get_stats(loader);
+
+        gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_HEADER);
+        GwVcdFile *cached_file = vcd_cache_read(fname, &cache_key);
+        gw_load_stats_end_phase(stats, GW_LOAD_PHASE_HEADER);
+
+        if (cached_file != NULL) {
+            g_clear_object(&self->blackout_regions);
+            g_clear_object(&self->tree_builder);
+            g_clear_pointer(&self->yytext, g_free);
+
+            cached_file->preserve_glitches = gw_loader_is_preserve_glitches(loader);
+            cached_file->preserve_glitches_real = gw_loader_is_preserve_glitches_real(loader);
+
+            return GW_DUMP_FILE(cached_file);
+        }
+    }
+
     self->has_escaped_names = TRUE;
 
     if (g_str_has_suffix(fname, ".gz") || g_str_has_suffix(fname, ".zip")) {
@@ -2521,8 +2614,18 @@ static GwDumpFile *gw_vcd_loader_load(GwLoader *loader, const gchar *fname, GErr
 
     self->time_vlist = gw_vlist_create(sizeof(GwTime));
 
+    GwLoadStats *stats = gw_loader_get_stats(loader);
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_HEADER);
+
     GError *error_internal = NULL;
     vcd_parse(self, &error_internal);
+
+    // The header phase is still running if the file has no value changes.
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_HEADER);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_VALUE_CHANGES);
+    gw_load_stats_add_bytes(stats, self->vcdbyteno + (self->vend - self->vcdbuf));
+    gw_load_stats_add_transitions(stats, self->value_change_count);
+
     if (error_internal != NULL) {
         // TODO: cleanup memory
         g_propagate_error(error, error_internal);
@@ -2573,11 +2676,18 @@ static GwDumpFile *gw_vcd_loader_load(GwLoader *loader, const gchar *fname, GErr
         return NULL;
     }
 
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_SYMBOLS);
     vcd_build_symbols(self);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_SYMBOLS);
+
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_FACS_SORT);
     GwFacs *facs = vcd_sortfacs(self);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_FACS_SORT);
 
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_TREE);
     self->tree_root = gw_tree_builder_build(self->tree_builder);
     GwTree *tree = vcd_build_tree(self, facs);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_TREE);
 
     vcd_cleanup(self);
 
@@ -2616,6 +2726,10 @@ static GwDumpFile *gw_vcd_loader_load(GwLoader *loader, const gchar *fname, GErr
     g_object_unref(tree);
     g_object_unref(time_range);
 
+    if (use_cache) {
+        vcd_cache_write(dump_file, fname, &cache_key);
+    }
+
     return GW_DUMP_FILE(dump_file);
 }
 
@@ -2639,6 +2753,10 @@ static void gw_vcd_loader_set_property(GObject *object,
             gw_vcd_loader_set_warning_filesize(self, g_value_get_uint(value));
             break;
 
+        case PROP_USE_CACHE:
+            gw_vcd_loader_set_use_cache(self, g_value_get_boolean(value));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -2665,6 +2783,10 @@ static void gw_vcd_loader_get_property(GObject *object,
             g_value_set_uint(value, gw_vcd_loader_get_warning_filesize(self));
             break;
 
+        case PROP_USE_CACHE:
+            g_value_set_boolean(value, gw_vcd_loader_is_use_cache(self));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -2707,6 +2829,13 @@ static void gw_vcd_loader_class_init(GwVcdLoaderClass *klass)
                           0,
                           G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
 
+    properties[PROP_USE_CACHE] =
+        g_param_spec_boolean("use-cache",
+                             NULL,
+                             NULL,
+                             FALSE,
+                             G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
     g_object_class_install_properties(object_class, N_PROPERTIES, properties);
 }
 
@@ -2791,4 +2920,34 @@ guint gw_vcd_loader_get_warning_filesize(GwVcdLoader *self)
     g_return_val_if_fail(GW_IS_VCD_LOADER(self), FALSE);
 
     return self->warning_filesize;
-}
\ No newline at end of file
+}
+
+/**
+ * gw_vcd_loader_set_use_cache:
+ * @self: A #GwVcdLoader.
+ * @use_cache: Whether to use a cache.
+ *
+ * Enables the sidecar cache. If a cache that matches the VCD file exists it is loaded instead
+ * of parsing the VCD file, otherwise a new cache is written after the VCD file was parsed. The
+ * cache is stored next to the VCD file with a `.gwcache` suffix or, if that directory isn't
+ * writable, in the user cache directory. Compressed files and stdin are never cached.
+ */
+void gw_vcd_loader_set_use_cache(GwVcdLoader *self, gboolean use_cache)
+{
+    g_return_if_fail(GW_IS_VCD_LOADER(self));
+
+    use_cache = !!use_cache;
+
+    if (self->use_cache != use_cache) {
+        self->use_cache = use_cache;
+
+        g_object_notify_by_pspec(G_OBJECT(self), properties[PROP_USE_CACHE]);
+    }
+}
+
+gboolean gw_vcd_loader_is_use_cache(GwVcdLoader *self)
+{
+    g_return_val_if_fail(GW_IS_VCD_LOADER(self), FALSE);
+
+    return self->use_cache;
+}
@@ -16,5 +16,7 @@ void gw_vcd_loader_set_vlist_compression_level(GwVcdLoader *self, gint level);
 gint gw_vcd_loader_get_vlist_compression_level(GwVcdLoader *self);
 void gw_vcd_loader_set_warning_filesize(GwVcdLoader *self, guint warning_filesize);
 guint gw_vcd_loader_get_warning_filesize(GwVcdLoader *self);
+void gw_vcd_loader_set_use_cache(GwVcdLoader *self, gboolean use_cache);
+gboolean gw_vcd_loader_is_use_cache(GwVcdLoader *self);
 
 G_END_DECLS
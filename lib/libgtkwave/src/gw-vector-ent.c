@@ -0,0 +1,245 @@
+#include "gw-vector-ent.h"
+#include "gw-bit.h"
+#include <string.h>
+
+// The 2 bit encoding stores the GwBit value directly, which requires these to be the first four.
+G_STATIC_ASSERT(GW_BIT_0 == 0 && GW_BIT_X == 1 && GW_BIT_Z == 2 && GW_BIT_1 == 3);
+
+/**
+ * gw_vector_ent_choose_packing:
+ * @bits: The values, one GwBit per position.
+ * @nbits: The number of positions.
+ *
+ * Returns the most compact encoding which can represent @bits.
+ *
+ * Returns: %GW_VECTOR_ENT_FLAG_PACKED_1, %GW_VECTOR_ENT_FLAG_PACKED_2 or 0 if @bits need to be
+ * stored one byte per position.
+ */
+guint8 gw_vector_ent_choose_packing(const guint8 *bits, gsize nbits)
+{
+    g_return_val_if_fail(bits != NULL, 0);
+
+    if (nbits < GW_VECTOR_ENT_PACK_THRESHOLD) {
+        return 0;
+    }
+
+    guint8 packing = GW_VECTOR_ENT_FLAG_PACKED_1;
+    for (gsize i = 0; i < nbits; i++) {
+        switch (bits[i]) {
+            case GW_BIT_0:
+            case GW_BIT_1:
+                break;
+
+            case GW_BIT_X:
+            case GW_BIT_Z:
+                packing = GW_VECTOR_ENT_FLAG_PACKED_2;
+                break;
+
+            default:
+                return 0;
+        }
+    }
+
+    return packing;
+}
+
+/**
+ * gw_vector_ent_get_storage_size:
+ * @packing: The encoding returned by gw_vector_ent_choose_packing().
+ * @nbits: The number of positions.
+ *
+ * Returns: The number of bytes required for v[].
+ */
+gsize gw_vector_ent_get_storage_size(guint8 packing, gsize nbits)
+{
+    switch (packing) {
+        case GW_VECTOR_ENT_FLAG_PACKED_1:
+            return (nbits + 7) / 8;
+
+        case GW_VECTOR_ENT_FLAG_PACKED_2:
+            return (nbits + 3) / 4;
+
+        default:
+            return nbits;
+    }
+}
+
+/**
+ * gw_vector_ent_pack_bits:
+ * @dest: (out): Buffer for gw_vector_ent_get_storage_size() bytes.
+ * @packing: The encoding returned by gw_vector_ent_choose_packing().
+ * @bits: The values, one GwBit per position.
+ * @nbits: The number of positions.
+ *
+ * Stores @bits in @dest using the given encoding. Positions are stored MSB first and unused
+ * bits in the last byte are zero.
+ */
+void gw_vector_ent_pack_bits(guint8 *dest, guint8 packing, const guint8 *bits, gsize nbits)
+{
+    g_return_if_fail(dest != NULL);
+    g_return_if_fail(bits != NULL);
+
+    switch (packing) {
+        case GW_VECTOR_ENT_FLAG_PACKED_1:
+            memset(dest, 0, gw_vector_ent_get_storage_size(packing, nbits));
+            for (gsize i = 0; i < nbits; i++) {
+                if (bits[i] == GW_BIT_1) {
+                    dest[i >> 3] |= 0x80 >> (i & 7);
+                }
+            }
+            break;
+
+        case GW_VECTOR_ENT_FLAG_PACKED_2:
+            memset(dest, 0, gw_vector_ent_get_storage_size(packing, nbits));
+            for (gsize i = 0; i < nbits; i++) {
+                dest[i >> 2] |= (bits[i] & 3) << (6 - 2 * (i & 3));
+            }
+            break;
+
+        default:
+            memcpy(dest, bits, nbits);
+            break;
+    }
+}
+
+/**
+ * gw_vector_ent_unpack_bits:
+ * @src: The stored values.
+ * @packing: The encoding of @src.
+ * @bits: (out): Buffer for @count values.
+ * @offset: The first position to expand.
+ * @count: The number of positions to expand.
+ *
+ * Expands positions [@offset, @offset + @count) of @src to one GwBit per position. The packed
+ * layouts don't depend on the total width, so only the requested range is touched.
+ */
+void gw_vector_ent_unpack_bits(const guint8 *src,
+                               guint8 packing,
+                               guint8 *bits,
+                               gsize offset,
+                               gsize count)
+{
+    g_return_if_fail(src != NULL);
+    g_return_if_fail(bits != NULL);
+
+    if (packing & GW_VECTOR_ENT_FLAG_PACKED_1) {
+        for (gsize i = 0; i < count; i++) {
+            gsize pos = offset + i;
+            bits[i] = (src[pos >> 3] & (0x80 >> (pos & 7))) ? GW_BIT_1 : GW_BIT_0;
+        }
+    } else if (packing & GW_VECTOR_ENT_FLAG_PACKED_2) {
+        for (gsize i = 0; i < count; i++) {
+            gsize pos = offset + i;
+            bits[i] = (src[pos >> 2] >> (6 - 2 * (pos & 3))) & 3;
+        }
+    } else {
+        memcpy(bits, src + offset, count);
+    }
+}
+
+/**
+ * gw_vector_ent_pack:
+ * @self: A GwVectorEnt with at least gw_vector_ent_get_storage_size() bytes in v[].
+ * @packing: The encoding returned by gw_vector_ent_choose_packing().
+ * @bits: The values, one GwBit per position.
+ * @nbits: The number of positions.
+ *
+ * Stores @bits in @self using the given encoding, see gw_vector_ent_pack_bits().
+ */
+void gw_vector_ent_pack(GwVectorEnt *self, guint8 packing, const guint8 *bits, gsize nbits)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(bits != NULL);
+
+    self->flags = (self->flags & ~GW_VECTOR_ENT_FLAG_PACKED) | packing;
+    gw_vector_ent_pack_bits(self->v, packing, bits, nbits);
+}
+
+/**
+ * gw_vector_ent_unpack:
+ * @self: A GwVectorEnt.
+ * @bits: (out): Buffer for @nbits values.
+ * @nbits: The number of positions.
+ *
+ * Expands the values of @self to one GwBit per position.
+ */
+void gw_vector_ent_unpack(const GwVectorEnt *self, guint8 *bits, gsize nbits)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(bits != NULL);
+
+    gw_vector_ent_unpack_bits(self->v, self->flags & GW_VECTOR_ENT_FLAG_PACKED, bits, 0, nbits);
+}
+
+/**
+ * gw_vector_ent_get_bits:
+ * @self: A GwVectorEnt.
+ * @nbits: The number of positions.
+ * @storage: (out): Set to a newly allocated buffer if @self needs to be unpacked, otherwise
+ * left unchanged. Free with g_free().
+ *
+ * Returns: The values of @self, one GwBit per position.
+ */
+const guint8 *gw_vector_ent_get_bits(const GwVectorEnt *self, gsize nbits, guint8 **storage)
+{
+    g_return_val_if_fail(self != NULL, NULL);
+    g_return_val_if_fail(storage != NULL, NULL);
+
+    if (!(self->flags & GW_VECTOR_ENT_FLAG_PACKED)) {
+        return self->v;
+    }
+
+    *storage = g_malloc(nbits + 1);
+    gw_vector_ent_unpack(self, *storage, nbits);
+    (*storage)[nbits] = 0;
+
+    return *storage;
+}
+
+/**
+ * gw_vector_ent_get_packed_word:
+ * @self: A GwVectorEnt using %GW_VECTOR_ENT_FLAG_PACKED_1.
+ * @nbits: The number of positions.
+ * @offset: The first position, may be negative.
+ * @count: The number of positions, at most 64.
+ *
+ * Reads @count positions starting at @offset as an unsigned integer with the first position
+ * as its MSB. Positions outside of [0, @nbits) read as 0.
+ *
+ * Returns: The value.
+ */
+guint64 gw_vector_ent_get_packed_word(const GwVectorEnt *self,
+                                      gsize nbits,
+                                      gssize offset,
+                                      guint count)
+{
+    g_return_val_if_fail(self != NULL, 0);
+    g_return_val_if_fail(self->flags & GW_VECTOR_ENT_FLAG_PACKED_1, 0);
+    g_return_val_if_fail(count <= 64, 0);
+
+    guint64 value = 0;
+    gssize end = offset + count;
+    gssize pos = offset;
+
+    while (pos < end) {
+        guint take;
+        guint chunk = 0;
+
+        if (pos < 0) {
+            take = MIN(end, 0) - pos;
+        } else if (pos >= (gssize)nbits) {
+            take = end - pos;
+        } else {
+            guint bit = pos & 7;
+
+            take = MIN(8 - bit, (guint)(end - pos));
+            take = MIN(take, (guint)(nbits - pos));
+            chunk = (self->v[pos >> 3] >> (8 - bit - take)) & ((1u << take) - 1);
+        }
+
+        value = (take >= 64) ? chunk : ((value << take) | chunk);
+        pos += take;
+    }
+
+    return value;
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <glib.h>
 #include "gw-types.h"
 #include "gw-time.h"
 
+G_BEGIN_DECLS
+
 #ifdef WAVE_USE_STRUCT_PACKING
 #pragma pack(push)
 #pragma pack(1)
@@ -12,10 +15,42 @@ struct _GwVectorEnt
 {
     GwTime time;
     GwVectorEnt *next;
-    unsigned char flags; /* so far only set on strings */
+    unsigned char flags; /* string or packed encoding of v[] */
     unsigned char v[]; /* C99 */
 };
 
 #ifdef WAVE_USE_STRUCT_PACKING
 #pragma pack(pop)
 #endif
+
+// Shares the flags field with GW_HIST_ENT_FLAG_STRING, GwHistEnt uses the same values for its
+// packed vectors.
+typedef enum
+{
+    GW_VECTOR_ENT_FLAG_PACKED_1 = 1 << 3, /* v[] holds 1 bit per position, 0/1 only */
+    GW_VECTOR_ENT_FLAG_PACKED_2 = 1 << 4, /* v[] holds 2 bits per position, 0/X/Z/1 only */
+} GwVectorEntFlag;
+
+#define GW_VECTOR_ENT_FLAG_PACKED (GW_VECTOR_ENT_FLAG_PACKED_1 | GW_VECTOR_ENT_FLAG_PACKED_2)
+
+// Narrower vectors are kept at one byte per position, as decoding them is not worth the few
+// bytes saved.
+#define GW_VECTOR_ENT_PACK_THRESHOLD 16
+
+guint8 gw_vector_ent_choose_packing(const guint8 *bits, gsize nbits);
+gsize gw_vector_ent_get_storage_size(guint8 packing, gsize nbits);
+void gw_vector_ent_pack_bits(guint8 *dest, guint8 packing, const guint8 *bits, gsize nbits);
+void gw_vector_ent_unpack_bits(const guint8 *src,
+                               guint8 packing,
+                               guint8 *bits,
+                               gsize offset,
+                               gsize count);
+void gw_vector_ent_pack(GwVectorEnt *self, guint8 packing, const guint8 *bits, gsize nbits);
+void gw_vector_ent_unpack(const GwVectorEnt *self, guint8 *bits, gsize nbits);
+const guint8 *gw_vector_ent_get_bits(const GwVectorEnt *self, gsize nbits, guint8 **storage);
+guint64 gw_vector_ent_get_packed_word(const GwVectorEnt *self,
+                                      gsize nbits,
+                                      gssize offset,
+                                      guint count);
+
+G_END_DECLS
@@ -10,6 +10,7 @@ struct _GwVlistReader
 
     GwVlist *vlist;
     guint8 *depacked;
+    const guint8 *data;
     gboolean prepacked;
 
     guint position;
@@ -51,6 +52,11 @@ static void gw_vlist_reader_constructed(GObject *object)
         g_clear_pointer(&self->vlist, gw_vlist_destroy);
     } else {
         self->size = gw_vlist_size(self->vlist);
+
+        /* frozen and uncompressed vlists consist of a single block, which can be read directly */
+        if (self->vlist->next == NULL && (gint)self->vlist->offset >= 0) {
+            self->data = (const guint8 *)(self->vlist + 1) + (self->vlist->size - 1);
+        }
     }
 }
 
@@ -126,8 +132,10 @@ gint gw_vlist_reader_next(GwVlistReader *self)
     guint8 value = 0;
     if (self->depacked != NULL) {
         value = self->depacked[self->position];
+    } else if (self->data != NULL) {
+        value = self->data[self->position];
     } else {
-        value = *(guint *)gw_vlist_locate(self->vlist, self->position);
+        value = *(guint8 *)gw_vlist_locate(self->vlist, self->position);
     }
 
     self->position++;
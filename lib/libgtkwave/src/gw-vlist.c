@@ -1,5 +1,6 @@
 #include "gw-vlist.h"
 #include <zlib.h>
+#include <string.h>
 
 /* create / destroy */
 GwVlist *gw_vlist_create(unsigned int element_size)
@@ -20,6 +21,48 @@ void gw_vlist_destroy(GwVlist *self)
     }
 }
 
+/* bytes in use after the header of one block, compressed blocks start with their length */
+static gsize gw_vlist_block_used(GwVlist *v)
+{
+    if ((int)v->offset < 0) {
+        return sizeof(int) + *(unsigned int *)(v + 1);
+    }
+
+    return (gsize)v->offset * v->element_size;
+}
+
+/* duplicates a vlist, only the used part of every block is copied */
+GwVlist *gw_vlist_copy(GwVlist *self)
+{
+    GwVlist *copy = NULL;
+    GwVlist **tail = &copy;
+
+    for (; self != NULL; self = self->next) {
+        gsize len = gw_vlist_block_used(self);
+
+        GwVlist *v = g_malloc(sizeof(GwVlist) + len);
+        memcpy(v, self, sizeof(GwVlist) + len);
+        v->next = NULL;
+
+        *tail = v;
+        tail = &v->next;
+    }
+
+    return copy;
+}
+
+/* size of a gw_vlist_copy() of the vlist */
+gsize gw_vlist_copy_size(GwVlist *self)
+{
+    gsize size = 0;
+
+    for (; self != NULL; self = self->next) {
+        size += sizeof(GwVlist) + gw_vlist_block_used(self);
+    }
+
+    return size;
+}
+
 /* realtime compression/decompression of bytewise vlists
  * this can obviously be extended if elem_siz > 1, but
  * the viewer doesn't need that feature
@@ -60,46 +103,103 @@ static GwVlist *gw_vlist_compress_block(GwVlist *v, guint *rsize, gint compressi
     return (v);
 }
 
+static gboolean gw_vlist_is_compressed(GwVlist *v)
+{
+    for (; v != NULL; v = v->next) {
+        if ((int)v->offset < 0) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/* copies all blocks into a single block.  the block has size 1 and the
+ * element count as offset, which makes vlist_locate() a plain array access
+ * and allows readers to walk the elements with a pointer.
+ */
+static GwVlist *gw_vlist_coalesce(GwVlist *v)
+{
+    if (v->next == NULL) {
+        return v;
+    }
+
+    guint count = gw_vlist_size(v);
+    guint element_size = v->element_size;
+    GwVlist *c = g_malloc(sizeof(GwVlist) + (count * element_size));
+    c->next = NULL;
+    c->size = 1;
+    c->offset = count;
+    c->element_size = element_size;
+
+    /* a block of size n holds the elements starting at index n-1 */
+    char *data = (char *)(c + 1);
+    while (v != NULL) {
+        GwVlist *vt = v->next;
+        memcpy(data + ((v->size - 1) * element_size), v + 1, v->offset * element_size);
+        g_free(v);
+        v = vt;
+    }
+
+    return c;
+}
+
+/* decompresses all blocks and coalesces them into a single block, see
+ * vlist_coalesce().
+ */
 void gw_vlist_uncompress(GwVlist **v)
 {
     GwVlist *vl = *v;
-    GwVlist *vprev = NULL;
 
+    if (!gw_vlist_is_compressed(vl)) {
+        *v = gw_vlist_coalesce(vl);
+        return;
+    }
+
+    /* compressed vlists always have an element size of 1 */
+    guint count = vl->size - 1 + (((int)vl->offset < 0) ? -(int)vl->offset : vl->offset);
+    GwVlist *c = g_malloc(sizeof(GwVlist) + count);
+    c->next = NULL;
+    c->size = 1;
+    c->offset = count;
+    c->element_size = 1;
+
+    unsigned char *data = (unsigned char *)(c + 1);
     while (vl != NULL) {
+        GwVlist *vt = vl->next;
+        unsigned char *dst = data + (vl->size - 1);
+
         if ((int)vl->offset < 0) {
-            GwVlist *vz = g_malloc(sizeof(GwVlist) + vl->size);
-            unsigned int *ipnt;
-            unsigned long sourcelen, destlen;
+            unsigned int used = (unsigned int)(-(int)vl->offset);
+            unsigned int *ipnt = (unsigned int *)(vl + 1);
+            unsigned long sourcelen = (unsigned long)ipnt[0];
+            unsigned long destlen = (unsigned long)vl->size;
+            unsigned char *tmp = NULL;
             int rc;
 
-            memcpy(vz, vl, sizeof(GwVlist));
-            vz->offset = (unsigned int)(-(int)vl->offset);
-
-            ipnt = (unsigned int *)(vl + 1);
-            sourcelen = (unsigned long)ipnt[0];
-            destlen = (unsigned long)vl->size;
+            /* the whole block was compressed, even if only part of it is used */
+            if (used < vl->size) {
+                tmp = g_malloc(vl->size);
+            }
 
-            rc = uncompress((unsigned char *)(vz + 1),
-                            &destlen,
-                            (unsigned char *)&ipnt[1],
-                            sourcelen);
+            rc = uncompress(tmp != NULL ? tmp : dst, &destlen, (unsigned char *)&ipnt[1], sourcelen);
             if (rc != Z_OK) {
                 g_error("Error in vlist uncompress(), rc=%d/destlen=%d exiting!", rc, (int)destlen);
             }
 
-            g_free(vl);
-            vl = vz;
-
-            if (vprev) {
-                vprev->next = vz;
-            } else {
-                *v = vz;
+            if (tmp != NULL) {
+                memcpy(dst, tmp, used);
+                g_free(tmp);
             }
+        } else {
+            memcpy(dst, vl + 1, vl->offset);
         }
 
-        vprev = vl;
-        vl = vl->next;
+        g_free(vl);
+        vl = vt;
     }
+
+    *v = c;
 }
 
 /* get pointer to one unit of space
@@ -170,7 +270,9 @@ void *gw_vlist_locate(GwVlist *self, unsigned int idx)
 }
 
 /* calling this if you don't plan on adding any more elements will free
-   up unused space as well as compress final blocks (if enabled)
+   up unused space as well as compress final blocks (if enabled).  vlists
+   which end up uncompressed are coalesced into a single block, see
+   vlist_coalesce().  no elements may be added after freezing.
  */
 void gw_vlist_freeze(GwVlist **v, gint compression_level)
 {
@@ -199,4 +301,8 @@ void gw_vlist_freeze(GwVlist **v, gint compression_level)
         g_free(vl);
         *v = w;
     }
+
+    if (!gw_vlist_is_compressed(*v)) {
+        *v = gw_vlist_coalesce(*v);
+    }
 }
@@ -14,6 +14,8 @@ struct _GwVlist
 
 GwVlist *gw_vlist_create(guint elem_siz);
 void gw_vlist_destroy(GwVlist *v);
+GwVlist *gw_vlist_copy(GwVlist *v);
+gsize gw_vlist_copy_size(GwVlist *v);
 void *gw_vlist_alloc(GwVlist **v, gboolean compressable, gint compression_level);
 guint gw_vlist_size(GwVlist *v);
 void *gw_vlist_locate(GwVlist *v, guint idx);
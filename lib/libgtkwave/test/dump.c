@@ -114,10 +114,13 @@ static void dump_node(GwDumpFile *file, GwNode *node)
             if (iter->time < 0) {
                 g_print("?");
             } else {
-                gint bits = ABS(node->msi - node->lsi) + 1;
-                for (gint i = 0; i < bits; i++) {
-                    g_print("%c", gw_bit_to_char(iter->v.h_vector[i]));
+                gint nbits = ABS(node->msi - node->lsi) + 1;
+                guint8 *unpacked = NULL;
+                const guint8 *bits = gw_hist_ent_get_bits(iter, nbits, &unpacked);
+                for (gint i = 0; i < nbits; i++) {
+                    g_print("%c", gw_bit_to_char(bits[i]));
                 }
+                g_free(unpacked);
             }
         }
         g_print(" @ %" GW_TIME_FORMAT "\n", iter->time);
@@ -77,6 +77,262 @@ static void test_find_symbols(void)
     g_object_unref(file);
 }
 
+static GwDumpFile *load_basic(GwLoader *loader, const gchar *filename)
+{
+    GwDumpFile *file = gw_loader_load(loader, filename, NULL);
+    g_assert_nonnull(file);
+    g_object_unref(loader);
+
+    return file;
+}
+
+static void lookup_basic_nodes(GwDumpFile *file, GwNode **nodes)
+{
+    GwSymbol *bit = gw_dump_file_lookup_symbol(file, "variables.bit");
+    GwSymbol *one_transition = gw_dump_file_lookup_symbol(file, "variables.one_transition");
+    g_assert_nonnull(bit);
+    g_assert_nonnull(one_transition);
+
+    nodes[0] = bit->n;
+    nodes[1] = one_transition->n;
+    nodes[2] = NULL;
+}
+
+static void check_values_at(GwDumpFile *file)
+{
+    GwNode *nodes[3];
+    GwHistEnt *values[2];
+    GError *error = NULL;
+
+    lookup_basic_nodes(file, nodes);
+
+    g_assert_true(gw_dump_file_get_values_at(file, nodes, 3, values, &error));
+    g_assert_no_error(error);
+    g_assert_cmpint(values[0]->time, ==, 3);
+    g_assert_cmpint(values[0]->v.h_val, ==, GW_BIT_1);
+    g_assert_cmpint(values[1]->time, ==, -1);
+    g_assert_cmpint(values[1]->v.h_val, ==, GW_BIT_X);
+
+    // Nodes are only imported once, later lookups reuse the history.
+
+    g_assert_true(gw_dump_file_get_values_at(file, nodes, 4, values, &error));
+    g_assert_no_error(error);
+    g_assert_cmpint(values[0]->time, ==, 4);
+    g_assert_cmpint(values[0]->v.h_val, ==, GW_BIT_H);
+    g_assert_cmpint(values[1]->time, ==, 4);
+    g_assert_cmpint(values[1]->v.h_val, ==, GW_BIT_0);
+}
+
+typedef struct
+{
+    GwNode **nodes;
+    GString *log;
+    guint limit;
+} ChangeLog;
+
+static gboolean log_change(GwNode *node, GwHistEnt *hist_ent, gpointer user_data)
+{
+    ChangeLog *log = user_data;
+
+    g_string_append_printf(log->log,
+                           "%c@%" GW_TIME_FORMAT " ",
+                           node == log->nodes[0] ? 'b' : 'o',
+                           hist_ent->time);
+
+    return --log->limit > 0;
+}
+
+static void check_iter_changes(GwDumpFile *file)
+{
+    GwNode *nodes[3];
+    ChangeLog log = {nodes, g_string_new(NULL), G_MAXUINT};
+    GError *error = NULL;
+
+    lookup_basic_nodes(file, nodes);
+
+    // The values in effect at the start time come first, followed by all transitions in time
+    // order.
+
+    g_assert_true(gw_dump_file_iter_changes(file, nodes, 3, 5, log_change, &log, &error));
+    g_assert_no_error(error);
+    g_assert_cmpstr(log.log->str, ==, "b@3 o@-1 b@4 o@4 b@5 ");
+
+    // The end of history markers are never reported.
+
+    g_string_truncate(log.log, 0);
+    g_assert_true(gw_dump_file_iter_changes(file, nodes, 8, GW_TIME_MAX, log_change, &log, &error));
+    g_assert_no_error(error);
+    g_assert_cmpstr(log.log->str, ==, "b@8 o@4 ");
+
+    // The callback can stop the iteration.
+
+    g_string_truncate(log.log, 0);
+    log.limit = 3;
+    g_assert_true(gw_dump_file_iter_changes(file, nodes, 0, 9, log_change, &log, &error));
+    g_assert_no_error(error);
+    g_assert_cmpstr(log.log->str, ==, "b@0 o@-1 b@1 ");
+
+    g_string_free(log.log, TRUE);
+}
+
+static void test_values_at_vcd(void)
+{
+    GwDumpFile *file = load_basic(gw_vcd_loader_new(), "files/basic.vcd");
+
+    check_values_at(file);
+    check_iter_changes(file);
+
+    g_object_unref(file);
+}
+
+static void test_values_at_fst(void)
+{
+    GwDumpFile *file = load_basic(gw_fst_loader_new(), "files/basic.fst");
+
+    check_values_at(file);
+    check_iter_changes(file);
+
+    g_object_unref(file);
+}
+
+static void lookup_nodes(GwDumpFile *file, const gchar **names, GwNode **nodes)
+{
+    for (; *names != NULL; names++, nodes++) {
+        GwSymbol *symbol = gw_dump_file_lookup_symbol(file, *names);
+        g_assert_nonnull(symbol);
+
+        *nodes = symbol->n;
+    }
+    *nodes = NULL;
+}
+
+static gchar *history_to_string(GwNode *node, gboolean is_vector)
+{
+    GString *str = g_string_new(NULL);
+
+    for (GwHistEnt *h = node->head.next; h != NULL; h = h->next) {
+        g_string_append_printf(str, "%" GW_TIME_FORMAT ":", h->time);
+
+        if (h->flags & GW_HIST_ENT_FLAG_STRING) {
+            g_string_append(str, h->v.h_vector != NULL ? h->v.h_vector : "(null)");
+        } else if (h->flags & GW_HIST_ENT_FLAG_REAL) {
+            g_string_append_printf(str, "%g", h->v.h_double);
+        } else if (is_vector) {
+            guint8 *unpacked = NULL;
+            const guint8 *bits = gw_hist_ent_get_bits(h, 8, &unpacked);
+            for (gint i = 0; i < 8 && bits != NULL; i++) {
+                g_string_append_c(str, gw_bit_to_char(bits[i]));
+            }
+            g_free(unpacked);
+        } else {
+            g_string_append_c(str, gw_bit_to_char(h->v.h_val));
+        }
+        g_string_append_c(str, ' ');
+    }
+
+    return g_string_free(str, FALSE);
+}
+
+static gboolean is_first_node(GwNode *node, gpointer user_data)
+{
+    GwNode **nodes = user_data;
+
+    return node == nodes[0];
+}
+
+static void check_eviction(GwDumpFile *file)
+{
+    static const gchar *NAMES[] = {
+        "variables.bit",
+        "variables.vector",
+        "variables.real",
+        "variables.string",
+        NULL,
+    };
+    GwNode *nodes[5];
+    gchar *histories[4];
+    GError *error = NULL;
+
+    lookup_nodes(file, NAMES, nodes);
+
+    // Traces are only tracked while a budget is set.
+
+    gw_dump_file_set_memory_budget(file, 1);
+    g_assert_cmpuint(gw_dump_file_get_memory_budget(file), ==, 1);
+    g_assert_cmpuint(gw_dump_file_get_memory_usage(file), ==, 0);
+
+    g_assert_true(gw_dump_file_import_traces(file, nodes, &error));
+    g_assert_no_error(error);
+    g_assert_cmpuint(gw_dump_file_get_memory_usage(file), >, 0);
+
+    for (gint i = 0; i < 4; i++) {
+        gw_node_build_harray(nodes[i]);
+        histories[i] = history_to_string(nodes[i], i == 1);
+    }
+
+    // Nodes which are in use are kept, the others return to their state before the import.
+
+    g_assert_cmpuint(gw_dump_file_trim_memory(file, is_first_node, nodes), ==, 3);
+    g_assert_null(nodes[0]->mv.mvlfac);
+    for (gint i = 1; i < 4; i++) {
+        g_assert_nonnull(nodes[i]->mv.mvlfac);
+        g_assert_null(nodes[i]->harray);
+    }
+
+    // Evicted nodes are imported again when they are requested.
+
+    g_assert_true(gw_dump_file_import_traces(file, nodes, &error));
+    g_assert_no_error(error);
+    for (gint i = 0; i < 4; i++) {
+        g_assert_null(nodes[i]->mv.mvlfac);
+
+        gchar *history = history_to_string(nodes[i], i == 1);
+        g_assert_cmpstr(history, ==, histories[i]);
+        g_free(history);
+    }
+
+    g_assert_cmpuint(gw_dump_file_trim_memory(file, NULL, NULL), ==, 4);
+    g_assert_cmpuint(gw_dump_file_get_memory_usage(file), ==, 0);
+
+    // Histories which are shared with an alias are never evicted.
+
+    static const gchar *ALIAS_NAMES[] = {"variables.vector", "aliases.vector_alias", NULL};
+    GwNode *aliases[3];
+
+    lookup_nodes(file, ALIAS_NAMES, aliases);
+
+    g_assert_true(gw_dump_file_import_traces(file, aliases, &error));
+    g_assert_no_error(error);
+    g_assert_cmpuint(gw_dump_file_trim_memory(file, NULL, NULL), ==, 0);
+    g_assert_null(aliases[0]->mv.mvlfac);
+
+    gchar *history = history_to_string(aliases[1], TRUE);
+    g_assert_cmpstr(history, ==, histories[1]);
+    g_free(history);
+
+    for (gint i = 0; i < 4; i++) {
+        g_free(histories[i]);
+    }
+}
+
+static void test_eviction_vcd(void)
+{
+    GwDumpFile *file = load_basic(gw_vcd_loader_new(), "files/basic.vcd");
+
+    check_eviction(file);
+
+    g_object_unref(file);
+}
+
+static void test_eviction_fst(void)
+{
+    GwDumpFile *file = load_basic(gw_fst_loader_new(), "files/basic.fst");
+
+    check_eviction(file);
+
+    g_object_unref(file);
+}
+
 int main(int argc, char *argv[])
 {
     g_test_init(&argc, &argv, NULL);
@@ -84,6 +340,10 @@ int main(int argc, char *argv[])
     g_test_add_func("/dump_file/blackout_regions", test_blackout_regions);
     g_test_add_func("/dump_file/stems", test_stems);
     g_test_add_func("/dump_file/find_symbols", test_find_symbols);
+    g_test_add_func("/dump_file/values_at_vcd", test_values_at_vcd);
+    g_test_add_func("/dump_file/values_at_fst", test_values_at_fst);
+    g_test_add_func("/dump_file/eviction_vcd", test_eviction_vcd);
+    g_test_add_func("/dump_file/eviction_fst", test_eviction_fst);
 
     return g_test_run();
 }
\ No newline at end of file
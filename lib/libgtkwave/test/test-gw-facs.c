@@ -1,4 +1,6 @@
 #include <gtkwave.h>
+#include "gw-facs-private.h"
+#include "gw-util.h"
 
 // TODO: replace with gw_tree_node_new or similar
 static GwTreeNode *alloc_node(const gchar *name, gint which)
@@ -64,12 +66,100 @@ static void test_sort()
     g_assert_cmpstr(gw_facs_get(facs, 4)->name, ==, "c");
 }
 
+static gint compare_symbols(gconstpointer v1, gconstpointer v2)
+{
+    const GwSymbol *s1 = *(const GwSymbol **)v1;
+    const GwSymbol *s2 = *(const GwSymbol **)v2;
+
+    return gw_signal_name_compare(s1->name, s2->name);
+}
+
+static void test_sort_parallel(void)
+{
+    const guint count = 20000;
+    const guint runs[] = {2, 3, 16};
+
+    // Numeric suffixes exercise the natural ordering, the small ranges produce duplicate names
+    // which check that the merge is stable.
+    GRand *rand = g_rand_new_with_seed(42);
+    GwSymbol *symbols = g_new0(GwSymbol, count);
+    for (guint i = 0; i < count; i++) {
+        symbols[i].name = g_strdup_printf("top.u%d.sig%d[%d]",
+                                          g_rand_int_range(rand, 0, 100),
+                                          g_rand_int_range(rand, 0, 50),
+                                          g_rand_int_range(rand, 0, 20));
+    }
+    g_rand_free(rand);
+
+    GPtrArray *expected = g_ptr_array_new();
+    for (guint i = 0; i < count; i++) {
+        g_ptr_array_add(expected, &symbols[i]);
+    }
+    g_ptr_array_sort(expected, compare_symbols);
+
+    for (guint r = 0; r < G_N_ELEMENTS(runs); r++) {
+        GwFacs *facs = gw_facs_new(count);
+        for (guint i = 0; i < count; i++) {
+            gw_facs_set(facs, i, &symbols[i]);
+        }
+
+        gw_facs_sort_parallel(facs, runs[r]);
+
+        for (guint i = 0; i < count; i++) {
+            g_assert_true(gw_facs_get(facs, i) == g_ptr_array_index(expected, i));
+        }
+
+        g_object_unref(facs);
+    }
+
+    g_ptr_array_free(expected, TRUE);
+    for (guint i = 0; i < count; i++) {
+        g_free(symbols[i].name);
+    }
+    g_free(symbols);
+}
+
+static void test_take_names(void)
+{
+    const gchar *names[] = {"top.b", "top.a.x", "top.c", "top.a"};
+    GStringChunk *chunk = g_string_chunk_new(16);
+    GwSymbol *symbols = g_new0(GwSymbol, G_N_ELEMENTS(names));
+    GwNode *nodes = g_new0(GwNode, G_N_ELEMENTS(names));
+
+    GwFacs *facs = gw_facs_new(G_N_ELEMENTS(names));
+    for (guint i = 0; i < G_N_ELEMENTS(names); i++) {
+        symbols[i].name = g_string_chunk_insert(chunk, names[i]);
+        symbols[i].n = &nodes[i];
+        nodes[i].nname = symbols[i].name;
+        gw_facs_set(facs, i, &symbols[i]);
+    }
+    gw_facs_take_names(facs, chunk);
+
+    // sorting replaces the array of the facs, the names stay with it
+    gw_facs_sort(facs);
+
+    g_assert_cmpstr(gw_facs_get(facs, 0)->name, ==, "top.a");
+    g_assert_cmpstr(gw_facs_get(facs, 1)->name, ==, "top.a.x");
+    g_assert_cmpstr(gw_facs_get(facs, 2)->name, ==, "top.b");
+    g_assert_cmpstr(gw_facs_get(facs, 3)->name, ==, "top.c");
+    for (guint i = 0; i < G_N_ELEMENTS(names); i++) {
+        g_assert_true(gw_facs_get(facs, i)->n->nname == gw_facs_get(facs, i)->name);
+    }
+
+    // the chunk is freed together with the facs
+    g_object_unref(facs);
+    g_free(nodes);
+    g_free(symbols);
+}
+
 int main(int argc, char *argv[])
 {
     g_test_init(&argc, &argv, NULL);
 
     g_test_add_func("/facs/order_from_tree", test_order_from_tree);
     g_test_add_func("/facs/sort", test_sort);
+    g_test_add_func("/facs/sort_parallel", test_sort_parallel);
+    g_test_add_func("/facs/take_names", test_take_names);
 
     return g_test_run();
 }
\ No newline at end of file
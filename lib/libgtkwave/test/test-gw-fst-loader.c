@@ -39,11 +39,76 @@ static void test_error_file_not_found()
     g_object_unref(loader);
 }
 
+static GwDumpFile *load_basic_fst(void)
+{
+    GwLoader *loader = gw_fst_loader_new();
+
+    GError *error = NULL;
+    GwDumpFile *file = gw_loader_load(loader, "files/basic.fst", &error);
+    g_assert_no_error(error);
+    g_object_unref(loader);
+
+    return file;
+}
+
+static void test_import_in_batches()
+{
+    GwDumpFile *reference = load_basic_fst();
+    g_assert_true(gw_dump_file_import_all(reference, NULL));
+
+    GwDumpFile *file = load_basic_fst();
+    GwFacs *facs = gw_dump_file_get_facs(file);
+    guint len = gw_facs_get_length(facs);
+
+    // Import every other fac first, then all of them with the first ones requested twice.
+
+    GPtrArray *nodes = g_ptr_array_new();
+    for (guint i = 0; i < len; i += 2) {
+        g_ptr_array_add(nodes, gw_facs_get(facs, i)->n);
+    }
+    g_ptr_array_add(nodes, NULL);
+    g_assert_true(gw_dump_file_import_traces(file, (GwNode **)nodes->pdata, NULL));
+
+    g_ptr_array_set_size(nodes, 0);
+    for (guint i = 0; i < len; i++) {
+        g_ptr_array_add(nodes, gw_facs_get(facs, i)->n);
+        g_ptr_array_add(nodes, gw_facs_get(facs, 0)->n);
+    }
+    g_ptr_array_add(nodes, NULL);
+    g_assert_true(gw_dump_file_import_traces(file, (GwNode **)nodes->pdata, NULL));
+    g_ptr_array_free(nodes, TRUE);
+
+    GwFacs *reference_facs = gw_dump_file_get_facs(reference);
+    g_assert_cmpint(gw_facs_get_length(reference_facs), ==, len);
+
+    for (guint i = 0; i < len; i++) {
+        GwNode *a = gw_facs_get(facs, i)->n;
+        GwNode *b = gw_facs_get(reference_facs, i)->n;
+
+        g_assert_null(a->mv.mvlfac);
+        g_assert_cmpint(a->numhist, ==, b->numhist);
+
+        GwHistEnt *ha = &a->head;
+        GwHistEnt *hb = &b->head;
+        while (ha != NULL && hb != NULL) {
+            g_assert_cmpint(ha->time, ==, hb->time);
+            g_assert_cmpint(ha->flags, ==, hb->flags);
+            ha = ha->next;
+            hb = hb->next;
+        }
+        g_assert_true(ha == NULL && hb == NULL);
+    }
+
+    g_object_unref(file);
+    g_object_unref(reference);
+}
+
 int main(int argc, char *argv[])
 {
     g_test_init(&argc, &argv, NULL);
 
     g_test_add_func("/fst_loader/enum", test_enum);
+    g_test_add_func("/fst_loader/import_in_batches", test_import_in_batches);
     g_test_add_func("/fst_loader/error_file_not_found", test_error_file_not_found);
 
     return g_test_run();
@@ -0,0 +1,89 @@
+#include <gtkwave.h>
+
+// harray layout used by the viewer: two entries before time zero followed by the transitions
+static const GwTime TIMES[] = {-2, -1, 0, 10, 10, 20, 30, 40, 50, 60, GW_TIME_MAX};
+
+static GwNode *create_node(void)
+{
+    GwNode *node = g_new0(GwNode, 1);
+
+    node->numhist = G_N_ELEMENTS(TIMES);
+    node->harray = g_new0(GwHistEnt *, node->numhist);
+
+    for (gint i = 0; i < node->numhist; i++) {
+        node->harray[i] = g_new0(GwHistEnt, 1);
+        node->harray[i]->time = TIMES[i];
+    }
+    for (gint i = 0; i + 1 < node->numhist; i++) {
+        node->harray[i]->next = node->harray[i + 1];
+    }
+
+    return node;
+}
+
+static void free_node(GwNode *node)
+{
+    for (gint i = 0; i < node->numhist; i++) {
+        g_free(node->harray[i]);
+    }
+    g_free(node->harray);
+    g_free(node);
+}
+
+static void test_seek(void)
+{
+    GwNode *node = create_node();
+    GwHistCursor cursor;
+
+    gw_hist_cursor_init_node(&cursor, node);
+
+    g_assert_cmpint(gw_hist_cursor_seek(&cursor, -10), ==, 1);
+    g_assert_cmpint(gw_hist_cursor_seek(&cursor, 0), ==, 2);
+    g_assert_cmpint(gw_hist_cursor_seek(&cursor, 5), ==, 2);
+    g_assert_cmpint(gw_hist_cursor_seek(&cursor, 10), ==, 4);
+    g_assert_cmpint(gw_hist_cursor_seek(&cursor, 19), ==, 4);
+    g_assert_cmpint(gw_hist_cursor_seek(&cursor, 20), ==, 5);
+    g_assert_cmpint(gw_hist_cursor_seek(&cursor, 1000), ==, 9);
+
+    g_assert_true(gw_hist_cursor_get_hist_ent(&cursor) == node->harray[9]);
+
+    free_node(node);
+}
+
+static void test_seek_near(void)
+{
+    GwNode *node = create_node();
+    GwHistCursor cursor;
+    GwHistCursor reference;
+
+    gw_hist_cursor_init_node(&cursor, node);
+    gw_hist_cursor_init_node(&reference, node);
+
+    // forward and backward scans must give the same results as a full seek
+    for (GwTime t = -5; t <= 70; t++) {
+        g_assert_cmpint(gw_hist_cursor_seek_near(&cursor, t),
+                        ==,
+                        gw_hist_cursor_seek(&reference, t));
+    }
+    for (GwTime t = 70; t >= -5; t--) {
+        g_assert_cmpint(gw_hist_cursor_seek_near(&cursor, t),
+                        ==,
+                        gw_hist_cursor_seek(&reference, t));
+    }
+
+    gw_hist_cursor_seek(&cursor, 0);
+    g_assert_cmpint(gw_hist_cursor_seek_near(&cursor, 55), ==, 8);
+    g_assert_cmpint(gw_hist_cursor_seek_near(&cursor, 12), ==, 4);
+
+    free_node(node);
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/hist_cursor/seek", test_seek);
+    g_test_add_func("/hist_cursor/seek_near", test_seek_near);
+
+    return g_test_run();
+}
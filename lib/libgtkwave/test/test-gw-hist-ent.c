@@ -0,0 +1,96 @@
+#include <gtkwave.h>
+
+#define NBITS 21
+
+static guint8 *parse_bits(const gchar *str)
+{
+    gsize len = strlen(str);
+    guint8 *bits = g_new0(guint8, len);
+
+    for (gsize i = 0; i < len; i++) {
+        bits[i] = gw_bit_from_char(str[i]);
+    }
+
+    return bits;
+}
+
+static void assert_set_vector(const gchar *str, guint8 expected_packing, gsize expected_size)
+{
+    guint8 *bits = parse_bits(str);
+    gsize nbits = strlen(str);
+
+    GwHistEnt h = {0};
+    h.flags = GW_HIST_ENT_FLAG_GLITCH;
+    gw_hist_ent_set_vector(&h, bits, nbits);
+
+    g_assert_cmpint(h.flags & GW_HIST_ENT_FLAG_PACKED, ==, expected_packing);
+    g_assert_true(h.flags & GW_HIST_ENT_FLAG_GLITCH);
+    g_assert_cmpuint(gw_hist_ent_get_vector_size(&h, nbits), ==, expected_size);
+
+    guint8 *storage = NULL;
+    const guint8 *unpacked = gw_hist_ent_get_bits(&h, nbits, &storage);
+    g_assert_cmpmem(unpacked, nbits, bits, nbits);
+    g_assert_cmpint(unpacked[nbits], ==, 0);
+    if (expected_packing == 0) {
+        g_assert_true(unpacked == (const guint8 *)h.v.h_vector);
+        g_assert_null(storage);
+    }
+
+    // any range can be expanded without the total width
+    guint8 range[5];
+    gw_hist_ent_unpack_vector(&h, range, 7, sizeof(range));
+    g_assert_cmpmem(range, sizeof(range), bits + 7, sizeof(range));
+
+    g_free(storage);
+    g_free(h.v.h_vector);
+    g_free(bits);
+}
+
+static void test_set_vector(void)
+{
+    assert_set_vector("101100111000111100001", GW_HIST_ENT_FLAG_PACKED_1, 3);
+    assert_set_vector("1011001110001111000xz", GW_HIST_ENT_FLAG_PACKED_2, 6);
+    assert_set_vector("10110011100011110000u", 0, NBITS);
+}
+
+static void test_vector_equal(void)
+{
+    guint8 *a_bits = parse_bits("101100111000111100001");
+    guint8 *b_bits = parse_bits("101100111000111100000");
+
+    GwHistEnt a = {0};
+    GwHistEnt b = {0};
+    GwHistEnt c = {0};
+    GwHistEnt none = {0};
+    gw_hist_ent_set_vector(&a, a_bits, NBITS);
+    gw_hist_ent_set_vector(&b, b_bits, NBITS);
+    gw_hist_ent_set_vector(&c, a_bits, NBITS);
+
+    g_assert_true(gw_hist_ent_vector_equal(&a, &c, NBITS));
+    g_assert_false(gw_hist_ent_vector_equal(&a, &b, NBITS));
+    g_assert_false(gw_hist_ent_vector_equal(&a, &none, NBITS));
+    g_assert_true(gw_hist_ent_vector_equal(&none, &none, NBITS));
+
+    // an unpacked vector, as stored by the other loaders, compares by value
+    GwHistEnt d = {0};
+    d.v.h_vector = g_memdup2(a_bits, NBITS);
+    g_assert_true(gw_hist_ent_vector_equal(&a, &d, NBITS));
+    g_assert_false(gw_hist_ent_vector_equal(&b, &d, NBITS));
+
+    g_free(a.v.h_vector);
+    g_free(b.v.h_vector);
+    g_free(c.v.h_vector);
+    g_free(d.v.h_vector);
+    g_free(a_bits);
+    g_free(b_bits);
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/hist_ent/set_vector", test_set_vector);
+    g_test_add_func("/hist_ent/vector_equal", test_vector_equal);
+
+    return g_test_run();
+}
@@ -0,0 +1,101 @@
+#include <gtkwave.h>
+
+static void on_phase_finished(GwLoadStats *stats, GwLoadPhase phase, gdouble seconds, guint *mask)
+{
+    (void)stats;
+
+    g_assert_cmpfloat(seconds, >=, 0.0);
+    *mask |= 1 << phase;
+}
+
+static void test_phases(void)
+{
+    GwLoadStats *stats = gw_load_stats_new();
+    guint mask = 0;
+    g_signal_connect(stats, "phase-finished", G_CALLBACK(on_phase_finished), &mask);
+
+    // ending a phase which wasn't started does nothing
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_TREE);
+    g_assert_cmpuint(mask, ==, 0);
+
+    gw_load_stats_begin_phase(stats, GW_LOAD_PHASE_TREE);
+    g_usleep(1000);
+    gw_load_stats_end_phase(stats, GW_LOAD_PHASE_TREE);
+    g_assert_cmpuint(mask, ==, 1 << GW_LOAD_PHASE_TREE);
+    g_assert_cmpfloat(gw_load_stats_get_phase_time(stats, GW_LOAD_PHASE_TREE), >=, 0.001);
+    g_assert_cmpfloat(gw_load_stats_get_phase_time(stats, GW_LOAD_PHASE_HEADER), ==, 0.0);
+
+    gw_load_stats_add_bytes(stats, 10);
+    gw_load_stats_add_bytes(stats, 5);
+    g_assert_cmpuint(gw_load_stats_get_bytes(stats), ==, 15);
+
+    g_object_unref(stats);
+}
+
+static void test_json(void)
+{
+    GwLoadStats *stats = gw_load_stats_new();
+    gw_load_stats_set_path(stats, "dir/\"quoted\".vcd");
+    gw_load_stats_add_transitions(stats, 42);
+
+    gchar *json = gw_load_stats_to_json(stats);
+    g_assert_nonnull(strstr(json, "\"path\":\"dir/\\\"quoted\\\".vcd\""));
+    g_assert_nonnull(strstr(json, "\"transitions\":42"));
+    g_assert_nonnull(strstr(json, "\"value_changes\":{\"seconds\":0.000000"));
+    g_assert_null(strchr(json, '\n'));
+    g_free(json);
+
+    g_object_unref(stats);
+}
+
+static void test_loader_common(GwLoader *loader, const gchar *filename)
+{
+    GError *error = NULL;
+    GwDumpFile *file = gw_loader_load(loader, filename, &error);
+    g_assert_no_error(error);
+    g_assert_nonnull(file);
+
+    GwLoadStats *stats = gw_loader_get_stats(loader);
+    g_assert_true(gw_dump_file_get_load_stats(file) == stats);
+    g_assert_cmpstr(gw_load_stats_get_path(stats), ==, filename);
+    g_assert_cmpuint(gw_load_stats_get_bytes(stats), >, 0);
+
+    g_assert_true(gw_dump_file_import_all(file, &error));
+    g_assert_no_error(error);
+    g_assert_cmpuint(gw_load_stats_get_transitions(stats), >, 0);
+
+    for (guint i = 0; i < GW_LOAD_PHASE_COUNT; i++) {
+        g_assert_cmpfloat(gw_load_stats_get_phase_time(stats, i), >=, 0.0);
+    }
+
+    g_object_unref(file);
+    g_object_unref(loader);
+}
+
+static void test_vcd_loader(void)
+{
+    test_loader_common(gw_vcd_loader_new(), "files/basic.vcd");
+}
+
+static void test_fst_loader(void)
+{
+    test_loader_common(gw_fst_loader_new(), "files/basic.fst");
+}
+
+static void test_ghw_loader(void)
+{
+    test_loader_common(gw_ghw_loader_new(), "files/basic.ghw");
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/load_stats/phases", test_phases);
+    g_test_add_func("/load_stats/json", test_json);
+    g_test_add_func("/load_stats/vcd_loader", test_vcd_loader);
+    g_test_add_func("/load_stats/fst_loader", test_fst_loader);
+    g_test_add_func("/load_stats/ghw_loader", test_ghw_loader);
+
+    return g_test_run();
+}
@@ -34,11 +34,122 @@ static void test_expand(void)
     g_object_unref(file);
 }
 
+#define TRANSPOSE_WIDTH 11
+
+// vectors of a node in the layout produced by the loaders, NULL entries have no value
+static const gchar *TRANSPOSE_VECTORS[] = {
+    NULL,
+    NULL,
+    "00000000000",
+    "00000000001",
+    "0000000000x",
+    "10000000001",
+    "1000000000z",
+    "1zz00000001",
+    "1zz00000001",
+    "xxxxxxxxxxx",
+    "zzzzzzzzzzz",
+};
+static const GwTime TRANSPOSE_TIMES[] = {-2, -1, 0, 10, 20, 30, 40, 50, 60, GW_TIME_MAX - 1, GW_TIME_MAX};
+
+static void test_transpose_history(void)
+{
+    gint count = G_N_ELEMENTS(TRANSPOSE_TIMES);
+    GwNode *vector = g_new0(GwNode, 1);
+    GwHistEnt *ents = g_new0(GwHistEnt, count);
+
+    vector->numhist = count;
+    vector->harray = g_new0(GwHistEnt *, count);
+    for (gint i = 0; i < count; i++) {
+        ents[i].time = TRANSPOSE_TIMES[i];
+        ents[i].v.h_vector = (gchar *)TRANSPOSE_VECTORS[i];
+        vector->harray[i] = &ents[i];
+    }
+
+    GwNode *outputs[TRANSPOSE_WIDTH];
+    for (gint j = 0; j < TRANSPOSE_WIDTH; j++) {
+        outputs[j] = g_new0(GwNode, 1);
+    }
+
+    gw_node_transpose_history(vector, outputs, 0, TRANSPOSE_WIDTH, 0, GW_TIME_MAX - 2);
+
+    for (gint j = 0; j < TRANSPOSE_WIDTH; j++) {
+        GwNode *node = outputs[j];
+        GwHistEnt *h = &node->head;
+        gint n = 0;
+        GwBit last = GW_BIT_X;
+
+        // every out of range entry is kept as X, in range entries only when the bit changes
+        for (gint i = 0; i < count; i++) {
+            gboolean in_range = TRANSPOSE_TIMES[i] >= 0 && TRANSPOSE_TIMES[i] <= GW_TIME_MAX - 2;
+            GwBit bit = in_range ? gw_bit_from_char(TRANSPOSE_VECTORS[i][j]) : GW_BIT_X;
+
+            if (i > 0 && in_range && bit == last) {
+                continue;
+            }
+
+            g_assert_nonnull(h);
+            g_assert_true(node->harray[n] == h);
+            g_assert_cmpint(h->time, ==, TRANSPOSE_TIMES[i]);
+            g_assert_cmpint(h->v.h_val, ==, bit);
+
+            last = bit;
+            h = h->next;
+            n++;
+        }
+
+        g_assert_null(h);
+        g_assert_cmpint(node->numhist, ==, n);
+
+        g_free(node->harray[1]);
+        g_free(node->harray);
+        g_free(node);
+    }
+
+    g_free(vector->harray);
+    g_free(vector);
+    g_free(ents);
+}
+
+static void test_build_harray(void)
+{
+    GwLoader *loader = gw_vcd_loader_new();
+    GwDumpFile *file = gw_loader_load(loader, "files/basic.vcd", NULL);
+    g_assert_nonnull(file);
+    g_object_unref(loader);
+
+    GwSymbol *bit = gw_dump_file_lookup_symbol(file, "variables.bit");
+    g_assert_nonnull(bit);
+
+    GwNode *nodes[] = {bit->n, NULL};
+    g_assert_true(gw_dump_file_import_traces(file, nodes, NULL));
+
+    GwNode *node = bit->n;
+    gw_node_build_harray(node);
+    g_assert_nonnull(node->harray);
+
+    gint count = 0;
+    for (GwHistEnt *h = &node->head; h != NULL; h = h->next) {
+        g_assert_true(node->harray[count] == h);
+        count++;
+    }
+    g_assert_cmpint(node->numhist, ==, count);
+
+    // an existing harray is kept
+    GwHistEnt **harray = node->harray;
+    gw_node_build_harray(node);
+    g_assert_true(node->harray == harray);
+
+    g_object_unref(file);
+}
+
 int main(int argc, char *argv[])
 {
     g_test_init(&argc, &argv, NULL);
 
     g_test_add_func("/node/expand", test_expand);
+    g_test_add_func("/node/transpose_history", test_transpose_history);
+    g_test_add_func("/node/build_harray", test_build_harray);
 
     return g_test_run();
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <gtkwave.h>
 #include "test-util.h"
+#include "gw-tree-private.h"
 
 static GwTreeNode *alloc_node(const gchar *name)
 {
@@ -74,6 +75,55 @@ static void test_sort(void)
     g_object_unref(tree);
 }
 
+static GwTreeNode *build_random_tree(GRand *rand, gint depth)
+{
+    GwTreeNode *head = NULL;
+    gint siblings = g_rand_int_range(rand, 1, 12);
+
+    for (gint i = 0; i < siblings; i++) {
+        gchar *name = g_strdup_printf("u%d[%d]",
+                                      g_rand_int_range(rand, 0, 40),
+                                      g_rand_int_range(rand, 0, 40));
+        GwTreeNode *node = alloc_node(name);
+        g_free(name);
+
+        if (depth > 0) {
+            node->child = build_random_tree(rand, depth - 1);
+        }
+        node->next = head;
+        head = node;
+    }
+
+    return head;
+}
+
+static void test_sort_parallel(void)
+{
+    const guint threads[] = {1, 2, 4};
+
+    for (guint i = 0; i < G_N_ELEMENTS(threads); i++) {
+        // Build two identical trees from the same seed, one for each path.
+        GRand *rand = g_rand_new_with_seed(42);
+        GwTree *serial = gw_tree_new(build_random_tree(rand, 3));
+        g_rand_free(rand);
+
+        rand = g_rand_new_with_seed(42);
+        GwTree *parallel = gw_tree_new(build_random_tree(rand, 3));
+        g_rand_free(rand);
+
+        // Small enough to stay on the serial path of gw_tree_sort().
+        gw_tree_sort(serial);
+        gw_tree_sort_parallel(parallel, threads[i]);
+
+        gchar *expected = tree_to_string(gw_tree_get_root(serial));
+        assert_tree(gw_tree_get_root(parallel), expected);
+        g_free(expected);
+
+        g_object_unref(serial);
+        g_object_unref(parallel);
+    }
+}
+
 static void test_graft(void)
 {
     GwTree *tree;
@@ -126,6 +176,7 @@ int main(int argc, char *argv[])
 
     g_test_add_func("/tree/to_string", test_to_string);
     g_test_add_func("/tree/sort", test_sort);
+    g_test_add_func("/tree/sort_parallel", test_sort_parallel);
     g_test_add_func("/tree/graft", test_graft);
 
     return g_test_run();
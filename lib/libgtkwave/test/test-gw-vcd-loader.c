@@ -1,4 +1,5 @@
 #include <gtkwave.h>
+#include <glib/gstdio.h>
 
 static void test_error_common(const gchar *filename, GQuark error_domain, gint error_code)
 {
@@ -32,6 +33,292 @@ static void test_error_no_transitions()
     test_error_common("files/error_no_transitions.vcd", GW_DUMP_FILE_ERROR, GW_DUMP_FILE_ERROR_NO_TRANSITIONS);
 }
 
+static void assert_tree_equal(GwTreeNode *a, GwTreeNode *b)
+{
+    for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+        g_assert_cmpstr(a->name, ==, b->name);
+        g_assert_cmpint(a->kind, ==, b->kind);
+        g_assert_cmpint(a->t_which, ==, b->t_which);
+
+        assert_tree_equal(a->child, b->child);
+    }
+
+    g_assert_null(a);
+    g_assert_null(b);
+}
+
+static void assert_history_equal(GwNode *a, GwNode *b)
+{
+    gint len = a->extvals ? ABS(a->msi - a->lsi) + 1 : 1;
+
+    GwHistEnt *ha = a->head.next;
+    GwHistEnt *hb = b->head.next;
+    for (; ha != NULL && hb != NULL; ha = ha->next, hb = hb->next) {
+        g_assert_cmpint(ha->time, ==, hb->time);
+        g_assert_cmpint(ha->flags, ==, hb->flags);
+
+        if (ha->flags & GW_HIST_ENT_FLAG_STRING) {
+            g_assert_cmpstr(ha->v.h_vector, ==, hb->v.h_vector);
+        } else if (ha->flags & GW_HIST_ENT_FLAG_REAL) {
+            g_assert_true(memcmp(&ha->v.h_double, &hb->v.h_double, sizeof(gdouble)) == 0);
+        } else if (len > 1) {
+            g_assert_true((ha->v.h_vector == NULL) == (hb->v.h_vector == NULL));
+            if (ha->v.h_vector != NULL) {
+                gsize size = gw_hist_ent_get_vector_size(ha, len);
+                g_assert_cmpmem(ha->v.h_vector, size, hb->v.h_vector, size);
+            }
+        } else {
+            g_assert_cmpint(ha->v.h_val, ==, hb->v.h_val);
+        }
+    }
+
+    g_assert_null(ha);
+    g_assert_null(hb);
+}
+
+static GwDumpFile *load_cached(const gchar *filename)
+{
+    GwLoader *loader = gw_vcd_loader_new();
+    gw_vcd_loader_set_use_cache(GW_VCD_LOADER(loader), TRUE);
+
+    GError *error = NULL;
+    GwDumpFile *file = gw_loader_load(loader, filename, &error);
+    g_assert_no_error(error);
+    g_assert_nonnull(file);
+
+    g_object_unref(loader);
+
+    return file;
+}
+
+static void test_cache(void)
+{
+    gchar *dir = g_dir_make_tmp("gw-vcd-cache-XXXXXX", NULL);
+    g_assert_nonnull(dir);
+
+    gchar *vcd_path = g_build_filename(dir, "basic.vcd", NULL);
+    gchar *cache_path = g_strconcat(vcd_path, ".gwcache", NULL);
+
+    gchar *contents = NULL;
+    gsize length = 0;
+    g_assert_true(g_file_get_contents("files/basic.vcd", &contents, &length, NULL));
+    g_assert_true(g_file_set_contents(vcd_path, contents, length, NULL));
+    g_free(contents);
+
+    GwDumpFile *parsed = load_cached(vcd_path);
+    g_assert_true(g_file_test(cache_path, G_FILE_TEST_IS_REGULAR));
+
+    GwDumpFile *cached = load_cached(vcd_path);
+
+    // The value changes were not parsed again.
+    GwLoadStats *stats = gw_dump_file_get_load_stats(cached);
+    g_assert_cmpuint(gw_load_stats_get_transitions(stats), ==, 0);
+    g_assert_cmpfloat(gw_load_stats_get_phase_time(stats, GW_LOAD_PHASE_VALUE_CHANGES), ==, 0.0);
+
+    g_assert_cmpint(gw_dump_file_get_time_scale(parsed), ==, gw_dump_file_get_time_scale(cached));
+    g_assert_cmpint(gw_time_range_get_end(gw_dump_file_get_time_range(parsed)),
+                    ==,
+                    gw_time_range_get_end(gw_dump_file_get_time_range(cached)));
+
+    assert_tree_equal(gw_tree_get_root(gw_dump_file_get_tree(parsed)),
+                      gw_tree_get_root(gw_dump_file_get_tree(cached)));
+
+    g_assert_true(gw_dump_file_import_all(parsed, NULL));
+    g_assert_true(gw_dump_file_import_all(cached, NULL));
+
+    GwFacs *parsed_facs = gw_dump_file_get_facs(parsed);
+    GwFacs *cached_facs = gw_dump_file_get_facs(cached);
+    g_assert_cmpint(gw_facs_get_length(parsed_facs), ==, gw_facs_get_length(cached_facs));
+
+    for (guint i = 0; i < gw_facs_get_length(parsed_facs); i++) {
+        GwSymbol *a = gw_facs_get(parsed_facs, i);
+        GwSymbol *b = gw_facs_get(cached_facs, i);
+
+        g_assert_cmpstr(a->name, ==, b->name);
+        assert_history_equal(a->n, b->n);
+    }
+
+    g_object_unref(parsed);
+    g_object_unref(cached);
+
+    // A modified dump doesn't match the cache anymore.
+    g_assert_true(g_file_set_contents(vcd_path, "", 0, NULL));
+    GwLoader *loader = gw_vcd_loader_new();
+    gw_vcd_loader_set_use_cache(GW_VCD_LOADER(loader), TRUE);
+    GError *error = NULL;
+    g_assert_null(gw_loader_load(loader, vcd_path, &error));
+    g_assert_error(error, GW_DUMP_FILE_ERROR, GW_DUMP_FILE_ERROR_NO_SYMBOLS);
+    g_error_free(error);
+    g_object_unref(loader);
+
+    g_remove(cache_path);
+    g_remove(vcd_path);
+    g_rmdir(dir);
+
+    g_free(cache_path);
+    g_free(vcd_path);
+    g_free(dir);
+}
+
+static GwDumpFile *load_generated(const gchar *path)
+{
+    GwLoader *loader = gw_vcd_loader_new();
+
+    GError *error = NULL;
+    GwDumpFile *file = gw_loader_load(loader, path, &error);
+    g_assert_no_error(error);
+    g_assert_nonnull(file);
+
+    g_object_unref(loader);
+
+    return file;
+}
+
+static void test_parallel_import(void)
+{
+    const gint num_signals = 300;
+
+    GString *vcd = g_string_new("$timescale 1ns $end\n$scope module top $end\n");
+    for (gint i = 0; i < num_signals; i++) {
+        if (i % 3 == 0) {
+            g_string_append_printf(vcd, "$var wire 8 v%d vec%d [7:0] $end\n", i, i);
+        } else {
+            g_string_append_printf(vcd, "$var wire 1 s%d sig%d $end\n", i, i);
+        }
+    }
+    // an alias of the first signal
+    g_string_append(vcd, "$var wire 8 v0 alias [7:0] $end\n");
+    g_string_append(vcd, "$upscope $end\n$enddefinitions $end\n");
+
+    for (gint t = 0; t < 100; t++) {
+        g_string_append_printf(vcd, "#%d\n", t * 10);
+        for (gint i = 0; i < num_signals; i++) {
+            if ((t + i) % 4 != 0) {
+                continue;
+            }
+            if (i % 3 == 0) {
+                g_string_append_printf(vcd, "b%d%d%d1010x v%d\n", t & 1, i & 1, (t + i) & 1, i);
+            } else {
+                g_string_append_printf(vcd, "%c s%d\n", "01xz"[(t * i) % 4], i);
+            }
+        }
+    }
+
+    gchar *dir = g_dir_make_tmp("gw-vcd-parallel-XXXXXX", NULL);
+    g_assert_nonnull(dir);
+
+    gchar *path = g_build_filename(dir, "parallel.vcd", NULL);
+    g_assert_true(g_file_set_contents(path, vcd->str, vcd->len, NULL));
+    g_string_free(vcd, TRUE);
+
+    GwDumpFile *parallel = load_generated(path);
+    GwDumpFile *serial = load_generated(path);
+
+    g_assert_true(gw_dump_file_import_all(parallel, NULL));
+
+    GwFacs *parallel_facs = gw_dump_file_get_facs(parallel);
+    GwFacs *serial_facs = gw_dump_file_get_facs(serial);
+    g_assert_cmpint(gw_facs_get_length(parallel_facs), ==, gw_facs_get_length(serial_facs));
+
+    // importing one trace at a time always stays on the calling thread
+    for (guint i = 0; i < gw_facs_get_length(serial_facs); i++) {
+        GwNode *nodes[] = {gw_facs_get(serial_facs, i)->n, NULL};
+        g_assert_true(gw_dump_file_import_traces(serial, nodes, NULL));
+    }
+
+    for (guint i = 0; i < gw_facs_get_length(parallel_facs); i++) {
+        GwSymbol *a = gw_facs_get(parallel_facs, i);
+        GwSymbol *b = gw_facs_get(serial_facs, i);
+
+        g_assert_cmpstr(a->name, ==, b->name);
+        assert_history_equal(a->n, b->n);
+    }
+
+    g_object_unref(parallel);
+    g_object_unref(serial);
+
+    g_remove(path);
+    g_rmdir(dir);
+
+    g_free(path);
+    g_free(dir);
+}
+
+static void test_packed_vectors(void)
+{
+    static const gchar *VALUES[] = {
+        "10110011100011110000",
+        "1011001110001111000x",
+        "1011001110001111000u",
+        "1",
+    };
+    static const struct
+    {
+        const gchar *bits;
+        guint8 packing;
+    } EXPECTED[] = {
+        {"10110011100011110000", GW_HIST_ENT_FLAG_PACKED_1},
+        {"1011001110001111000x", GW_HIST_ENT_FLAG_PACKED_2},
+        {"1011001110001111000u", 0},
+        {"00000000000000000001", GW_HIST_ENT_FLAG_PACKED_1},
+        {"xxxxxxxxxxxxxxxxxxxx", GW_HIST_ENT_FLAG_PACKED_2},
+        {"zzzzzzzzzzzzzzzzzzzz", GW_HIST_ENT_FLAG_PACKED_2},
+    };
+    const gint width = 20;
+
+    GString *vcd = g_string_new("$timescale 1ns $end\n$scope module top $end\n");
+    g_string_append(vcd, "$var wire 20 ! bus [19:0] $end\n");
+    g_string_append(vcd, "$upscope $end\n$enddefinitions $end\n");
+    for (guint i = 0; i < G_N_ELEMENTS(VALUES); i++) {
+        g_string_append_printf(vcd, "#%u\nb%s !\n", i * 10, VALUES[i]);
+    }
+
+    gchar *dir = g_dir_make_tmp("gw-vcd-packed-XXXXXX", NULL);
+    g_assert_nonnull(dir);
+
+    gchar *path = g_build_filename(dir, "packed.vcd", NULL);
+    g_assert_true(g_file_set_contents(path, vcd->str, vcd->len, NULL));
+    g_string_free(vcd, TRUE);
+
+    GwDumpFile *file = load_generated(path);
+    g_assert_true(gw_dump_file_import_all(file, NULL));
+
+    GwFacs *facs = gw_dump_file_get_facs(file);
+    g_assert_cmpint(gw_facs_get_length(facs), ==, 1);
+    GwNode *node = gw_facs_get(facs, 0)->n;
+
+    guint i = 0;
+    for (GwHistEnt *h = node->head.next; h != NULL; h = h->next) {
+        if (h->time < 0) {
+            continue;
+        }
+
+        g_assert_cmpuint(i, <, G_N_ELEMENTS(EXPECTED));
+        g_assert_cmpint(h->flags & GW_HIST_ENT_FLAG_PACKED, ==, EXPECTED[i].packing);
+        g_assert_cmpuint(gw_hist_ent_get_vector_size(h, width),
+                         ==,
+                         gw_vector_ent_get_storage_size(EXPECTED[i].packing, width));
+
+        guint8 *unpacked = NULL;
+        const guint8 *bits = gw_hist_ent_get_bits(h, width, &unpacked);
+        for (gint j = 0; j < width; j++) {
+            g_assert_cmpint(bits[j], ==, gw_bit_from_char(EXPECTED[i].bits[j]));
+        }
+        g_free(unpacked);
+
+        i++;
+    }
+    g_assert_cmpuint(i, ==, G_N_ELEMENTS(EXPECTED));
+
+    g_object_unref(file);
+
+    g_remove(path);
+    g_rmdir(dir);
+
+    g_free(path);
+    g_free(dir);
+}
+
 int main(int argc, char *argv[])
 {
     g_test_init(&argc, &argv, NULL);
@@ -40,6 +327,9 @@ int main(int argc, char *argv[])
     g_test_add_func("/vcd_loader/error_empty", test_error_empty);
     g_test_add_func("/vcd_loader/error_no_symbols", test_error_no_symbols);
     g_test_add_func("/vcd_loader/error_no_transitions", test_error_no_transitions);
+    g_test_add_func("/vcd_loader/cache", test_cache);
+    g_test_add_func("/vcd_loader/parallel_import", test_parallel_import);
+    g_test_add_func("/vcd_loader/packed_vectors", test_packed_vectors);
 
     return g_test_run();
 }
@@ -0,0 +1,89 @@
+#include <gtkwave.h>
+
+#define NBITS 21
+
+static guint8 *parse_bits(const gchar *str)
+{
+    gsize len = strlen(str);
+    guint8 *bits = g_new0(guint8, len);
+
+    for (gsize i = 0; i < len; i++) {
+        bits[i] = gw_bit_from_char(str[i]);
+    }
+
+    return bits;
+}
+
+static GwVectorEnt *create_vector_ent(const guint8 *bits, gsize nbits, guint8 *packing)
+{
+    *packing = gw_vector_ent_choose_packing(bits, nbits);
+
+    GwVectorEnt *v =
+        g_malloc0(sizeof(GwVectorEnt) + gw_vector_ent_get_storage_size(*packing, nbits));
+    gw_vector_ent_pack(v, *packing, bits, nbits);
+
+    return v;
+}
+
+static void assert_roundtrip(const gchar *str, guint8 expected_packing, gsize expected_size)
+{
+    guint8 *bits = parse_bits(str);
+    gsize nbits = strlen(str);
+    guint8 packing;
+
+    GwVectorEnt *v = create_vector_ent(bits, nbits, &packing);
+    g_assert_cmpint(packing, ==, expected_packing);
+    g_assert_cmpint(gw_vector_ent_get_storage_size(packing, nbits), ==, expected_size);
+    g_assert_cmpint(v->flags & GW_VECTOR_ENT_FLAG_PACKED, ==, expected_packing);
+
+    guint8 *storage = NULL;
+    const guint8 *unpacked = gw_vector_ent_get_bits(v, nbits, &storage);
+    g_assert_cmpmem(unpacked, nbits, bits, nbits);
+    if (expected_packing == 0) {
+        g_assert_true(unpacked == v->v);
+        g_assert_null(storage);
+    }
+
+    g_free(storage);
+    g_free(v);
+    g_free(bits);
+}
+
+static void test_pack(void)
+{
+    assert_roundtrip("101100111000111100001", GW_VECTOR_ENT_FLAG_PACKED_1, 3);
+    assert_roundtrip("1011001110001111000xz", GW_VECTOR_ENT_FLAG_PACKED_2, 6);
+    assert_roundtrip("10110011100011110000u", 0, NBITS);
+
+    // narrow vectors are never packed
+    assert_roundtrip("1010", 0, 4);
+}
+
+static void test_packed_word(void)
+{
+    guint8 *bits = parse_bits("101100111000111100001");
+    guint8 packing;
+    GwVectorEnt *v = create_vector_ent(bits, NBITS, &packing);
+
+    g_assert_cmpuint(gw_vector_ent_get_packed_word(v, NBITS, 0, NBITS), ==, 0x1671E1);
+    g_assert_cmpuint(gw_vector_ent_get_packed_word(v, NBITS, 0, 4), ==, 0xB);
+    g_assert_cmpuint(gw_vector_ent_get_packed_word(v, NBITS, 5, 7), ==, 0x38);
+
+    // positions outside of the vector read as 0
+    g_assert_cmpuint(gw_vector_ent_get_packed_word(v, NBITS, -3, 4), ==, 0x1);
+    g_assert_cmpuint(gw_vector_ent_get_packed_word(v, NBITS, 20, 4), ==, 0x8);
+    g_assert_cmpuint(gw_vector_ent_get_packed_word(v, NBITS, -43, 64), ==, 0x1671E1);
+
+    g_free(v);
+    g_free(bits);
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/vector_ent/pack", test_pack);
+    g_test_add_func("/vector_ent/packed_word", test_packed_word);
+
+    return g_test_run();
+}
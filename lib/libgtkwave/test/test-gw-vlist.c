@@ -25,6 +25,91 @@ static void test_common(gint compression_level)
     gw_vlist_destroy(vlist);
 }
 
+static void test_coalesced(gboolean compressable, gint compression_level)
+{
+    GwVlist *vlist = gw_vlist_create(1);
+
+    for (gint i = 0; i < 10000; i++) {
+        guint8 *t = gw_vlist_alloc(&vlist, compressable, compression_level);
+        *t = (i / 16) & 0xFF;
+    }
+
+    gw_vlist_freeze(&vlist, compression_level);
+    gw_vlist_uncompress(&vlist);
+
+    g_assert_null(vlist->next);
+    g_assert_cmpint(gw_vlist_size(vlist), ==, 10000);
+
+    for (gint i = 0; i < 10000; i++) {
+        guint8 *t = gw_vlist_locate(vlist, i);
+        g_assert_cmpint(*t, ==, (i / 16) & 0xFF);
+    }
+    g_assert_null(gw_vlist_locate(vlist, 10000));
+
+    gw_vlist_destroy(vlist);
+}
+
+static void test_coalesced_compressed(void)
+{
+    test_coalesced(TRUE, 9);
+}
+
+static void test_coalesced_uncompressed(void)
+{
+    test_coalesced(TRUE, -1);
+}
+
+static void test_coalesced_wide(void)
+{
+    GwVlist *vlist = gw_vlist_create(sizeof(GwTime));
+
+    for (gint i = 0; i < 1000; i++) {
+        GwTime *t = gw_vlist_alloc(&vlist, FALSE, 0);
+        *t = i * 10;
+    }
+
+    gw_vlist_freeze(&vlist, 0);
+
+    g_assert_null(vlist->next);
+    g_assert_cmpint(gw_vlist_size(vlist), ==, 1000);
+
+    for (gint i = 0; i < 1000; i++) {
+        GwTime *t = gw_vlist_locate(vlist, i);
+        g_assert_cmpint(*t, ==, i * 10);
+    }
+
+    gw_vlist_destroy(vlist);
+}
+
+static void test_copy(void)
+{
+    GwVlist *vlist = gw_vlist_create(1);
+
+    for (gint i = 0; i < 10000; i++) {
+        guint8 *t = gw_vlist_alloc(&vlist, TRUE, 9);
+        *t = (i / 16) & 0xFF;
+    }
+
+    gw_vlist_freeze(&vlist, 9);
+
+    // The copy must stay valid after the original is gone.
+
+    GwVlist *copy = gw_vlist_copy(vlist);
+    g_assert_cmpuint(gw_vlist_copy_size(copy), ==, gw_vlist_copy_size(vlist));
+    g_assert_cmpuint(gw_vlist_copy_size(copy), <, 10000); // the blocks stay compressed
+    gw_vlist_destroy(vlist);
+
+    gw_vlist_uncompress(&copy);
+    g_assert_cmpint(gw_vlist_size(copy), ==, 10000);
+
+    for (gint i = 0; i < 10000; i++) {
+        guint8 *t = gw_vlist_locate(copy, i);
+        g_assert_cmpint(*t, ==, (i / 16) & 0xFF);
+    }
+
+    gw_vlist_destroy(copy);
+}
+
 static void test_uncompressed(void)
 {
     test_common(0);
@@ -41,6 +126,10 @@ int main(int argc, char *argv[])
 
     g_test_add_func("/vlist/uncompressed", test_uncompressed);
     g_test_add_func("/vlist/compressed", test_compressed);
+    g_test_add_func("/vlist/coalesced/compressed", test_coalesced_compressed);
+    g_test_add_func("/vlist/coalesced/uncompressed", test_coalesced_uncompressed);
+    g_test_add_func("/vlist/coalesced/wide", test_coalesced_wide);
+    g_test_add_func("/vlist/copy", test_copy);
 
     return g_test_run();
 }
@@ -22,7 +22,7 @@ static void tree_to_string_recursive(GwTreeNode *node, GString *str)
     }
 }
 
-static gchar *tree_to_string(GwTreeNode *node)
+gchar *tree_to_string(GwTreeNode *node)
 {
     GString *str = g_string_new(NULL);
 
@@ -2,5 +2,6 @@
 
 #include "gw-tree.h"
 
+gchar *tree_to_string(GwTreeNode *node);
 void assert_tree(GwTreeNode *node, const gchar *expected);
 GwTreeNode *get_tree_node(GwTree *tree, const gchar *path);
\ No newline at end of file
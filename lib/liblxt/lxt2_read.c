@@ -23,6 +23,10 @@
 #include <config.h>
 #include "lxt2_read.h"
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 /****************************************************************************/
 
 #ifdef _WAVE_BE32
@@ -42,6 +46,44 @@
 #define lxt2_rd_get_24(mm,offset)      ((lxt2_rd_get_32((mm),(offset)-1)<<8)>>8)
 #define lxt2_rd_get_64(mm,offset)      ((((lxtint64_t)lxt2_rd_get_32((mm),(offset)))<<32)|((lxtint64_t)lxt2_rd_get_32((mm),(offset)+4)))
 
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+/*
+ * reconstruct 8/16/24/32 bits out of the lxt's representation
+ * of a big-endian integer with one (possibly unaligned) word load
+ * and a byte swap.
+ */
+#define lxt2_rd_get_byte(mm,offset) 	((unsigned int)(*((unsigned char *)(mm)+(offset))))
+
+static unsigned int lxt2_rd_get_16(void *mm, int offset)
+{
+uint16_t v;
+memcpy(&v, (unsigned char *)mm+offset, sizeof(v));
+return(__builtin_bswap16(v));
+}
+
+static unsigned int lxt2_rd_get_24(void *mm,int offset)
+{
+unsigned char *nn=(unsigned char *)mm+offset;
+uint16_t v;
+memcpy(&v, nn, sizeof(v));
+return((((unsigned int)__builtin_bswap16(v))<<8)|nn[2]);
+}
+
+static unsigned int lxt2_rd_get_32(void *mm, int offset)
+{
+uint32_t v;
+memcpy(&v, (unsigned char *)mm+offset, sizeof(v));
+return(__builtin_bswap32(v));
+}
+
+static lxtint64_t lxt2_rd_get_64(void *mm, int offset)
+{
+uint64_t v;
+memcpy(&v, (unsigned char *)mm+offset, sizeof(v));
+return(__builtin_bswap64(v));
+}
+
 #else
 
 /*
@@ -777,6 +819,17 @@ if(!(lt->handle=fopen(name, "rb")))
 
 	setvbuf(lt->handle, (char *)NULL, _IONBF, 0);	/* keeps gzip from acting weird in tandem with fopen */
 
+#ifdef HAVE_MMAP
+	fseeko(lt->handle, 0L, SEEK_END);
+	lt->mm_size = ftello(lt->handle);
+	fseeko(lt->handle, 0L, SEEK_SET);
+	if(lt->mm_size > 0)
+		{
+		lt->mm = mmap(NULL, lt->mm_size, PROT_READ, MAP_SHARED, fileno(lt->handle), 0);
+		if(lt->mm == MAP_FAILED) { lt->mm = NULL; }
+		}
+#endif
+
 	if(!fread(&id, 2, 1, lt->handle)) { id = 0; }
 	if(!fread(&version, 2, 1, lt->handle)) { id = 0; }
 	if(!fread(&lt->granule_size, 1, 1, lt->handle)) { id = 0; }
@@ -1081,6 +1134,9 @@ if(lt)
 	lt->block_head=lt->block_curr=NULL;
 
 	if(lt->zhandle) { gzclose(lt->zhandle); lt->zhandle=NULL; }
+#ifdef HAVE_MMAP
+	if(lt->mm) { munmap(lt->mm, lt->mm_size); lt->mm=NULL; }
+#endif
 	if(lt->handle) { fclose(lt->handle); lt->handle=NULL; }
 	free(lt);
 	}
@@ -1452,6 +1508,43 @@ return(blk);
 
 /****************************************************************************/
 
+/*
+ * inflate a gzip block straight out of the file mapping,
+ * returns the number of bytes decompressed
+ */
+static int lxt2_rd_inflate_mm(struct lxt2_rd_trace *lt, struct lxt2_rd_block *b)
+{
+z_stream strm;
+int rc = 0;
+
+memset(&strm, 0, sizeof(strm));
+strm.next_in = (unsigned char *)lt->mm + b->filepos;
+strm.avail_in = b->compressed_siz;
+strm.next_out = (unsigned char *)b->mem;
+strm.avail_out = b->uncompressed_siz;
+
+if(inflateInit2(&strm, 16+MAX_WBITS) == Z_OK)
+	{
+	while(strm.avail_out)
+		{
+		int zrc = inflate(&strm, Z_FINISH);
+
+		if((zrc == Z_STREAM_END) && (strm.avail_in)) /* concatenated members */
+			{
+			inflateReset(&strm);
+			continue;
+			}
+		if(zrc != Z_OK) break;
+		}
+
+	rc = strm.total_out;
+	inflateEnd(&strm);
+	}
+
+return(rc);
+}
+
+
 /*
  * block iteration...purge/reload code here isn't sophisticated as it
  * merely caches the FIRST set of blocks which fit in lt->block_mem_max.
@@ -1520,29 +1613,50 @@ if(lt)
 				while(iter!=0xFFFFFFFF)
 					{
 					size_t rcf;
+					char *zsrc = zbuff;
 
 					clen = unclen = iter = 0;
-					rcf = fread(&clen, 4, 1, lt->handle);	clen = rcf ? lxt2_rd_get_32(&clen,0) : 0;
-					rcf = fread(&unclen, 4, 1, lt->handle);	unclen = rcf ? lxt2_rd_get_32(&unclen,0) : 0;
-					rcf = fread(&iter, 4, 1, lt->handle);	iter = rcf ? lxt2_rd_get_32(&iter,0) : 0;
+					if(lt->mm)
+						{
+						if(fspos + 12 <= lt->mm_size)
+							{
+							clen = lxt2_rd_get_32(lt->mm, fspos);
+							unclen = lxt2_rd_get_32(lt->mm, fspos + 4);
+							iter = lxt2_rd_get_32(lt->mm, fspos + 8);
+							}
+						}
+						else
+						{
+						rcf = fread(&clen, 4, 1, lt->handle);	clen = rcf ? lxt2_rd_get_32(&clen,0) : 0;
+						rcf = fread(&unclen, 4, 1, lt->handle);	unclen = rcf ? lxt2_rd_get_32(&unclen,0) : 0;
+						rcf = fread(&iter, 4, 1, lt->handle);	iter = rcf ? lxt2_rd_get_32(&iter,0) : 0;
+						}
 
 					fspos += 12;
 					if((iter==0xFFFFFFFF)||(lt->process_mask_compressed[iter/LXT2_RD_PARTIAL_SIZE]))
 						{
-						if(clen > zlen)
+						if(lt->mm) /* inflate in place, no copy */
 							{
-							if(zbuff) free(zbuff);
-							zlen = clen * 2;
-							zbuff = malloc(zlen ? zlen : 1 /* scan-build */);
+							if(fspos + (off_t)clen <= lt->mm_size) { zsrc = lt->mm + fspos; } else { clen = 0; }
 							}
+							else
+							{
+							if(clen > zlen)
+								{
+								if(zbuff) free(zbuff);
+								zlen = clen * 2;
+								zbuff = malloc(zlen ? zlen : 1 /* scan-build */);
+								}
 
-						if(!fread(zbuff, clen, 1, lt->handle)) { clen = 0; }
+							zsrc = zbuff;
+							if(!fread(zbuff, clen, 1, lt->handle)) { clen = 0; }
+							}
 
 						strm.avail_in = clen-10;
 						strm.avail_out = unclen;
 						strm.total_in = strm.total_out = 0;
 						strm.zalloc = NULL; strm.zfree = NULL; strm.opaque = NULL;
-						strm.next_in = (unsigned char *)(zbuff+10);
+						strm.next_in = (unsigned char *)(zsrc+10);
 						strm.next_out = (unsigned char *)(pnt);
 
 						if((clen != 0)&&(unclen != 0))
@@ -1568,7 +1682,7 @@ if(lt)
 						else
 						{
 						fspos += clen;
-						fseeko(lt->handle, fspos, SEEK_SET);
+						if(!lt->mm) fseeko(lt->handle, fspos, SEEK_SET);
 						}
 					}
 
@@ -1577,12 +1691,20 @@ if(lt)
 				}
 				else
 				{
-				int rc;
+				int rc = 0;
 
 				b->mem = malloc(b->uncompressed_siz);
-				lt->zhandle = gzdopen(dup(fileno(lt->handle)), "rb");
-				rc=gzread(lt->zhandle, b->mem, b->uncompressed_siz);
-				gzclose(lt->zhandle); lt->zhandle=NULL;
+				if((lt->mm)&&(b->filepos + (off_t)b->compressed_siz <= lt->mm_size))
+					{
+					rc = lxt2_rd_inflate_mm(lt, b);
+					}
+
+				if(((lxtint32_t)rc)!=b->uncompressed_siz) /* no mapping, go through the file */
+					{
+					lt->zhandle = gzdopen(dup(fileno(lt->handle)), "rb");
+					rc=gzread(lt->zhandle, b->mem, b->uncompressed_siz);
+					gzclose(lt->zhandle); lt->zhandle=NULL;
+					}
 				if(((lxtint32_t)rc)!=b->uncompressed_siz)
 					{
 					fprintf(stderr, LXT2_RDLOAD"short read on block %d vs "LXT2_RD_LD" (exp), ignoring\n", rc, b->uncompressed_siz);
@@ -244,6 +244,9 @@ struct lxt2_rd_facname_cache *faccache;
 FILE *handle;
 gzFile zhandle;
 
+char *mm;			/* whole file mapped read-only if possible, NULL otherwise */
+off_t mm_size;
+
 lxtint64_t block_mem_consumed, block_mem_max;
 
 unsigned process_mask_dirty : 1; /* only used on partial block reads */
@@ -36,6 +36,10 @@
 #include <fcntl.h>
 #endif
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 /****************************************************************************/
 
 static int is_big_endian(void)
@@ -57,12 +61,6 @@ struct vzt_ncycle_autosort
 struct vzt_ncycle_autosort *next;
 };
 
-struct vzt_pth_args
-{
-struct vzt_rd_trace *lt;
-struct vzt_rd_block *b;
-};
-
 struct vzt_synvec_chain
 {
 vztint32_t num_entries;
@@ -92,21 +90,11 @@ _VZT_RD_INLINE static void vzt_rd_pthread_mutex_destroy(struct vzt_rd_trace *lt,
 if(lt->pthreads) { pthread_mutex_destroy(mutex); }
 }
 
-_VZT_RD_INLINE static void vzt_rd_pthread_create(struct vzt_rd_trace *lt, pthread_t *thread, pthread_attr_t *attr, void *(*start_routine)(void *), void *arg)
-{
-if(lt->pthreads)
-	{
-	pthread_attr_init(attr);
-	pthread_attr_setdetachstate(attr, PTHREAD_CREATE_DETACHED);
-	pthread_create(thread, attr, start_routine, arg);
-	}
-}
 #else
 #define vzt_rd_pthread_mutex_init(a, b, c)
 #define vzt_rd_pthread_mutex_lock(a, b)
 #define vzt_rd_pthread_mutex_unlock(a, b)
 #define vzt_rd_pthread_mutex_destroy(a, b)
-#define vzt_rd_pthread_create(a, b, c, d, e)
 #endif
 
 /****************************************************************************/
@@ -124,6 +112,36 @@ if(lt->pthreads)
 #define vzt_rd_get_32(mm,offset)      (*(unsigned int *)(((unsigned char *)(mm))+(offset)))
 #define vzt_rd_get_64(mm,offset)      ((((vztint64_t)vzt_rd_get_32((mm),(offset)))<<32)|((vztint64_t)vzt_rd_get_32((mm),(offset)+4)))
 
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+/*
+ * reconstruct 8/16/32/64 bits out of the vzt's representation
+ * of a big-endian integer with one (possibly unaligned) word load
+ * and a byte swap.
+ */
+#define vzt_rd_get_byte(mm,offset) 	((unsigned int)(*((unsigned char *)(mm)+(offset))))
+
+static unsigned int vzt_rd_get_16(void *mm, int offset)
+{
+uint16_t v;
+memcpy(&v, (unsigned char *)mm+offset, sizeof(v));
+return(__builtin_bswap16(v));
+}
+
+static unsigned int vzt_rd_get_32(void *mm, int offset)
+{
+uint32_t v;
+memcpy(&v, (unsigned char *)mm+offset, sizeof(v));
+return(__builtin_bswap32(v));
+}
+
+static vztint64_t vzt_rd_get_64(void *mm, int offset)
+{
+uint64_t v;
+memcpy(&v, (unsigned char *)mm+offset, sizeof(v));
+return(__builtin_bswap64(v));
+}
+
 #else
 
 /*
@@ -1360,20 +1378,62 @@ return(VZT_RD_IS_BZ2);
 
 /****************************************************************************/
 
-static void vzt_rd_decompress_blk(struct vzt_rd_trace *lt, struct vzt_rd_block *b, int reopen)
+/*
+ * decompress a gzip or bzip2 block straight out of the file mapping,
+ * returns the number of bytes decompressed
+ */
+static unsigned int vzt_rd_decompress_blk_mm(struct vzt_rd_trace *lt, struct vzt_rd_block *b)
 {
-unsigned int rc;
-void *zhandle;
-FILE *handle;
-if(reopen)
+unsigned int rc = 0;
+
+if(b->ztype == VZT_RD_IS_GZ)
 	{
-	handle = fopen(lt->filename, "rb");
+	z_stream strm;
+
+	memset(&strm, 0, sizeof(strm));
+	strm.next_in = (unsigned char *)lt->mm + b->filepos;
+	strm.avail_in = b->compressed_siz;
+	strm.next_out = (unsigned char *)b->mem;
+	strm.avail_out = b->uncompressed_siz;
+
+	if(inflateInit2(&strm, 16+MAX_WBITS) == Z_OK)
+		{
+		while(strm.avail_out)
+			{
+			int zrc = inflate(&strm, Z_FINISH);
+
+			if((zrc == Z_STREAM_END) && (strm.avail_in)) /* concatenated members */
+				{
+				inflateReset(&strm);
+				continue;
+				}
+			if(zrc != Z_OK) break;
+			}
+
+		rc = strm.total_out;
+		inflateEnd(&strm);
+		}
 	}
-	else
+else
+if(b->ztype == VZT_RD_IS_BZ2)
 	{
-	handle = lt->handle;
+	unsigned int destlen = b->uncompressed_siz;
+
+	if(BZ2_bzBuffToBuffDecompress(b->mem, &destlen, lt->mm + b->filepos, b->compressed_siz, 0, 0) == BZ_OK)
+		{
+		rc = destlen;
+		}
 	}
-fseeko(handle, b->filepos, SEEK_SET);
+
+return(rc);
+}
+
+
+static void vzt_rd_decompress_blk(struct vzt_rd_trace *lt, struct vzt_rd_block *b, int reopen)
+{
+unsigned int rc;
+void *zhandle;
+FILE *handle = NULL;
 
 vzt_rd_pthread_mutex_lock(lt, &b->mutex);
 
@@ -1381,27 +1441,55 @@ if((!b->killed)&&(!b->mem))
 	{
 	b->mem = malloc(b->uncompressed_siz);
 
-	switch(b->ztype)
+	if((lt->mm)&&(b->ztype != VZT_RD_IS_LZMA)&&(b->filepos + (off_t)b->compressed_siz <= lt->mm_size))
 		{
-		case VZT_RD_IS_GZ:
-			zhandle = gzdopen(dup(fileno(handle)), "rb");
-			rc=gzread(zhandle, b->mem, b->uncompressed_siz);
-			gzclose(zhandle);
-			break;
+		rc = vzt_rd_decompress_blk_mm(lt, b);
+		}
+		else
+		{
+		rc = 0;
+		}
 
-		case VZT_RD_IS_BZ2:
-			zhandle = BZ2_bzdopen(dup(fileno(handle)), "rb");
-			rc=BZ2_bzread(zhandle, b->mem, b->uncompressed_siz);
-			BZ2_bzclose(zhandle);
-			break;
+	if(rc!=b->uncompressed_siz) /* no mapping or lzma, go through the file */
+		{
+		if(reopen)
+			{
+			handle = fopen(lt->filename, "rb");
+			}
+			else
+			{
+			handle = lt->handle;
+			}
+		fseeko(handle, b->filepos, SEEK_SET);
 
-		case VZT_RD_IS_LZMA:
-		default:
-			zhandle = LZMA_fdopen(dup(fileno(handle)), "rb");
-			rc=LZMA_read(zhandle, b->mem, b->uncompressed_siz);
-			LZMA_close(zhandle);
-			break;
+		switch(b->ztype)
+			{
+			case VZT_RD_IS_GZ:
+				zhandle = gzdopen(dup(fileno(handle)), "rb");
+				rc=gzread(zhandle, b->mem, b->uncompressed_siz);
+				gzclose(zhandle);
+				break;
+
+			case VZT_RD_IS_BZ2:
+				zhandle = BZ2_bzdopen(dup(fileno(handle)), "rb");
+				rc=BZ2_bzread(zhandle, b->mem, b->uncompressed_siz);
+				BZ2_bzclose(zhandle);
+				break;
+
+			case VZT_RD_IS_LZMA:
+			default:
+				zhandle = LZMA_fdopen(dup(fileno(handle)), "rb");
+				rc=LZMA_read(zhandle, b->mem, b->uncompressed_siz);
+				LZMA_close(zhandle);
+				break;
+			}
+
+		if(reopen)
+			{
+			fclose(handle);
+			}
 		}
+
 	if(rc!=b->uncompressed_siz)
 		{
 		fprintf(stderr, VZT_RDLOAD"short read on block %p %d vs "VZT_RD_LD" (exp), ignoring\n", (void *)b, rc, b->uncompressed_siz);
@@ -1417,33 +1505,177 @@ if((!b->killed)&&(!b->mem))
 	}
 
 vzt_rd_pthread_mutex_unlock(lt, &b->mutex);
+}
 
-if(reopen)
+
+#ifdef PTHREAD_CREATE_DETACHED
+/*
+ * block decode pool: lt->pthreads workers decompress and decode the blocks
+ * queued ahead of the one currently being iterated
+ */
+static void *vzt_rd_pool_worker(void *args)
+{
+struct vzt_rd_trace *lt = (struct vzt_rd_trace *)args;
+
+pthread_mutex_lock(&lt->pool_mutex);
+for(;;)
 	{
-	fclose(handle);
+	struct vzt_rd_block *b;
+
+	while((!lt->queue_head)&&(!lt->pool_quit))
+		{
+		pthread_cond_wait(&lt->pool_cond, &lt->pool_mutex);
+		}
+
+	if(lt->pool_quit) break;
+
+	b = lt->queue_head;
+	lt->queue_head = b->queue_next;
+	if(!lt->queue_head) lt->queue_tail = NULL;
+	b->queued = 0;
+	b->decoding = 1;
+	pthread_mutex_unlock(&lt->pool_mutex);
+
+	vzt_rd_decompress_blk(lt, b, 1);
+	vzt_rd_block_vch_decode(lt, b);
+
+	pthread_mutex_lock(&lt->pool_mutex);
+	b->decoding = 0;
 	}
+pthread_mutex_unlock(&lt->pool_mutex);
+
+return(NULL);
 }
 
+static void vzt_rd_pool_start(struct vzt_rd_trace *lt)
+{
+unsigned int i;
+
+if(!lt->pthreads) return;
 
-static void *vzt_rd_decompress_blk_pth_actual(void *args)
+pthread_mutex_init(&lt->pool_mutex, NULL);
+pthread_cond_init(&lt->pool_cond, NULL);
+
+lt->pool = calloc(lt->pthreads, sizeof(pthread_t));
+for(i=0;i<lt->pthreads;i++)
+	{
+	pthread_create(&lt->pool[i], NULL, vzt_rd_pool_worker, lt);
+	}
+}
+
+static void vzt_rd_pool_stop(struct vzt_rd_trace *lt)
 {
-struct vzt_pth_args *vpa = (struct vzt_pth_args *)args;
-vzt_rd_decompress_blk(vpa->lt, vpa->b, 1);
-vzt_rd_block_vch_decode(vpa->lt, vpa->b);
-free(vpa);
+unsigned int i;
 
-return(NULL);
+if(!lt->pool) return;
+
+pthread_mutex_lock(&lt->pool_mutex);
+while(lt->queue_head)
+	{
+	lt->queue_head->queued = 0;
+	lt->queue_head = lt->queue_head->queue_next;
+	}
+lt->queue_tail = NULL;
+lt->pool_quit = 1;
+pthread_cond_broadcast(&lt->pool_cond);
+pthread_mutex_unlock(&lt->pool_mutex);
+
+for(i=0;i<lt->pthreads;i++)
+	{
+	pthread_join(lt->pool[i], NULL);
+	}
+
+free(lt->pool); lt->pool = NULL;
+pthread_cond_destroy(&lt->pool_cond);
+pthread_mutex_destroy(&lt->pool_mutex);
+}
+
+/* lt->pool_mutex is held */
+static void vzt_rd_pool_enqueue(struct vzt_rd_trace *lt, struct vzt_rd_block *b)
+{
+b->queued = 1;
+b->queue_next = NULL;
+if(lt->queue_tail) { lt->queue_tail->queue_next = b; } else { lt->queue_head = b; }
+lt->queue_tail = b;
 }
 
 static void vzt_rd_decompress_blk_pth(struct vzt_rd_trace *lt, struct vzt_rd_block *b)
 {
-struct vzt_pth_args *vpa = malloc(sizeof(struct vzt_pth_args));
-vpa->lt = lt;
-vpa->b = b;
+if(!lt->pool) return;
 
-vzt_rd_pthread_create(lt, &b->pth, &b->pth_attr, vzt_rd_decompress_blk_pth_actual, vpa); /* cppcheck misfires thinking vpa is not freed even though vzt_rd_decompress_blk_pth_actual() does it */
+pthread_mutex_lock(&lt->pool_mutex);
+if((!b->queued)&&(!b->decoding))
+	{
+	vzt_rd_pool_enqueue(lt, b);
+	pthread_cond_signal(&lt->pool_cond);
+	}
+pthread_mutex_unlock(&lt->pool_mutex);
 }
 
+/*
+ * keeps the lt->pthreads blocks after b queued or being decoded, called on
+ * every block boundary so the pool never runs dry while cached blocks are
+ * iterated.  b->mem of a block which is neither queued nor decoding is not
+ * touched by the pool, so it can be looked at under the pool mutex.
+ */
+static void vzt_rd_pool_top_up(struct vzt_rd_trace *lt, struct vzt_rd_block *b)
+{
+unsigned int count = 0;
+int added = 0;
+
+if(!lt->pool) return;
+
+pthread_mutex_lock(&lt->pool_mutex);
+for(b = b->next; b && (count < lt->pthreads); b = b->next)
+	{
+	if((b->queued)||(b->decoding))
+		{
+		count++;
+		continue;
+		}
+
+	if((b->mem)||(b->short_read_ignore)||(b->exclude_block)) continue;
+
+	vzt_rd_pool_enqueue(lt, b);
+	count++;
+	added++;
+	}
+
+if(added) pthread_cond_broadcast(&lt->pool_cond);
+pthread_mutex_unlock(&lt->pool_mutex);
+}
+
+/* the iterator needs b now: take it back if no worker has picked it up yet */
+static void vzt_rd_decompress_blk_unqueue(struct vzt_rd_trace *lt, struct vzt_rd_block *b)
+{
+if(!lt->pool) return;
+
+pthread_mutex_lock(&lt->pool_mutex);
+if(b->queued)
+	{
+	struct vzt_rd_block **pnt = &lt->queue_head;
+	struct vzt_rd_block *prev = NULL;
+
+	while(*pnt != b)
+		{
+		prev = *pnt;
+		pnt = &(*pnt)->queue_next;
+		}
+
+	*pnt = b->queue_next;
+	if(lt->queue_tail == b) lt->queue_tail = prev;
+	b->queued = 0;
+	}
+pthread_mutex_unlock(&lt->pool_mutex);
+}
+#else
+#define vzt_rd_pool_start(a)
+#define vzt_rd_pool_stop(a)
+#define vzt_rd_decompress_blk_pth(a, b)
+#define vzt_rd_pool_top_up(a, b)
+#define vzt_rd_decompress_blk_unqueue(a, b)
+#endif
+
 /*
  * block iteration...purge/reload code here isn't sophisticated as it
  * merely caches the FIRST set of blocks which fit in lt->block_mem_max.
@@ -1453,7 +1685,7 @@ int vzt_rd_iter_blocks(struct vzt_rd_trace *lt,
 	void (*value_change_callback)(struct vzt_rd_trace **lt, vztint64_t *time, vztint32_t *facidx, char **value),
 	void *user_callback_data_pointer)
 {
-struct vzt_rd_block *b, *bpre;
+struct vzt_rd_block *b;
 int blk=0, blkfinal=0;
 int processed = 0;
 struct vzt_rd_block *bcutoff=NULL, *bfinal=NULL;
@@ -1468,7 +1700,15 @@ if(lt)
 
 	while(b)
 		{
-		if((!b->mem)&&(!b->short_read_ignore)&&(!b->exclude_block))
+		int loaded;
+
+		vzt_rd_pool_top_up(lt, b);
+
+		vzt_rd_pthread_mutex_lock(lt, &b->mutex); /* the decode pool may be filling it in */
+		loaded = (b->mem)||(b->short_read_ignore)||(b->exclude_block);
+		vzt_rd_pthread_mutex_unlock(lt, &b->mutex);
+
+		if(!loaded)
 			{
 			if(processed<5)
 				{
@@ -1480,23 +1720,7 @@ if(lt)
 
 			processed++;
 
-			if(lt->pthreads)
-				{
-				int count = lt->pthreads;
-				/* prefetch next *empty* block(s) on an alternate thread */
-				bpre = b->next;
-				while(bpre)
-					{
-					if((!bpre->mem)&&(!bpre->short_read_ignore)&&(!bpre->exclude_block))
-						{
-						vzt_rd_decompress_blk_pth(lt, bpre);
-						count--;
-						if(!count) break;
-						}
-					bpre = bpre->next;
-					}
-				}
-
+			vzt_rd_decompress_blk_unqueue(lt, b);
 			vzt_rd_decompress_blk(lt, b, 0);
 			bfinal=b;
 			blkfinal = blk;
@@ -1696,6 +1920,17 @@ if(!(lt->handle=fopen(name, "rb")))
 
 	setvbuf(lt->handle, (char *)NULL, _IONBF, 0);	/* keeps gzip from acting weird in tandem with fopen */
 
+#ifdef HAVE_MMAP
+	fseeko(lt->handle, 0L, SEEK_END);
+	lt->mm_size = ftello(lt->handle);
+	fseeko(lt->handle, 0L, SEEK_SET);
+	if(lt->mm_size > 0)
+		{
+		lt->mm = mmap(NULL, lt->mm_size, PROT_READ, MAP_SHARED, fileno(lt->handle), 0);
+		if(lt->mm == MAP_FAILED) { lt->mm = NULL; }
+		}
+#endif
+
 	if(!fread(&id, 2, 1, lt->handle)) { id = 0; }
 	if(!fread(&version, 2, 1, lt->handle)) { id = 0; }
 	if(!fread(&lt->granule_size, 1, 1, lt->handle)) { id = 0; }
@@ -1730,6 +1965,7 @@ if(!(lt->handle=fopen(name, "rb")))
 		struct vzt_rd_block *b;
 
 		vzt_rd_pthread_mutex_init(lt, &lt->mutex, NULL);
+		vzt_rd_pool_start(lt);
 
 		rcf = fread(&lt->numfacs, 4, 1, lt->handle);		lt->numfacs = rcf ? vzt_rd_get_32(&lt->numfacs,0) : 0;
 
@@ -1949,9 +2185,9 @@ if(!(lt->handle=fopen(name, "rb")))
 				fseeko(lt->handle, b->compressed_siz, SEEK_CUR);
 
 				lt->numblocks++;
+				vzt_rd_pthread_mutex_init(lt, &b->mutex, NULL); /* any block may go through the pool */
 				if(lt->numblocks <= lt->pthreads)
 					{
-					vzt_rd_pthread_mutex_init(lt, &b->mutex, NULL);
 					vzt_rd_decompress_blk_pth(lt, b); /* prefetch first block */
 					}
 
@@ -2207,6 +2443,8 @@ if(lt)
 	{
 	struct vzt_rd_block *b, *bt;
 
+	vzt_rd_pool_stop(lt);
+
 	if(lt->process_mask) { free(lt->process_mask); lt->process_mask=NULL; }
 
 	if(lt->rows) { free(lt->rows); lt->rows=NULL; }
@@ -2242,6 +2480,9 @@ if(lt)
 	lt->block_head=lt->block_curr=NULL;
 
 	if(lt->zhandle) { gzclose(lt->zhandle); lt->zhandle=NULL; }
+#ifdef HAVE_MMAP
+	if(lt->mm) { munmap(lt->mm, lt->mm_size); lt->mm=NULL; }
+#endif
 	if(lt->handle) { fclose(lt->handle); lt->handle=NULL; }
 	if(lt->filename) { free(lt->filename); lt->filename=NULL; }
 
@@ -56,6 +56,7 @@ typedef int pthread_t;
 typedef int pthread_attr_t;
 typedef int pthread_mutex_t;
 typedef int pthread_mutexattr_t;
+typedef int pthread_cond_t;
 #else
 #include <pthread.h>
 #endif
@@ -160,8 +161,9 @@ unsigned killed : 1;		/* we're in vzt_close(), don't grab anymore blocks */
 unsigned ztype : 2;		/* 1: gzip, 0: bzip2, 2: lzma */
 unsigned rle : 1;		/* set when end < start which says that an rle depack is necessary */
 
-pthread_t pth;
-pthread_attr_t pth_attr;
+struct vzt_rd_block *queue_next;	/* decode pool queue */
+unsigned queued : 1;		/* waiting in the decode pool queue */
+unsigned decoding : 1;		/* taken off the queue by a pool worker */
 pthread_mutex_t mutex;
 
 vztint64_t last_rd_value_simtime;
@@ -226,6 +228,15 @@ char *filename;			/* for multithread */
 FILE *handle;
 void *zhandle;
 
+char *mm;			/* whole file mapped read-only if possible, NULL otherwise */
+off_t mm_size;
+
+pthread_t *pool;		/* lt->pthreads block decode workers */
+pthread_mutex_t pool_mutex;
+pthread_cond_t pool_cond;
+struct vzt_rd_block *queue_head, *queue_tail;
+unsigned pool_quit : 1;
+
 vztint64_t block_mem_consumed, block_mem_max;
 pthread_mutex_t mutex;	/* for these */
 
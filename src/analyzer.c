@@ -435,10 +435,6 @@ int InsertBlankTrace(char *comment, TraceFlagsType different_flags)
 int AddNodeTraceReturn(GwNode *nd, char *aliasname, GwTrace **tret)
 {
     GwTrace *t;
-    GwHistEnt *histpnt;
-    GwHistEnt **harray;
-    int histcount;
-    int i;
 
     if (!nd)
         return (0); /* passed it a null node ptr by mistake */
@@ -453,31 +449,9 @@ int AddNodeTraceReturn(GwNode *nd, char *aliasname, GwTrace **tret)
         return (0);
     }
 
-    if (!nd->harray) /* make quick array lookup for aet display */
-    {
-        histpnt = &(nd->head);
-        histcount = 0;
-
-        while (histpnt) {
-            histcount++;
-            histpnt = histpnt->next;
-        }
-
-        nd->numhist = histcount;
-
-        if (!(nd->harray = harray = malloc_2(histcount * sizeof(GwHistEnt *)))) {
-            fprintf(stderr, "Out of memory, can't add to analyzer\n");
-            free_2(t);
-            return (0);
-        }
-
-        histpnt = &(nd->head);
-        for (i = 0; i < histcount; i++) {
-            *harray = histpnt;
-            harray++;
-            histpnt = histpnt->next;
-        }
-    }
+    /* make quick array lookup for aet display, allocated like the library does so that
+     * evicted traces can release it */
+    gw_node_build_harray(nd);
 
     if (aliasname) {
         char *alias;
@@ -580,6 +554,7 @@ int AddVector(GwBitVector *vec, char *aliasname)
 void FreeTrace(GwTrace *t)
 {
     GLOBALS->traces.dirty = 1;
+    RemoveSignalLength(t);
 
     if (GLOBALS->strace_ctx->straces) {
         struct strace_defer_free *sd = calloc_2(1, sizeof(struct strace_defer_free));
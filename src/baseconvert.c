@@ -411,6 +411,84 @@ static void cvt_fpsudec(GwTrace *t, GwTime val, char *os, int len)
     }
 }
 
+/*
+ * read count positions of a one bit per position vector, inverting
+ * only the positions which are part of the vector
+ */
+static GwUTime packed_word(GwVectorEnt *v, int nbits, int offset, int count, int invert)
+{
+    GwUTime val = gw_vector_ent_get_packed_word(v, nbits, offset, count);
+
+    if (invert) {
+        int lo = MAX(offset, 0);
+        int hi = MIN(offset + count, nbits);
+
+        if (hi > lo) {
+            GwUTime mask = (hi - lo < 64) ? ((GW_UTIME_CONSTANT(1) << (hi - lo)) - 1)
+                                          : ~GW_UTIME_CONSTANT(0);
+            val ^= mask << (offset + count - hi);
+        }
+    }
+
+    return (val);
+}
+
+/*
+ * word-wide hex/decimal conversion of two-state vectors stored with one bit
+ * per position, returns NULL for anything that needs the generic per-bit path
+ */
+static char *convert_ascii_packed(GwTrace *t, GwVectorEnt *v)
+{
+    TraceFlagsType flags = t->flags;
+    int nbits = t->n.vec->nbits;
+    int invert = (flags & TR_INVERT) != 0;
+    char *os, *pnt;
+    int i, len;
+
+    if (!(v->flags & GW_VECTOR_ENT_FLAG_PACKED_1)) {
+        return (NULL);
+    }
+
+    if (flags & (TR_REVERSE | TR_ZEROFILL | TR_ONEFILL | TR_GRAYMASK | TR_POPCNT | TR_FFO |
+                 TR_ASCII | TR_FPDECSHIFT | TR_TIME)) {
+        return (NULL);
+    }
+
+    if ((flags & TR_HEX) || ((flags & (TR_DEC | TR_SIGNED)) && (nbits > 64))) {
+        int offset = (flags & TR_RJUSTIFY) ? (((nbits + 3) & 3) - 3) : 0;
+
+        len = (nbits / 4) + 2 + 1; /* $xxxxx */
+        os = pnt = (char *)calloc_2(1, len);
+        if (GLOBALS->show_base) {
+            *(pnt++) = '$';
+        }
+
+        for (i = 0; i < nbits; i += 4) {
+            *(pnt++) = AN_HEX_STR[packed_word(v, nbits, offset + i, 4, invert)];
+        }
+    } else if (flags & (TR_OCT | TR_BIN | TR_REAL)) {
+        return (NULL);
+    } else if (nbits > 64) {
+        return (NULL);
+    } else {
+        GwUTime val = packed_word(v, nbits, 0, nbits, invert);
+
+        len = 21; /* len+1 of 0xffffffffffffffff expressed in decimal */
+        os = (char *)calloc_2(1, len);
+
+        if (flags & TR_SIGNED) {
+            if ((nbits < 64) && (val & (GW_UTIME_CONSTANT(1) << (nbits - 1)))) {
+                val |= ~GW_UTIME_CONSTANT(0) << nbits;
+            }
+            sprintf(os, "%" GW_TIME_FORMAT, (GwTime)val);
+        } else {
+            sprintf(os, "%" GW_UTIME_FORMAT, val);
+        }
+    }
+
+    return (os);
+}
+
 /*
  * convert trptr+vptr into an ascii string
  */
@@ -427,10 +505,15 @@ static char *convert_ascii_2(GwTrace *t, GwVectorEnt *v)
     const char *xtab;
 
     GwTimeDimension time_dimension = gw_dump_file_get_time_dimension(GLOBALS->dump_file);
+    guint8 *unpacked = NULL;
+
+    if ((os = convert_ascii_packed(t, v))) {
+        return (os);
+    }
 
     flags = t->flags;
     nbits = t->n.vec->nbits;
-    bits = v->v;
+    bits = (unsigned char *)gw_vector_ent_get_bits(v, nbits, &unpacked);
 
     if (flags & TR_INVERT) {
         xtab = xrev;
@@ -928,9 +1011,32 @@ static char *convert_ascii_2(GwTrace *t, GwVectorEnt *v)
     }
 
     free_2(newbuff);
+    g_free(unpacked);
     return (os);
 }
 
+static int hist_nbits(GwTrace *t)
+{
+    int nbits = t->n.nd->msi - t->n.nd->lsi;
+    if (nbits < 0)
+        nbits = -nbits;
+
+    return (nbits + 1);
+}
+
+/*
+ * vtype() for a trptr+hptr, unpacking the vector if needed
+ */
+int vtype_hist(GwTrace *t, GwHistEnt *h)
+{
+    guint8 *unpacked = NULL;
+    int nbits = hist_nbits(t);
+    int rc = vtype(t, (char *)gw_hist_ent_get_bits(h, nbits, &unpacked));
+
+    g_free(unpacked);
+    return (rc);
+}
+
 /*
  * convert trptr+hptr vectorstring into an ascii string
  */
@@ -1071,18 +1177,11 @@ static const unsigned char cvt_table[] = {
     GW_BIT_DASH /* . */, GW_BIT_DASH /* . */, GW_BIT_DASH /* . */, GW_BIT_DASH /* . */
 };
 
-int vtype(GwTrace *t, char *vec)
+static int vtype_bits(const char *vec, int nbits)
 {
-    int i, nbits;
+    int i;
     char pch, ch;
 
-    if (vec == NULL)
-        return (GW_BIT_X);
-
-    nbits = t->n.nd->msi - t->n.nd->lsi;
-    if (nbits < 0)
-        nbits = -nbits;
-    nbits++;
     pch = ch = cvt_table[(unsigned char)vec[0]];
     for (i = 1; i < nbits; i++) {
         ch = cvt_table[(unsigned char)vec[i]];
@@ -1108,11 +1207,26 @@ miscompare:
     return (GW_BIT_COUNT);
 }
 
+int vtype(GwTrace *t, char *vec)
+{
+    int nbits;
+
+    if (vec == NULL)
+        return (GW_BIT_X);
+
+    nbits = t->n.nd->msi - t->n.nd->lsi;
+    if (nbits < 0)
+        nbits = -nbits;
+    nbits++;
+
+    return (vtype_bits(vec, nbits));
+}
+
 int vtype2(GwTrace *t, GwVectorEnt *v)
 {
-    int i, nbits;
-    char pch, ch;
+    int i, nbits, rc;
     char *vec = (char *)v->v;
+    guint8 *unpacked = NULL;
 
     if (!t->t_filter_converted) {
         if (vec == NULL)
@@ -1123,29 +1237,34 @@ int vtype2(GwTrace *t, GwVectorEnt *v)
 
     nbits = t->n.vec->nbits;
 
-    pch = ch = cvt_table[(unsigned char)vec[0]];
-    for (i = 1; i < nbits; i++) {
-        ch = cvt_table[(unsigned char)vec[i]];
-        if (ch != pch)
-            goto miscompare;
-    }
+    if (v->flags & GW_VECTOR_ENT_FLAG_PACKED_1) {
+        /* two-state: only all zeroes or all ones are uniform, check a word at a time */
+        int zeroes = 1, ones = 1;
 
-    return (ch);
+        for (i = 0; (i < nbits) && (zeroes || ones); i += 64) {
+            int count = MIN(nbits - i, 64);
+            GwUTime w = gw_vector_ent_get_packed_word(v, nbits, i, count);
+            GwUTime all = (count < 64) ? ((GW_UTIME_CONSTANT(1) << count) - 1)
+                                       : ~GW_UTIME_CONSTANT(0);
 
-miscompare:
-    if ((pch == GW_BIT_X) || (pch == GW_BIT_U))
-        return (pch);
-    if (pch == GW_BIT_Z)
-        return (GW_BIT_X);
-    for (; i < nbits; i++) {
-        ch = cvt_table[(unsigned char)vec[i]];
-        if ((ch == GW_BIT_X) || (ch == GW_BIT_U))
-            return (ch);
-        if (ch == GW_BIT_Z)
-            return (GW_BIT_X);
+            if (w != 0)
+                zeroes = 0;
+            if (w != all)
+                ones = 0;
+        }
+
+        if (zeroes)
+            return (cvt_table[GW_BIT_0]);
+        if (ones)
+            return (cvt_table[GW_BIT_1]);
+        return (GW_BIT_COUNT);
     }
 
-    return (GW_BIT_COUNT);
+    vec = (char *)gw_vector_ent_get_bits(v, nbits, &unpacked);
+    rc = vtype_bits(vec, nbits);
+    g_free(unpacked);
+
+    return (rc);
 }
 
 /*
@@ -1690,6 +1809,18 @@ char *convert_ascii_vec(GwTrace *t, char *vec)
     return (s);
 }
 
+/*
+ * convert_ascii_vec() for a trptr+hptr, unpacking the vector if needed
+ */
+char *convert_ascii_hist(GwTrace *t, GwHistEnt *h)
+{
+    guint8 *unpacked = NULL;
+    char *s = convert_ascii_vec(t, (char *)gw_hist_ent_get_bits(h, hist_nbits(t), &unpacked));
+
+    g_free(unpacked);
+    return (s);
+}
+
 char *convert_ascii(GwTrace *t, GwVectorEnt *v)
 {
     char *s;
@@ -1895,6 +2026,18 @@ double convert_real_vec(GwTrace *t, char *vec)
     return (retval);
 }
 
+/*
+ * convert_real_vec() for a trptr+hptr, unpacking the vector if needed
+ */
+double convert_real_hist(GwTrace *t, GwHistEnt *h)
+{
+    guint8 *unpacked = NULL;
+    double d = convert_real_vec(t, (char *)gw_hist_ent_get_bits(h, hist_nbits(t), &unpacked));
+
+    g_free(unpacked);
+    return (d);
+}
+
 /*
  * convert trptr+vptr into a real
  */
@@ -1908,13 +2051,14 @@ double convert_real(GwTrace *t, GwVectorEnt *v)
     const char *xtab;
     double mynan = strtod("NaN", NULL);
     double retval = mynan;
+    guint8 *unpacked = NULL;
 
     static const char xfwd[GW_BIT_COUNT] = AN_NORMAL;
     static const char xrev[GW_BIT_COUNT] = AN_INVERSE;
 
     flags = t->flags;
     nbits = t->n.vec->nbits;
-    bits = v->v;
+    bits = (unsigned char *)gw_vector_ent_get_bits(v, nbits, &unpacked);
 
     if (flags & TR_INVERT) {
         xtab = xrev;
@@ -2010,5 +2154,6 @@ double convert_real(GwTrace *t, GwVectorEnt *v)
     }
 
     free_2(newbuff);
+    g_free(unpacked);
     return (retval);
 }
@@ -12,12 +12,15 @@
 
 char *convert_ascii(GwTrace *t, GwVectorEnt *v);
 char *convert_ascii_vec(GwTrace *t, char *vec);
+char *convert_ascii_hist(GwTrace *t, GwHistEnt *h);
 char *convert_ascii_real(GwTrace *t, double *d);
 char *convert_ascii_string(char *s);
 char *convert_ascii_vec_2(GwTrace *t, char *vec);
 double convert_real_vec(GwTrace *t, char *vec);
+double convert_real_hist(GwTrace *t, GwHistEnt *h);
 double convert_real(GwTrace *t, GwVectorEnt *v);
 int vtype(GwTrace *t, char *vec);
+int vtype_hist(GwTrace *t, GwHistEnt *h);
 int vtype2(GwTrace *t, GwVectorEnt *v);
 
 #endif
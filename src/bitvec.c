@@ -207,7 +207,8 @@ GwBitVector *bits2vector(GwBits *b)
     GwVectorEnt *vcurr = NULL;
     GwVectorEnt *vadd;
     int numextrabytes;
-    GwTime mintime, lasttime = -1;
+    unsigned char *vbits;
+    GwTime mintime, vtime, lasttime = -1;
     GwBitVector *bitvec = NULL;
     GwTime tshift, tmod;
     int is_string;
@@ -219,6 +220,7 @@ GwBitVector *bits2vector(GwBits *b)
     h = calloc_2(b->nnbits, sizeof(GwHistEnt *));
 
     numextrabytes = b->nnbits;
+    vbits = malloc_2(numextrabytes);
 
     for (i = 0; i < b->nnbits; i++) {
         n = b->nodes[i];
@@ -230,8 +232,6 @@ GwBitVector *bits2vector(GwBits *b)
     {
         mintime = MAX_HISTENT_TIME;
 
-        vadd = calloc_2(1, sizeof(GwVectorEnt) + numextrabytes);
-
         for (i = 0; i < b->nnbits; i++) /* was 1...big mistake */
         {
             tshift = (b->attribs) ? b->attribs[i].shift : 0;
@@ -253,7 +253,7 @@ GwBitVector *bits2vector(GwBits *b)
             }
         }
 
-        vadd->time = lasttime;
+        vtime = lasttime;
         lasttime = mintime;
 
         regions++;
@@ -280,9 +280,8 @@ GwBitVector *bits2vector(GwBits *b)
         }
 
         if (is_string) {
+            vadd = calloc_2(1, sizeof(GwVectorEnt) + string_len + 1);
             vadd->flags |= GW_HIST_ENT_FLAG_STRING;
-            vadd = realloc_2(vadd, sizeof(GwVectorEnt) + string_len + 1);
-            vadd->v[0] = 0;
         }
 
         for (i = 0; i < b->nnbits; i++) {
@@ -346,7 +345,7 @@ GwBitVector *bits2vector(GwBits *b)
                     enc = ((unsigned char)(h[i]->v.h_val)) & GW_BIT_MASK;
                 }
 
-                vadd->v[i] = enc;
+                vbits[i] = enc;
             } else {
                 if (h[i]->time >= 0) {
                     if (h[i]->v.h_vector) {
@@ -385,6 +384,17 @@ GwBitVector *bits2vector(GwBits *b)
             }
         }
 
+        if (!is_string) {
+            /* wide two and four state buses are stored with 1 or 2 bits per position */
+            unsigned char packing = gw_vector_ent_choose_packing(vbits, numextrabytes);
+
+            vadd = calloc_2(1,
+                            sizeof(GwVectorEnt) +
+                                gw_vector_ent_get_storage_size(packing, numextrabytes));
+            gw_vector_ent_pack(vadd, packing, vbits, numextrabytes);
+        }
+        vadd->time = vtime;
+
         if (vhead) {
             vcurr->next = vadd;
             vcurr = vadd;
@@ -396,6 +406,8 @@ GwBitVector *bits2vector(GwBits *b)
             break; /* normal bail part */
     }
 
+    free_2(vbits);
+
     vadd = calloc_2(1, sizeof(GwVectorEnt) + numextrabytes);
     vadd->time = MAX_HISTENT_TIME;
     for (i = 0; i < numextrabytes; i++)
@@ -1412,7 +1424,6 @@ GwNode *ExtractNodeSingleBit(GwNode *n, int bit)
 {
     int lft, rgh;
     GwHistEnt *h;
-    GwHistEnt *htemp;
     int i, j;
     int actual;
     GwNode *np;
@@ -1498,35 +1509,8 @@ GwNode *ExtractNodeSingleBit(GwNode *n, int bit)
         nam = (char *)g_alloca(offset + 20);
         memcpy(nam, namex, offset);
 
-        if (!n->harray) /* make quick array lookup for aet display--normally this is done in addnode
-                         */
-        {
-            GwHistEnt *histpnt;
-            int histcount;
-            GwHistEnt **harray;
-
-            histpnt = &(n->head);
-            histcount = 0;
-
-            while (histpnt) {
-                histcount++;
-                histpnt = histpnt->next;
-            }
-
-            n->numhist = histcount;
-
-            if (!(n->harray = harray = malloc_2(histcount * sizeof(GwHistEnt *)))) {
-                DEBUG(fprintf(stderr, "Out of memory, can't add to analyzer\n"));
-                return (NULL);
-            }
-
-            histpnt = &(n->head);
-            for (i = 0; i < histcount; i++) {
-                *harray = histpnt;
-                harray++;
-                histpnt = histpnt->next;
-            }
-        }
+        /* make quick array lookup for aet display--normally this is done in addnode */
+        gw_node_build_harray(n);
 
         h = &(n->head);
         while (h) {
@@ -1542,7 +1526,7 @@ GwNode *ExtractNodeSingleBit(GwNode *n, int bit)
                       bit,
                       n->numhist));
 
-        np = calloc_2(1, sizeof(GwNode));
+        np = g_new0(GwNode, 1);
 
         if (!is_2d) {
             sprintf(nam + offset, "[%d]", actual);
@@ -1560,92 +1544,22 @@ GwNode *ExtractNodeSingleBit(GwNode *n, int bit)
 
         len = offset + strlen(nam + offset);
 
-        np->nname = (char *)malloc_2(len + 1);
+        np->nname = (char *)g_malloc(len + 1);
         strcpy(np->nname, nam);
 
-        exp1 = calloc_2(1, sizeof(GwExpandReferences));
+        exp1 = g_new0(GwExpandReferences, 1);
         exp1->parent = n; /* point to parent */
         exp1->parentbit = bit;
         exp1->actual = actual; /* actual bitnum in [] */
         np->expansion = exp1; /* can be safely deleted if expansion set like here */
 
         GwTimeRange *time_range = gw_dump_file_get_time_range(GLOBALS->dump_file);
-
-        for (i = 0; i < n->numhist; i++) {
-            h = n->harray[i];
-            if (!gw_time_range_contains(time_range, h->time)) {
-                if (np->curr) {
-                    htemp = calloc_2(1, sizeof(GwHistEnt));
-                    htemp->v.h_val = GW_BIT_X; /* 'x' */
-                    htemp->time = h->time;
-                    np->curr->next = htemp;
-                    np->curr = htemp;
-                } else {
-                    np->head.v.h_val = GW_BIT_X; /* 'x' */
-                    np->head.time = h->time;
-                    np->curr = &(np->head);
-                }
-
-                np->numhist++;
-            } else {
-                unsigned char val = h->v.h_vector[bit];
-                switch (val) {
-                    case '0':
-                        val = GW_BIT_0;
-                        break;
-                    case '1':
-                        val = GW_BIT_1;
-                        break;
-                    case 'x':
-                    case 'X':
-                        val = GW_BIT_X;
-                        break;
-                    case 'z':
-                    case 'Z':
-                        val = GW_BIT_Z;
-                        break;
-                    case 'h':
-                    case 'H':
-                        val = GW_BIT_H;
-                        break;
-                    case 'l':
-                    case 'L':
-                        val = GW_BIT_L;
-                        break;
-                    case 'u':
-                    case 'U':
-                        val = GW_BIT_U;
-                        break;
-                    case 'w':
-                    case 'W':
-                        val = GW_BIT_W;
-                        break;
-                    case '-':
-                        val = GW_BIT_DASH;
-                        break;
-                    default:
-                        break; /* leave val alone as it's been converted already.. */
-                }
-
-                if (np->curr->v.h_val !=
-                    val) /* curr will have been established already by 'x' at time: -1 */
-                {
-                    htemp = calloc_2(1, sizeof(GwHistEnt));
-                    htemp->v.h_val = val;
-                    htemp->time = h->time;
-                    np->curr->next = htemp;
-                    np->curr = htemp;
-                    np->numhist++;
-                }
-            }
-        }
-
-        np->harray = calloc_2(np->numhist, sizeof(GwHistEnt *));
-        htemp = &(np->head);
-        for (j = 0; j < np->numhist; j++) {
-            np->harray[j] = htemp;
-            htemp = htemp->next;
-        }
+        gw_node_transpose_history(n,
+                                  &np,
+                                  bit,
+                                  1,
+                                  gw_time_range_get_start(time_range),
+                                  gw_time_range_get_end(time_range));
 
         return (np);
     }
@@ -1658,18 +1572,16 @@ GwNode *ExtractNodeSingleBit(GwNode *n, int bit)
  */
 void DeleteNode(GwNode *n)
 {
-    int i;
-
     if (n->expansion) {
         if (n->expansion->refcnt == 0) {
-            for (i = 1; i < n->numhist; i++) /* 1st is actually part of the Node! */
-            {
-                free_2(n->harray[i]);
+            /* the histents after the head are a single block, see gw_node_transpose_history() */
+            if (n->numhist > 1) {
+                g_free(n->harray[1]);
             }
-            free_2(n->harray);
-            free_2(n->expansion);
-            free_2(n->nname);
-            free_2(n);
+            g_free(n->harray);
+            g_free(n->expansion);
+            g_free(n->nname);
+            g_free(n);
         } else {
             n->expansion->refcnt--;
         }
@@ -16,170 +16,58 @@
 #include "strace.h"
 #include <ctype.h>
 
-static int compar_timechain(const void *s1, const void *s2)
-{
-    GwTime key, obj, delta;
-    GwTime *cpos;
-    int rv;
-
-    key = *((GwTime *)s1);
-    obj = *(cpos = (GwTime *)s2);
-
-    if ((obj <= key) && (obj > GLOBALS->max_compare_time_tc_bsearch_c_1)) {
-        GLOBALS->max_compare_time_tc_bsearch_c_1 = obj;
-        GLOBALS->max_compare_pos_tc_bsearch_c_1 = cpos;
-    }
-
-    delta = key - obj;
-    if (delta < 0)
-        rv = -1;
-    else if (delta > 0)
-        rv = 1;
-    else
-        rv = 0;
-
-    return (rv);
-}
-
 int bsearch_timechain(GwTime key)
 {
-    GLOBALS->max_compare_time_tc_bsearch_c_1 = -2;
-    GLOBALS->max_compare_pos_tc_bsearch_c_1 = NULL;
+    GwTime *timearray = GLOBALS->strace_ctx->timearray;
+    int lo, hi, pos;
 
-    if (!GLOBALS->strace_ctx->timearray)
+    if (!timearray)
         return (-1);
 
-    if (bsearch(&key,
-                GLOBALS->strace_ctx->timearray,
-                GLOBALS->strace_ctx->timearray_size,
-                sizeof(GwTime),
-                compar_timechain)) {
-        /* nothing, all side effects are in bsearch */
+    /* last entry at or before key, reentrant replacement for the old bsearch side channel */
+    lo = 0;
+    hi = GLOBALS->strace_ctx->timearray_size - 1;
+    pos = -1;
+    while (lo <= hi) {
+        int mid = lo + ((hi - lo) / 2);
+
+        if (timearray[mid] <= key) {
+            pos = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
     }
 
-    if ((!GLOBALS->max_compare_pos_tc_bsearch_c_1) ||
-        (GLOBALS->max_compare_time_tc_bsearch_c_1 < GLOBALS->shift_timebase)) {
-        GLOBALS->max_compare_pos_tc_bsearch_c_1 =
-            GLOBALS->strace_ctx->timearray; /* aix bsearch fix */
+    if ((pos < 0) || (timearray[pos] < GLOBALS->shift_timebase)) {
+        pos = 0; /* aix bsearch fix */
     }
 
-    return (GLOBALS->max_compare_pos_tc_bsearch_c_1 - GLOBALS->strace_ctx->timearray);
+    return (pos);
 }
 
 /*****************************************************************************************/
 
-static int compar_histent(const void *s1, const void *s2)
-{
-    GwTime key, obj, delta;
-    GwHistEnt *cpos;
-    int rv;
-
-    key = *((GwTime *)s1);
-    obj = (cpos = (*((GwHistEnt **)s2)))->time;
-
-    if ((obj <= key) && (obj > GLOBALS->max_compare_time_bsearch_c_1)) {
-        GLOBALS->max_compare_time_bsearch_c_1 = obj;
-        GLOBALS->max_compare_pos_bsearch_c_1 = cpos;
-        GLOBALS->max_compare_index = (GwHistEnt **)s2;
-    }
-
-    delta = key - obj;
-    if (delta < 0)
-        rv = -1;
-    else if (delta > 0)
-        rv = 1;
-    else
-        rv = 0;
-
-    return (rv);
-}
-
 GwHistEnt *bsearch_node(GwNode *n, GwTime key)
 {
-    GLOBALS->max_compare_time_bsearch_c_1 = -2;
-    GLOBALS->max_compare_pos_bsearch_c_1 = NULL;
-    GLOBALS->max_compare_index = NULL;
+    GwHistCursor cursor;
 
-    if (bsearch(&key, n->harray, n->numhist, sizeof(GwHistEnt *), compar_histent)) {
-        /* nothing, all side effects are in bsearch */
-    }
+    gw_hist_cursor_init_node(&cursor, n);
+    gw_hist_cursor_seek(&cursor, key);
 
-    if ((!GLOBALS->max_compare_pos_bsearch_c_1) ||
-        (GLOBALS->max_compare_time_bsearch_c_1 < GW_TIME_CONSTANT(0))) {
-        GLOBALS->max_compare_pos_bsearch_c_1 = n->harray[1]; /* aix bsearch fix */
-        GLOBALS->max_compare_index = &(n->harray[1]);
-    }
-
-    while (GLOBALS->max_compare_pos_bsearch_c_1->next) /* non-RoSync dumper deglitching fix */
-    {
-        if (GLOBALS->max_compare_pos_bsearch_c_1->time !=
-            GLOBALS->max_compare_pos_bsearch_c_1->next->time)
-            break;
-        GLOBALS->max_compare_pos_bsearch_c_1 = GLOBALS->max_compare_pos_bsearch_c_1->next;
-    }
-
-    return (GLOBALS->max_compare_pos_bsearch_c_1);
+    return (gw_hist_cursor_get_hist_ent(&cursor));
 }
 
 /*****************************************************************************************/
 
-static int compar_vectorent(const void *s1, const void *s2)
-{
-    GwTime key, obj, delta;
-    GwVectorEnt *cpos;
-    int rv;
-
-    key = *((GwTime *)s1);
-    /* obj=(cpos=(*((GwVectorEnt **)s2)))->time+GLOBALS->shift_timebase; */
-
-    obj = (cpos = (*((GwVectorEnt **)s2)))->time;
-
-    if ((obj <= key) && (obj > GLOBALS->vmax_compare_time_bsearch_c_1)) {
-        GLOBALS->vmax_compare_time_bsearch_c_1 = obj;
-        GLOBALS->vmax_compare_pos_bsearch_c_1 = cpos;
-        GLOBALS->vmax_compare_index = (GwVectorEnt **)s2;
-    }
-
-    delta = key - obj;
-    if (delta < 0)
-        rv = -1;
-    else if (delta > 0)
-        rv = 1;
-    else
-        rv = 0;
-
-    return (rv);
-}
-
 GwVectorEnt *bsearch_vector(GwBitVector *b, GwTime key)
 {
-    GLOBALS->vmax_compare_time_bsearch_c_1 = -2;
-    GLOBALS->vmax_compare_pos_bsearch_c_1 = NULL;
-    GLOBALS->vmax_compare_index = NULL;
+    GwHistCursor cursor;
 
-    if (bsearch(&key, b->vectors, b->numregions, sizeof(GwVectorEnt *), compar_vectorent)) {
-        /* nothing, all side effects are in bsearch */
-    }
-
-    if ((!GLOBALS->vmax_compare_pos_bsearch_c_1) ||
-        (GLOBALS->vmax_compare_time_bsearch_c_1 < GW_TIME_CONSTANT(0))) {
-        /* ignore warning: array index of '1' indexes past the end of an array (that contains 1
-         * elements) [-Warray-bounds] */
-        /* because this array is allocated with size > that declared in the structure definition via
-         * end of structure malloc padding */
-        GLOBALS->vmax_compare_pos_bsearch_c_1 = b->vectors[1]; /* aix bsearch fix */
-        GLOBALS->vmax_compare_index = &(b->vectors[1]);
-    }
-
-    while (GLOBALS->vmax_compare_pos_bsearch_c_1->next) /* non-RoSync dumper deglitching fix */
-    {
-        if (GLOBALS->vmax_compare_pos_bsearch_c_1->time !=
-            GLOBALS->vmax_compare_pos_bsearch_c_1->next->time)
-            break;
-        GLOBALS->vmax_compare_pos_bsearch_c_1 = GLOBALS->vmax_compare_pos_bsearch_c_1->next;
-    }
+    gw_hist_cursor_init_vector(&cursor, b);
+    gw_hist_cursor_seek(&cursor, key);
 
-    return (GLOBALS->vmax_compare_pos_bsearch_c_1);
+    return (gw_hist_cursor_get_vector_ent(&cursor));
 }
 
 /*****************************************************************************************/
@@ -34,6 +34,8 @@ static GwDumpFile *load(GwLoader *loader, const gchar *fname)
         exit(EXIT_FAILURE);
     }
 
+    gw_dump_file_set_memory_budget(file, GLOBALS->settings.memory_budget * 1024 * 1024);
+
     return file;
 }
 
@@ -49,6 +51,7 @@ GwDumpFile *vcd_recoder_main(char *fname)
                                               global_settings->vlist_compression_level);
     gw_vcd_loader_set_warning_filesize(GW_VCD_LOADER(loader),
                                        global_settings->vcd_warning_filesize);
+    gw_vcd_loader_set_use_cache(GW_VCD_LOADER(loader), global_settings->vcd_cache);
 
     GwDumpFile *file = load(loader, fname);
 
@@ -109,17 +109,17 @@ static void edge_search_2(int direction, int is_last_iteration)
                 GLOBALS->shift_timebase = t->shift;
                 if (!(t->vector)) {
                     GwHistEnt *h;
-                    GwHistEnt **hp;
+                    GwHistCursor cursor;
                     GwUTime utt;
                     GwTime tt;
 
-                    /* h= */ bsearch_node(t->n.nd, basetime - t->shift); /* scan-build */
-                    hp = GLOBALS->max_compare_index;
-                    if ((hp == &(t->n.nd->harray[1])) || (hp == &(t->n.nd->harray[0])))
+                    gw_hist_cursor_init_node(&cursor, t->n.nd);
+                    if (gw_hist_cursor_seek(&cursor, basetime - t->shift) <= 1)
                         return;
-                    if (basetime == ((*hp)->time + GLOBALS->shift_timebase))
-                        hp--;
-                    h = *hp;
+                    if (basetime == (gw_hist_cursor_get_hist_ent(&cursor)->time +
+                                     GLOBALS->shift_timebase))
+                        gw_hist_cursor_seek_near(&cursor, basetime - t->shift - 1);
+                    h = gw_hist_cursor_get_hist_ent(&cursor);
                     s->his.h = h;
                     utt = strace_adjust(h->time, GLOBALS->shift_timebase);
                     tt = utt;
@@ -127,17 +127,17 @@ static void edge_search_2(int direction, int is_last_iteration)
                         maxbase = tt;
                 } else {
                     GwVectorEnt *v;
-                    GwVectorEnt **vp;
+                    GwHistCursor cursor;
                     GwUTime utt;
                     GwTime tt;
 
-                    /* v= */ bsearch_vector(t->n.vec, basetime - t->shift); /* scan-build */
-                    vp = GLOBALS->vmax_compare_index;
-                    if ((vp == &(t->n.vec->vectors[1])) || (vp == &(t->n.vec->vectors[0])))
+                    gw_hist_cursor_init_vector(&cursor, t->n.vec);
+                    if (gw_hist_cursor_seek(&cursor, basetime - t->shift) <= 1)
                         return;
-                    if (basetime == ((*vp)->time + GLOBALS->shift_timebase))
-                        vp--;
-                    v = *vp;
+                    if (basetime == (gw_hist_cursor_get_vector_ent(&cursor)->time +
+                                     GLOBALS->shift_timebase))
+                        gw_hist_cursor_seek_near(&cursor, basetime - t->shift - 1);
+                    v = gw_hist_cursor_get_vector_ent(&cursor);
                     s->his.v = v;
                     utt = strace_adjust(v->time, GLOBALS->shift_timebase);
                     tt = utt;
@@ -313,7 +313,7 @@ static void edge_search_2(int direction, int is_last_iteration)
                             }
                         }
                     } else {
-                        chval = convert_ascii_vec(t, s->his.h->v.h_vector);
+                        chval = convert_ascii_hist(t, s->his.h);
                     }
                 }
 
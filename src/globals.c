@@ -82,14 +82,6 @@ static const struct Global globals_base_values = {
      */
     GW_TIME_CONSTANT(0), /* shift_timebase 10 */
     GW_TIME_CONSTANT(0), /* shift_timebase_default_for_add 11 */
-    0, /* max_compare_time_tc_bsearch_c_1 12 */
-    0, /* max_compare_pos_tc_bsearch_c_1 13 */
-    0, /* max_compare_time_bsearch_c_1 14 */
-    0, /* max_compare_pos_bsearch_c_1 15 */
-    0, /* max_compare_index 16 */
-    0, /* vmax_compare_time_bsearch_c_1 17 */
-    0, /* vmax_compare_pos_bsearch_c_1 18 */
-    0, /* vmax_compare_index 19 */
     0, /* maxlen_trunc 20 */
     0, /* maxlen_trunc_pos_bsearch_c_1 21 */
     0, /* trunc_asciibase_bsearch_c_1 22 */
@@ -395,6 +387,10 @@ static const struct Global globals_base_values = {
     NULL, /* signalfont 370 */
     0, /* max_signal_name_pixel_width 372 */
     0, /* signal_pixmap_width 373 */
+    NULL, /* signal_name_widths */
+    NULL, /* signal_value_widths */
+    0, /* signal_width_epoch */
+    0, /* signal_value_generation */
     1, /* fontheight 376 */
     0, /* dnd_state 377 */
     0, /* cached_mouseover_x */
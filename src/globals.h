@@ -78,6 +78,9 @@ typedef struct
     gboolean preserve_glitches_real;
 
     gsize vcd_warning_filesize;
+    gboolean vcd_cache;
+
+    gsize memory_budget; /* in MB, 0 means no limit */
 } Settings;
 
 struct Global
@@ -111,14 +114,6 @@ struct Global
      */
     GwTime shift_timebase; /* from bsearch.c 10 */
     GwTime shift_timebase_default_for_add; /* from bsearch.c 11 */
-    GwTime max_compare_time_tc_bsearch_c_1; /* from bsearch.c 12 */
-    GwTime *max_compare_pos_tc_bsearch_c_1; /* from bsearch.c 13 */
-    GwTime max_compare_time_bsearch_c_1; /* from bsearch.c 14 */
-    GwHistEnt *max_compare_pos_bsearch_c_1; /* from bsearch.c 15 */
-    GwHistEnt **max_compare_index; /* from bsearch.c 16 */
-    GwTime vmax_compare_time_bsearch_c_1; /* from bsearch.c 17 */
-    GwVectorEnt *vmax_compare_pos_bsearch_c_1; /* from bsearch.c 18 */
-    GwVectorEnt **vmax_compare_index; /* from bsearch.c 19 */
     int maxlen_trunc; /* from bsearch.c 20 */
     char *maxlen_trunc_pos_bsearch_c_1; /* from bsearch.c 21 */
     char *trunc_asciibase_bsearch_c_1; /* from bsearch.c 22 */
@@ -432,6 +427,10 @@ struct Global
     struct font_engine_font_t *signalfont; /* from signalwindow.c 397 */
     int max_signal_name_pixel_width; /* from signalwindow.c 399 */
     int signal_pixmap_width; /* from signalwindow.c 400 */
+    struct signal_width_set *signal_name_widths; /* from wavewindow.c */
+    struct signal_width_set *signal_value_widths; /* from wavewindow.c */
+    guint signal_width_epoch; /* from wavewindow.c */
+    guint signal_value_generation; /* from wavewindow.c */
     int fontheight; /* from signalwindow.c 404 */
     char dnd_state; /* from signalwindow.c 405 */
     gint cached_mouseover_x; /* from signalwindow.c */
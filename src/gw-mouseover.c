@@ -149,7 +149,7 @@ static gchar *local_trace_asciival(GwTrace *t, GwTime tim)
                             str = convert_ascii_string((char *)h_ptr->v.h_vector);
                         }
                     } else {
-                        str = convert_ascii_vec(t, h_ptr->v.h_vector);
+                        str = convert_ascii_hist(t, h_ptr);
                     }
 
                     return str;
@@ -5,11 +5,40 @@
 
 G_BEGIN_DECLS
 
+/* display settings which are not part of the traces but change how a row tile looks */
+typedef struct
+{
+    GwWaveformColors colors;
+    gdouble line_width;
+    gint vector_padding;
+    gboolean disable_antialiasing;
+    gchar highlight_wavewindow;
+    gchar fill_waveform;
+    gchar display_grid;
+    gchar enable_horiz_grid;
+    gchar black_and_white;
+    gchar use_roundcaps;
+    gchar keep_xz_colors;
+} GwRowTileStyle;
+
 struct _GwWaveView
 {
     GtkDrawingArea parent_instance;
 
     cairo_surface_t *traces_surface;
+    cairo_surface_t *scroll_surface; /* back buffer for shifting traces_surface */
+
+    GHashTable *row_tiles; /* per trace row renderings, see gw-wave-view-traces.c */
+    guint64 row_tiles_frame;
+    GwRowTileStyle row_tiles_style; /* settings the cached tiles were rendered with */
+
+    /* state of traces_surface, used to only render the exposed strip on scrolling */
+    GwTime rendered_start;
+    gdouble rendered_nspx;
+    gint rendered_width;
+    gboolean scroll_pending;
+    gboolean rendering_strip;
+    guint settle_source;
 
     gboolean dirty;
 };
@@ -1,4 +1,5 @@
 #include <config.h>
+#include <string.h>
 #include <gtk/gtk.h>
 #include "cairo.h"
 #include "gw-wave-view.h"
@@ -133,6 +134,173 @@ static void draw_vptr_trace(GwWaveView *self,
                             GwVectorEnt *v,
                             int which);
 
+// Rows are cached as tiles which extend a little bit past the row boundaries to include
+// the horizontal grid line and highlight box of the row.
+#define ROW_TILE_MARGIN (3)
+
+typedef struct
+{
+    GwTrace *trace;
+    GwTime start;
+    gdouble nspx;
+    gint width;
+    gint fontheight;
+    guint64 flags;
+    gint color;
+} RowTileKey;
+
+typedef struct
+{
+    cairo_surface_t *surface;
+    guint64 last_used;
+} RowTile;
+
+static guint row_tile_key_hash(gconstpointer v)
+{
+    const RowTileKey *key = v;
+
+    return g_direct_hash(key->trace) ^ g_int64_hash(&key->start) ^ g_double_hash(&key->nspx) ^
+           (guint)key->flags ^ ((guint)key->width << 8) ^ (guint)key->fontheight ^
+           ((guint)key->color << 24);
+}
+
+static gboolean row_tile_key_equal(gconstpointer a, gconstpointer b)
+{
+    const RowTileKey *ka = a;
+    const RowTileKey *kb = b;
+
+    return ka->trace == kb->trace && ka->start == kb->start && ka->nspx == kb->nspx &&
+           ka->width == kb->width && ka->fontheight == kb->fontheight && ka->flags == kb->flags &&
+           ka->color == kb->color;
+}
+
+static void row_tile_free(gpointer data)
+{
+    RowTile *tile = data;
+
+    cairo_surface_destroy(tile->surface);
+    g_free(tile);
+}
+
+GHashTable *gw_wave_view_row_tiles_new(void)
+{
+    return g_hash_table_new_full(row_tile_key_hash, row_tile_key_equal, g_free, row_tile_free);
+}
+
+// Analog traces span multiple rows and transaction traces draw into the following blank
+// rows, so only single row traces can be cached.
+static gboolean row_tile_is_cacheable(GwTrace *t)
+{
+    return !(t->flags & (TR_ANALOGMASK | TR_TTRANSLATED));
+}
+
+static void render_row(GwWaveView *self,
+                       cairo_t *cr,
+                       GwWaveformColors *colors,
+                       GwTrace *t,
+                       int which)
+{
+    GLOBALS->shift_timebase = t->shift;
+    if (!t->vector) {
+        GwHistEnt *h = bsearch_node(t->n.nd, GLOBALS->tims.start - t->shift);
+
+        if (!t->n.nd->extvals) {
+            draw_hptr_trace(self, cr, colors, t, h, which, 1, 0);
+        } else {
+            draw_hptr_trace_vector(self, cr, colors, t, h, which);
+        }
+    } else {
+        GwVectorEnt *v = bsearch_vector(t->n.vec, GLOBALS->tims.start - t->shift);
+
+        draw_vptr_trace(self, cr, colors, t, v, which);
+    }
+}
+
+// Draws a row from the tile cache. The geometry of a row only depends on its trace,
+// the visible time window, the zoom level and the format flags, not on the row position,
+// so vertical scrolling and selection changes only need to render the rows that changed.
+static void render_row_cached(GwWaveView *self,
+                              cairo_t *cr,
+                              GwWaveformColors *colors,
+                              GwTrace *t,
+                              int which)
+{
+    RowTileKey key = {
+        .trace = t,
+        .start = GLOBALS->tims.start,
+        .nspx = GLOBALS->nspx,
+        .width = GLOBALS->wavewidth,
+        .fontheight = GLOBALS->fontheight,
+        .flags = t->flags,
+        .color = t->t_color,
+    };
+    gint tile_y = (which + 1) * GLOBALS->fontheight - ROW_TILE_MARGIN;
+    gint tile_height = GLOBALS->fontheight + 2 * ROW_TILE_MARGIN;
+
+    RowTile *tile = g_hash_table_lookup(self->row_tiles, &key);
+    if (tile == NULL) {
+        tile = g_new0(RowTile, 1);
+        tile->surface = cairo_surface_create_similar(cairo_get_target(cr),
+                                                     CAIRO_CONTENT_COLOR_ALPHA,
+                                                     GLOBALS->wavewidth,
+                                                     tile_height);
+
+        cairo_t *tile_cr = cairo_create(tile->surface);
+        cairo_set_line_width(tile_cr, cairo_get_line_width(cr));
+        cairo_set_line_cap(tile_cr, cairo_get_line_cap(cr));
+        cairo_set_antialias(tile_cr, cairo_get_antialias(cr));
+        cairo_translate(tile_cr, 0.0, -tile_y);
+
+        render_row(self, tile_cr, colors, t, which);
+
+        cairo_destroy(tile_cr);
+
+        g_hash_table_insert(self->row_tiles, g_memdup2(&key, sizeof(key)), tile);
+    }
+
+    tile->last_used = self->row_tiles_frame;
+
+    cairo_set_source_surface(cr, tile->surface, 0.0, tile_y);
+    cairo_rectangle(cr, 0.0, tile_y, GLOBALS->wavewidth, tile_height);
+    cairo_fill(cr);
+}
+
+// The menus change the display settings (grid, highlight, fill, colors, ...) without touching
+// the traces, so instead of keying every tile on them all tiles are dropped once the settings
+// differ from those the tiles were rendered with.
+static void row_tiles_check_style(GwWaveView *self)
+{
+    GwRowTileStyle style;
+
+    memset(&style, 0, sizeof(style)); // the padding is compared as well
+    style.colors = *gw_color_theme_get_waveform_colors(GLOBALS->color_theme);
+    style.line_width = GLOBALS->cr_line_width;
+    style.vector_padding = GLOBALS->vector_padding;
+    style.disable_antialiasing = GLOBALS->disable_antialiasing;
+    style.highlight_wavewindow = GLOBALS->highlight_wavewindow;
+    style.fill_waveform = GLOBALS->fill_waveform;
+    style.display_grid = GLOBALS->display_grid;
+    style.enable_horiz_grid = GLOBALS->enable_horiz_grid;
+    style.black_and_white = GLOBALS->black_and_white;
+    style.use_roundcaps = GLOBALS->use_roundcaps;
+    style.keep_xz_colors = GLOBALS->keep_xz_colors;
+
+    if (memcmp(&style, &self->row_tiles_style, sizeof(style)) != 0) {
+        g_hash_table_remove_all(self->row_tiles);
+        memcpy(&self->row_tiles_style, &style, sizeof(style));
+    }
+}
+
+static gboolean row_tile_is_stale(gpointer key, gpointer value, gpointer user_data)
+{
+    (void)key;
+
+    RowTile *tile = value;
+    GwWaveView *self = user_data;
+
+    return tile->last_used != self->row_tiles_frame;
+}
+
 void gw_wave_view_render_traces(GwWaveView *self, cairo_t *cr)
 {
     GwTrace *t = gw_signal_list_get_trace(GW_SIGNAL_LIST(GLOBALS->signalarea), 0);
@@ -149,6 +317,9 @@ void gw_wave_view_render_traces(GwWaveView *self, cairo_t *cr)
         num_traces_displayable = allocation.height / (GLOBALS->fontheight);
         num_traces_displayable--; /* for the time trace that is always there */
 
+        self->row_tiles_frame++;
+        row_tiles_check_style(self);
+
         /* ensure that transaction traces are visible even if the topmost traces are blanks */
         while (tback) {
             if (tback->flags & (TR_BLANK | TR_ANALOG_BLANK_STRETCH)) {
@@ -180,7 +351,11 @@ void gw_wave_view_render_traces(GwWaveView *self, cairo_t *cr)
 
             if (!(t->flags & (TR_EXCLUDE | TR_BLANK | TR_ANALOG_BLANK_STRETCH))) {
                 GLOBALS->shift_timebase = t->shift;
-                if (!t->vector) {
+                if (!self->rendering_strip && row_tile_is_cacheable(t)) {
+                    if (i >= 0) {
+                        render_row_cached(self, cr, colors, t, i);
+                    }
+                } else if (!t->vector) {
                     h = bsearch_node(t->n.nd, GLOBALS->tims.start - t->shift);
                     DEBUG(printf("Start time: %" GW_TIME_FORMAT ", Histent time: %" GW_TIME_FORMAT
                                  "\n",
@@ -253,6 +428,11 @@ void gw_wave_view_render_traces(GwWaveView *self, cairo_t *cr)
                 g_free(colors);
             }
         }
+
+        /* keep the tiles of roughly two pages around for scrolling back and forth */
+        if (g_hash_table_size(self->row_tiles) > (guint)MAX(2 * num_traces_displayable, 64)) {
+            g_hash_table_foreach_remove(self->row_tiles, row_tile_is_stale, self);
+        }
     }
 }
 
@@ -676,7 +856,7 @@ static void draw_hptr_trace_vector_analog(GwWaveView *self,
                             tv = h3->v.h_double;
                     } else {
                         if (h3->time <= GLOBALS->tims.last)
-                            tv = convert_real_vec(t, h3->v.h_vector);
+                            tv = convert_real_hist(t, h3);
                     }
 
                     if (!isnan(tv) && !isinf(tv)) {
@@ -750,7 +930,7 @@ static void draw_hptr_trace_vector_analog(GwWaveView *self,
                     tv = h3->v.h_double;
             } else {
                 if (h3->time <= GLOBALS->tims.last)
-                    tv = convert_real_vec(t, h3->v.h_vector);
+                    tv = convert_real_hist(t, h3);
             }
 
             if (!isnan(tv) && !isinf(tv)) {
@@ -842,7 +1022,7 @@ static void draw_hptr_trace_vector_analog(GwWaveView *self,
 
         /* draw trans */
         type = (!(h->flags & (GW_HIST_ENT_FLAG_REAL | GW_HIST_ENT_FLAG_STRING)))
-                   ? vtype(t, h->v.h_vector)
+                   ? vtype_hist(t, h)
                    : GW_BIT_COUNT;
         tv = tv2 = mynan;
 
@@ -851,7 +1031,7 @@ static void draw_hptr_trace_vector_analog(GwWaveView *self,
                 tv = h->v.h_double;
         } else {
             if (h->time <= GLOBALS->tims.last)
-                tv = convert_real_vec(t, h->v.h_vector);
+                tv = convert_real_hist(t, h);
         }
 
         if (h2->flags & GW_HIST_ENT_FLAG_REAL) {
@@ -859,7 +1039,7 @@ static void draw_hptr_trace_vector_analog(GwWaveView *self,
                 tv2 = h2->v.h_double;
         } else {
             if (h2->time <= GLOBALS->tims.last)
-                tv2 = convert_real_vec(t, h2->v.h_vector);
+                tv2 = convert_real_hist(t, h2);
         }
 
         if ((is_inf = isinf(tv))) {
@@ -1188,7 +1368,7 @@ static void draw_hptr_trace_vector(GwWaveView *self,
 
         /* draw trans */
         if (!(h->flags & (GW_HIST_ENT_FLAG_REAL | GW_HIST_ENT_FLAG_STRING))) {
-            type = vtype(t, h->v.h_vector);
+            type = vtype_hist(t, h);
         } else {
             /* s\000 ID is special "z" case */
             type = GW_BIT_COUNT;
@@ -1208,7 +1388,7 @@ static void draw_hptr_trace_vector(GwWaveView *self,
             }
         }
         /* type = (!(h->flags&(GW_HIST_ENT_FLAG_REAL|GW_HIST_ENT_FLAG_STRING))) ?
-         * vtype(t,h->v.h_vector) : GW_BIT_COUNT; */
+         * vtype_hist(t,h) : GW_BIT_COUNT; */
 
         if (_x0 != _x1) {
             if (type == GW_BIT_Z) {
@@ -1308,7 +1488,7 @@ static void draw_hptr_trace_vector(GwWaveView *self,
                             ascii = convert_ascii_string((char *)h->v.h_vector);
                         }
                     } else {
-                        ascii = convert_ascii_vec(t, h->v.h_vector);
+                        ascii = convert_ascii_hist(t, h);
                     }
 
                     ascii2 = ascii;
@@ -1373,7 +1553,7 @@ static void draw_hptr_trace_vector(GwWaveView *self,
                             ascii = convert_ascii_string((char *)h->v.h_vector);
                         }
                     } else {
-                        ascii = convert_ascii_vec(t, h->v.h_vector);
+                        ascii = convert_ascii_hist(t, h);
                     }
 
                     /* ascii2 = ascii; */ /* scan-build */
@@ -5,6 +5,7 @@
 
 G_BEGIN_DECLS
 
+GHashTable *gw_wave_view_row_tiles_new(void);
 void gw_wave_view_render_traces(GwWaveView *self, cairo_t *cr);
 
 G_END_DECLS
@@ -1,4 +1,5 @@
 #include <config.h>
+#include <math.h>
 #include "cairo.h"
 #include "gw-wave-view.h"
 #include "gw-wave-view-private.h"
@@ -597,6 +598,115 @@ static void draw_named_markers(GwWaveView *self, cairo_t *cr, GwWaveformColors *
     // }
 }
 
+static void render_traces_area(GwWaveView *self, cairo_t *traces_cr, GwWaveformColors *colors)
+{
+    cairo_set_line_width(traces_cr, GLOBALS->cr_line_width);
+    cairo_set_line_cap(traces_cr, CAIRO_LINE_CAP_SQUARE);
+
+    GwBlackoutRegions *blackout_regions = gw_dump_file_get_blackout_regions(GLOBALS->dump_file);
+
+    RenderBlackoutData data = {.cr = traces_cr, .colors = colors};
+    gw_blackout_regions_foreach(blackout_regions, renderblackout, &data);
+
+    if (GLOBALS->disable_antialiasing) {
+        cairo_set_antialias(traces_cr, CAIRO_ANTIALIAS_NONE);
+    }
+    gw_wave_view_render_traces(self, traces_cr);
+}
+
+static gboolean settle_scroll(gpointer user_data)
+{
+    GwWaveView *self = user_data;
+
+    self->settle_source = 0;
+    gw_wave_view_redraw_rows(self);
+
+    return G_SOURCE_REMOVE;
+}
+
+// Reuses the previous frame after a horizontal scroll: the traces surface is shifted by the
+// pixel delta and only the newly exposed strip is rendered, using a time window which is
+// clipped to that strip. This is only possible if the zoom is unchanged and the delta and the
+// strip start are whole pixels and the view actually moved, otherwise FALSE is returned and a
+// full redraw is needed.
+static gboolean scroll_traces_surface(GwWaveView *self, GwWaveformColors *colors)
+{
+    gint width = GLOBALS->wavewidth;
+    gint height = GLOBALS->waveheight;
+
+    if (self->scroll_surface == NULL || self->rendered_nspx != GLOBALS->nspx ||
+        self->rendered_width != width) {
+        return FALSE;
+    }
+
+    // an unchanged start time is how the menu toggles (grid, highlight, fill, fullscreen) ask
+    // for a repaint, the old frame is out of date then
+    GwTime delta = GLOBALS->tims.start - self->rendered_start;
+    if (delta == 0) {
+        return FALSE;
+    }
+
+    gdouble dx_exact = delta * GLOBALS->pxns;
+    gint dx = (gint)round(dx_exact);
+    if (fabs(dx_exact - dx) > 1e-6 || ABS(dx) >= width) {
+        return FALSE;
+    }
+
+    gint x0 = dx > 0 ? width - dx : 0;
+    gint x1 = dx > 0 ? width : -dx;
+
+    // the strip has to start on an integer time, widen it to the left if necessary
+    gint x0_min = MAX(x0 - 64, 0);
+    while (x0 > x0_min && x0 * GLOBALS->nspx != floor(x0 * GLOBALS->nspx)) {
+        x0--;
+    }
+    if (x0 * GLOBALS->nspx != floor(x0 * GLOBALS->nspx)) {
+        return FALSE;
+    }
+
+    cairo_t *cr = cairo_create(self->scroll_surface);
+
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+    cairo_set_source_surface(cr, self->traces_surface, -dx, 0.0);
+    cairo_paint(cr);
+
+    cairo_rectangle(cr, x0, 0.0, x1 - x0, height);
+    cairo_clip(cr);
+    cairo_set_source_rgba(cr, 0.0, 0.0, 0.0, 0.0);
+    cairo_paint(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+    cairo_translate(cr, x0, 0.0);
+
+    GwTime start = GLOBALS->tims.start;
+    GwTime end = GLOBALS->tims.end;
+    gint wavewidth = GLOBALS->wavewidth;
+
+    GLOBALS->tims.start = start + (GwTime)(x0 * GLOBALS->nspx);
+    GLOBALS->wavewidth = x1 - x0;
+    GLOBALS->tims.end = GLOBALS->tims.start + GLOBALS->nspx * GLOBALS->wavewidth;
+    self->rendering_strip = TRUE;
+
+    render_traces_area(self, cr, colors);
+
+    self->rendering_strip = FALSE;
+    GLOBALS->tims.start = start;
+    GLOBALS->tims.end = end;
+    GLOBALS->wavewidth = wavewidth;
+
+    cairo_destroy(cr);
+
+    cairo_surface_t *tmp = self->traces_surface;
+    self->traces_surface = self->scroll_surface;
+    self->scroll_surface = tmp;
+
+    // vector values are centered in the visible part of their boxes, so the text near the
+    // strip boundary is only approximate. Render everything once scrolling has stopped.
+    g_clear_handle_id(&self->settle_source, g_source_remove);
+    self->settle_source = g_timeout_add(250, settle_scroll, self);
+
+    return TRUE;
+}
+
 static gboolean gw_wave_view_draw(GtkWidget *widget, cairo_t *cr)
 {
     GwWaveView *self = GW_WAVE_VIEW(widget);
@@ -628,32 +738,30 @@ static gboolean gw_wave_view_draw(GtkWidget *widget, cairo_t *cr)
 
         GLOBALS->tims.end = GLOBALS->tims.start + GLOBALS->nspx * GLOBALS->wavewidth;
 
-        cairo_t *traces_cr = cairo_create(self->traces_surface);
+        if (!(self->scroll_pending && scroll_traces_surface(self, colors))) {
+            cairo_t *traces_cr = cairo_create(self->traces_surface);
 
-        cairo_set_operator(traces_cr, CAIRO_OPERATOR_SOURCE);
-        cairo_set_source_rgba(traces_cr, 0.0, 0.0, 0.0, 0.0);
-        cairo_paint(traces_cr);
-        cairo_set_operator(traces_cr, CAIRO_OPERATOR_OVER);
+            cairo_set_operator(traces_cr, CAIRO_OPERATOR_SOURCE);
+            cairo_set_source_rgba(traces_cr, 0.0, 0.0, 0.0, 0.0);
+            cairo_paint(traces_cr);
+            cairo_set_operator(traces_cr, CAIRO_OPERATOR_OVER);
 
-        cairo_set_line_width(traces_cr, GLOBALS->cr_line_width);
-        cairo_set_line_cap(traces_cr, CAIRO_LINE_CAP_SQUARE);
+            render_traces_area(self, traces_cr, colors);
 
-        GwBlackoutRegions *blackout_regions = gw_dump_file_get_blackout_regions(GLOBALS->dump_file);
+            cairo_destroy(traces_cr);
 
-        RenderBlackoutData data = {.cr = traces_cr, .colors = colors};
-        gw_blackout_regions_foreach(blackout_regions, renderblackout, &data);
-
-        if (GLOBALS->disable_antialiasing) {
-            cairo_set_antialias(traces_cr, CAIRO_ANTIALIAS_NONE);
+            g_clear_handle_id(&self->settle_source, g_source_remove);
         }
-        gw_wave_view_render_traces(self, traces_cr);
 
-        cairo_destroy(traces_cr);
+        self->rendered_start = GLOBALS->tims.start;
+        self->rendered_nspx = GLOBALS->nspx;
+        self->rendered_width = GLOBALS->wavewidth;
 
         // gdouble time = g_timer_elapsed(timer, NULL);
         // g_printerr("Draw: %f\n", time);
         // g_timer_destroy(timer);
 
+        self->scroll_pending = FALSE;
         self->dirty = FALSE;
     }
 
@@ -707,6 +815,8 @@ static void gw_wave_view_size_allocate(GtkWidget *widget, GtkAllocation *allocat
     GLOBALS->waveheight = allocation->height;
 
     g_clear_pointer(&self->traces_surface, cairo_surface_destroy);
+    g_clear_pointer(&self->scroll_surface, cairo_surface_destroy);
+    g_hash_table_remove_all(self->row_tiles);
 
     scale = gtk_widget_get_scale_factor(widget);
 
@@ -715,14 +825,35 @@ static void gw_wave_view_size_allocate(GtkWidget *widget, GtkAllocation *allocat
                                                                    allocation->width * scale,
                                                                    allocation->height * scale,
                                                                    scale);
+    self->scroll_surface = gdk_window_create_similar_image_surface(gtk_widget_get_window(widget),
+                                                                   CAIRO_FORMAT_ARGB32,
+                                                                   allocation->width * scale,
+                                                                   allocation->height * scale,
+                                                                   scale);
 
+    self->scroll_pending = FALSE;
     self->dirty = TRUE;
 }
 
+static void gw_wave_view_finalize(GObject *object)
+{
+    GwWaveView *self = GW_WAVE_VIEW(object);
+
+    g_clear_handle_id(&self->settle_source, g_source_remove);
+    g_clear_pointer(&self->traces_surface, cairo_surface_destroy);
+    g_clear_pointer(&self->scroll_surface, cairo_surface_destroy);
+    g_clear_pointer(&self->row_tiles, g_hash_table_unref);
+
+    G_OBJECT_CLASS(gw_wave_view_parent_class)->finalize(object);
+}
+
 static void gw_wave_view_class_init(GwWaveViewClass *klass)
 {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
     GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
 
+    object_class->finalize = gw_wave_view_finalize;
+
     widget_class->configure_event = gw_wave_view_configure_event;
     widget_class->size_allocate = gw_wave_view_size_allocate;
     widget_class->draw = gw_wave_view_draw;
@@ -739,6 +870,7 @@ static void gw_wave_view_init(GwWaveView *self)
 #endif
     );
 
+    self->row_tiles = gw_wave_view_row_tiles_new();
     self->dirty = TRUE;
 }
 
@@ -751,6 +883,31 @@ void gw_wave_view_force_redraw(GwWaveView *self)
 {
     g_return_if_fail(GW_IS_WAVE_VIEW(self));
 
+    g_hash_table_remove_all(self->row_tiles);
+
+    self->scroll_pending = FALSE;
+    self->dirty = TRUE;
+    gtk_widget_queue_draw(GTK_WIDGET(self));
+}
+
+// Redraws the traces but keeps the cached row tiles. Only use this if the trace data and
+// the rendering settings are unchanged, e.g. for vertical scrolling or selection changes.
+void gw_wave_view_redraw_rows(GwWaveView *self)
+{
+    g_return_if_fail(GW_IS_WAVE_VIEW(self));
+
+    self->scroll_pending = FALSE;
+    self->dirty = TRUE;
+    gtk_widget_queue_draw(GTK_WIDGET(self));
+}
+
+// Redraws after the visible start time has changed. If nothing else changed in the meantime
+// the previous frame is shifted and only the newly exposed strip is rendered.
+void gw_wave_view_scroll(GwWaveView *self)
+{
+    g_return_if_fail(GW_IS_WAVE_VIEW(self));
+
+    self->scroll_pending = self->scroll_pending || !self->dirty;
     self->dirty = TRUE;
     gtk_widget_queue_draw(GTK_WIDGET(self));
 }
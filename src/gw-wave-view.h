@@ -9,5 +9,7 @@ G_DECLARE_FINAL_TYPE(GwWaveView, gw_wave_view, GW, WAVE_VIEW, GtkDrawingArea)
 
 GtkWidget *gw_wave_view_new(void);
 void gw_wave_view_force_redraw(GwWaveView *self);
+void gw_wave_view_redraw_rows(GwWaveView *self);
+void gw_wave_view_scroll(GwWaveView *self);
 
 G_END_DECLS
\ No newline at end of file
@@ -22,15 +22,45 @@
 
 #include <config.h>
 #include <fstapi.h>
+#include <glib.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
 
 #ifdef HAVE_GETOPT_H
 #include <getopt.h>
 #endif
 
 #include "wave_locale.h"
+#include "fst_slices.h"
 
 #define FST_VCD_WRITE_BUF_SIZ (2 * 1024 * 1024)
 
+/*
+ * parallel conversion (-j), see fst_slices.h
+ *
+ * a worker formats the value changes of its slice into a memory buffer, the main thread writes
+ * the changes at the head of the slice and the buffers in order with large write() calls.
+ */
+typedef struct
+{
+    char *id; /* vcd identifier as emitted in the header */
+    unsigned char is_real;
+} VcdVar;
+
+typedef struct
+{
+    VcdVar *vars;
+    int fd;
+    GString *head;
+} ParallelContext;
+
+typedef struct
+{
+    GString *text; /* the changes after the head */
+    uint64_t last_time;
+} SliceText;
+
 void print_help(char *nam)
 {
 #ifdef __linux__
@@ -38,6 +68,7 @@ void print_help(char *nam)
            "  -f, --fstname=FILE         specify FST input filename\n"
            "  -o, --output=FILE          specify output filename\n"
            "  -e, --extensions           emit FST extensions to VCD\n"
+           "  -j, --jobs=N               convert on N threads\n"
            "  -h, --help                 display this help then exit\n\n"
            "VCD is emitted to stdout if output filename is unspecified.\n\n"
            "Report bugs to <" PACKAGE_BUGREPORT ">.\n",
@@ -47,6 +78,7 @@ void print_help(char *nam)
            "  -f                         specify FST input filename\n"
            "  -o                         specify output filename\n"
            "  -e                         emit FST extensions to VCD\n"
+           "  -j                         convert on N threads\n"
            "  -h                         display this help then exit\n\n"
            "VCD is emitted to stdout if output filename is unspecified.\n\n"
            "Report bugs to <" PACKAGE_BUGREPORT ">.\n",
@@ -56,6 +88,266 @@ void print_help(char *nam)
     exit(0);
 }
 
+static void format_value(GString *out, const VcdVar *var, const unsigned char *value)
+{
+    if (var->is_real) {
+        g_string_append_c(out, 'r');
+        g_string_append(out, (const char *)value);
+        g_string_append_c(out, ' ');
+        g_string_append(out, var->id);
+        g_string_append_c(out, '\n');
+    } else if (value[0] && !value[1]) {
+        g_string_append_c(out, value[0]);
+        g_string_append(out, var->id);
+        g_string_append_c(out, '\n');
+    } else {
+        g_string_append_c(out, 'b');
+        g_string_append(out, (const char *)value);
+        g_string_append_c(out, ' ');
+        g_string_append(out, var->id);
+        g_string_append_c(out, '\n');
+    }
+}
+
+static gpointer worker_new(struct fstReaderContext *xc, gpointer user_data)
+{
+    fstReaderSetFacProcessMaskAll(xc);
+
+    return user_data; /* the context is only read by the workers */
+}
+
+static void worker_free(gpointer worker_data)
+{
+    (void)worker_data;
+}
+
+static void slice_begin(FstSlice *slice, gpointer worker_data)
+{
+    SliceText *st = g_new(SliceText, 1);
+
+    (void)worker_data;
+
+    st->text = g_string_sized_new(FST_VCD_WRITE_BUF_SIZ);
+    st->last_time = slice->start;
+    slice->data = st;
+}
+
+static void slice_change(FstSlice *slice,
+                         gpointer worker_data,
+                         uint64_t tim,
+                         fstHandle facidx,
+                         const unsigned char *value,
+                         uint32_t len)
+{
+    ParallelContext *ctx = worker_data;
+    SliceText *st = slice->data;
+    const VcdVar *var = &ctx->vars[facidx];
+
+    (void)len;
+
+    if (!var->id) {
+        return;
+    }
+
+    if (tim != st->last_time) {
+        g_string_append_printf(st->text, "#%" PRIu64 "\n", tim);
+        st->last_time = tim;
+    }
+
+    format_value(st->text, var, value);
+}
+
+static void write_all(int fd, const char *buf, size_t len)
+{
+    while (len) {
+        ssize_t rc = write(fd, buf, len);
+
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("write");
+            exit(255);
+        }
+
+        buf += rc;
+        len -= rc;
+    }
+}
+
+/* writes a converted slice, the first one always carries the initial $dumpvars */
+static void slice_end(FstSlice *slice, uint64_t head_time, GArray *head, gpointer user_data)
+{
+    ParallelContext *ctx = user_data;
+    SliceText *st = slice->data;
+    gsize head_len;
+    guint i;
+
+    g_string_printf(ctx->head, "#%" PRIu64 "\n", head_time);
+    if (!slice->index) {
+        g_string_append(ctx->head, "$dumpvars\n");
+    }
+    head_len = ctx->head->len;
+
+    for (i = 0; i < head->len; i++) {
+        FstSliceValue *v = &g_array_index(head, FstSliceValue, i);
+
+        if (ctx->vars[v->handle].id) {
+            format_value(ctx->head, &ctx->vars[v->handle], v->value);
+        }
+    }
+
+    if (!slice->index) {
+        g_string_append(ctx->head, "$end\n");
+    }
+
+    if ((!slice->index) || (ctx->head->len > head_len)) {
+        write_all(ctx->fd, ctx->head->str, ctx->head->len);
+    }
+    write_all(ctx->fd, st->text->str, st->text->len);
+
+    g_string_free(st->text, TRUE);
+    g_free(st);
+}
+
+/* collects the identifiers of the $var lines of the header in hierarchy order */
+static int collect_vars(struct fstReaderContext *xc, const char *header, VcdVar *vars)
+{
+    struct fstHier *h;
+    const char *pnt = header;
+
+    fstReaderIterateHierRewind(xc);
+    while ((h = fstReaderIterateHier(xc))) {
+        char **tokens;
+        const char *eol;
+        char *line;
+
+        if (h->htyp != FST_HT_VAR) {
+            continue;
+        }
+
+        if ((h->u.var.typ == FST_VT_VCD_PORT) || (h->u.var.typ == FST_VT_VCD_SPARRAY) ||
+            (h->u.var.typ == FST_VT_GEN_STRING) || (!h->u.var.length)) {
+            return 0; /* no native VCD value representation, let the reader format those */
+        }
+
+        while ((pnt = strstr(pnt, "$var"))) {
+            if ((pnt == header) || (pnt[-1] == '\n') || (pnt[-1] == ' ') || (pnt[-1] == '\t')) {
+                break;
+            }
+            pnt += 4;
+        }
+        if (!pnt) {
+            return 0;
+        }
+
+        eol = strchr(pnt, '\n');
+        line = eol ? g_strndup(pnt, eol - pnt) : g_strdup(pnt);
+        pnt = eol ? eol : pnt + strlen(pnt);
+
+        tokens = g_strsplit_set(line, " \t", -1);
+        if ((g_strv_length(tokens) < 4) || (h->u.var.handle > fstReaderGetMaxHandle(xc))) {
+            g_strfreev(tokens);
+            g_free(line);
+            return 0;
+        }
+
+        if (!vars[h->u.var.handle].id) {
+            vars[h->u.var.handle].id = g_strdup(tokens[3]);
+            vars[h->u.var.handle].is_real =
+                (h->u.var.typ == FST_VT_VCD_REAL) || (h->u.var.typ == FST_VT_VCD_REAL_PARAMETER) ||
+                (h->u.var.typ == FST_VT_VCD_REALTIME) || (h->u.var.typ == FST_VT_SV_SHORTREAL);
+        }
+
+        g_strfreev(tokens);
+        g_free(line);
+    }
+
+    return 1;
+}
+
+/* returns 0 if the dump needs the serial conversion */
+static int convert_parallel(struct fstReaderContext *xc,
+                            const char *fstname,
+                            FILE *fv,
+                            int use_extensions,
+                            int jobs)
+{
+    static const FstSliceFuncs funcs = {
+        worker_new,
+        worker_free,
+        slice_begin,
+        slice_change,
+        slice_end,
+    };
+    ParallelContext ctx;
+    FstSlices *slices;
+    FILE *hier;
+    GString *header;
+    char buf[65536];
+    size_t len;
+    fstHandle maxhandle = fstReaderGetMaxHandle(xc);
+    fstHandle i;
+
+    if (fstReaderGetNumberDumpActivityChanges(xc)) {
+        return 0;
+    }
+
+    slices = fst_slices_new(xc, fstname, jobs);
+    if (!slices) {
+        return 0;
+    }
+
+    hier = tmpfile();
+    if (!hier) {
+        fst_slices_free(slices);
+        return 0;
+    }
+
+    fstReaderSetVcdExtensions(xc, use_extensions);
+    if (!fstReaderProcessHier(xc, hier)) {
+        fprintf(stderr, "could not process hierarchy for '%s', exiting.\n", fstname);
+        exit(255);
+    }
+
+    header = g_string_new(NULL);
+    rewind(hier);
+    while ((len = fread(buf, 1, sizeof(buf), hier)) > 0) {
+        g_string_append_len(header, buf, len);
+    }
+    fclose(hier);
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.vars = g_new0(VcdVar, maxhandle + 1);
+
+    if (!collect_vars(xc, header->str, ctx.vars)) {
+        for (i = 0; i <= maxhandle; i++) {
+            g_free(ctx.vars[i].id);
+        }
+        g_free(ctx.vars);
+        g_string_free(header, TRUE);
+        fst_slices_free(slices);
+        return 0;
+    }
+
+    fflush(fv);
+    ctx.fd = fileno(fv);
+    write_all(ctx.fd, header->str, header->len);
+    g_string_free(header, TRUE);
+
+    ctx.head = g_string_new(NULL);
+    fst_slices_run(slices, &funcs, &ctx);
+
+    for (i = 0; i <= maxhandle; i++) {
+        g_free(ctx.vars[i].id);
+    }
+    g_free(ctx.vars);
+    g_string_free(ctx.head, TRUE);
+    fst_slices_free(slices);
+
+    return 1;
+}
+
 int main(int argc, char **argv)
 {
     char opt_errors_encountered = 0;
@@ -66,6 +358,7 @@ int main(int argc, char **argv)
     struct fstReaderContext *xc;
     FILE *fv;
     int use_extensions = 0;
+    int jobs = 1;
 
     WAVE_LOCALE_FIX
 
@@ -76,12 +369,13 @@ int main(int argc, char **argv)
         static struct option long_options[] = {{"extensions", 0, 0, 'e'},
                                                {"fstname", 1, 0, 'f'},
                                                {"output", 1, 0, 'o'},
+                                               {"jobs", 1, 0, 'j'},
                                                {"help", 0, 0, 'h'},
                                                {0, 0, 0, 0}};
 
-        c = getopt_long(argc, argv, "ef:o:h", long_options, &option_index);
+        c = getopt_long(argc, argv, "ef:o:j:h", long_options, &option_index);
 #else
-        c = getopt(argc, argv, "ef:o:h");
+        c = getopt(argc, argv, "ef:o:j:h");
 #endif
 
         if (c == -1)
@@ -106,6 +400,13 @@ int main(int argc, char **argv)
                 strcpy(outname, optarg);
                 break;
 
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs < 1) {
+                    jobs = 1;
+                }
+                break;
+
             case 'h':
                 print_help(argv[0]);
                 break;
@@ -159,6 +460,10 @@ int main(int argc, char **argv)
         fv = stdout;
     }
 
+    if ((jobs > 1) && convert_parallel(xc, fstname, fv, use_extensions, jobs)) {
+        goto done;
+    }
+
     fstReaderSetVcdExtensions(xc,
                               use_extensions); /* TRUE is incompatible with vfast and other tools */
     if (!fstReaderProcessHier(xc, fv)) /* these 3 lines do all the VCD writing work */
@@ -169,6 +474,7 @@ int main(int argc, char **argv)
     fstReaderSetFacProcessMaskAll(xc); /* these 3 lines do all the VCD writing work */
     fstReaderIterBlocks(xc, NULL, NULL, fv); /* these 3 lines do all the VCD writing work */
 
+done:
     fstReaderClose(xc);
 
     if (outname) {
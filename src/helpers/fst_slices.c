@@ -0,0 +1,408 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fst_slices.h"
+
+#define FST_SLICES_PER_JOB (8)
+#define FST_SLICES_IN_FLIGHT_PER_JOB (2)
+
+struct FstSlices
+{
+    const char *fstname;
+    fstHandle maxhandle;
+    int jobs;
+
+    FstSlice *slices;
+    int num_slices;
+    int next_slice;
+    int written_slices;
+    int max_in_flight;
+
+    const FstSliceFuncs *funcs;
+    gpointer user_data;
+
+    GMutex mutex;
+    GCond cond;
+};
+
+typedef struct
+{
+    FstSlices *ctx;
+    FstSlice *slice;
+    gpointer data;
+
+    GByteArray **last_value; /* per handle, reused across slices */
+    int *last_slice; /* slice which last_value belongs to per handle */
+    GArray *touched; /* handles with a last_value in the current slice */
+} FstSliceWorker;
+
+static int read_u64(FILE *f, uint64_t *v)
+{
+    int i;
+
+    *v = 0;
+    for (i = 0; i < 8; i++) {
+        int ch = fgetc(f);
+
+        if (ch == EOF) {
+            return (0);
+        }
+        *v = (*v << 8) | (unsigned char)ch;
+    }
+
+    return (1);
+}
+
+/*
+ * returns the start times of the value change blocks as found in the section headers of the
+ * file, NULL for wrapped (compressed as a whole) files as those are unpacked by the reader.
+ */
+static GArray *read_block_times(const char *fstname)
+{
+    FILE *f = fopen(fstname, "rb");
+    GArray *times;
+    off_t pos = 0;
+
+    if (!f) {
+        return (NULL);
+    }
+
+    times = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+    for (;;) {
+        uint64_t seclen;
+        uint64_t beg_tim;
+        int sectype;
+
+        if (fseeko(f, pos, SEEK_SET)) {
+            break;
+        }
+
+        sectype = fgetc(f);
+        if ((sectype == EOF) || (sectype == FST_BL_SKIP)) {
+            break;
+        }
+        if ((sectype == FST_BL_ZWRAPPER) || (!read_u64(f, &seclen)) || (!seclen)) {
+            g_array_free(times, TRUE);
+            times = NULL;
+            break;
+        }
+
+        if ((sectype == FST_BL_VCDATA) || (sectype == FST_BL_VCDATA_DYN_ALIAS) ||
+            (sectype == FST_BL_VCDATA_DYN_ALIAS2)) {
+            if (!read_u64(f, &beg_tim)) {
+                break;
+            }
+            g_array_append_val(times, beg_tim);
+        }
+
+        pos += 1 + seclen;
+    }
+
+    fclose(f);
+    return (times);
+}
+
+FstSlices *fst_slices_new(struct fstReaderContext *xc, const char *fstname, int jobs)
+{
+    FstSlices *ctx;
+    GArray *times = read_block_times(fstname);
+    uint64_t *beg;
+    int num_blocks;
+    int num_slices;
+    int i;
+
+    /* a section count which differs from the headers means the scan went wrong */
+    if ((!times) || (times->len < 2) ||
+        (times->len != fstReaderGetValueChangeSectionCount(xc))) {
+        if (times) {
+            g_array_free(times, TRUE);
+        }
+        return (NULL);
+    }
+
+    ctx = g_new0(FstSlices, 1);
+    ctx->fstname = fstname;
+    ctx->maxhandle = fstReaderGetMaxHandle(xc);
+    ctx->max_in_flight = jobs * FST_SLICES_IN_FLIGHT_PER_JOB;
+
+    /* consecutive slices take whole blocks, never more slices than blocks */
+    beg = (uint64_t *)times->data;
+    num_blocks = times->len;
+    num_slices = MIN(jobs * FST_SLICES_PER_JOB, num_blocks);
+    ctx->slices = g_new0(FstSlice, num_slices);
+    for (i = 0; i < num_slices; i++) {
+        uint64_t start = beg[(gint64)num_blocks * i / num_slices];
+
+        if (ctx->num_slices && (start <= ctx->slices[ctx->num_slices - 1].start)) {
+            continue; /* blocks starting at the same time stay in one slice */
+        }
+
+        ctx->slices[ctx->num_slices].index = ctx->num_slices;
+        ctx->slices[ctx->num_slices].start = start;
+        if (ctx->num_slices) {
+            ctx->slices[ctx->num_slices - 1].end = start - 1;
+        }
+        ctx->num_slices++;
+    }
+    ctx->slices[ctx->num_slices - 1].end = MAX(fstReaderGetEndTime(xc), beg[num_blocks - 1]);
+    ctx->jobs = MIN(jobs, ctx->num_slices);
+
+    g_array_free(times, TRUE);
+
+    return (ctx);
+}
+
+static void slice_callback2(void *user_callback_data_pointer,
+                            uint64_t tim,
+                            fstHandle facidx,
+                            const unsigned char *value,
+                            uint32_t len)
+{
+    FstSliceWorker *w = user_callback_data_pointer;
+    FstSlice *slice = w->slice;
+    GByteArray *last;
+
+    if ((tim < slice->start) || (tim > slice->end) || (facidx > w->ctx->maxhandle)) {
+        return;
+    }
+
+    if (!slice->has_head) {
+        slice->has_head = 1;
+        slice->head_time = tim;
+    }
+
+    if (tim == slice->head_time) {
+        FstSliceValue v;
+
+        v.handle = facidx;
+        v.len = len;
+        v.value = g_malloc(len + 1);
+        memcpy(v.value, value, len);
+        v.value[len] = 0;
+        g_array_append_val(slice->head, v);
+        return;
+    }
+
+    if (w->last_slice[facidx] != slice->index) {
+        w->last_slice[facidx] = slice->index;
+        g_array_append_val(w->touched, facidx);
+        if (!w->last_value[facidx]) {
+            w->last_value[facidx] = g_byte_array_new();
+        }
+    }
+
+    last = w->last_value[facidx];
+    g_byte_array_set_size(last, 0);
+    g_byte_array_append(last, value, len);
+
+    w->ctx->funcs->change(slice, w->data, tim, facidx, value, len);
+}
+
+static void slice_callback(void *user_callback_data_pointer,
+                           uint64_t tim,
+                           fstHandle facidx,
+                           const unsigned char *value)
+{
+    slice_callback2(user_callback_data_pointer,
+                    tim,
+                    facidx,
+                    value,
+                    value ? strlen((const char *)value) : 0);
+}
+
+static gpointer worker_thread(gpointer data)
+{
+    FstSliceWorker *w = data;
+    FstSlices *ctx = w->ctx;
+    struct fstReaderContext *xc = fstReaderOpen(ctx->fstname);
+    fstHandle i;
+
+    if (!xc) {
+        fprintf(stderr, "Could not open '%s', exiting.\n", ctx->fstname);
+        exit(255);
+    }
+
+    w->data = ctx->funcs->worker_new(xc, ctx->user_data);
+    w->last_value = g_new0(GByteArray *, ctx->maxhandle + 1);
+    w->last_slice = g_new(int, ctx->maxhandle + 1);
+    memset(w->last_slice, 0xff, (ctx->maxhandle + 1) * sizeof(int));
+    w->touched = g_array_new(FALSE, FALSE, sizeof(fstHandle));
+
+    for (;;) {
+        FstSlice *slice;
+        guint j;
+        int n;
+
+        g_mutex_lock(&ctx->mutex);
+        while ((ctx->next_slice < ctx->num_slices) &&
+               (ctx->next_slice >= ctx->written_slices + ctx->max_in_flight)) {
+            g_cond_wait(&ctx->cond, &ctx->mutex);
+        }
+        n = ctx->next_slice++;
+        g_mutex_unlock(&ctx->mutex);
+
+        if (n >= ctx->num_slices) {
+            break;
+        }
+
+        slice = w->slice = &ctx->slices[n];
+        slice->head = g_array_new(FALSE, FALSE, sizeof(FstSliceValue));
+        ctx->funcs->slice_begin(slice, w->data);
+
+        fstReaderSetLimitTimeRange(xc, slice->start, slice->end);
+        fstReaderIterBlocks2(xc, slice_callback, slice_callback2, w, NULL);
+
+        slice->last = g_array_sized_new(FALSE, FALSE, sizeof(FstSliceValue), w->touched->len);
+        for (j = 0; j < w->touched->len; j++) {
+            fstHandle h = g_array_index(w->touched, fstHandle, j);
+            GByteArray *last = w->last_value[h];
+            FstSliceValue v;
+
+            v.handle = h;
+            v.len = last->len;
+            v.value = g_malloc(last->len + 1);
+            memcpy(v.value, last->data, last->len);
+            v.value[last->len] = 0;
+            g_array_append_val(slice->last, v);
+        }
+        g_array_set_size(w->touched, 0);
+
+        g_mutex_lock(&ctx->mutex);
+        slice->done = 1;
+        g_cond_broadcast(&ctx->cond);
+        g_mutex_unlock(&ctx->mutex);
+    }
+
+    for (i = 0; i <= ctx->maxhandle; i++) {
+        if (w->last_value[i]) {
+            g_byte_array_free(w->last_value[i], TRUE);
+        }
+    }
+    g_free(w->last_value);
+    g_free(w->last_slice);
+    g_array_free(w->touched, TRUE);
+    ctx->funcs->worker_free(w->data);
+    fstReaderClose(xc);
+
+    return (NULL);
+}
+
+static int same_value(const FstSliceValue *a, const FstSliceValue *b)
+{
+    return (a->value && (a->len == b->len) && (!memcmp(a->value, b->value, a->len)));
+}
+
+void fst_slices_run(FstSlices *ctx, const FstSliceFuncs *funcs, gpointer user_data)
+{
+    FstSliceWorker *workers;
+    GThread **threads;
+    FstSliceValue *state;
+    GArray *changes;
+    int i;
+
+    ctx->funcs = funcs;
+    ctx->user_data = user_data;
+
+    g_mutex_init(&ctx->mutex);
+    g_cond_init(&ctx->cond);
+
+    workers = g_new0(FstSliceWorker, ctx->jobs);
+    threads = g_new0(GThread *, ctx->jobs);
+    for (i = 0; i < ctx->jobs; i++) {
+        workers[i].ctx = ctx;
+        threads[i] = g_thread_new("fst_slices", worker_thread, &workers[i]);
+    }
+
+    state = g_new0(FstSliceValue, ctx->maxhandle + 1);
+    changes = g_array_new(FALSE, FALSE, sizeof(FstSliceValue));
+    for (i = 0; i < ctx->num_slices; i++) {
+        FstSlice *slice = &ctx->slices[i];
+        guint j;
+
+        g_mutex_lock(&ctx->mutex);
+        while (!slice->done) {
+            g_cond_wait(&ctx->cond, &ctx->mutex);
+        }
+        g_mutex_unlock(&ctx->mutex);
+
+        /* the head values replace the state in order, the replaced ones are freed after
+         * slice_end as the changes may point to them */
+        g_array_set_size(changes, 0);
+        for (j = 0; j < slice->head->len; j++) {
+            FstSliceValue *v = &g_array_index(slice->head, FstSliceValue, j);
+            FstSliceValue old = state[v->handle];
+
+            if (!same_value(&old, v)) {
+                g_array_append_val(changes, *v);
+            }
+            state[v->handle] = *v;
+            *v = old;
+        }
+
+        funcs->slice_end(slice,
+                         slice->has_head ? slice->head_time : slice->start,
+                         changes,
+                         user_data);
+
+        for (j = 0; j < slice->head->len; j++) {
+            g_free(g_array_index(slice->head, FstSliceValue, j).value);
+        }
+        for (j = 0; j < slice->last->len; j++) {
+            FstSliceValue *v = &g_array_index(slice->last, FstSliceValue, j);
+
+            g_free(state[v->handle].value);
+            state[v->handle] = *v;
+        }
+        g_array_free(slice->head, TRUE);
+        g_array_free(slice->last, TRUE);
+
+        g_mutex_lock(&ctx->mutex);
+        ctx->written_slices++;
+        g_cond_broadcast(&ctx->cond);
+        g_mutex_unlock(&ctx->mutex);
+    }
+
+    for (i = 0; i < ctx->jobs; i++) {
+        g_thread_join(threads[i]);
+    }
+
+    for (i = 0; i <= (int)ctx->maxhandle; i++) {
+        g_free(state[i].value);
+    }
+    g_free(state);
+    g_array_free(changes, TRUE);
+    g_free(threads);
+    g_free(workers);
+    g_mutex_clear(&ctx->mutex);
+    g_cond_clear(&ctx->cond);
+}
+
+void fst_slices_free(FstSlices *ctx)
+{
+    if (ctx) {
+        g_free(ctx->slices);
+        g_free(ctx);
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef WAVE_FST_SLICES_H
+#define WAVE_FST_SLICES_H
+
+#include <fstapi.h>
+#include <glib.h>
+
+/*
+ * parallel pass over the value changes of an FST file (-j of fst2vcd and fstminer)
+ *
+ * the time range is cut into slices along the value change blocks of the file, so every block
+ * is decompressed once.  the slices are scanned by worker threads, each with its own reader
+ * context, and handed to the main thread in time order.
+ *
+ * a reader limited to a time range reports the values in effect at the start of the range at
+ * the first time of the range.  so the value changes at the first time of a slice (its head)
+ * are kept apart and only those which differ from the values in effect at the end of the
+ * previous slice are handed on as changes.  everything at the head of the first slice is a
+ * change.
+ */
+
+typedef struct
+{
+    fstHandle handle;
+    uint32_t len;
+    unsigned char *value;
+} FstSliceValue;
+
+typedef struct
+{
+    int index;
+    uint64_t start;
+    uint64_t end;
+    gpointer data; /* owned by the caller */
+
+    /* private */
+    int has_head;
+    uint64_t head_time;
+    GArray *head; /* FstSliceValue reported at head_time */
+    GArray *last; /* FstSliceValue of the last later change of each handle */
+    int done;
+} FstSlice;
+
+typedef struct
+{
+    /* on a worker thread after opening its reader, returns the data of the worker */
+    gpointer (*worker_new)(struct fstReaderContext *xc, gpointer user_data);
+    void (*worker_free)(gpointer worker_data);
+
+    /* on a worker thread before the slice is scanned */
+    void (*slice_begin)(FstSlice *slice, gpointer worker_data);
+
+    /* on a worker thread for every value change after the head of the slice */
+    void (*change)(FstSlice *slice,
+                   gpointer worker_data,
+                   uint64_t tim,
+                   fstHandle facidx,
+                   const unsigned char *value,
+                   uint32_t len);
+
+    /* on the main thread in slice order, head holds the FstSliceValue changed at head_time */
+    void (*slice_end)(FstSlice *slice, uint64_t head_time, GArray *head, gpointer user_data);
+} FstSliceFuncs;
+
+typedef struct FstSlices FstSlices;
+
+/* returns NULL if the file has too few value change blocks to be cut for that many jobs */
+FstSlices *fst_slices_new(struct fstReaderContext *xc, const char *fstname, int jobs);
+void fst_slices_run(FstSlices *slices, const FstSliceFuncs *funcs, gpointer user_data);
+void fst_slices_free(FstSlices *slices);
+
+#endif
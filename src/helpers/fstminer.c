@@ -22,15 +22,42 @@
 
 #include <config.h>
 #include <fstapi.h>
+#include <glib.h>
+#include <ctype.h>
+#include <string.h>
 
 #ifdef HAVE_GETOPT_H
 #include <getopt.h>
 #endif
 
 #include "wave_locale.h"
+#include "fst_slices.h"
+
+/*
+ * match queries: a value matches if any of the literal (-m/-x), regex (-r) or range (-R)
+ * queries matches it.  all literals are searched at once with an aho-corasick automaton.
+ */
+typedef struct
+{
+    int32_t next[256];
+    int32_t fail;
+    char out;
+} AcNode;
+
+typedef struct
+{
+    guint64 lo;
+    guint64 hi;
+} MatchRange;
+
+static AcNode *ac_nodes = NULL;
+static int ac_count = 0;
+static int ac_allocated = 0;
+static GPtrArray *regexes = NULL;
+static GArray *ranges = NULL;
+static GPtrArray *scope_globs = NULL;
+static int jobs = 1;
 
-static char *match = NULL;
-static uint32_t matchlen = 0;
 static int names_only = 0;
 static char *killed_list = NULL;
 char killed_value = 1;
@@ -117,71 +144,241 @@ static char *get_facname(void *lt, fstHandle pnt_facidx)
     }
 }
 
-static const char *strnstr_2(const char *haystack,
-                             const char *needle,
-                             size_t haystack_len) /* exists in BSDs, but not in linux */
+static int ac_new_node(void)
 {
-    if (needle && haystack) /* overkill for this usage, but to avoid tripping static checkers */
-    {
-        size_t needle_len = strlen(needle);
+    if (ac_count == ac_allocated) {
+        ac_allocated = ac_allocated ? ac_allocated * 2 : 64;
+        ac_nodes = realloc(ac_nodes, ac_allocated * sizeof(AcNode));
+    }
+
+    memset(&ac_nodes[ac_count], 0, sizeof(AcNode));
+    return (ac_count++);
+}
+
+static void ac_add(const char *pattern)
+{
+    int state;
+
+    if (!ac_count) {
+        ac_new_node(); /* root */
+    }
 
-        if (!needle_len) /* trivial case is match against null string */
-        {
-            return (haystack);
+    for (state = 0; *pattern; pattern++) {
+        unsigned char ch = (unsigned char)*pattern;
+
+        if (!ac_nodes[state].next[ch]) {
+            int n = ac_new_node(); /* may move ac_nodes */
+            ac_nodes[state].next[ch] = n;
         }
+        state = ac_nodes[state].next[ch];
+    }
+
+    ac_nodes[state].out = 1; /* an empty pattern matches everything, as before */
+}
+
+/* turns the trie into a dfa: missing transitions follow the failure links */
+static void ac_build(void)
+{
+    int32_t *queue;
+    int head = 0;
+    int tail = 0;
+    int ch;
+
+    if (!ac_count) {
+        return;
+    }
 
-        while (haystack_len >= needle_len) /* otherwise, impossible to match */
-        {
-            if (!memcmp(haystack, needle, needle_len)) {
-                return (haystack);
+    queue = malloc(ac_count * sizeof(int32_t));
+
+    for (ch = 0; ch < 256; ch++) {
+        int32_t v = ac_nodes[0].next[ch];
+
+        if (v) {
+            ac_nodes[v].fail = 0;
+            queue[tail++] = v;
+        }
+    }
+
+    while (head < tail) {
+        int32_t u = queue[head++];
+
+        for (ch = 0; ch < 256; ch++) {
+            int32_t v = ac_nodes[u].next[ch];
+            int32_t f = ac_nodes[ac_nodes[u].fail].next[ch];
+
+            if (v) {
+                ac_nodes[v].fail = f;
+                ac_nodes[v].out |= ac_nodes[f].out;
+                queue[tail++] = v;
+            } else {
+                ac_nodes[u].next[ch] = f;
             }
-            haystack++;
-            haystack_len--;
         }
     }
 
-    return (NULL);
+    free(queue);
+}
+
+static int ac_match(const unsigned char *value, uint32_t len)
+{
+    int32_t state = 0;
+    uint32_t i;
+
+    if (ac_nodes[0].out) {
+        return (1);
+    }
+
+    for (i = 0; i < len; i++) {
+        state = ac_nodes[state].next[value[i]];
+        if (ac_nodes[state].out) {
+            return (1);
+        }
+    }
+
+    return (0);
+}
+
+static int range_match(const unsigned char *value, uint32_t len)
+{
+    guint64 val = 0;
+    uint32_t i;
+
+    if ((!len) || (len > 64)) {
+        return (0);
+    }
+
+    for (i = 0; i < len; i++) {
+        if ((value[i] != '0') && (value[i] != '1')) {
+            return (0); /* only fully known vectors have a numeric value */
+        }
+        val = (val << 1) | (value[i] - '0');
+    }
+
+    for (i = 0; i < ranges->len; i++) {
+        MatchRange *r = &g_array_index(ranges, MatchRange, i);
+
+        if ((val >= r->lo) && (val <= r->hi)) {
+            return (1);
+        }
+    }
+
+    return (0);
 }
 
-static void vcd_callback2(void *lt,
+static int value_matches(const unsigned char *value, uint32_t len)
+{
+    guint i;
+
+    if ((!ac_count) && (!regexes->len) && (!ranges->len)) {
+        return (1); /* no query: everything matches */
+    }
+
+    if (!value) /* scan-build */
+    {
+        return (0);
+    }
+
+    if (ac_count && ac_match(value, len)) {
+        return (1);
+    }
+
+    for (i = 0; i < regexes->len; i++) {
+        if (g_regex_match_full(g_ptr_array_index(regexes, i),
+                               (const gchar *)value,
+                               len,
+                               0,
+                               0,
+                               NULL,
+                               NULL)) {
+            return (1);
+        }
+    }
+
+    return (ranges->len && range_match(value, len));
+}
+
+static int scope_selected(const char *facname)
+{
+    guint i;
+
+    if (!scope_globs->len) {
+        return (1);
+    }
+
+    for (i = 0; i < scope_globs->len; i++) {
+        if (g_pattern_spec_match_string(g_ptr_array_index(scope_globs, i), facname)) {
+            return (1);
+        }
+    }
+
+    return (0);
+}
+
+/* state of one pass over (a time range of) the dump */
+typedef struct
+{
+    void *lt;
+    char *killed;
+    GString *text; /* NULL when printing directly */
+    GArray *matches; /* MinerMatch into text */
+} MinerScan;
+
+typedef struct
+{
+    fstHandle handle;
+    gsize offset;
+    gsize len;
+} MinerMatch;
+
+static void vcd_callback2(void *user_callback_data_pointer,
                           uint64_t pnt_time,
                           fstHandle pnt_facidx,
                           const unsigned char *pnt_value,
                           uint32_t plen)
 {
-    if (plen >= matchlen) {
-        if (!killed_list[pnt_facidx]) {
-            if ((!match) || (pnt_value /* scan-build */ &&
-                             (strnstr_2((const char *)pnt_value,
-                                        match,
-                                        plen)))) /* #423: changed strstr to strnstr_2 */
-            {
-                char *fn;
-                fn = get_facname(lt, pnt_facidx);
-
-                if (!names_only) {
-                    char *s = malloc(
-                        plen + 1); /* #423: fstminer doesn't handle string transitions correctly */
-                    memcpy(s, pnt_value, plen);
-                    s[plen] = 0; /* strings are not null terminated */
-
-                    printf("#%" PRIu64 " %s %s\n", pnt_time, fn, s);
-                    free(s);
-                } else {
-                    printf("%s\n", fn);
-                }
-                free(fn);
+    MinerScan *scan = user_callback_data_pointer;
 
-                if (killed_value) {
-                    fstReaderClrFacProcessMask(lt, pnt_facidx);
-                    killed_list[pnt_facidx] = 1;
-                }
+    if ((!scan->killed[pnt_facidx]) && value_matches(pnt_value, plen)) {
+        char *fn;
+        fn = get_facname(scan->lt, pnt_facidx);
+
+        if (scan->text) {
+            MinerMatch m;
+
+            m.handle = pnt_facidx;
+            m.offset = scan->text->len;
+
+            if (!names_only) {
+                g_string_append_printf(scan->text, "#%" PRIu64 " %s ", pnt_time, fn);
+                g_string_append_len(scan->text, (const gchar *)pnt_value, plen);
+                g_string_append_c(scan->text, '\n');
+            } else {
+                g_string_append_printf(scan->text, "%s\n", fn);
             }
+
+            m.len = scan->text->len - m.offset;
+            g_array_append_val(scan->matches, m);
+        } else if (!names_only) {
+            char *s =
+                malloc(plen + 1); /* #423: fstminer doesn't handle string transitions correctly */
+            memcpy(s, pnt_value, plen);
+            s[plen] = 0; /* strings are not null terminated */
+
+            printf("#%" PRIu64 " %s %s\n", pnt_time, fn, s);
+            free(s);
+        } else {
+            printf("%s\n", fn);
+        }
+        free(fn);
+
+        if (killed_value) {
+            fstReaderClrFacProcessMask(scan->lt, pnt_facidx);
+            scan->killed[pnt_facidx] = 1;
         }
     }
 }
 
-static void vcd_callback(void *lt,
+static void vcd_callback(void *user_callback_data_pointer,
                          uint64_t pnt_time,
                          fstHandle pnt_facidx,
                          const unsigned char *pnt_value)
@@ -194,7 +391,144 @@ static void vcd_callback(void *lt,
         plen = 0;
     }
 
-    vcd_callback2(lt, pnt_time, pnt_facidx, pnt_value, plen);
+    vcd_callback2(user_callback_data_pointer, pnt_time, pnt_facidx, pnt_value, plen);
+}
+
+/*
+ * parallel search (-j), see fst_slices.h: the matches of a slice are collected in memory and
+ * printed in slice order by the main thread, after the matches among the changes at the head
+ * of the slice.  the main thread also drops the matches of facs that matched in an earlier
+ * slice.
+ */
+typedef struct
+{
+    GString *text;
+    GArray *matches;
+} MinerSlice;
+
+typedef struct
+{
+    int numfacs;
+    char *killed; /* killed_list before the search, as the main thread updates killed_list */
+    MinerScan head; /* prints the matches at the heads of the slices */
+} MinerContext;
+
+static void set_process_mask(void *lt, const char *killed, int numfacs)
+{
+    int i;
+
+    fstReaderSetFacProcessMaskAll(lt);
+    for (i = 1; i < numfacs; i++) {
+        if (killed[i]) {
+            fstReaderClrFacProcessMask(lt, i);
+        }
+    }
+}
+
+static gpointer miner_worker_new(struct fstReaderContext *xc, gpointer user_data)
+{
+    MinerContext *ctx = user_data;
+    MinerScan *scan = calloc(1, sizeof(MinerScan));
+
+    /* matches in later slices of a killed fac are dropped anyway, so kills stay local */
+    scan->lt = xc;
+    scan->killed = malloc(ctx->numfacs);
+    memcpy(scan->killed, ctx->killed, ctx->numfacs);
+    set_process_mask(scan->lt, scan->killed, ctx->numfacs);
+
+    return (scan);
+}
+
+static void miner_worker_free(gpointer worker_data)
+{
+    MinerScan *scan = worker_data;
+
+    free(scan->killed);
+    free(scan);
+}
+
+static void miner_slice_begin(FstSlice *slice, gpointer worker_data)
+{
+    MinerScan *scan = worker_data;
+    MinerSlice *ms = calloc(1, sizeof(MinerSlice));
+
+    ms->text = g_string_new(NULL);
+    ms->matches = g_array_new(FALSE, FALSE, sizeof(MinerMatch));
+    slice->data = ms;
+
+    scan->text = ms->text;
+    scan->matches = ms->matches;
+}
+
+static void miner_slice_change(FstSlice *slice,
+                               gpointer worker_data,
+                               uint64_t tim,
+                               fstHandle facidx,
+                               const unsigned char *value,
+                               uint32_t len)
+{
+    (void)slice;
+
+    vcd_callback2(worker_data, tim, facidx, value, len);
+}
+
+static void miner_slice_end(FstSlice *slice, uint64_t head_time, GArray *head, gpointer user_data)
+{
+    MinerContext *ctx = user_data;
+    MinerSlice *ms = slice->data;
+    guint j;
+
+    for (j = 0; j < head->len; j++) {
+        FstSliceValue *v = &g_array_index(head, FstSliceValue, j);
+
+        vcd_callback2(&ctx->head, head_time, v->handle, v->value, v->len);
+    }
+
+    for (j = 0; j < ms->matches->len; j++) {
+        MinerMatch *m = &g_array_index(ms->matches, MinerMatch, j);
+
+        if (!killed_list[m->handle]) {
+            fwrite(ms->text->str + m->offset, 1, m->len, stdout);
+            if (killed_value) {
+                killed_list[m->handle] = 1;
+            }
+        }
+    }
+
+    g_string_free(ms->text, TRUE);
+    g_array_free(ms->matches, TRUE);
+    free(ms);
+}
+
+/* returns 0 if the dump needs the serial search */
+static int process_fst_parallel(void *lt, const char *fname, int numfacs)
+{
+    static const FstSliceFuncs funcs = {
+        miner_worker_new,
+        miner_worker_free,
+        miner_slice_begin,
+        miner_slice_change,
+        miner_slice_end,
+    };
+    FstSlices *slices = fst_slices_new(lt, fname, jobs);
+    MinerContext ctx;
+
+    if (!slices) {
+        return (0);
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.numfacs = numfacs;
+    ctx.killed = malloc(numfacs);
+    memcpy(ctx.killed, killed_list, numfacs);
+    ctx.head.lt = lt;
+    ctx.head.killed = killed_list;
+
+    fst_slices_run(slices, &funcs, &ctx);
+    fst_slices_free(slices);
+    free(ctx.killed);
+
+    return (1);
 }
 
 int process_fst(char *fname)
@@ -215,8 +549,28 @@ int process_fst(char *fname)
 
         extractVarNames(lt);
 
-        fstReaderSetFacProcessMaskAll(lt);
-        fstReaderIterBlocks2(lt, vcd_callback, vcd_callback2, lt, NULL);
+        /* facs outside of the selected hierarchy are never looked at */
+        for (i = 1; i < numfacs; i++) {
+            if (fac_names[i]) {
+                char *fn = get_facname(lt, i);
+
+                killed_list[i] = !scope_selected(fn);
+                free(fn);
+            } else {
+                killed_list[i] = 1;
+            }
+        }
+
+        if ((jobs <= 1) || (!process_fst_parallel(lt, fname, numfacs))) {
+            MinerScan scan;
+
+            memset(&scan, 0, sizeof(scan));
+            scan.lt = lt;
+            scan.killed = killed_list;
+
+            set_process_mask(lt, killed_list, numfacs);
+            fstReaderIterBlocks2(lt, vcd_callback, vcd_callback2, &scan, NULL);
+        }
 
         for (i = 0; i < allocated_scopes; i++) {
             free(scope_names[i]);
@@ -248,11 +602,16 @@ void print_help(char *nam)
            "  -d, --dumpfile=FILE        specify FST input dumpfile\n"
            "  -m, --match                bitwise match value\n"
            "  -x, --hex                  hex match value\n"
+           "  -r, --regex=REGEX          regular expression match value\n"
+           "  -R, --range=LO[:HI]        numeric range of vector values\n"
+           "  -s, --scope=GLOB           only search facnames matching GLOB\n"
+           "  -j, --jobs=N               search on N threads\n"
            "  -n, --namesonly            emit facsnames only (gtkwave savefile)\n"
            "  -c, --comprehensive        do not stop after first match\n"
            "  -h, --help                 display this help then exit\n\n"
            "First occurrence of facnames with times and matching values are emitted to\nstdout.  "
-           "Using -n generates a gtkwave save file.\n\n"
+           "Using -n generates a gtkwave save file.  -m, -x, -r, -R and -s may be\n"
+           "given more than once, a value matches if any of them matches.\n\n"
            "Report bugs to <" PACKAGE_BUGREPORT ">.\n",
            nam);
 #else
@@ -260,11 +619,16 @@ void print_help(char *nam)
            "  -d                         specify FST input dumpfile\n"
            "  -m                         bitwise match value\n"
            "  -x                         hex match value\n"
+           "  -r                         regular expression match value\n"
+           "  -R                         numeric range of vector values (LO[:HI])\n"
+           "  -s                         only search facnames matching glob\n"
+           "  -j                         search on N threads\n"
            "  -n                         emit facsnames only\n"
            "  -c                         do not stop after first match\n"
            "  -h                         display this help then exit (gtkwave savefile)\n\n"
            "First occurrence of facnames with times and matching values are emitted to\nstdout.  "
-           "Using -n generates a gtkwave save file.\n\n"
+           "Using -n generates a gtkwave save file.  -m, -x, -r, -R and -s may be\n"
+           "given more than once, a value matches if any of them matches.\n\n"
            "Report bugs to <" PACKAGE_BUGREPORT ">.\n",
            nam);
 #endif
@@ -280,9 +644,15 @@ int main(int argc, char **argv)
     int rc;
     uint32_t i, j, k;
     int comprehensive = 0;
+    char *hex;
+    uint32_t hexlen;
 
     WAVE_LOCALE_FIX
 
+    regexes = g_ptr_array_new_with_free_func((GDestroyNotify)g_regex_unref);
+    ranges = g_array_new(FALSE, FALSE, sizeof(MatchRange));
+    scope_globs = g_ptr_array_new_with_free_func((GDestroyNotify)g_pattern_spec_free);
+
     while (1) {
 #ifdef __linux__
         int option_index = 0;
@@ -290,14 +660,18 @@ int main(int argc, char **argv)
         static struct option long_options[] = {{"dumpfile", 1, 0, 'd'},
                                                {"match", 1, 0, 'm'},
                                                {"hex", 1, 0, 'x'},
+                                               {"regex", 1, 0, 'r'},
+                                               {"range", 1, 0, 'R'},
+                                               {"scope", 1, 0, 's'},
+                                               {"jobs", 1, 0, 'j'},
                                                {"namesonly", 0, 0, 'n'},
                                                {"comprehensive", 0, 0, 'c'},
                                                {"help", 0, 0, 'h'},
                                                {0, 0, 0, 0}};
 
-        c = getopt_long(argc, argv, "d:m:x:nch", long_options, &option_index);
+        c = getopt_long(argc, argv, "d:m:x:r:R:s:j:nch", long_options, &option_index);
 #else
-        c = getopt(argc, argv, "d:m:x:nch");
+        c = getopt(argc, argv, "d:m:x:r:R:s:j:nch");
 #endif
 
         if (c == -1)
@@ -320,41 +694,81 @@ int main(int argc, char **argv)
                 break;
 
             case 'm':
-                if (match)
-                    free(match);
-                match = malloc((matchlen = strlen(optarg)) + 1);
-                strcpy(match, optarg);
+                ac_add(optarg);
                 break;
 
             case 'x':
-                if (match)
-                    free(match);
-                match = malloc((matchlen = 4 * strlen(optarg)) + 1);
-                for (i = 0, k = 0; i < matchlen; i += 4, k++) {
+                hex = malloc((hexlen = 4 * strlen(optarg)) + 1);
+                for (i = 0, k = 0; i < hexlen; i += 4, k++) {
                     int ch = tolower((int)(unsigned char)optarg[k]);
 
                     if (ch == 'z') {
                         for (j = 0; j < 4; j++) {
-                            match[i + j] = 'z';
+                            hex[i + j] = 'z';
                         }
                     } else if ((ch >= '0') && (ch <= '9')) {
                         ch -= '0';
                         for (j = 0; j < 4; j++) {
-                            match[i + j] = ((ch >> (3 - j)) & 1) + '0';
+                            hex[i + j] = ((ch >> (3 - j)) & 1) + '0';
                         }
                     } else if ((ch >= 'a') && (ch <= 'f')) {
                         ch = ch - 'a' + 10;
                         for (j = 0; j < 4; j++) {
-                            match[i + j] = ((ch >> (3 - j)) & 1) + '0';
+                            hex[i + j] = ((ch >> (3 - j)) & 1) + '0';
                         }
                     } else /* "x" */
                     {
                         for (j = 0; j < 4; j++) {
-                            match[i + j] = 'x';
+                            hex[i + j] = 'x';
                         }
                     }
                 }
-                match[matchlen] = 0;
+                hex[hexlen] = 0;
+                ac_add(hex);
+                free(hex);
+                break;
+
+            case 'r': {
+                GError *error = NULL;
+                GRegex *regex = g_regex_new(optarg, G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, &error);
+
+                if (regex) {
+                    g_ptr_array_add(regexes, regex);
+                } else {
+                    fprintf(stderr, "Invalid regex '%s': %s\n", optarg, error->message);
+                    g_error_free(error);
+                    opt_errors_encountered = 1;
+                }
+                break;
+            }
+
+            case 'R': {
+                MatchRange r;
+                char *end;
+
+                r.lo = r.hi = g_ascii_strtoull(optarg, &end, 0);
+                if (*end == ':') {
+                    r.hi = g_ascii_strtoull(end + 1, &end, 0);
+                }
+
+                if ((end == optarg) || (*end) || (r.hi < r.lo)) {
+                    fprintf(stderr, "Invalid range '%s'\n", optarg);
+                    opt_errors_encountered = 1;
+                } else {
+                    g_array_append_val(ranges, r);
+                }
+                break;
+            }
+
+            case 's':
+                g_ptr_array_add(scope_globs, g_pattern_spec_new(optarg));
+                break;
+
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs < 1) {
+                    jobs = 1;
+                }
                 break;
 
             case 'h':
@@ -393,8 +807,13 @@ int main(int argc, char **argv)
         print_help(argv[0]);
     }
 
+    ac_build();
+
     rc = process_fst(lxname);
-    free(match);
+    free(ac_nodes);
+    g_ptr_array_free(regexes, TRUE);
+    g_array_free(ranges, TRUE);
+    g_ptr_array_free(scope_globs, TRUE);
     free(lxname);
 
     return (rc);
@@ -0,0 +1,748 @@
+#include <config.h>
+#include <gtkwave.h>
+#include <stdio.h>
+#include <string.h>
+
+// Answers batches of waveform queries without starting the viewer.
+//
+// Queries are read one per line from a file or stdin:
+//
+//   value SIGNAL TIME                 value in effect at TIME
+//   transitions SIGNAL START END      number of value changes in [START, END]
+//   rising SIGNAL START END           number of changes to 1/H from another value
+//   falling SIGNAL START END          number of changes to 0/L from another value
+//   first SIGNAL ==|!= VALUE [START]  first time at or after START the condition holds
+//
+// Times are in the time dimension of the dump file. Bit values are given MSB first in binary
+// (0, 1, x, z, ...) or as hex with a 0x prefix and are extended to the signal width. Empty lines
+// and lines starting with '#' are skipped.
+//
+// Queries are processed in chunks: the traces needed by a chunk are imported, the chunk is
+// evaluated on a thread pool and its results are written in input order before the next chunk
+// is read.
+
+#define QUERY_CHUNK_SIZE 4096
+#define QUERY_TASK_SIZE 64
+
+#define QUERY_ERROR (g_quark_from_static_string("gwquery-error"))
+
+typedef enum
+{
+    QUERY_VALUE,
+    QUERY_TRANSITIONS,
+    QUERY_RISING,
+    QUERY_FALLING,
+    QUERY_FIRST,
+} QueryKind;
+
+typedef enum
+{
+    OUTPUT_JSON,
+    OUTPUT_CSV,
+} OutputFormat;
+
+typedef struct
+{
+    guint line;
+    gchar *text;
+
+    QueryKind kind;
+    GwNode *node;
+    GwTime start;
+    GwTime end;
+
+    // condition of QUERY_FIRST
+    gboolean negate;
+    guint8 *bits;
+    gdouble real;
+    gchar *string;
+
+    gchar *result;
+    gboolean result_is_string;
+    gchar *error;
+} Query;
+
+typedef struct
+{
+    GwDumpFile *file;
+    GwTime end_time;
+    GHashTable *imported;
+
+    GThreadPool *pool;
+    GMutex mutex;
+    GCond cond;
+    gint pending;
+} QueryContext;
+
+typedef struct
+{
+    QueryContext *ctx;
+    Query *queries;
+    guint count;
+} QueryTask;
+
+static void query_clear(Query *query)
+{
+    g_free(query->text);
+    g_free(query->bits);
+    g_free(query->string);
+    g_free(query->result);
+    g_free(query->error);
+}
+
+// Returns the GW_HIST_ENT_FLAG_REAL/STRING flags of the imported history.
+static guint8 node_get_flags(GwNode *node)
+{
+    for (GwHistEnt *h = node->head.next; h != NULL; h = h->next) {
+        if (h->time >= 0) {
+            return h->flags & (GW_HIST_ENT_FLAG_REAL | GW_HIST_ENT_FLAG_STRING);
+        }
+    }
+
+    return 0;
+}
+
+static gint node_get_width(GwNode *node)
+{
+    return ABS(node->msi - node->lsi) + 1;
+}
+
+static gboolean node_is_scalar(GwNode *node)
+{
+    return node->msi == node->lsi;
+}
+
+// Parses a binary or 0x prefixed hex literal into width GwBits, extended like in Verilog.
+static guint8 *parse_bits(const gchar *str, gint width, GError **error)
+{
+    GString *digits = g_string_new(NULL);
+
+    if (g_str_has_prefix(str, "0x") || g_str_has_prefix(str, "0X")) {
+        for (const gchar *p = str + 2; *p != '\0'; p++) {
+            if (g_ascii_isxdigit(*p)) {
+                gint v = g_ascii_xdigit_value(*p);
+                for (gint i = 3; i >= 0; i--) {
+                    g_string_append_c(digits, (v >> i) & 1 ? '1' : '0');
+                }
+            } else if (strchr("xXzZ", *p) != NULL) {
+                for (gint i = 0; i < 4; i++) {
+                    g_string_append_c(digits, g_ascii_tolower(*p));
+                }
+            } else {
+                g_set_error(error, QUERY_ERROR, 0, "bad hex value");
+                g_string_free(digits, TRUE);
+                return NULL;
+            }
+        }
+    } else {
+        for (const gchar *p = str; *p != '\0'; p++) {
+            if (strchr("01xXzZhHuUwWlL-", *p) == NULL) {
+                g_set_error(error, QUERY_ERROR, 0, "bad bit value");
+                g_string_free(digits, TRUE);
+                return NULL;
+            }
+            g_string_append_c(digits, *p);
+        }
+    }
+
+    if (digits->len == 0) {
+        g_set_error(error, QUERY_ERROR, 0, "empty value");
+        g_string_free(digits, TRUE);
+        return NULL;
+    }
+
+    guint8 *bits = g_new(guint8, width);
+    gchar fill = strchr("xXzZ", digits->str[0]) != NULL ? digits->str[0] : '0';
+    gint offset = width - (gint)digits->len;
+
+    for (gint i = 0; i < width; i++) {
+        gchar c = i < offset ? fill : digits->str[i - offset];
+        bits[i] = gw_bit_from_char(c);
+    }
+
+    g_string_free(digits, TRUE);
+
+    return bits;
+}
+
+static gboolean parse_time(const gchar *str, GwTime *time, GError **error)
+{
+    gint64 value;
+
+    if (!g_ascii_string_to_signed(str, 10, G_MININT64, G_MAXINT64, &value, error)) {
+        return FALSE;
+    }
+
+    *time = value;
+
+    return TRUE;
+}
+
+static gboolean parse_query(QueryContext *ctx, Query *query, GError **error)
+{
+    gchar **tokens = g_strsplit_set(query->text, " \t", -1);
+    GPtrArray *args = g_ptr_array_new();
+    gboolean ok = FALSE;
+
+    for (gint i = 0; tokens[i] != NULL; i++) {
+        if (tokens[i][0] != '\0') {
+            g_ptr_array_add(args, tokens[i]);
+        }
+    }
+
+    if (args->len < 3) {
+        g_set_error(error, QUERY_ERROR, 0, "missing arguments");
+        goto out;
+    }
+
+    const gchar *command = g_ptr_array_index(args, 0);
+    const gchar *name = g_ptr_array_index(args, 1);
+
+    GwSymbol *symbol = gw_dump_file_lookup_symbol(ctx->file, name);
+    if (symbol == NULL) {
+        g_set_error(error, QUERY_ERROR, 0, "unknown signal '%s'", name);
+        goto out;
+    }
+    query->node = symbol->n;
+    query->start = 0;
+    query->end = ctx->end_time;
+
+    if (g_strcmp0(command, "value") == 0 && args->len == 3) {
+        query->kind = QUERY_VALUE;
+        ok = parse_time(g_ptr_array_index(args, 2), &query->start, error);
+    } else if ((g_strcmp0(command, "transitions") == 0 || g_strcmp0(command, "rising") == 0 ||
+                g_strcmp0(command, "falling") == 0) &&
+               args->len == 4) {
+        if (command[0] == 't') {
+            query->kind = QUERY_TRANSITIONS;
+        } else {
+            query->kind = command[0] == 'r' ? QUERY_RISING : QUERY_FALLING;
+        }
+        ok = parse_time(g_ptr_array_index(args, 2), &query->start, error) &&
+             parse_time(g_ptr_array_index(args, 3), &query->end, error);
+    } else if (g_strcmp0(command, "first") == 0 && (args->len == 4 || args->len == 5)) {
+        const gchar *op = g_ptr_array_index(args, 2);
+        const gchar *value = g_ptr_array_index(args, 3);
+
+        query->kind = QUERY_FIRST;
+        if (g_strcmp0(op, "==") == 0 || g_strcmp0(op, "!=") == 0) {
+            query->negate = op[0] == '!';
+        } else {
+            g_set_error(error, QUERY_ERROR, 0, "unknown operator '%s'", op);
+            goto out;
+        }
+
+        // the trace type is only known after the import, see resolve_condition()
+        query->string = g_strdup(value);
+        ok = args->len == 4 || parse_time(g_ptr_array_index(args, 4), &query->start, error);
+    } else {
+        g_set_error(error,
+                    QUERY_ERROR,
+                    0,
+                    "unknown query '%s' with %u arguments",
+                    command,
+                    args->len - 1);
+    }
+
+out:
+    g_ptr_array_free(args, TRUE);
+    g_strfreev(tokens);
+
+    return ok;
+}
+
+static gboolean resolve_condition(Query *query, GError **error)
+{
+    GwNode *node = query->node;
+    guint8 flags = node_get_flags(node);
+
+    if (flags & GW_HIST_ENT_FLAG_STRING) {
+        return TRUE;
+    }
+
+    if (flags & GW_HIST_ENT_FLAG_REAL) {
+        gchar *end = NULL;
+        query->real = g_ascii_strtod(query->string, &end);
+        if (end == query->string || *end != '\0') {
+            g_set_error(error, QUERY_ERROR, 0, "bad real value");
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    query->bits = parse_bits(query->string, node_get_width(node), error);
+
+    return query->bits != NULL;
+}
+
+static gboolean hist_ent_matches(Query *query, GwHistEnt *h)
+{
+    GwNode *node = query->node;
+    gboolean match;
+
+    if (h->flags & GW_HIST_ENT_FLAG_STRING) {
+        match = g_strcmp0(h->v.h_vector, query->string) == 0;
+    } else if (h->flags & GW_HIST_ENT_FLAG_REAL) {
+        match = h->v.h_double == query->real;
+    } else if (query->bits == NULL) {
+        match = FALSE;
+    } else if (node_is_scalar(node)) {
+        match = h->v.h_val == query->bits[0];
+    } else if (h->v.h_vector != NULL) {
+        guint8 *unpacked = NULL;
+        const guint8 *bits = gw_hist_ent_get_bits(h, node_get_width(node), &unpacked);
+
+        match = memcmp(bits, query->bits, node_get_width(node)) == 0;
+        g_free(unpacked);
+    } else {
+        // entries without a value are all x
+        match = TRUE;
+        for (gint i = 0; i < node_get_width(node) && match; i++) {
+            match = query->bits[i] == GW_BIT_X;
+        }
+    }
+
+    return query->negate ? !match : match;
+}
+
+static gchar *hist_ent_to_string(GwNode *node, GwHistEnt *h)
+{
+    if (h->flags & GW_HIST_ENT_FLAG_STRING) {
+        return g_strdup(h->v.h_vector != NULL ? h->v.h_vector : "");
+    } else if (h->flags & GW_HIST_ENT_FLAG_REAL) {
+        gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+        return g_strdup(g_ascii_dtostr(buf, sizeof(buf), h->v.h_double));
+    } else if (node_is_scalar(node)) {
+        return g_strdup_printf("%c", gw_bit_to_char(h->v.h_val));
+    }
+
+    gint width = node_get_width(node);
+    guint8 *unpacked = NULL;
+    const guint8 *bits = gw_hist_ent_get_bits(h, width, &unpacked);
+
+    gchar *str = g_malloc(width + 1);
+    for (gint i = 0; i < width; i++) {
+        str[i] = bits != NULL ? gw_bit_to_char(bits[i]) : 'x';
+    }
+    str[width] = '\0';
+    g_free(unpacked);
+
+    return str;
+}
+
+static gboolean is_high(GwBit bit)
+{
+    return bit == GW_BIT_1 || bit == GW_BIT_H;
+}
+
+static gboolean is_low(GwBit bit)
+{
+    return bit == GW_BIT_0 || bit == GW_BIT_L;
+}
+
+static void evaluate_query(QueryContext *ctx, Query *query)
+{
+    GwNode *node = query->node;
+    GwHistCursor cursor;
+
+    gw_hist_cursor_init_node(&cursor, node);
+
+    switch (query->kind) {
+        case QUERY_VALUE: {
+            gw_hist_cursor_seek(&cursor, query->start);
+            query->result = hist_ent_to_string(node, gw_hist_cursor_get_hist_ent(&cursor));
+            query->result_is_string = TRUE;
+            break;
+        }
+
+        case QUERY_TRANSITIONS:
+        case QUERY_RISING:
+        case QUERY_FALLING: {
+            GwTime end = MIN(query->end, ctx->end_time);
+            guint64 count = 0;
+
+            if (query->kind != QUERY_TRANSITIONS && !node_is_scalar(node)) {
+                query->error = g_strdup("edges can only be counted on single bit signals");
+                break;
+            }
+
+            // the entry in effect at start only counts if it changed exactly there
+            gint index = gw_hist_cursor_seek(&cursor, query->start);
+            if (gw_hist_cursor_get_time(&cursor, index) < query->start ||
+                gw_hist_cursor_get_time(&cursor, index) < 0) {
+                index++;
+            }
+
+            for (; index < cursor.count; index++) {
+                GwHistEnt *h = node->harray[index];
+
+                if (h->time > end) {
+                    break;
+                }
+
+                if (query->kind == QUERY_TRANSITIONS) {
+                    count++;
+                } else {
+                    GwBit prev = node->harray[index - 1]->v.h_val;
+                    GwBit curr = h->v.h_val;
+
+                    if (query->kind == QUERY_RISING ? (is_high(curr) && !is_high(prev))
+                                                    : (is_low(curr) && !is_low(prev))) {
+                        count++;
+                    }
+                }
+            }
+
+            query->result = g_strdup_printf("%" G_GUINT64_FORMAT, count);
+            break;
+        }
+
+        case QUERY_FIRST: {
+            gint index = gw_hist_cursor_seek(&cursor, query->start);
+
+            for (; index < cursor.count; index++) {
+                GwHistEnt *h = node->harray[index];
+
+                if (h->time > ctx->end_time) {
+                    break;
+                }
+
+                if (hist_ent_matches(query, h)) {
+                    query->result =
+                        g_strdup_printf("%" GW_TIME_FORMAT, MAX(h->time, query->start));
+                    break;
+                }
+            }
+            break;
+        }
+    }
+}
+
+static void query_task(gpointer data, gpointer user_data)
+{
+    QueryTask *task = data;
+    QueryContext *ctx = user_data;
+
+    for (guint i = 0; i < task->count; i++) {
+        Query *query = &task->queries[i];
+        if (query->error == NULL) {
+            evaluate_query(ctx, query);
+        }
+    }
+    g_free(task);
+
+    g_mutex_lock(&ctx->mutex);
+    ctx->pending--;
+    g_cond_signal(&ctx->cond);
+    g_mutex_unlock(&ctx->mutex);
+}
+
+static gboolean import_nodes(QueryContext *ctx, GArray *queries, GError **error)
+{
+    GPtrArray *nodes = g_ptr_array_new();
+
+    for (guint i = 0; i < queries->len; i++) {
+        Query *query = &g_array_index(queries, Query, i);
+        if (query->node != NULL && !g_hash_table_contains(ctx->imported, query->node)) {
+            g_hash_table_add(ctx->imported, query->node);
+            g_ptr_array_add(nodes, query->node);
+        }
+    }
+
+    gboolean ok = TRUE;
+    if (nodes->len > 0) {
+        g_ptr_array_add(nodes, NULL);
+        ok = gw_dump_file_import_traces(ctx->file, (GwNode **)nodes->pdata, error);
+
+        for (guint i = 0; ok && nodes->pdata[i] != NULL; i++) {
+            gw_node_build_harray(nodes->pdata[i]);
+        }
+    }
+
+    g_ptr_array_free(nodes, TRUE);
+
+    return ok;
+}
+
+static void evaluate_chunk(QueryContext *ctx, GArray *queries)
+{
+    for (guint i = 0; i < queries->len; i += QUERY_TASK_SIZE) {
+        QueryTask *task = g_new(QueryTask, 1);
+        task->ctx = ctx;
+        task->queries = &g_array_index(queries, Query, i);
+        task->count = MIN(QUERY_TASK_SIZE, queries->len - i);
+
+        g_mutex_lock(&ctx->mutex);
+        ctx->pending++;
+        g_mutex_unlock(&ctx->mutex);
+
+        g_thread_pool_push(ctx->pool, task, NULL);
+    }
+
+    g_mutex_lock(&ctx->mutex);
+    while (ctx->pending > 0) {
+        g_cond_wait(&ctx->cond, &ctx->mutex);
+    }
+    g_mutex_unlock(&ctx->mutex);
+}
+
+static void write_json_string(FILE *out, const gchar *str)
+{
+    fputc('"', out);
+    for (const guchar *p = (const guchar *)str; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') {
+            fprintf(out, "\\%c", *p);
+        } else if (*p < 0x20) {
+            fprintf(out, "\\u%04x", *p);
+        } else {
+            fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void write_csv_string(FILE *out, const gchar *str)
+{
+    fputc('"', out);
+    for (const gchar *p = str; *p != '\0'; p++) {
+        if (*p == '"') {
+            fputc('"', out);
+        }
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+static void write_results(FILE *out, OutputFormat format, GArray *queries)
+{
+    for (guint i = 0; i < queries->len; i++) {
+        Query *query = &g_array_index(queries, Query, i);
+
+        if (format == OUTPUT_JSON) {
+            fprintf(out, "{\"line\":%u,\"query\":", query->line);
+            write_json_string(out, query->text);
+            if (query->error != NULL) {
+                fprintf(out, ",\"error\":");
+                write_json_string(out, query->error);
+            } else if (query->result == NULL) {
+                fprintf(out, ",\"result\":null");
+            } else if (query->result_is_string) {
+                fprintf(out, ",\"result\":");
+                write_json_string(out, query->result);
+            } else {
+                fprintf(out, ",\"result\":%s", query->result);
+            }
+            fprintf(out, "}\n");
+        } else {
+            fprintf(out, "%u,", query->line);
+            write_csv_string(out, query->text);
+            fputc(',', out);
+            if (query->result != NULL) {
+                write_csv_string(out, query->result);
+            }
+            fputc(',', out);
+            if (query->error != NULL) {
+                write_csv_string(out, query->error);
+            }
+            fputc('\n', out);
+        }
+    }
+}
+
+static void process_chunk(QueryContext *ctx, OutputFormat format, GArray *queries, FILE *out)
+{
+    GError *error = NULL;
+
+    if (!import_nodes(ctx, queries, &error)) {
+        g_printerr("Couldn't import traces: %s\n", error->message);
+        exit(EXIT_FAILURE);
+    }
+
+    for (guint i = 0; i < queries->len; i++) {
+        Query *query = &g_array_index(queries, Query, i);
+
+        if (query->error == NULL && query->kind == QUERY_FIRST &&
+            !resolve_condition(query, &error)) {
+            query->error = g_strdup(error->message);
+            g_clear_error(&error);
+        }
+    }
+
+    evaluate_chunk(ctx, queries);
+    write_results(out, format, queries);
+    fflush(out);
+
+    for (guint i = 0; i < queries->len; i++) {
+        query_clear(&g_array_index(queries, Query, i));
+    }
+    g_array_set_size(queries, 0);
+}
+
+static gchar *read_line(FILE *in)
+{
+    GString *line = g_string_new(NULL);
+    gchar buf[4096];
+
+    while (fgets(buf, sizeof(buf), in) != NULL) {
+        g_string_append(line, buf);
+        if (line->len > 0 && line->str[line->len - 1] == '\n') {
+            break;
+        }
+    }
+
+    if (line->len == 0 && feof(in)) {
+        g_string_free(line, TRUE);
+        return NULL;
+    }
+
+    return g_strstrip(g_string_free(line, FALSE));
+}
+
+static GwLoader *create_loader(const gchar *filename)
+{
+    if (g_str_has_suffix(filename, ".fst")) {
+        return gw_fst_loader_new();
+    } else if (g_str_has_suffix(filename, ".vcd")) {
+        return gw_vcd_loader_new();
+    } else if (g_str_has_suffix(filename, ".ghw")) {
+        return gw_ghw_loader_new();
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    gchar *query_filename = NULL;
+    gchar *format_name = NULL;
+    gint num_threads = 0;
+    GError *error = NULL;
+
+    GOptionEntry entries[] = {
+        {"queries",
+         'q',
+         0,
+         G_OPTION_ARG_FILENAME,
+         &query_filename,
+         "Read queries from FILE instead of stdin",
+         "FILE"},
+        {"format",
+         'f',
+         0,
+         G_OPTION_ARG_STRING,
+         &format_name,
+         "Output format: json (default) or csv",
+         "FORMAT"},
+        {"threads", 'j', 0, G_OPTION_ARG_INT, &num_threads, "Number of evaluation threads", "N"},
+        {NULL},
+    };
+
+    GOptionContext *context = g_option_context_new("DUMP_FILE - answer waveform queries");
+    g_option_context_add_main_entries(context, entries, NULL);
+    g_option_context_set_description(
+        context,
+        "Queries, one per line:\n"
+        "  value SIGNAL TIME\n"
+        "  transitions SIGNAL START END\n"
+        "  rising SIGNAL START END\n"
+        "  falling SIGNAL START END\n"
+        "  first SIGNAL ==|!= VALUE [START]\n\n"
+        "Report bugs to <" PACKAGE_BUGREPORT ">.\n");
+
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        exit(EXIT_FAILURE);
+    }
+    if (argc != 2) {
+        gchar *help = g_option_context_get_help(context, TRUE, NULL);
+        g_printerr("%s", help);
+        g_free(help);
+        exit(EXIT_FAILURE);
+    }
+    g_option_context_free(context);
+
+    OutputFormat format = OUTPUT_JSON;
+    if (format_name != NULL && g_strcmp0(format_name, "csv") == 0) {
+        format = OUTPUT_CSV;
+    } else if (format_name != NULL && g_strcmp0(format_name, "json") != 0) {
+        g_printerr("Unknown output format '%s'\n", format_name);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE *in = stdin;
+    if (query_filename != NULL && (in = fopen(query_filename, "r")) == NULL) {
+        g_printerr("Couldn't open '%s'\n", query_filename);
+        exit(EXIT_FAILURE);
+    }
+
+    const gchar *filename = argv[1];
+    GwLoader *loader = create_loader(filename);
+    if (loader == NULL) {
+        g_printerr("Unknown file type: %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+
+    GwDumpFile *file = gw_loader_load(loader, filename, &error);
+    g_object_unref(loader);
+    if (file == NULL) {
+        g_printerr("Couldn't load dumpfile: %s\n", error->message);
+        exit(EXIT_FAILURE);
+    }
+
+    QueryContext ctx = {0};
+    ctx.file = file;
+    ctx.end_time = gw_time_range_get_end(gw_dump_file_get_time_range(file));
+    ctx.imported = g_hash_table_new(g_direct_hash, g_direct_equal);
+    g_mutex_init(&ctx.mutex);
+    g_cond_init(&ctx.cond);
+    if (num_threads <= 0) {
+        num_threads = g_get_num_processors();
+    }
+    ctx.pool = g_thread_pool_new(query_task, &ctx, num_threads, FALSE, NULL);
+
+    if (format == OUTPUT_CSV) {
+        printf("line,query,result,error\n");
+    }
+
+    GArray *queries = g_array_sized_new(FALSE, TRUE, sizeof(Query), QUERY_CHUNK_SIZE);
+    guint line_number = 0;
+    gchar *line;
+
+    while ((line = read_line(in)) != NULL) {
+        line_number++;
+
+        if (line[0] == '\0' || line[0] == '#') {
+            g_free(line);
+            continue;
+        }
+
+        Query query = {0};
+        query.line = line_number;
+        query.text = line;
+        if (!parse_query(&ctx, &query, &error)) {
+            query.error = g_strdup(error->message);
+            g_clear_error(&error);
+        }
+        g_array_append_val(queries, query);
+
+        if (queries->len == QUERY_CHUNK_SIZE) {
+            process_chunk(&ctx, format, queries, stdout);
+        }
+    }
+    process_chunk(&ctx, format, queries, stdout);
+
+    g_array_free(queries, TRUE);
+    g_thread_pool_free(ctx.pool, FALSE, TRUE);
+    g_mutex_clear(&ctx.mutex);
+    g_cond_clear(&ctx.cond);
+    g_hash_table_destroy(ctx.imported);
+    g_object_unref(file);
+
+    if (in != stdin) {
+        fclose(in);
+    }
+    g_free(query_filename);
+    g_free(format_name);
+
+    return EXIT_SUCCESS;
+}
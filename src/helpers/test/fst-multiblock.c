@@ -0,0 +1,86 @@
+/*
+ * writes a small FST file with many value change blocks for the -j tests of the FST helpers:
+ * fst-multiblock FSTFILE
+ */
+
+#include <config.h>
+#include <fstapi.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MULTIBLOCK_STEPS (400)
+#define MULTIBLOCK_STEPS_PER_BLOCK (7)
+
+int main(int argc, char **argv)
+{
+    struct fstContext *ctx;
+    fstHandle clk, cnt, bus, wide, r, rare;
+    char bits[65];
+    int t;
+
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s FSTFILE\n", argv[0]);
+        return (1);
+    }
+
+    ctx = fstWriterCreate(argv[1], 1);
+    if (!ctx) {
+        fprintf(stderr, "Could not open '%s', exiting.\n", argv[1]);
+        return (255);
+    }
+
+    fstWriterSetTimescale(ctx, -9);
+    fstWriterSetScope(ctx, FST_ST_VCD_MODULE, "top", NULL);
+    clk = fstWriterCreateVar(ctx, FST_VT_VCD_WIRE, FST_VD_IMPLICIT, 1, "clk", 0);
+    cnt = fstWriterCreateVar(ctx, FST_VT_VCD_REG, FST_VD_IMPLICIT, 8, "cnt", 0);
+    bus = fstWriterCreateVar(ctx, FST_VT_VCD_WIRE, FST_VD_IMPLICIT, 4, "bus", 0);
+    wide = fstWriterCreateVar(ctx, FST_VT_VCD_WIRE, FST_VD_IMPLICIT, 64, "wide", 0);
+    r = fstWriterCreateVar(ctx, FST_VT_VCD_REAL, FST_VD_IMPLICIT, 8, "r", 0);
+    rare = fstWriterCreateVar(ctx, FST_VT_VCD_WIRE, FST_VD_IMPLICIT, 1, "rare", 0);
+    fstWriterCreateVar(ctx, FST_VT_VCD_WIRE, FST_VD_IMPLICIT, 8, "cnt_alias", cnt);
+    fstWriterSetUpscope(ctx);
+
+    for (t = 0; t < MULTIBLOCK_STEPS; t++) {
+        double d = t * 0.25;
+        int i;
+
+        /* blocks start on both quiet and busy steps, some values stay the same over many blocks */
+        if (t && !(t % MULTIBLOCK_STEPS_PER_BLOCK)) {
+            fstWriterFlushContext(ctx);
+        }
+        fstWriterEmitTimeChange(ctx, t * 5);
+
+        fstWriterEmitValueChange(ctx, clk, (t & 1) ? "1" : "0");
+
+        if (!(t % 3)) {
+            for (i = 0; i < 8; i++) {
+                bits[i] = '0' + (((t / 3) >> (7 - i)) & 1);
+            }
+            bits[8] = 0;
+            fstWriterEmitValueChange(ctx, cnt, bits);
+        }
+
+        if (!(t % 5)) {
+            static const char *bus_values[] = {"0000", "1x0z", "zzzz", "0101", "xxxx"};
+
+            fstWriterEmitValueChange(ctx, bus, bus_values[(t / 5) % 5]);
+        }
+
+        if (!(t % 4)) {
+            for (i = 0; i < 64; i++) {
+                bits[i] = "01xz"[(t / 4 + i) & 3];
+            }
+            bits[64] = 0;
+            fstWriterEmitValueChange(ctx, wide, bits);
+            fstWriterEmitValueChange(ctx, r, &d);
+        }
+
+        if (!(t % 50)) {
+            fstWriterEmitValueChange(ctx, rare, ((t / 50) & 1) ? "1" : "0");
+        }
+    }
+
+    fstWriterClose(ctx);
+
+    return (0);
+}
@@ -21,6 +21,7 @@
  */
 
 #include <config.h>
+#include <glib.h>
 #include "vzt_read.h"
 
 #ifdef HAVE_GETOPT_H
@@ -36,6 +37,7 @@
 static int flat_earth = 0;
 static int vectorize = 0;
 static int notruncate = 0;
+static int jobs = 0;
 static FILE *fv = NULL;
 int dumpvars_state = 0;
 
@@ -162,7 +164,7 @@ int process_vzt(char *fname)
     struct vzt_rd_trace *lt;
     char *netname;
 
-    lt = vzt_rd_init(fname);
+    lt = vzt_rd_init_smp(fname, jobs ? jobs : g_get_num_processors()); /* decode blocks on the other cpus */
     if (lt) {
         int i;
         int numfacs;
@@ -343,6 +345,7 @@ void print_help(char *nam)
            "  -f, --flatearth            emit flattened hierarchies\n"
            "  -c, --coalesce             coalesce bitblasted vectors\n"
            "  -n, --notruncate           do not shorten bitvectors\n"
+           "  -j, --jobs=N               decompress blocks on N threads\n"
            "  -h, --help                 display this help then exit\n\n"
            "VCD is emitted to stdout if output filename is unspecified.\n\n"
            "Report bugs to <" PACKAGE_BUGREPORT ">.\n",
@@ -354,6 +357,7 @@ void print_help(char *nam)
            "  -f                         emit flattened hierarchies\n"
            "  -c                         coalesce bitblasted vectors\n"
            "  -n                         do not shorten bitvectors\n"
+           "  -j                         decompress blocks on N threads\n"
            "  -h                         display this help then exit\n\n"
            "VCD is emitted to stdout if output filename is unspecified.\n\n"
            "Report bugs to <" PACKAGE_BUGREPORT ">.\n",
@@ -383,12 +387,13 @@ int main(int argc, char **argv)
                                                {"coalesce", 0, 0, 'c'},
                                                {"flatearth", 0, 0, 'f'},
                                                {"notruncate", 0, 0, 'n'},
+                                               {"jobs", 1, 0, 'j'},
                                                {"help", 0, 0, 'h'},
                                                {0, 0, 0, 0}};
 
-        c = getopt_long(argc, argv, "v:o:cfnh", long_options, &option_index);
+        c = getopt_long(argc, argv, "v:o:cfnj:h", long_options, &option_index);
 #else
-        c = getopt(argc, argv, "v:o:cfnh");
+        c = getopt(argc, argv, "v:o:cfnj:h");
 #endif
 
         if (c == -1)
@@ -421,6 +426,13 @@ int main(int argc, char **argv)
                 flat_earth = 1;
                 break;
 
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs < 1) {
+                    jobs = 1;
+                }
+                break;
+
             case 'h':
                 print_help(argv[0]);
                 break;
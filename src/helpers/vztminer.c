@@ -22,6 +22,7 @@
 
 #include <config.h>
 
+#include <glib.h>
 #include "vzt_read.h"
 
 #ifdef HAVE_GETOPT_H
@@ -115,7 +116,7 @@ int process_vzt(char *fname)
 {
     struct vzt_rd_trace *lt;
 
-    lt = vzt_rd_init(fname);
+    lt = vzt_rd_init_smp(fname, g_get_num_processors()); /* decode blocks on the other cpus */
     if (lt) {
         int numfacs;
 
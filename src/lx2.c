@@ -20,10 +20,82 @@
 #include "symbol.h"
 #include "vcd.h"
 #include "busy.h"
+#include "status.h"
 
 // TODO: remove
 static GPtrArray *import_nodes;
 
+static guint trim_source_id;
+
+static void add_displayed_nodes(GHashTable *nodes, GwTrace *t)
+{
+    for (; t != NULL; t = t->t_next) {
+        if (!HasWave(t)) {
+            continue;
+        }
+
+        if (!t->vector) {
+            g_hash_table_add(nodes, t->n.nd);
+        } else if (t->n.vec->bits != NULL) {
+            /* the bits are needed again when the vector is regenerated */
+            GwBits *bits = t->n.vec->bits;
+            for (int i = 0; i < bits->nnbits; i++) {
+                g_hash_table_add(nodes, bits->nodes[i]);
+            }
+        }
+    }
+}
+
+static gboolean node_is_displayed(GwNode *node, gpointer user_data)
+{
+    return g_hash_table_contains(user_data, node);
+}
+
+static gboolean trim_imported_traces(gpointer user_data)
+{
+    trim_source_id = 0;
+
+    /* the traces of another tab can't tell which nodes of this dump file are in use */
+    if (GLOBALS != user_data || GLOBALS->dump_file == NULL) {
+        return G_SOURCE_REMOVE;
+    }
+
+    GHashTable *displayed = g_hash_table_new(g_direct_hash, g_direct_equal);
+    add_displayed_nodes(displayed, GLOBALS->traces.first);
+    add_displayed_nodes(displayed, GLOBALS->traces.buffer);
+
+    guint evicted = gw_dump_file_trim_memory(GLOBALS->dump_file, node_is_displayed, displayed);
+
+    g_hash_table_destroy(displayed);
+
+    if (evicted > 0) {
+        gchar *msg = g_strdup_printf("Evicted %u traces, %" G_GSIZE_FORMAT
+                                     " KB of trace data remain imported.\n",
+                                     evicted,
+                                     gw_dump_file_get_memory_usage(GLOBALS->dump_file) / 1024);
+        status_text(msg);
+        g_free(msg);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * evicts traces which exceed the memory_budget rc setting once the current
+ * action has finished adding the just imported traces to the display
+ */
+static void schedule_trim(void)
+{
+    GwDumpFile *dump_file = GLOBALS->dump_file;
+
+    if (trim_source_id != 0 ||
+        gw_dump_file_get_memory_usage(dump_file) <= gw_dump_file_get_memory_budget(dump_file)) {
+        return;
+    }
+
+    trim_source_id = g_idle_add(trim_imported_traces, GLOBALS);
+}
+
 /*
  * actually import an lx2 trace but don't do it if it's already been imported
  */
@@ -33,6 +105,8 @@ void import_lx2_trace(GwNode *np)
 
     // TODO: report errors
     g_assert_true(gw_dump_file_import_traces(GLOBALS->dump_file, nodes, NULL));
+
+    schedule_trim();
 }
 
 /*
@@ -60,4 +134,6 @@ void lx2_import_masked(void)
         gw_dump_file_import_traces(GLOBALS->dump_file, (GwNode **)import_nodes->pdata, NULL));
 
     g_ptr_array_set_size(import_nodes, 0);
+
+    schedule_trim();
 }
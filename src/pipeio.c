@@ -185,6 +185,7 @@ struct pipe_ctx *pipeio_create(char *execappname, char *arg)
     p->sout = fsout;
     p->fd0 = filedes_r[0]; /* for potential select() ops */
     p->fd1 = filedes_w[1]; /* ditto */
+    p->ttrans_protocol = 0; /* TTRANS_PROTOCOL_UNKNOWN */
 
     return (p);
 }
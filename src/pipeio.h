@@ -42,6 +42,7 @@ struct pipe_ctx
     FILE *sin, *sout;
     int fd0, fd1;
     pid_t pid;
+    int ttrans_protocol; /* TTRANS_PROTOCOL_*, negotiated per filter, see ttrans_frame.h */
 
 #endif
 };
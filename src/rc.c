@@ -255,6 +255,14 @@ int f_lz_removal(const char *str)
     return (0);
 }
 
+int f_memory_budget(const char *str)
+{
+    DEBUG(printf("f_memory_budget(\"%s\")\n", str));
+    GwTime budget = atoi_64(str);
+    GLOBALS->settings.memory_budget = budget > 0 ? budget : 0;
+    return (0);
+}
+
 int f_fontname_logfile(const char *str)
 {
     DEBUG(printf("f_fontname_logfile(\"%s\")\n", str));
@@ -594,6 +602,13 @@ int f_ruler_step(const char *str)
     return (0);
 }
 
+int f_vcd_cache(const char *str)
+{
+    DEBUG(printf("f_vcd_cache(\"%s\")\n", str));
+    GLOBALS->settings.vcd_cache = atoi_64(str) ? 1 : 0;
+    return (0);
+}
+
 int f_vcd_preserve_glitches(const char *str)
 {
     DEBUG(printf("f_vcd_preserve_glitches(\"%s\")\n", str));
@@ -837,6 +852,7 @@ static struct rc_entry rcitems[] = {{"accel", f_accel},
                                     {"keep_xz_colors", f_keep_xz_colors},
                                     {"left_justify_sigs", f_left_justify_sigs},
                                     {"lz_removal", f_lz_removal},
+                                    {"memory_budget", f_memory_budget},
                                     {"page_divisor", f_page_divisor},
                                     {"ps_maxveclen", f_ps_maxveclen},
                                     {"ruler_origin", f_ruler_origin},
@@ -858,6 +874,7 @@ static struct rc_entry rcitems[] = {{"accel", f_accel},
                                     {"use_nonprop_fonts", f_use_nonprop_fonts},
                                     {"use_pango_fonts", f_use_pango_fonts},
                                     {"use_roundcaps", f_use_roundcaps},
+                                    {"vcd_cache", f_vcd_cache},
                                     {"vcd_preserve_glitches", f_vcd_preserve_glitches},
                                     {"vcd_preserve_glitches_real", f_vcd_preserve_glitches_real},
                                     {"vcd_warning_filesize", f_vcd_warning_filesize},
@@ -93,6 +93,7 @@ int f_initial_window_y(const char *str);
 int f_initial_window_ypos(const char *str);
 int f_left_justify_sigs(const char *str);
 int f_lxt_clock_compress_to_z(const char *str);
+int f_memory_budget(const char *str);
 int f_page_divisor(const char *str);
 int f_ps_maxveclen(const char *str);
 int f_show_base_symbols(const char *str);
@@ -105,6 +106,7 @@ int f_use_full_precision(const char *str);
 int f_use_maxtime_display(const char *str);
 int f_use_nonprop_fonts(const char *str);
 int f_use_roundcaps(const char *str);
+int f_vcd_cache(const char *str);
 int f_vcd_preserve_glitches(const char *str);
 int f_vcd_warning_filesize(const char *str);
 int f_vector_padding(const char *str);
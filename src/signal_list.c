@@ -465,9 +465,7 @@ static void select_range(GwTrace *a, GwTrace *b)
 static gboolean button_press_event(GtkWidget *widget, GdkEventButton *event)
 {
     GwSignalList *signal_list = GW_SIGNAL_LIST(widget);
-    gboolean full_redraw =
-        GLOBALS->highlight_wavewindow; // force redraw for this because signal updates cause
-                                       // wavewindow updates when active
+    gboolean full_redraw = FALSE;
 
     gtk_widget_grab_focus(widget);
 
@@ -560,6 +558,12 @@ static gboolean button_press_event(GtkWidget *widget, GdkEventButton *event)
         redraw_signals_and_waves();
     } else if (signal_list->dirty) {
         gtk_widget_queue_draw(widget);
+
+        // selection changes are visible in the wavewindow when highlighting is active,
+        // only the affected rows have to be rendered again
+        if (GLOBALS->highlight_wavewindow) {
+            gw_wave_view_redraw_rows(GW_WAVE_VIEW(GLOBALS->wavearea));
+        }
     }
 
     return GDK_EVENT_STOP;
@@ -591,7 +595,7 @@ static gboolean button_release_event(GtkWidget *widget, GdkEventButton *event)
             gtk_widget_queue_draw(widget);
 
             if (GLOBALS->highlight_wavewindow) {
-                gw_wave_view_force_redraw(GW_WAVE_VIEW(GLOBALS->wavearea));
+                gw_wave_view_redraw_rows(GW_WAVE_VIEW(GLOBALS->wavearea));
             }
         }
     }
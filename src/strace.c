@@ -609,17 +609,17 @@ static void strace_search_2(int direction, int is_last_iteration)
                 GLOBALS->shift_timebase = t->shift;
                 if (!(t->vector)) {
                     GwHistEnt *h;
-                    GwHistEnt **hp;
+                    GwHistCursor cursor;
                     GwUTime utt;
                     GwTime tt;
 
-                    /* h= */ bsearch_node(t->n.nd, basetime - t->shift); /* scan-build */
-                    hp = GLOBALS->max_compare_index;
-                    if ((hp == &(t->n.nd->harray[1])) || (hp == &(t->n.nd->harray[0])))
+                    gw_hist_cursor_init_node(&cursor, t->n.nd);
+                    if (gw_hist_cursor_seek(&cursor, basetime - t->shift) <= 1)
                         return;
-                    if (basetime == ((*hp)->time + GLOBALS->shift_timebase))
-                        hp--;
-                    h = *hp;
+                    if (basetime == (gw_hist_cursor_get_hist_ent(&cursor)->time +
+                                     GLOBALS->shift_timebase))
+                        gw_hist_cursor_seek_near(&cursor, basetime - t->shift - 1);
+                    h = gw_hist_cursor_get_hist_ent(&cursor);
                     s->his.h = h;
                     utt = strace_adjust(h->time, GLOBALS->shift_timebase);
                     tt = utt;
@@ -627,17 +627,17 @@ static void strace_search_2(int direction, int is_last_iteration)
                         maxbase = tt;
                 } else {
                     GwVectorEnt *v;
-                    GwVectorEnt **vp;
+                    GwHistCursor cursor;
                     GwUTime utt;
                     GwTime tt;
 
-                    /* v= */ bsearch_vector(t->n.vec, basetime - t->shift); /* scan-build */
-                    vp = GLOBALS->vmax_compare_index;
-                    if ((vp == &(t->n.vec->vectors[1])) || (vp == &(t->n.vec->vectors[0])))
+                    gw_hist_cursor_init_vector(&cursor, t->n.vec);
+                    if (gw_hist_cursor_seek(&cursor, basetime - t->shift) <= 1)
                         return;
-                    if (basetime == ((*vp)->time + GLOBALS->shift_timebase))
-                        vp--;
-                    v = *vp;
+                    if (basetime == (gw_hist_cursor_get_vector_ent(&cursor)->time +
+                                     GLOBALS->shift_timebase))
+                        gw_hist_cursor_seek_near(&cursor, basetime - t->shift - 1);
+                    v = gw_hist_cursor_get_vector_ent(&cursor);
                     s->his.v = v;
                     utt = strace_adjust(v->time, GLOBALS->shift_timebase);
                     tt = utt;
@@ -813,7 +813,7 @@ static void strace_search_2(int direction, int is_last_iteration)
                             }
                         }
                     } else {
-                        chval = convert_ascii_vec(t, s->his.h->v.h_vector);
+                        chval = convert_ascii_hist(t, s->his.h);
                     }
                 }
 
@@ -991,334 +991,347 @@ void strace_search(int direction)
 /*********************************************/
 
 /*
- * strace forward to make the timetrace
+ * streaming pattern mark engine: each participating trace gets a cursor into its
+ * harray (or vectors[] for vector traces) that only ever moves forward, so the
+ * whole marker range is evaluated in one merged pass over the histories instead
+ * of a bsearch per trace for every candidate time.
  */
-GwTime strace_timetrace(GwTime basetime, int notfirst)
+struct strace_cursor
 {
     struct strace *s;
-    GwTime maxbase, fintim;
-    GwTrace *t;
-    int totaltraces, passcount;
-    int whichpass;
+    GwHistCursor hc;
+    char level; /* cached value match for the current entry, edges excluded */
+};
 
-    fintim = GLOBALS->tims.last;
-
-    for (whichpass = 0;; whichpass++) {
-        maxbase = MAX_HISTENT_TIME;
-        s = GLOBALS->strace_ctx->straces;
-        while (s) {
-            t = s->trace;
-            GLOBALS->shift_timebase = t->shift;
-            if (!(t->vector)) {
-                GwHistEnt *h;
-                GwUTime utt;
-                GwTime tt;
-
-                h = bsearch_node(t->n.nd, basetime - t->shift);
-                s->his.h = h;
-                while (h->time == h->next->time) {
-                    h = h->next;
-                }
-                if ((whichpass) || (notfirst)) {
-                    h = h->next;
-                }
-                if (h == NULL) {
-                    return MAX_HISTENT_TIME;
-                }
-                utt = strace_adjust(h->time, GLOBALS->shift_timebase);
-                tt = utt;
-                if (tt < maxbase)
-                    maxbase = tt;
-            } else {
-                GwVectorEnt *v;
-                GwUTime utt;
-                GwTime tt;
+static GwTime strace_cursor_time(struct strace_cursor *c, int idx)
+{
+    return strace_adjust(gw_hist_cursor_get_time(&c->hc, idx), c->s->trace->shift);
+}
 
-                v = bsearch_vector(t->n.vec, basetime - t->shift);
-                if ((whichpass) || (notfirst)) {
-                    v = v->next;
-                }
-                if (v == NULL) {
-                    return MAX_HISTENT_TIME;
-                }
-                s->his.v = v;
-                utt = strace_adjust(v->time, GLOBALS->shift_timebase);
-                tt = utt;
-                if (tt < maxbase)
-                    maxbase = tt;
-            }
+/*
+ * value part of the search type for the entry under the cursor, edge search types
+ * only report the level here and are qualified against the candidate time later
+ */
+static char strace_cursor_level(struct strace_cursor *c)
+{
+    struct strace *s = c->s;
+    GwTrace *t = s->trace;
+    char result = 0;
 
-            s = s->next;
-        }
+    if (s->value == ST_DC) {
+        return 0;
+    }
 
-        s = GLOBALS->strace_ctx->straces;
-        totaltraces = 0; /* increment when not don't care */
-        while (s) {
-            char str[2];
-            t = s->trace;
-            s->search_result = 0; /* explicitly must set this */
-            GLOBALS->shift_timebase = t->shift;
+    if ((!t->vector) && (!(t->n.nd->extvals))) {
+        GwHistEnt *h = gw_hist_cursor_get_hist_ent(&c->hc);
+        char str[2];
 
-            if ((!t->vector) && (!(t->n.nd->extvals))) {
-                if (strace_adjust(s->his.h->time, GLOBALS->shift_timebase) != maxbase) {
-                    s->his.h = bsearch_node(t->n.nd, maxbase - t->shift);
-                    while (s->his.h->next && s->his.h->time == s->his.h->next->time) {
-                        s->his.h = s->his.h->next;
-                    }
-                }
+        str[0] = gw_bit_to_char(h->v.h_val);
+        str[1] = 0x00;
 
-                GwBit h_val = s->his.h->v.h_val;
-                if (t->flags & TR_INVERT) {
-                    h_val = gw_bit_invert(h_val);
-                }
+        switch (s->value) {
+            case ST_HIGH:
+            case ST_RISE:
+                result = (str[0] == '1' || str[0] == 'h' || str[0] == 'H');
+                break;
 
-                str[0] = gw_bit_to_char(s->his.h->v.h_val);
-                str[1] = 0x00;
+            case ST_LOW:
+            case ST_FALL:
+                result = (str[0] == '0' || str[0] == 'l' || str[0] == 'L');
+                break;
 
-                switch (s->value) {
-                    case ST_DC:
-                        break;
+            case ST_MID:
+                result = (str[0] == 'z' || str[0] == 'Z');
+                break;
 
-                    case ST_HIGH:
-                        totaltraces++;
-                        if (str[0] == '1' || str[0] == 'h' || str[0] == 'H') {
-                            s->search_result = 1;
-                        }
-                        break;
+            case ST_X:
+                result = (str[0] == 'x' || str[0] == 'X');
+                break;
 
-                    case ST_RISE:
-                        totaltraces++;
-                        if ((str[0] == '1' || str[0] == 'h' || str[0] == 'H') &&
-                            strace_adjust(s->his.h->time, GLOBALS->shift_timebase) == maxbase) {
-                            s->search_result = 1;
-                        }
-                        break;
+            case ST_ANY:
+                result = 1;
+                break;
 
-                    case ST_LOW:
-                        totaltraces++;
-                        if (str[0] == '0' || str[0] == 'l' || str[0] == 'L') {
-                            s->search_result = 1;
-                        }
-                        break;
+            case ST_STRING:
+                result = (s->string != NULL && strstr_i(s->string, str) != NULL);
+                break;
 
-                    case ST_FALL:
-                        totaltraces++;
-                        if ((str[0] == '0' || str[0] == 'l' || str[0] == 'L') &&
-                            strace_adjust(s->his.h->time, GLOBALS->shift_timebase) == maxbase) {
-                            s->search_result = 1;
-                        }
-                        break;
+            default:
+                fprintf(stderr, "Internal error: st_type of %d\n", s->value);
+                exit(255);
+        }
+    } else {
+        char *chval, *chval2;
+        char ch;
 
-                    case ST_MID:
-                        totaltraces++;
-                        if ((str[0] == 'z') || (str[0] == 'Z'))
-                            s->search_result = 1;
-                        break;
+        if (t->vector) {
+            chval = convert_ascii(t, gw_hist_cursor_get_vector_ent(&c->hc));
+        } else {
+            GwHistEnt *h = gw_hist_cursor_get_hist_ent(&c->hc);
 
-                    case ST_X:
-                        totaltraces++;
-                        if (str[0] == 'x' || str[0] == 'X') {
-                            s->search_result = 1;
+            if (h->flags & GW_HIST_ENT_FLAG_REAL) {
+                if (!(h->flags & GW_HIST_ENT_FLAG_STRING)) {
+                    chval = convert_ascii_real(t, &h->v.h_double);
+                } else {
+                    chval = convert_ascii_string((char *)h->v.h_vector);
+                    chval2 = chval;
+                    while ((ch = *chval2)) { /* toupper() the string */
+                        if ((ch >= 'a') && (ch <= 'z')) {
+                            *chval2 = ch - ('a' - 'A');
                         }
-                        break;
+                        chval2++;
+                    }
+                }
+            } else {
+                chval = convert_ascii_hist(t, h);
+            }
+        }
 
-                    case ST_ANY:
-                        totaltraces++;
-                        if (strace_adjust(s->his.h->time, GLOBALS->shift_timebase) == maxbase) {
-                            s->search_result = 1;
-                        }
-                        break;
+        switch (s->value) {
+            case ST_RISE:
+            case ST_FALL:
+                break;
 
-                    case ST_STRING:
-                        totaltraces++;
-                        if (s->string != NULL && strstr_i(s->string, str) != NULL) {
-                            s->search_result = 1;
+            case ST_HIGH:
+                if ((chval2 = chval)) {
+                    while ((ch = *(chval2++))) {
+                        if ((ch >= '1' && ch <= '9') || ch == 'h' || ch == 'H' ||
+                            (ch >= 'A' && ch <= 'F')) {
+                            result = 1;
+                            break;
                         }
-                        break;
-
-                    default:
-                        fprintf(stderr, "Internal error: st_type of %d\n", s->value);
-                        exit(255);
+                    }
                 }
+                break;
 
-            } else {
-                char *chval, *chval2;
-                char ch;
-
-                if (t->vector) {
-                    if (strace_adjust(s->his.v->time, GLOBALS->shift_timebase) != maxbase) {
-                        s->his.v = bsearch_vector(t->n.vec, maxbase - t->shift);
-                        while (s->his.v->next && s->his.v->time == s->his.v->next->time) {
-                            s->his.v = s->his.v->next;
+            case ST_LOW:
+                if ((chval2 = chval)) {
+                    result = 1;
+                    while ((ch = *(chval2++))) {
+                        if (ch != '0' && ch != 'l' && ch != 'L') {
+                            result = 0;
+                            break;
                         }
                     }
-                    chval = convert_ascii(t, s->his.v);
-                } else {
-                    if (strace_adjust(s->his.h->time, GLOBALS->shift_timebase) != maxbase) {
-                        s->his.h = bsearch_node(t->n.nd, maxbase - t->shift);
-                        while (s->his.h->next && s->his.h->time == s->his.h->next->time) {
-                            s->his.h = s->his.h->next;
+                }
+                break;
+
+            case ST_MID:
+                if ((chval2 = chval)) {
+                    result = 1;
+                    while ((ch = *(chval2++))) {
+                        if (ch != 'z' && ch != 'Z') {
+                            result = 0;
+                            break;
                         }
                     }
-                    if (s->his.h->flags & GW_HIST_ENT_FLAG_REAL) {
-                        if (!(s->his.h->flags & GW_HIST_ENT_FLAG_STRING)) {
-                            chval = convert_ascii_real(t, &s->his.h->v.h_double);
-                        } else {
-                            chval = convert_ascii_string((char *)s->his.h->v.h_vector);
-                            chval2 = chval;
-                            while ((ch = *chval2)) { /* toupper() the string */
-                                if ((ch >= 'a') && (ch <= 'z')) {
-                                    *chval2 = ch - ('a' - 'A');
-                                }
-                                chval2++;
-                            }
+                }
+                break;
+
+            case ST_X:
+                if ((chval2 = chval)) {
+                    result = 1;
+                    while ((ch = *(chval2++))) {
+                        if (ch != 'x' && ch != 'w' && ch != 'X' && ch != 'W') {
+                            result = 0;
+                            break;
                         }
-                    } else {
-                        chval = convert_ascii_vec(t, s->his.h->v.h_vector);
                     }
                 }
+                break;
 
-                switch (s->value) {
-                    case ST_DC:
-                        break;
+            case ST_ANY:
+                result = 1;
+                break;
 
-                    case ST_RISE:
-                    case ST_FALL:
-                        totaltraces++;
-                        break;
+            case ST_STRING:
+                result = (s->string != NULL && strstr_i(chval, s->string) != NULL);
+                break;
 
-                    case ST_HIGH:
-                        totaltraces++;
-                        if ((chval2 = chval)) {
-                            while ((ch = *(chval2++))) {
-                                if ((ch >= '1' && ch <= '9') || ch == 'h' || ch == 'H' ||
-                                    (ch >= 'A' && ch <= 'F')) {
-                                    s->search_result = 1;
-                                    break;
-                                }
-                            }
-                        }
-                        break;
+            default:
+                fprintf(stderr, "Internal error: st_type of %d\n", s->value);
+                exit(255);
+        }
 
-                    case ST_LOW:
-                        totaltraces++;
-                        if ((chval2 = chval)) {
-                            s->search_result = 1;
-                            while ((ch = *(chval2++))) {
-                                if (ch != '0' && ch != 'l' && ch != 'L') {
-                                    s->search_result = 0;
-                                    break;
-                                }
-                            }
-                        }
-                        break;
+        free_2(chval);
+    }
 
-                    case ST_MID:
-                        totaltraces++;
-                        if ((chval2 = chval)) {
-                            s->search_result = 1;
-                            while ((ch = *(chval2++))) {
-                                if (ch != 'z' && ch != 'Z') {
-                                    s->search_result = 0;
-                                    break;
-                                }
-                            }
-                        }
-                        break;
+    return result;
+}
 
-                    case ST_X:
-                        totaltraces++;
-                        if ((chval2 = chval)) {
-                            s->search_result = 1;
-                            while ((ch = *(chval2++))) {
-                                if (ch != 'x' && ch != 'w' && ch != 'X' && ch != 'W') {
-                                    s->search_result = 0;
-                                    break;
-                                }
-                            }
-                        }
-                        break;
+static void strace_cursor_reset(struct strace_cursor *c, GwTime key)
+{
+    gw_hist_cursor_seek(&c->hc, key - c->s->trace->shift);
+    c->level = strace_cursor_level(c);
+}
 
-                    case ST_ANY:
-                        totaltraces++;
-                        if (strace_adjust(s->his.v->time, GLOBALS->shift_timebase) == maxbase) {
-                            s->search_result = 1;
-                        }
-                        break;
+/* moves forward only, value conversion is redone only when the entry changes */
+static void strace_cursor_advance(struct strace_cursor *c, GwTime key)
+{
+    int idx = gw_hist_cursor_get_index(&c->hc);
 
-                    case ST_STRING:
-                        totaltraces++;
-                        if (s->string != NULL && strstr_i(chval, s->string) != NULL) {
-                            s->search_result = 1;
-                        }
-                        break;
+    if (gw_hist_cursor_seek_near(&c->hc, key - c->s->trace->shift) != idx) {
+        c->level = strace_cursor_level(c);
+    }
+}
 
-                    default:
-                        fprintf(stderr, "Internal error: st_type of %d\n", s->value);
-                        exit(255);
-                }
+static gboolean strace_logical_pass(int totaltraces, int passcount)
+{
+    if (!totaltraces) {
+        return FALSE;
+    }
 
-                free_2(chval);
-            }
-            s = s->next;
+    if (GLOBALS->strace_ctx->logical_mutex[0]) { /* and */
+        return totaltraces == passcount;
+    } else if (GLOBALS->strace_ctx->logical_mutex[1]) { /* or */
+        return passcount != 0;
+    } else if (GLOBALS->strace_ctx->logical_mutex[2]) { /* xor */
+        return (passcount & 1) != 0;
+    } else if (GLOBALS->strace_ctx->logical_mutex[3]) { /* nand */
+        return totaltraces != passcount;
+    } else if (GLOBALS->strace_ctx->logical_mutex[4]) { /* nor */
+        return passcount == 0;
+    } else if (GLOBALS->strace_ctx->logical_mutex[5]) { /* xnor */
+        return (passcount & 1) == 0;
+    }
+
+    return FALSE;
+}
+
+/*
+ * walk forward from basetime to endtime emitting every time the pattern matches,
+ * candidates are the merged transition times of all participating traces
+ */
+static int strace_timetrace_stream(GwTime basetime, GwTime endtime, GwTime **timearray)
+{
+    struct strace *s;
+    struct strace_cursor *cursors;
+    int numcursors = 0;
+    int i;
+    GwTime fintim = GLOBALS->tims.last;
+    GwTime tim;
+    GwTime *t;
+    int t_allocated = 1;
+    int t_size = 0;
+
+    *timearray = NULL;
+
+    for (s = GLOBALS->strace_ctx->straces; s; s = s->next) {
+        numcursors++;
+    }
+    if (!numcursors) {
+        return 0;
+    }
+
+    cursors = calloc_2(numcursors, sizeof(struct strace_cursor));
+    for (i = 0, s = GLOBALS->strace_ctx->straces; s; s = s->next, i++) {
+        GwTrace *tr = s->trace;
+
+        cursors[i].s = s;
+        if (tr->vector) {
+            gw_hist_cursor_init_vector(&cursors[i].hc, tr->n.vec);
+        } else {
+            gw_hist_cursor_init_node(&cursors[i].hc, tr->n.nd);
         }
+    }
 
-        if (maxbase > fintim)
-            return (MAX_HISTENT_TIME);
+    /* first candidate is the earliest value in effect at basetime */
+    tim = MAX_HISTENT_TIME;
+    for (i = 0; i < numcursors; i++) {
+        GwTime ct;
 
-        DEBUG(printf("Maxbase: %" GW_TIME_FORMAT ", total traces: %d\n", maxbase, totaltraces));
-        s = GLOBALS->strace_ctx->straces;
-        passcount = 0;
-        while (s) {
-            DEBUG(printf("\tPass: %d, Name: %s\n", s->search_result, s->trace->name));
-            if (s->search_result) {
+        gw_hist_cursor_seek(&cursors[i].hc, basetime - cursors[i].s->trace->shift);
+        ct = strace_cursor_time(&cursors[i], gw_hist_cursor_get_index(&cursors[i].hc));
+        if (ct < tim) {
+            tim = ct;
+        }
+    }
+    for (i = 0; i < numcursors; i++) {
+        strace_cursor_reset(&cursors[i], tim);
+    }
+
+    t = malloc_2(sizeof(GwTime) * t_allocated);
+
+    for (;;) {
+        int totaltraces = 0;
+        int passcount = 0;
+        GwTime nexttim;
+
+        if ((tim > fintim) || (tim > endtime)) {
+            break;
+        }
+
+        for (i = 0; i < numcursors; i++) {
+            struct strace_cursor *c = &cursors[i];
+            char result;
+
+            if (c->s->value == ST_DC) {
+                continue;
+            }
+
+            totaltraces++;
+            result = c->level;
+            if (result && ((c->s->value == ST_RISE) || (c->s->value == ST_FALL) ||
+                           (c->s->value == ST_ANY))) {
+                result = (strace_cursor_time(c, gw_hist_cursor_get_index(&c->hc)) == tim);
+            }
+            c->s->search_result = result;
+            if (result) {
                 passcount++;
             }
-            s = s->next;
         }
 
-        if (totaltraces) {
-            if (GLOBALS->strace_ctx->logical_mutex[0]) { /* and */
-                if (totaltraces == passcount) {
-                    break;
-                }
-            } else if (GLOBALS->strace_ctx->logical_mutex[1]) { /* or */
-                if (passcount) {
-                    break;
-                }
-            } else if (GLOBALS->strace_ctx->logical_mutex[2]) { /* xor */
-                if (passcount & 1) {
-                    break;
-                }
-            } else if (GLOBALS->strace_ctx->logical_mutex[3]) { /* nand */
-                if (totaltraces != passcount) {
-                    break;
-                }
-            } else if (GLOBALS->strace_ctx->logical_mutex[4]) { /* nor */
-                if (!passcount) {
-                    break;
-                }
-            } else if (GLOBALS->strace_ctx->logical_mutex[5]) { /* xnor */
-                if (!(passcount & 1)) {
-                    break;
-                }
+        if ((tim >= basetime) && strace_logical_pass(totaltraces, passcount)) {
+            t[t_size++] = tim;
+            if (t_size == t_allocated) {
+                t_allocated *= 2;
+                t = realloc_2(t, sizeof(GwTime) * t_allocated);
             }
         }
 
-        basetime = maxbase;
+        /* next candidate is the earliest pending transition, any trace running out ends it */
+        nexttim = MAX_HISTENT_TIME;
+        for (i = 0; i < numcursors; i++) {
+            struct strace_cursor *c = &cursors[i];
+            int next = gw_hist_cursor_get_index(&c->hc) + 1;
+            GwTime ct;
+
+            if (next >= c->hc.count) {
+                nexttim = MAX_HISTENT_TIME;
+                break;
+            }
+
+            ct = strace_cursor_time(c, next);
+            if (ct < nexttim) {
+                nexttim = ct;
+            }
+        }
+
+        if ((nexttim == MAX_HISTENT_TIME) || (nexttim <= tim)) {
+            break;
+        }
+
+        tim = nexttim;
+        for (i = 0; i < numcursors; i++) {
+            strace_cursor_advance(&cursors[i], tim);
+        }
+    }
+
+    free_2(cursors);
+
+    if (t_size) {
+        *timearray = realloc_2(t, sizeof(GwTime) * t_size);
+    } else {
+        free_2(t);
     }
 
-    return (maxbase);
+    return t_size;
 }
 
 void strace_maketimetrace(int mode)
 {
     GwTime basetime = GLOBALS->tims.first;
     GwTime endtime = MAX_HISTENT_TIME;
-    int notfirst = 0;
-    GwTime *t;
-    int t_allocated;
-    GwTime orig_basetime;
 
     if (GLOBALS->strace_ctx->timearray) {
         free_2(GLOBALS->strace_ctx->timearray);
@@ -1366,40 +1379,8 @@ void strace_maketimetrace(int mode)
         endtime = tmp;
     }
 
-    t_allocated = 1;
-    t = malloc_2(sizeof(GwTime) * t_allocated);
-
-    orig_basetime = basetime;
-    while (1) {
-        basetime = strace_timetrace(basetime, notfirst);
-        notfirst = 1;
-
-        if (endtime == MAX_HISTENT_TIME) {
-            if (basetime == MAX_HISTENT_TIME)
-                break;
-        } else {
-            if (basetime > endtime)
-                break; /* formerly was >= which didn't mark the endpoint if true which is incorrect
-                        */
-        } /* i.e., if start is markable, end should be also */
-
-        if (basetime >= orig_basetime) {
-            t[GLOBALS->strace_ctx->timearray_size] = basetime;
-            GLOBALS->strace_ctx->timearray_size++;
-            if (GLOBALS->strace_ctx->timearray_size == t_allocated) {
-                t_allocated *= 2;
-                t = realloc_2(t, sizeof(GwTime) * t_allocated);
-            }
-        }
-    }
-
-    if (GLOBALS->strace_ctx->timearray_size) {
-        GLOBALS->strace_ctx->timearray =
-            realloc_2(t, sizeof(GwTime) * GLOBALS->strace_ctx->timearray_size);
-    } else {
-        free_2(t);
-        GLOBALS->strace_ctx->timearray = NULL;
-    }
+    GLOBALS->strace_ctx->timearray_size =
+        strace_timetrace_stream(basetime, endtime, &GLOBALS->strace_ctx->timearray);
 
     if (!GLOBALS->strace_ctx->shadow_active)
         update_mark_count_label();
@@ -1468,7 +1468,7 @@ static char *give_value_string(GwTrace *t)
                                 rc = convert_ascii_string((char *)h_ptr->v.h_vector);
                             }
                         } else {
-                            rc = convert_ascii_vec(t, h_ptr->v.h_vector);
+                            rc = convert_ascii_hist(t, h_ptr);
                         }
                     }
                 }
@@ -1607,7 +1607,9 @@ char *add_traces_from_signal_window(gboolean is_from_tcl_command)
                         ? bsearch_vector(t->n.vec,
                                          gw_marker_get_position(primary_marker) - t->shift)
                         : NULL;
-                unsigned char *bits = v ? (v->v) : NULL;
+                guint8 *unpacked = NULL;
+                const unsigned char *bits =
+                    v ? gw_vector_ent_get_bits(v, t->n.vec->nbits, &unpacked) : NULL;
                 char *first_str = NULL;
                 int coalesce_pass = 1;
 
@@ -1765,6 +1767,8 @@ char *add_traces_from_signal_window(gboolean is_from_tcl_command)
                             }
                         }
                     }
+
+                g_free(unpacked);
             } else {
                 if (t->n.nd->expansion) {
                     int which, cnt;
@@ -0,0 +1,169 @@
+#include <config.h>
+#include "globals.h"
+#include "baseconvert.h"
+#include "currenttime.h"
+#include "translate.h"
+
+// Stubs for the viewer functions used by baseconvert.c.
+
+struct Global *GLOBALS = NULL;
+
+void *malloc_2(size_t size)
+{
+    return g_malloc(size);
+}
+
+void *calloc_2(size_t nmemb, size_t size)
+{
+    return g_malloc0_n(nmemb, size);
+}
+
+void free_2(void *ptr)
+{
+    g_free(ptr);
+}
+
+char *strdup_2(const char *s)
+{
+    return g_strdup(s);
+}
+
+void reformat_time(char *buf, GwTime val, GwTimeDimension dim)
+{
+    (void)dim;
+    sprintf(buf, "%" GW_TIME_FORMAT, val);
+}
+
+xl_Tree *xl_splay(char *i, xl_Tree *t)
+{
+    (void)i;
+    return t;
+}
+
+static GwBitVector *create_vector(gsize nbits)
+{
+    GwBitVector *vec = g_malloc0(sizeof(GwBitVector) + sizeof(GwVectorEnt *));
+    vec->nbits = nbits;
+
+    return vec;
+}
+
+static GwVectorEnt *create_vector_ent(const guint8 *bits, gsize nbits, gboolean packed)
+{
+    guint8 packing = packed ? gw_vector_ent_choose_packing(bits, nbits) : 0;
+
+    GwVectorEnt *v =
+        g_malloc0(sizeof(GwVectorEnt) + gw_vector_ent_get_storage_size(packing, nbits));
+    gw_vector_ent_pack(v, packing, bits, nbits);
+
+    return v;
+}
+
+static gchar *convert(GwTrace *t, const guint8 *bits, gsize nbits, gboolean packed)
+{
+    GwVectorEnt *v = create_vector_ent(bits, nbits, packed);
+    if (packed && nbits >= GW_VECTOR_ENT_PACK_THRESHOLD) {
+        g_assert_cmpint(v->flags & GW_VECTOR_ENT_FLAG_PACKED, !=, 0);
+    }
+
+    char *s = convert_ascii(t, v);
+    gchar *ret = g_strdup(s);
+
+    free_2(s);
+    g_free(v);
+
+    return ret;
+}
+
+static void check_equivalence(const GwBit *alphabet, guint alphabet_size)
+{
+    static const gsize WIDTHS[] = {16, 17, 21, 32, 63, 64, 65, 100, 128, 130};
+    static const TraceFlagsType FORMATS[] = {
+        TR_HEX,
+        TR_DEC,
+        TR_DEC | TR_SIGNED,
+        TR_BIN,
+        TR_OCT,
+    };
+    static const TraceFlagsType ATTRIBUTES[] = {
+        0,
+        TR_RJUSTIFY,
+        TR_INVERT,
+        TR_RJUSTIFY | TR_INVERT,
+    };
+
+    for (guint w = 0; w < G_N_ELEMENTS(WIDTHS); w++) {
+        gsize nbits = WIDTHS[w];
+        GwBitVector *vec = create_vector(nbits);
+        guint8 *bits = g_new(guint8, nbits);
+
+        for (guint round = 0; round < 20; round++) {
+            // the first rounds cover vectors with the same value in every position
+            for (gsize i = 0; i < nbits; i++) {
+                guint index =
+                    round < alphabet_size ? round : g_test_rand_int_range(0, alphabet_size);
+                bits[i] = alphabet[index];
+            }
+
+            for (guint f = 0; f < G_N_ELEMENTS(FORMATS); f++) {
+                for (guint a = 0; a < G_N_ELEMENTS(ATTRIBUTES); a++) {
+                    GwTrace t = {0};
+                    t.n.vec = vec;
+                    t.vector = 1;
+                    t.flags = FORMATS[f] | ATTRIBUTES[a];
+
+                    gchar *unpacked = convert(&t, bits, nbits, FALSE);
+                    gchar *packed = convert(&t, bits, nbits, TRUE);
+
+                    g_assert_cmpstr(packed, ==, unpacked);
+
+                    g_free(unpacked);
+                    g_free(packed);
+                }
+            }
+        }
+
+        g_free(bits);
+        g_free(vec);
+    }
+}
+
+static void test_two_state(void)
+{
+    static const GwBit ALPHABET[] = {GW_BIT_0, GW_BIT_1};
+
+    check_equivalence(ALPHABET, G_N_ELEMENTS(ALPHABET));
+}
+
+static void test_four_state(void)
+{
+    static const GwBit ALPHABET[] = {GW_BIT_0, GW_BIT_1, GW_BIT_X, GW_BIT_Z};
+
+    check_equivalence(ALPHABET, G_N_ELEMENTS(ALPHABET));
+}
+
+static void test_show_base(void)
+{
+    GLOBALS->show_base = 1;
+    test_two_state();
+    GLOBALS->show_base = 0;
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    GLOBALS = g_new0(struct Global, 1);
+    GLOBALS->dump_file = g_object_new(GW_TYPE_DUMP_FILE, NULL);
+
+    g_test_add_func("/baseconvert/two_state", test_two_state);
+    g_test_add_func("/baseconvert/four_state", test_four_state);
+    g_test_add_func("/baseconvert/show_base", test_show_base);
+
+    int ret = g_test_run();
+
+    g_object_unref(GLOBALS->dump_file);
+    g_free(GLOBALS);
+
+    return ret;
+}
@@ -0,0 +1,325 @@
+#include <config.h>
+#include <string.h>
+#include "ttrans_frame.h"
+
+static FILE *write_frames(void (*writer)(struct ttrans_frame *f))
+{
+    FILE *file = tmpfile();
+    struct ttrans_frame f;
+
+    g_assert_nonnull(file);
+
+    ttrans_frame_init(&f, file);
+    writer(&f);
+    ttrans_frame_clear(&f);
+
+    fflush(file);
+    rewind(file);
+
+    return file;
+}
+
+static void write_fields(struct ttrans_frame *f)
+{
+    const char bits[] = {GW_BIT_1, GW_BIT_0, GW_BIT_X, GW_BIT_Z, GW_BIT_H};
+
+    ttrans_frame_begin(f, TTRANS_FRAME_HEADER);
+    ttrans_put_u8(f, 0xA5);
+    ttrans_put_u32(f, 0xDEADBEEF);
+    ttrans_put_i64(f, -1234567890123LL);
+    ttrans_put_f64(f, -2.5);
+    ttrans_put_str(f, "top.sig");
+    ttrans_put_str(f, "");
+    ttrans_put_bits(f, bits, G_N_ELEMENTS(bits));
+    ttrans_put_bits(f, NULL, 3);
+    ttrans_frame_flush(f);
+
+    ttrans_frame_begin(f, TTRANS_FRAME_END);
+    ttrans_frame_flush(f);
+}
+
+static void test_fields(void)
+{
+    FILE *file = write_frames(write_fields);
+    GByteArray *payload = g_byte_array_new();
+    struct ttrans_cursor c;
+    const char *s;
+    const guint8 *packed;
+    guint32 len;
+    guint8 typ;
+
+    g_assert_true(ttrans_frame_read(file, &typ, payload));
+    g_assert_cmpint(typ, ==, TTRANS_FRAME_HEADER);
+
+    ttrans_cursor_init(&c, payload);
+    g_assert_cmpuint(ttrans_get_u8(&c), ==, 0xA5);
+    g_assert_cmpuint(ttrans_get_u32(&c), ==, 0xDEADBEEF);
+    g_assert_cmpint(ttrans_get_i64(&c), ==, -1234567890123LL);
+    g_assert_cmpfloat(ttrans_get_f64(&c), ==, -2.5);
+
+    s = ttrans_get_str(&c, &len);
+    g_assert_cmpuint(len, ==, 7);
+    g_assert_cmpmem(s, len, "top.sig", 7);
+
+    s = ttrans_get_str(&c, &len);
+    g_assert_nonnull(s);
+    g_assert_cmpuint(len, ==, 0);
+
+    // five bits take three bytes, MSB first, the unused low nibble is zero
+    packed = ttrans_get(&c, 3);
+    g_assert_nonnull(packed);
+    g_assert_cmpuint(packed[0], ==, (GW_BIT_1 << 4) | GW_BIT_0);
+    g_assert_cmpuint(packed[1], ==, (GW_BIT_X << 4) | GW_BIT_Z);
+    g_assert_cmpuint(packed[2], ==, GW_BIT_H << 4);
+
+    // a missing value is sent as x
+    packed = ttrans_get(&c, 2);
+    g_assert_nonnull(packed);
+    g_assert_cmpuint(packed[0], ==, (GW_BIT_X << 4) | GW_BIT_X);
+    g_assert_cmpuint(packed[1], ==, GW_BIT_X << 4);
+
+    g_assert_false(c.error);
+    g_assert_true(c.pnt == c.end);
+
+    // reading past the end sets the error and keeps it
+    g_assert_cmpuint(ttrans_get_u32(&c), ==, 0);
+    g_assert_true(c.error);
+    g_assert_null(ttrans_get(&c, 0));
+
+    g_assert_true(ttrans_frame_read(file, &typ, payload));
+    g_assert_cmpint(typ, ==, TTRANS_FRAME_END);
+    g_assert_cmpuint(payload->len, ==, 0);
+
+    g_assert_false(ttrans_frame_read(file, &typ, payload));
+
+    g_byte_array_unref(payload);
+    fclose(file);
+}
+
+#define SPLIT_RECORDS (20000)
+
+static void write_split(struct ttrans_frame *f)
+{
+    ttrans_frame_begin(f, TTRANS_FRAME_VALUES);
+    for (guint32 i = 0; i < SPLIT_RECORDS; i++) {
+        ttrans_put_i64(f, i * 10);
+        ttrans_put_u32(f, i);
+        ttrans_frame_split(f);
+    }
+    ttrans_frame_flush(f);
+}
+
+static void test_split(void)
+{
+    FILE *file = write_frames(write_split);
+    GByteArray *payload = g_byte_array_new();
+    guint32 next = 0;
+    guint frames = 0;
+    guint8 typ;
+
+    // records never straddle two frames
+    while (ttrans_frame_read(file, &typ, payload)) {
+        struct ttrans_cursor c;
+
+        g_assert_cmpint(typ, ==, TTRANS_FRAME_VALUES);
+        g_assert_cmpuint(payload->len, <=, TTRANS_FRAME_FLUSH_SIZE);
+        frames++;
+
+        ttrans_cursor_init(&c, payload);
+        while (c.pnt < c.end) {
+            g_assert_cmpint(ttrans_get_i64(&c), ==, next * 10);
+            g_assert_cmpuint(ttrans_get_u32(&c), ==, next);
+            g_assert_false(c.error);
+            next++;
+        }
+    }
+
+    g_assert_cmpuint(next, ==, SPLIT_RECORDS);
+    g_assert_cmpuint(frames, >, 1);
+
+    g_byte_array_unref(payload);
+    fclose(file);
+}
+
+static void test_bad_frames(void)
+{
+    GByteArray *payload = g_byte_array_new();
+    guint8 typ;
+    FILE *file;
+
+    // oversized length
+    file = tmpfile();
+    {
+        guint8 hdr[TTRANS_FRAME_HEADER_SIZE] = {TTRANS_FRAME_VALUES};
+        guint32 len = GUINT32_TO_LE(TTRANS_FRAME_MAX_SIZE + 1);
+
+        memcpy(hdr + 4, &len, sizeof(len));
+        fwrite(hdr, 1, sizeof(hdr), file);
+    }
+    rewind(file);
+    g_assert_false(ttrans_frame_read(file, &typ, payload));
+    fclose(file);
+
+    // truncated payload
+    file = tmpfile();
+    {
+        guint8 hdr[TTRANS_FRAME_HEADER_SIZE] = {TTRANS_FRAME_NAME};
+        guint32 len = GUINT32_TO_LE(16);
+
+        memcpy(hdr + 4, &len, sizeof(len));
+        fwrite(hdr, 1, sizeof(hdr), file);
+        fwrite("short", 1, 5, file);
+    }
+    rewind(file);
+    g_assert_false(ttrans_frame_read(file, &typ, payload));
+    fclose(file);
+
+    // truncated header
+    file = tmpfile();
+    fwrite("T\0\0", 1, 3, file);
+    rewind(file);
+    g_assert_false(ttrans_frame_read(file, &typ, payload));
+    fclose(file);
+
+    g_byte_array_unref(payload);
+}
+
+// Runs examples/transaction_binary.c through the protocol handshake and a small trace, and
+// checks its reply.
+static void test_example_filter(void)
+{
+    const gchar *filter = g_getenv("TTRANS_BINARY_FILTER");
+    gchar *argv[] = {(gchar *)filter, NULL};
+    GError *error = NULL;
+    gint fd_in;
+    gint fd_out;
+
+    if (filter == NULL) {
+        g_test_skip("TTRANS_BINARY_FILTER is not set");
+        return;
+    }
+
+    g_assert_true(g_spawn_async_with_pipes(NULL,
+                                           argv,
+                                           NULL,
+                                           G_SPAWN_DEFAULT,
+                                           NULL,
+                                           NULL,
+                                           NULL,
+                                           &fd_in,
+                                           &fd_out,
+                                           NULL,
+                                           &error));
+    g_assert_no_error(error);
+
+    FILE *to_filter = fdopen(fd_in, "wb");
+    FILE *from_filter = fdopen(fd_out, "rb");
+    struct ttrans_frame f;
+    const char v1[] = {GW_BIT_1, GW_BIT_0, GW_BIT_1, GW_BIT_0, GW_BIT_0, GW_BIT_0};
+    const char v2[] = {GW_BIT_X, GW_BIT_0, GW_BIT_1, GW_BIT_1, GW_BIT_1, GW_BIT_1};
+
+    char line[256];
+
+    // the offer comes with a textual trace, which the filter skips once it accepts
+    fputs(TTRANS_BINARY_REQUEST, to_filter);
+    fputs("$timescale 1ns $end\n$scope module top $end\n$var wire 6 ! bus $end\n", to_filter);
+    fputs("$upscope $end\n$enddefinitions $end\n#10\nb101000 !\n", to_filter);
+    fputs("$comment data_end 0x1 $end\n", to_filter);
+    fflush(to_filter);
+
+    g_assert_nonnull(fgets(line, sizeof(line), from_filter));
+    g_assert_cmpstr(line, ==, TTRANS_BINARY_ACCEPT "\n");
+
+    ttrans_frame_init(&f, to_filter);
+    ttrans_frame_begin(&f, TTRANS_FRAME_HEADER);
+    ttrans_put_u8(&f, 0);
+    ttrans_put_i64(&f, 1);
+    ttrans_put_i64(&f, 0);
+    ttrans_put_i64(&f, 0);
+    ttrans_put_i64(&f, 100);
+    ttrans_put_str(&f, "bus");
+    ttrans_put_str(&f, "");
+    ttrans_put_u32(&f, 2);
+    ttrans_put_u32(&f, 1);
+    ttrans_put_u8(&f, TTRANS_KIND_REAL);
+    ttrans_put_u32(&f, 1);
+    ttrans_put_str(&f, "top.r");
+    ttrans_put_u32(&f, 2);
+    ttrans_put_u8(&f, TTRANS_KIND_BITS);
+    ttrans_put_u32(&f, 6);
+    ttrans_put_str(&f, "top.bus");
+    ttrans_frame_flush(&f);
+
+    ttrans_frame_begin(&f, TTRANS_FRAME_VALUES);
+    ttrans_put_i64(&f, 5);
+    ttrans_put_u32(&f, 1);
+    ttrans_put_f64(&f, 1.5);
+    ttrans_put_i64(&f, 10);
+    ttrans_put_u32(&f, 2);
+    ttrans_put_bits(&f, v1, 6);
+    ttrans_put_i64(&f, 20);
+    ttrans_put_u32(&f, 2);
+    ttrans_put_bits(&f, v2, 6);
+    ttrans_frame_flush(&f);
+
+    ttrans_frame_begin(&f, TTRANS_FRAME_END);
+    ttrans_frame_flush(&f);
+    ttrans_frame_clear(&f);
+    fclose(to_filter);
+
+    GByteArray *payload = g_byte_array_new();
+    GString *transactions = g_string_new(NULL);
+    gchar *name = NULL;
+    gboolean marker_seen = FALSE;
+    gboolean finished = FALSE;
+    guint8 typ;
+
+    while (!finished && ttrans_frame_read(from_filter, &typ, payload)) {
+        struct ttrans_cursor c;
+        const char *s;
+        guint32 len;
+
+        ttrans_cursor_init(&c, payload);
+
+        if (typ == TTRANS_FRAME_TRANSACTIONS) {
+            while (c.pnt < c.end && !c.error) {
+                GwTime tim = ttrans_get_i64(&c);
+
+                s = ttrans_get_str(&c, &len);
+                g_string_append_printf(transactions, "#%" GW_TIME_FORMAT " %.*s;", tim, (int)len, s);
+            }
+        } else if (typ == TTRANS_FRAME_MARKERS) {
+            g_assert_cmpuint(ttrans_get_u32(&c), ==, 0);
+            g_assert_cmpint(ttrans_get_i64(&c), ==, 10);
+            marker_seen = TRUE;
+        } else if (typ == TTRANS_FRAME_NAME) {
+            s = ttrans_get_str(&c, &len);
+            name = g_strndup(s, len);
+        } else if (typ == TTRANS_FRAME_FINISH) {
+            finished = TRUE;
+        }
+        g_assert_false(c.error);
+    }
+
+    g_assert_true(finished);
+    g_assert_true(marker_seen);
+    g_assert_cmpstr(name, ==, "bus (hex)");
+    g_assert_cmpstr(transactions->str, ==, "#10 ?darkgreen?28;#20 ?darkgreen?xF;#100 ;");
+
+    g_free(name);
+    g_string_free(transactions, TRUE);
+    g_byte_array_unref(payload);
+    fclose(from_filter);
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/ttrans_frame/fields", test_fields);
+    g_test_add_func("/ttrans_frame/split", test_split);
+    g_test_add_func("/ttrans_frame/bad_frames", test_bad_frames);
+    g_test_add_func("/ttrans_frame/example_filter", test_example_filter);
+
+    return g_test_run();
+}
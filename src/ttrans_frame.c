@@ -0,0 +1,189 @@
+#include <config.h>
+#include <string.h>
+#include "ttrans_frame.h"
+
+/************************ writing ************************/
+
+void ttrans_frame_init(struct ttrans_frame *f, FILE *file)
+{
+    f->file = file;
+    f->buf = g_byte_array_sized_new(TTRANS_FRAME_FLUSH_SIZE + 256);
+    f->typ = 0;
+}
+
+void ttrans_frame_clear(struct ttrans_frame *f)
+{
+    g_byte_array_unref(f->buf);
+    f->buf = NULL;
+}
+
+void ttrans_frame_begin(struct ttrans_frame *f, unsigned char typ)
+{
+    f->typ = typ;
+    g_byte_array_set_size(f->buf, TTRANS_FRAME_HEADER_SIZE);
+}
+
+void ttrans_frame_flush(struct ttrans_frame *f)
+{
+    guint32 len = GUINT32_TO_LE(f->buf->len - TTRANS_FRAME_HEADER_SIZE);
+
+    f->buf->data[0] = f->typ;
+    f->buf->data[1] = f->buf->data[2] = f->buf->data[3] = 0;
+    memcpy(f->buf->data + 4, &len, sizeof(len));
+
+    fwrite(f->buf->data, 1, f->buf->len, f->file);
+}
+
+/* values frames are cut into pieces so the filter can start on them early */
+void ttrans_frame_split(struct ttrans_frame *f)
+{
+    if (f->buf->len >= TTRANS_FRAME_FLUSH_SIZE) {
+        ttrans_frame_flush(f);
+        ttrans_frame_begin(f, f->typ);
+    }
+}
+
+void ttrans_put_u8(struct ttrans_frame *f, guint8 v)
+{
+    g_byte_array_append(f->buf, &v, 1);
+}
+
+void ttrans_put_u32(struct ttrans_frame *f, guint32 v)
+{
+    v = GUINT32_TO_LE(v);
+    g_byte_array_append(f->buf, (const guint8 *)&v, sizeof(v));
+}
+
+void ttrans_put_i64(struct ttrans_frame *f, GwTime v)
+{
+    guint64 u = GUINT64_TO_LE((guint64)v);
+    g_byte_array_append(f->buf, (const guint8 *)&u, sizeof(u));
+}
+
+void ttrans_put_f64(struct ttrans_frame *f, double v)
+{
+    guint64 u;
+
+    memcpy(&u, &v, sizeof(u));
+    u = GUINT64_TO_LE(u);
+    g_byte_array_append(f->buf, (const guint8 *)&u, sizeof(u));
+}
+
+void ttrans_put_str(struct ttrans_frame *f, const char *s)
+{
+    guint32 len = strlen(s);
+
+    ttrans_put_u32(f, len);
+    g_byte_array_append(f->buf, (const guint8 *)s, len);
+}
+
+void ttrans_put_bits(struct ttrans_frame *f, const char *v, int len)
+{
+    int i;
+
+    for (i = 0; i < len; i += 2) {
+        guint8 hi = v ? (guint8)v[i] : GW_BIT_X;
+        guint8 lo = (v && (i + 1 < len)) ? (guint8)v[i + 1] : GW_BIT_X;
+
+        if (hi >= GW_BIT_COUNT)
+            hi = GW_BIT_X;
+        if (lo >= GW_BIT_COUNT)
+            lo = GW_BIT_X;
+        if (i + 1 >= len)
+            lo = 0;
+
+        ttrans_put_u8(f, (hi << 4) | lo);
+    }
+}
+
+/************************ reading ************************/
+
+int ttrans_frame_read(FILE *file, guint8 *typ, GByteArray *payload)
+{
+    guint8 hdr[TTRANS_FRAME_HEADER_SIZE];
+    guint32 len;
+
+    if (fread(hdr, 1, sizeof(hdr), file) != sizeof(hdr))
+        return (0);
+
+    memcpy(&len, hdr + 4, sizeof(len));
+    len = GUINT32_FROM_LE(len);
+    if (len > TTRANS_FRAME_MAX_SIZE)
+        return (0);
+
+    g_byte_array_set_size(payload, len);
+    if (len && (fread(payload->data, 1, len, file) != len))
+        return (0);
+
+    *typ = hdr[0];
+    return (1);
+}
+
+void ttrans_cursor_init(struct ttrans_cursor *c, const GByteArray *payload)
+{
+    c->pnt = payload->data;
+    c->end = payload->data + payload->len;
+    c->error = 0;
+}
+
+const guint8 *ttrans_get(struct ttrans_cursor *c, guint32 len)
+{
+    const guint8 *pnt = c->pnt;
+
+    if (c->error || ((guint32)(c->end - c->pnt) < len)) {
+        c->error = 1;
+        return (NULL);
+    }
+
+    c->pnt += len;
+    return (pnt);
+}
+
+guint8 ttrans_get_u8(struct ttrans_cursor *c)
+{
+    const guint8 *pnt = ttrans_get(c, 1);
+
+    return (pnt ? *pnt : 0);
+}
+
+guint32 ttrans_get_u32(struct ttrans_cursor *c)
+{
+    const guint8 *pnt = ttrans_get(c, sizeof(guint32));
+    guint32 v = 0;
+
+    if (pnt) {
+        memcpy(&v, pnt, sizeof(v));
+    }
+    return (GUINT32_FROM_LE(v));
+}
+
+GwTime ttrans_get_i64(struct ttrans_cursor *c)
+{
+    const guint8 *pnt = ttrans_get(c, sizeof(guint64));
+    guint64 v = 0;
+
+    if (pnt) {
+        memcpy(&v, pnt, sizeof(v));
+    }
+    return ((GwTime)GUINT64_FROM_LE(v));
+}
+
+double ttrans_get_f64(struct ttrans_cursor *c)
+{
+    const guint8 *pnt = ttrans_get(c, sizeof(guint64));
+    guint64 u = 0;
+    double v;
+
+    if (pnt) {
+        memcpy(&u, pnt, sizeof(u));
+    }
+    u = GUINT64_FROM_LE(u);
+    memcpy(&v, &u, sizeof(v));
+    return (v);
+}
+
+const char *ttrans_get_str(struct ttrans_cursor *c, guint32 *len)
+{
+    *len = ttrans_get_u32(c);
+    return ((const char *)ttrans_get(c, *len));
+}
@@ -0,0 +1,112 @@
+#ifndef WAVE_TTRANS_FRAME_H
+#define WAVE_TTRANS_FRAME_H
+
+#include <stdio.h>
+#include <gtkwave.h>
+
+/*
+ * binary transaction filter protocol
+ *
+ * the binary protocol is negotiated per filter.  the first trace gtkwave sends to a filter is
+ * textual and starts with the offer TTRANS_BINARY_REQUEST, a VCD comment that filters which
+ * only speak text ignore.  a filter that supports frames writes TTRANS_BINARY_ACCEPT as the
+ * first line of its reply right away, skips the rest of the textual trace up to and including
+ * its "$comment data_end" line, and uses frames in both directions from then on.  gtkwave then
+ * sends the same trace again as frames.  any other first line starts a textual reply and the
+ * filter stays on the textual protocol.  nothing waits on a timeout, the offer is answered
+ * where a reply is read anyway.
+ *
+ * a frame is an 8 byte header (type, 3 reserved bytes, payload length as u32) followed by the
+ * payload.  integers are little endian, a str is a u32 length followed by the bytes.  times are
+ * in units of the timescale as in the textual protocol.
+ *
+ * gtkwave to filter:
+ *   'H' u8 time dimension, i64 timescale, i64 timezero, i64 min time, i64 max time,
+ *       str trace name, str args, u32 signal count, then per signal:
+ *       u32 seqn, u8 kind (TTRANS_KIND_*), u32 width, str name
+ *   'V' records of i64 time, u32 seqn and the value: (width + 1) / 2 bytes of GwBit values
+ *       packed two per byte with the MSB first, an f64 or a str
+ *   'E' end of data
+ *
+ * filter to gtkwave:
+ *   'T' records of i64 time, str transaction
+ *   'M' records of u32 marker index, i64 time, str alias
+ *   'N' str trace name
+ *   'X' end of the current transaction trace, another one follows
+ *   'F' end of the last transaction trace
+ */
+#define TTRANS_BINARY_REQUEST "$comment protocol binary 1 $end\n"
+#define TTRANS_BINARY_ACCEPT "$protocol binary 1" /* without the line end */
+
+/* pipe_ctx.ttrans_protocol */
+enum ttrans_protocol
+{
+    TTRANS_PROTOCOL_UNKNOWN,
+    TTRANS_PROTOCOL_OFFERED,
+    TTRANS_PROTOCOL_TEXT,
+    TTRANS_PROTOCOL_BINARY
+};
+
+#define TTRANS_FRAME_HEADER_SIZE (8)
+#define TTRANS_FRAME_FLUSH_SIZE (64 * 1024)
+#define TTRANS_FRAME_MAX_SIZE (64 * 1024 * 1024)
+
+enum ttrans_frame_typ
+{
+    TTRANS_FRAME_HEADER = 'H',
+    TTRANS_FRAME_VALUES = 'V',
+    TTRANS_FRAME_END = 'E',
+    TTRANS_FRAME_TRANSACTIONS = 'T',
+    TTRANS_FRAME_MARKERS = 'M',
+    TTRANS_FRAME_NAME = 'N',
+    TTRANS_FRAME_NEXT = 'X',
+    TTRANS_FRAME_FINISH = 'F'
+};
+enum ttrans_signal_kind
+{
+    TTRANS_KIND_BITS,
+    TTRANS_KIND_REAL,
+    TTRANS_KIND_STRING
+};
+
+/* frame being written */
+struct ttrans_frame
+{
+    FILE *file;
+    GByteArray *buf;
+    unsigned char typ;
+};
+
+void ttrans_frame_init(struct ttrans_frame *f, FILE *file);
+void ttrans_frame_clear(struct ttrans_frame *f);
+void ttrans_frame_begin(struct ttrans_frame *f, unsigned char typ);
+void ttrans_frame_flush(struct ttrans_frame *f);
+void ttrans_frame_split(struct ttrans_frame *f);
+
+void ttrans_put_u8(struct ttrans_frame *f, guint8 v);
+void ttrans_put_u32(struct ttrans_frame *f, guint32 v);
+void ttrans_put_i64(struct ttrans_frame *f, GwTime v);
+void ttrans_put_f64(struct ttrans_frame *f, double v);
+void ttrans_put_str(struct ttrans_frame *f, const char *s);
+void ttrans_put_bits(struct ttrans_frame *f, const char *v, int len);
+
+/* reads the next frame into payload, returns zero at the end of the stream or if out of sync */
+int ttrans_frame_read(FILE *file, guint8 *typ, GByteArray *payload);
+
+/* frame being read, error is set once a read runs past the end of the payload */
+struct ttrans_cursor
+{
+    const guint8 *pnt;
+    const guint8 *end;
+    int error;
+};
+
+void ttrans_cursor_init(struct ttrans_cursor *c, const GByteArray *payload);
+const guint8 *ttrans_get(struct ttrans_cursor *c, guint32 len);
+guint8 ttrans_get_u8(struct ttrans_cursor *c);
+guint32 ttrans_get_u32(struct ttrans_cursor *c);
+GwTime ttrans_get_i64(struct ttrans_cursor *c);
+double ttrans_get_f64(struct ttrans_cursor *c);
+const char *ttrans_get_str(struct ttrans_cursor *c, guint32 *len);
+
+#endif
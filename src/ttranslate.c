@@ -545,273 +545,366 @@ void set_current_translate_ttrans(char *name)
     }
 }
 
-int traverse_vector_nodes(GwTrace *t)
+/*
+ * transaction traces are built up entry by entry as the filter sends them
+ */
+struct ttrans_builder
+{
+    GwVectorEnt *vt_head;
+    GwVectorEnt *vt_curr;
+    GwVectorEnt *vprev;
+    int regions;
+    GwTime prev_tim;
+    char *trace_name;
+};
+
+static void ttrans_builder_init(struct ttrans_builder *b)
+{
+    GwVectorEnt *vt;
+
+    b->vt_head = b->vt_curr = vt = calloc_2(1, sizeof(GwVectorEnt) + 1);
+    vt->time = GW_TIME_CONSTANT(-2);
+    b->vprev = vt; /* for duplicate removal */
+
+    b->vt_curr = b->vt_curr->next = vt = calloc_2(1, sizeof(GwVectorEnt) + 1);
+    vt->time = GW_TIME_CONSTANT(-1);
+
+    b->regions = 2;
+    b->prev_tim = GW_TIME_CONSTANT(-1);
+    b->trace_name = NULL;
+}
+
+static void ttrans_builder_add(struct ttrans_builder *b, GwTime tim, const char *sp, int slen)
+{
+    GwVectorEnt *vt = calloc_2(1, sizeof(GwVectorEnt) + slen + 1);
+    memcpy(vt->v, sp, slen);
+
+    if (tim > b->prev_tim) {
+        b->prev_tim = vt->time = tim;
+        b->vt_curr->next = vt;
+        b->vt_curr = vt;
+        b->vprev = b->vprev->next; /* bump forward the -2 node pointer */
+        b->regions++;
+    } else if (tim == b->prev_tim) {
+        vt->time = b->prev_tim;
+        free_2(b->vt_curr);
+        b->vt_curr = b->vprev->next = vt; /* splice new one in -1 node place */
+    } else {
+        free_2(vt); /* throw it away */
+    }
+}
+
+static void ttrans_builder_set_name(struct ttrans_builder *b, const char *sp, int slen)
 {
+    if (slen) {
+        if (b->trace_name)
+            free_2(b->trace_name);
+        b->trace_name = malloc_2(slen + 1);
+        memcpy(b->trace_name, sp, slen);
+        b->trace_name[slen] = 0;
+    }
+}
+
+static GwBitVector *ttrans_builder_finish(struct ttrans_builder *b, GwTrace *t)
+{
+    GwVectorEnt *vt;
+    GwBitVector *bv;
     int i;
-    int cvt_ok = 0;
 
-    GwTime time_scale = gw_dump_file_get_time_scale(GLOBALS->dump_file);
+    b->vt_curr = b->vt_curr->next = vt = calloc_2(1, sizeof(GwVectorEnt) + 1);
+    vt->time = MAX_HISTENT_TIME - 1;
+    b->regions++;
 
-    if ((t->t_filter) && (t->flags & TR_TTRANSLATED) && (t->vector) && (!t->t_filter_converted)) {
-#if !defined __MINGW32__
-        int rc = save_nodes_to_trans(GLOBALS->ttrans_filter[t->t_filter]->sout, t);
-#else
-        int rc =
-            save_nodes_to_trans((FILE *)(GLOBALS->ttrans_filter[t->t_filter]->g_hChildStd_IN_Wr),
-                                t);
-#endif
+    /* vt_curr = */ b->vt_curr->next = vt = calloc_2(1, sizeof(GwVectorEnt) + 1); /* scan-build */
+    vt->time = MAX_HISTENT_TIME;
+    b->regions++;
 
-        if (rc == VCDSAV_OK) {
-            int is_finish = 0;
-            GwBitVector *prev_transaction_trace = NULL;
+    bv = calloc_2(1, sizeof(GwBitVector) + (sizeof(GwVectorEnt *) * (b->regions)));
+    bv->bvname = strdup_2(b->trace_name ? b->trace_name : t->n.vec->bvname);
+    bv->nbits = 1;
+    bv->numregions = b->regions;
+    bv->bits = t->n.vec->bits;
 
-            while (!is_finish) {
-                GwVectorEnt *vt_head = NULL;
-                GwVectorEnt *vt_curr = NULL;
-                GwVectorEnt *vt;
-                GwVectorEnt *vprev;
-                GwBitVector *bv;
-                int regions = 2;
-                GwTime prev_tim = GW_TIME_CONSTANT(-1);
-                char *trace_name = NULL;
-                char *orig_name = t->n.vec->bvname;
+    vt = b->vt_head;
+    for (i = 0; i < b->regions; i++) {
+        bv->vectors[i] = vt;
+        vt = vt->next;
+    }
 
-                cvt_ok = 1;
+    return (bv);
+}
+
+static void set_ttrans_marker(guint which_marker, GwTime tim, const char *alias)
+{
+    GwNamedMarkers *markers = gw_project_get_named_markers(GLOBALS->project);
+
+    if (which_marker >= gw_named_markers_get_number_of_markers(markers)) {
+        return;
+    }
+
+    GwMarker *marker = gw_named_markers_get(markers, which_marker);
+
+    if (tim < GW_TIME_CONSTANT(0))
+        tim = GW_TIME_CONSTANT(-1);
+
+    gw_marker_set_position(marker, tim);
+    gw_marker_set_enabled(marker, tim >= 0);
+    gw_marker_set_alias(marker, alias);
+}
+
+/*
+ * skip the current word and the whitespace around the next one, which is returned
+ */
+static char *ttrans_next_word(char *pnt, int *slen)
+{
+    char *sp;
+
+    while (*pnt) {
+        if (!isspace((int)(unsigned char)*pnt))
+            pnt++;
+        else
+            break;
+    }
+    while (*pnt) {
+        if (isspace((int)(unsigned char)*pnt))
+            pnt++;
+        else
+            break;
+    }
 
-                vt_head = vt_curr = vt = calloc_2(1, sizeof(GwVectorEnt) + 1);
-                vt->time = GW_TIME_CONSTANT(-2);
-                vprev = vt; /* for duplicate removal */
+    sp = pnt;
+    *slen = strlen(sp);
 
-                vt_curr = vt_curr->next = vt = calloc_2(1, sizeof(GwVectorEnt) + 1);
-                vt->time = GW_TIME_CONSTANT(-1);
+    if (*slen) {
+        pnt = sp + *slen - 1;
+        do {
+            if (isspace((int)(unsigned char)*pnt)) {
+                *pnt = 0;
+                pnt--;
+                (*slen)--;
+            } else {
+                break;
+            }
+        } while (pnt != (sp - 1));
+    }
 
-                for (;;) {
-                    char buf[1025];
-                    char *pnt, *rtn;
+    return (sp);
+}
+
+/*
+ * reads one transaction trace in the textual protocol, returns nonzero after the last one.
+ * also returns if the filter accepts the binary protocol instead of sending a textual reply.
+ */
+static int read_text_transactions(struct pipe_ctx *filter,
+                                  struct ttrans_builder *b,
+                                  GwTime time_scale)
+{
+    for (;;) {
+        char buf[1025];
+        char *pnt;
+        char *sp;
+        int slen;
 
 #if !defined __MINGW32__
-                    if (feof(GLOBALS->ttrans_filter[t->t_filter]->sin))
-                        break; /* should never happen */
-
-                    buf[0] = 0;
-                    pnt = fgets(buf, 1024, GLOBALS->ttrans_filter[t->t_filter]->sin);
-                    if (!pnt)
-                        break;
-                    rtn = pnt;
-                    while (*rtn) {
-                        if ((*rtn == '\n') || (*rtn == '\r')) {
-                            *rtn = 0;
-                            break;
-                        }
-                        rtn++;
-                    }
+        char *rtn;
+
+        if (feof(filter->sin))
+            return (1); /* should never happen */
+
+        buf[0] = 0;
+        pnt = fgets(buf, 1024, filter->sin);
+        if (!pnt)
+            return (1);
+        rtn = pnt;
+        while (*rtn) {
+            if ((*rtn == '\n') || (*rtn == '\r')) {
+                *rtn = 0;
+                break;
+            }
+            rtn++;
+        }
+
+        /* the first line after the offer tells how the filter wants to talk, see ttrans_frame.h */
+        if (filter->ttrans_protocol == TTRANS_PROTOCOL_OFFERED) {
+            if (!strcmp(buf, TTRANS_BINARY_ACCEPT)) {
+                filter->ttrans_protocol = TTRANS_PROTOCOL_BINARY;
+                return (1);
+            }
+            filter->ttrans_protocol = TTRANS_PROTOCOL_TEXT;
+        }
 #else
-                    {
-                        BOOL bSuccess;
-                        DWORD dwRead;
-                        int n;
-
-                        for (n = 0; n < 1024; n++) {
-                            do {
-                                bSuccess = ReadFile(
-                                    GLOBALS->ttrans_filter[t->t_filter]->g_hChildStd_OUT_Rd,
-                                    buf + n,
-                                    1,
-                                    &dwRead,
-                                    NULL);
-                                if ((!bSuccess) || (buf[n] == '\n')) {
-                                    goto ex;
-                                }
-
-                            } while (buf[n] == '\r');
-                        }
-                    ex:
-                        buf[n] = 0;
-                        pnt = buf;
+        {
+            BOOL bSuccess;
+            DWORD dwRead;
+            int n;
+
+            for (n = 0; n < 1024; n++) {
+                do {
+                    bSuccess = ReadFile(filter->g_hChildStd_OUT_Rd, buf + n, 1, &dwRead, NULL);
+                    if ((!bSuccess) || (buf[n] == '\n')) {
+                        goto ex;
                     }
+
+                } while (buf[n] == '\r');
+            }
+        ex:
+            buf[n] = 0;
+            pnt = buf;
+        }
 #endif
 
-                    while (*pnt) {
-                        if (isspace((int)(unsigned char)*pnt))
-                            pnt++;
-                        else
-                            break;
-                    }
+        while (*pnt) {
+            if (isspace((int)(unsigned char)*pnt))
+                pnt++;
+            else
+                break;
+        }
 
-                    if (*pnt == '#') {
-                        GwTime tim = atoi_64(pnt + 1) * time_scale;
-                        int slen;
-                        char *sp;
+        if (*pnt == '#') {
+            GwTime tim = atoi_64(pnt + 1) * time_scale;
 
-                        while (*pnt) {
-                            if (!isspace((int)(unsigned char)*pnt))
-                                pnt++;
-                            else
-                                break;
-                        }
-                        while (*pnt) {
-                            if (isspace((int)(unsigned char)*pnt))
-                                pnt++;
-                            else
-                                break;
-                        }
+            sp = ttrans_next_word(pnt, &slen);
+            ttrans_builder_add(b, tim, sp, slen);
+        } else if ((*pnt == 'M') || (*pnt == 'm')) {
+            int mlen;
+            pnt++;
 
-                        sp = pnt;
-                        slen = strlen(sp);
-
-                        if (slen) {
-                            pnt = sp + slen - 1;
-                            do {
-                                if (isspace((int)(unsigned char)*pnt)) {
-                                    *pnt = 0;
-                                    pnt--;
-                                    slen--;
-                                } else {
-                                    break;
-                                }
-                            } while (pnt != (sp - 1));
-                        }
+            mlen = bijective_marker_id_string_len(pnt);
+            if (mlen) {
+                int which_marker = bijective_marker_id_string_hash(pnt);
+                GwTime tim = atoi_64(pnt + mlen) * time_scale;
 
-                        vt = calloc_2(1, sizeof(GwVectorEnt) + slen + 1);
-                        if (sp)
-                            strcpy((char *)vt->v, sp);
-
-                        if (tim > prev_tim) {
-                            prev_tim = vt->time = tim;
-                            vt_curr->next = vt;
-                            vt_curr = vt;
-                            vprev = vprev->next; /* bump forward the -2 node pointer */
-                            regions++;
-                        } else if (tim == prev_tim) {
-                            vt->time = prev_tim;
-                            free_2(vt_curr);
-                            vt_curr = vprev->next = vt; /* splice new one in -1 node place */
-                        } else {
-                            free_2(vt); /* throw it away */
-                        }
+                sp = ttrans_next_word(pnt, &slen);
+                set_ttrans_marker((guint)which_marker, tim, sp);
+            }
+        } else if (*pnt == '$') {
+            if (!strncmp(pnt + 1, "finish", 6)) {
+                return (1);
+            } else if (!strncmp(pnt + 1, "next", 4)) {
+                return (0);
+            } else if (!strncmp(pnt + 1, "name", 4)) {
+                /* "$name" is one word, so this strips the whitespace before the name */
+                sp = ttrans_next_word(pnt, &slen);
+                ttrans_builder_set_name(b, sp, slen);
+            }
+        }
+    }
+}
 
-                        continue;
-                    } else if ((*pnt == 'M') || (*pnt == 'm')) {
-                        int mlen;
-                        pnt++;
-
-                        mlen = bijective_marker_id_string_len(pnt);
-                        if (mlen) {
-                            int which_marker = bijective_marker_id_string_hash(pnt);
-
-                            GwNamedMarkers *markers =
-                                gw_project_get_named_markers(GLOBALS->project);
-                            GwMarker *marker = gw_named_markers_get(markers, which_marker);
-
-                            if (marker != NULL) {
-                                GwTime tim = atoi_64(pnt + mlen) * time_scale;
-                                int slen;
-                                char *sp;
-
-                                if (tim < GW_TIME_CONSTANT(0))
-                                    tim = GW_TIME_CONSTANT(-1);
-
-                                gw_marker_set_position(marker, tim);
-                                gw_marker_set_enabled(marker, tim >= 0);
-
-                                while (*pnt) {
-                                    if (!isspace((int)(unsigned char)*pnt))
-                                        pnt++;
-                                    else
-                                        break;
-                                }
-                                while (*pnt) {
-                                    if (isspace((int)(unsigned char)*pnt))
-                                        pnt++;
-                                    else
-                                        break;
-                                }
-
-                                sp = pnt;
-                                slen = strlen(sp);
-
-                                if (slen) {
-                                    pnt = sp + slen - 1;
-                                    do {
-                                        if (isspace((int)(unsigned char)*pnt)) {
-                                            *pnt = 0;
-                                            pnt--;
-                                            slen--;
-                                        } else {
-                                            break;
-                                        }
-                                    } while (pnt != (sp - 1));
-                                }
-
-                                gw_marker_set_alias(marker, sp);
-                            }
-                        }
+#if !defined __MINGW32__
 
-                        continue;
-                    } else if (*pnt == '$') {
-                        if (!strncmp(pnt + 1, "finish", 6)) {
-                            is_finish = 1;
-                            break;
-                        } else if (!strncmp(pnt + 1, "next", 4)) {
-                            break;
-                        } else if (!strncmp(pnt + 1, "name", 4)) {
-                            int slen;
-                            char *sp;
-
-                            pnt += 5;
-                            while (*pnt) {
-                                if (isspace((int)(unsigned char)*pnt))
-                                    pnt++;
-                                else
-                                    break;
-                            }
+/*
+ * reads one transaction trace in the binary protocol, returns nonzero after the last one.
+ * records are added to the trace frame by frame as they arrive.
+ */
+static int read_binary_transactions(struct pipe_ctx *filter,
+                                    struct ttrans_builder *b,
+                                    GwTime time_scale)
+{
+    GByteArray *payload = g_byte_array_new();
+    guint8 typ;
+    int is_finish = 1;
 
-                            sp = pnt;
-                            slen = strlen(sp);
-
-                            if (slen) {
-                                pnt = sp + slen - 1;
-                                do {
-                                    if (isspace((int)(unsigned char)*pnt)) {
-                                        *pnt = 0;
-                                        pnt--;
-                                        slen--;
-                                    } else {
-                                        break;
-                                    }
-                                } while (pnt != (sp - 1));
-                            }
+    while (ttrans_frame_read(filter->sin, &typ, payload)) {
+        struct ttrans_cursor c;
+        const char *sp;
+        guint32 slen;
 
-                            if (sp && *sp) {
-                                if (trace_name)
-                                    free_2(trace_name);
-                                trace_name = strdup_2(sp);
-                            }
-                        }
-                    }
+        ttrans_cursor_init(&c, payload);
+
+        if (typ == TTRANS_FRAME_TRANSACTIONS) {
+            while ((c.pnt < c.end) && (!c.error)) {
+                GwTime tim = ttrans_get_i64(&c) * time_scale;
+
+                sp = ttrans_get_str(&c, &slen);
+                if (sp)
+                    ttrans_builder_add(b, tim, sp, slen);
+            }
+        } else if (typ == TTRANS_FRAME_MARKERS) {
+            while ((c.pnt < c.end) && (!c.error)) {
+                guint32 which_marker = ttrans_get_u32(&c);
+                GwTime tim = ttrans_get_i64(&c) * time_scale;
+
+                sp = ttrans_get_str(&c, &slen);
+                if (sp) {
+                    char *alias = g_strndup(sp, slen);
+                    set_ttrans_marker(which_marker, tim, alias);
+                    g_free(alias);
                 }
+            }
+        } else if (typ == TTRANS_FRAME_NAME) {
+            sp = ttrans_get_str(&c, &slen);
+            if (sp)
+                ttrans_builder_set_name(b, sp, slen);
+        } else if (typ == TTRANS_FRAME_NEXT) {
+            is_finish = 0;
+            break;
+        } else if (typ == TTRANS_FRAME_FINISH) {
+            break;
+        }
+        /* unknown frame types are skipped */
+    }
 
-                vt_curr = vt_curr->next = vt = calloc_2(1, sizeof(GwVectorEnt) + 1);
-                vt->time = MAX_HISTENT_TIME - 1;
-                regions++;
-
-                /* vt_curr = */ vt_curr->next = vt =
-                    calloc_2(1, sizeof(GwVectorEnt) + 1); /* scan-build */
-                vt->time = MAX_HISTENT_TIME;
-                regions++;
-
-                bv = calloc_2(1, sizeof(GwBitVector) + (sizeof(GwVectorEnt *) * (regions)));
-                bv->bvname = strdup_2(trace_name ? trace_name : orig_name);
-                bv->nbits = 1;
-                bv->numregions = regions;
-                bv->bits = t->n.vec->bits;
-
-                vt = vt_head;
-                for (i = 0; i < regions; i++) {
-                    bv->vectors[i] = vt;
-                    vt = vt->next;
+    g_byte_array_unref(payload);
+
+    return (is_finish);
+}
+
+#endif
+
+int traverse_vector_nodes(GwTrace *t)
+{
+    int cvt_ok = 0;
+
+    GwTime time_scale = gw_dump_file_get_time_scale(GLOBALS->dump_file);
+
+    if ((t->t_filter) && (t->flags & TR_TTRANSLATED) && (t->vector) && (!t->t_filter_converted)) {
+        struct pipe_ctx *filter = GLOBALS->ttrans_filter[t->t_filter];
+#if !defined __MINGW32__
+        int rc;
+
+        /* the offer goes out with the first trace, filters which only speak text ignore it */
+        if (filter->ttrans_protocol == TTRANS_PROTOCOL_UNKNOWN) {
+            fputs(TTRANS_BINARY_REQUEST, filter->sout);
+            filter->ttrans_protocol = TTRANS_PROTOCOL_OFFERED;
+        }
+
+        rc = (filter->ttrans_protocol == TTRANS_PROTOCOL_BINARY)
+                 ? save_nodes_to_trans_binary(filter->sout, t)
+                 : save_nodes_to_trans(filter->sout, t);
+#else
+        int rc = save_nodes_to_trans((FILE *)(filter->g_hChildStd_IN_Wr), t);
+#endif
+
+        if (rc == VCDSAV_OK) {
+            int is_finish = 0;
+            GwBitVector *prev_transaction_trace = NULL;
+
+            while (!is_finish) {
+                struct ttrans_builder b;
+                GwBitVector *bv;
+
+                cvt_ok = 1;
+
+                ttrans_builder_init(&b);
+#if !defined __MINGW32__
+                if (filter->ttrans_protocol == TTRANS_PROTOCOL_BINARY) {
+                    is_finish = read_binary_transactions(filter, &b, time_scale);
+                } else
+#endif
+                {
+                    is_finish = read_text_transactions(filter, &b, time_scale);
+#if !defined __MINGW32__
+                    if (filter->ttrans_protocol == TTRANS_PROTOCOL_BINARY) {
+                        /* accepted, the filter skipped the textual trace so send it again */
+                        is_finish = (save_nodes_to_trans_binary(filter->sout, t) != VCDSAV_OK) ||
+                                    read_binary_transactions(filter, &b, time_scale);
+                    }
+#endif
                 }
 
+                bv = ttrans_builder_finish(&b, t);
+
                 if (!prev_transaction_trace) {
                     prev_transaction_trace = bv;
                     bv->transaction_cache = t->n.vec; /* for possible restore later */
@@ -819,8 +912,8 @@ int traverse_vector_nodes(GwTrace *t)
 
                     t->t_filter_converted = 1;
 
-                    if (trace_name) /* if NULL, no need to regen display as trace name didn't change
-                                     */
+                    if (b.trace_name) /* if NULL, no need to regen display as trace name didn't
+                                         change */
                     {
                         t->name = t->n.vec->bvname;
                         if (GLOBALS->hier_max_level)
@@ -833,6 +926,9 @@ int traverse_vector_nodes(GwTrace *t)
                     prev_transaction_trace->transaction_chain = bv;
                     prev_transaction_trace = bv;
                 }
+
+                if (b.trace_name)
+                    free_2(b.trace_name);
             }
         } else {
             /* failed */
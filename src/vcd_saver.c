@@ -320,6 +320,53 @@ static void heapify(int i, int heap_size)
     }
 }
 
+/*
+ * add the nodes of a trace to the tree, numbering new ones from nodecnt
+ */
+static vcdsav_Tree *vcdsav_add_node(GwNode *n, vcdsav_Tree *vt, int *nodecnt)
+{
+    if (n->expansion)
+        n = n->expansion->parent;
+    vt = vcdsav_splay(n, vt);
+    if (!vt || vt->item != n) {
+        unsigned char flags = 0;
+
+        if (n->head.next)
+            if (n->head.next->next) {
+                flags = n->head.next->next->flags;
+            }
+
+        vt = vcdsav_insert(n, vt, ++(*nodecnt), flags, &n->head);
+    }
+
+    return (vt);
+}
+
+static vcdsav_Tree *vcdsav_add_trace(GwTrace *t, vcdsav_Tree *vt, int *nodecnt)
+{
+    int i;
+
+    if (!t->vector) {
+        if (t->n.nd) {
+            vt = vcdsav_add_node(t->n.nd, vt, nodecnt);
+        }
+    } else {
+        GwBitVector *b = t->n.vec;
+        if (b) {
+            GwBits *bt = b->bits;
+            if (bt) {
+                for (i = 0; i < bt->nnbits; i++) {
+                    if (bt->nodes[i]) {
+                        vt = vcdsav_add_node(bt->nodes[i], vt, nodecnt);
+                    }
+                }
+            }
+        }
+    }
+
+    return (vt);
+}
+
 /*
  * mainline
  */
@@ -332,7 +379,6 @@ int save_nodes_to_export_generic(FILE *trans_file,
     int nodecnt = 0;
     vcdsav_Tree *vt = NULL;
     vcdsav_Tree **hp_clone = GLOBALS->hp_vcd_saver_c_1;
-    GwNode *n;
     /* ExtNode *e; */
     /* int msi, lsi; */
     int i;
@@ -365,50 +411,7 @@ int save_nodes_to_export_generic(FILE *trans_file,
     }
 
     while (t) {
-        if (!t->vector) {
-            if (t->n.nd) {
-                n = t->n.nd;
-                if (n->expansion)
-                    n = n->expansion->parent;
-                vt = vcdsav_splay(n, vt);
-                if (!vt || vt->item != n) {
-                    unsigned char flags = 0;
-
-                    if (n->head.next)
-                        if (n->head.next->next) {
-                            flags = n->head.next->next->flags;
-                        }
-
-                    vt = vcdsav_insert(n, vt, ++nodecnt, flags, &n->head);
-                }
-            }
-        } else {
-            GwBitVector *b = t->n.vec;
-            if (b) {
-                GwBits *bt = b->bits;
-                if (bt) {
-                    for (i = 0; i < bt->nnbits; i++) {
-                        if (bt->nodes[i]) {
-                            n = bt->nodes[i];
-
-                            if (n->expansion)
-                                n = n->expansion->parent;
-                            vt = vcdsav_splay(n, vt);
-                            if (!vt || vt->item != n) {
-                                unsigned char flags = 0;
-
-                                if (n->head.next)
-                                    if (n->head.next->next) {
-                                        flags = n->head.next->next->flags;
-                                    }
-
-                                vt = vcdsav_insert(n, vt, ++nodecnt, flags, &n->head);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        vt = vcdsav_add_trace(t, vt, &nodecnt);
 
         if (export_typ == WAVE_EXPORT_TRANS) {
             break;
@@ -680,11 +683,16 @@ int save_nodes_to_export_generic(FILE *trans_file,
                                         vcdid(GLOBALS->hp_vcd_saver_c_1[0]->val, export_typ));
                 }
             } else if (GLOBALS->hp_vcd_saver_c_1[0]->len) {
-                if (GLOBALS->hp_vcd_saver_c_1[0]->hist->v.h_vector) {
+                guint8 *unpacked = NULL;
+                const guint8 *vec = gw_hist_ent_get_bits(GLOBALS->hp_vcd_saver_c_1[0]->hist,
+                                                         GLOBALS->hp_vcd_saver_c_1[0]->len,
+                                                         &unpacked);
+
+                if (vec) {
                     for (i = 0; i < GLOBALS->hp_vcd_saver_c_1[0]->len; i++) {
-                        row_data[i] =
-                            analyzer_demang(0, GLOBALS->hp_vcd_saver_c_1[0]->hist->v.h_vector[i]);
+                        row_data[i] = analyzer_demang(0, vec[i]);
                     }
+                    g_free(unpacked);
                 } else {
                     for (i = 0; i < GLOBALS->hp_vcd_saver_c_1[0]->len; i++) {
                         row_data[i] = 'x';
@@ -756,6 +764,143 @@ int save_nodes_to_trans(FILE *trans, GwTrace *t)
     return (save_nodes_to_export_generic(trans, t, NULL, WAVE_EXPORT_TRANS));
 }
 
+/************************ binary transaction frames ************************/
+
+/*
+ * same data as save_nodes_to_trans(), sent as frames of the binary transaction protocol
+ */
+int save_nodes_to_trans_binary(FILE *trans, GwTrace *t)
+{
+    vcdsav_Tree *vt = NULL;
+    vcdsav_Tree **hp_clone;
+    int nodecnt = 0;
+    int i;
+    struct ttrans_frame f;
+
+    if ((!trans) || (!t)) {
+        return (VCDSAV_FILE_ERROR);
+    }
+
+    vt = vcdsav_add_trace(t, vt, &nodecnt);
+    if (!nodecnt)
+        return (VCDSAV_EMPTY);
+
+    GwTime global_time_offset = gw_dump_file_get_global_time_offset(GLOBALS->dump_file);
+    GwTime time_scale = gw_dump_file_get_time_scale(GLOBALS->dump_file);
+    GwTimeDimension time_dimension = gw_dump_file_get_time_dimension(GLOBALS->dump_file);
+    GwTimeRange *time_range = gw_dump_file_get_time_range(GLOBALS->dump_file);
+
+    hp_clone = GLOBALS->hp_vcd_saver_c_1 = calloc_2(nodecnt, sizeof(vcdsav_Tree *));
+    recurse_build(vt, &hp_clone);
+
+    ttrans_frame_init(&f, trans);
+
+    ttrans_frame_begin(&f, TTRANS_FRAME_HEADER);
+    ttrans_put_u8(&f, time_dimension);
+    ttrans_put_i64(&f, time_scale);
+    ttrans_put_i64(&f, global_time_offset);
+    ttrans_put_i64(&f, gw_time_range_get_start(time_range) / time_scale);
+    ttrans_put_i64(&f, gw_time_range_get_end(time_range) / time_scale);
+    ttrans_put_str(&f, t->name ? t->name : "UNKNOWN");
+    ttrans_put_str(&f, t->transaction_args ? t->transaction_args : "");
+    ttrans_put_u32(&f, nodecnt);
+
+    for (i = 0; i < nodecnt; i++) {
+        vcdsav_Tree *hp = GLOBALS->hp_vcd_saver_c_1[i];
+        int msi = -1, lsi = -1;
+
+        ttrans_put_u32(&f, hp->val);
+
+        if (hp->flags & GW_HIST_ENT_FLAG_STRING) {
+            ttrans_put_u8(&f, TTRANS_KIND_STRING);
+            ttrans_put_u32(&f, 0);
+        } else if (hp->flags & GW_HIST_ENT_FLAG_REAL) {
+            ttrans_put_u8(&f, TTRANS_KIND_REAL);
+            ttrans_put_u32(&f, 1);
+        } else {
+            if (hp->item->extvals) {
+                msi = hp->item->msi;
+                lsi = hp->item->lsi;
+            }
+
+            /* len stays 0 for single bits, as these are read from h_val */
+            if (msi != lsi) {
+                hp->len = (msi < lsi) ? (lsi - msi + 1) : (msi - lsi + 1);
+            }
+
+            ttrans_put_u8(&f, TTRANS_KIND_BITS);
+            ttrans_put_u32(&f, hp->len ? hp->len : 1);
+        }
+
+        ttrans_put_str(&f, hp->item->nname);
+    }
+
+    ttrans_frame_flush(&f);
+
+    /* value changes */
+
+    for (i = (nodecnt / 2 - 1); i > 0; i--) /* build nodes into having heap property */
+    {
+        heapify(i, nodecnt);
+    }
+
+    ttrans_frame_begin(&f, TTRANS_FRAME_VALUES);
+
+    for (;;) {
+        vcdsav_Tree *hp;
+        GwHistEnt *h;
+
+        heapify(0, nodecnt);
+
+        hp = GLOBALS->hp_vcd_saver_c_1[0];
+        h = hp->hist;
+        if (!h)
+            break;
+        if (h->time > gw_time_range_get_end(time_range))
+            break;
+
+        if (h->time >= GW_TIME_CONSTANT(0)) {
+            ttrans_put_i64(&f, h->time / time_scale);
+            ttrans_put_u32(&f, hp->val);
+
+            if (hp->flags & GW_HIST_ENT_FLAG_STRING) {
+                ttrans_put_str(&f, h->v.h_vector ? h->v.h_vector : "UNDEF");
+            } else if (hp->flags & GW_HIST_ENT_FLAG_REAL) {
+                ttrans_put_f64(&f, h->v.h_double);
+            } else if (hp->len) {
+                guint8 *unpacked = NULL;
+                const guint8 *vec = gw_hist_ent_get_bits(h, hp->len, &unpacked);
+
+                ttrans_put_bits(&f, (const char *)vec, hp->len);
+                g_free(unpacked);
+            } else {
+                char v = h->v.h_val;
+                ttrans_put_bits(&f, &v, 1);
+            }
+
+            ttrans_frame_split(&f);
+        }
+
+        hp->hist = h->next;
+    }
+
+    ttrans_frame_flush(&f);
+    ttrans_frame_begin(&f, TTRANS_FRAME_END);
+    ttrans_frame_flush(&f);
+    fflush(trans);
+
+    ttrans_frame_clear(&f);
+
+    for (i = 0; i < nodecnt; i++) {
+        free_2(GLOBALS->hp_vcd_saver_c_1[i]);
+    }
+
+    free_2(GLOBALS->hp_vcd_saver_c_1);
+    GLOBALS->hp_vcd_saver_c_1 = NULL;
+
+    return (VCDSAV_OK);
+}
+
 /************************ scopenav ************************/
 
 struct namehier
@@ -1072,7 +1217,7 @@ static char *get_hptr_vector_val(GwTrace *t, GwHistEnt *h)
             ascii = convert_ascii_string((char *)h->v.h_vector);
         }
     } else {
-        ascii = convert_ascii_vec(t, h->v.h_vector);
+        ascii = convert_ascii_hist(t, h);
     }
 
     format_value_string(ascii);
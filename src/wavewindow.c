@@ -328,7 +328,7 @@ static void service_hslider(GtkWidget *text, gpointer data)
                                              */
 #endif
     {
-        gw_wave_view_force_redraw(GW_WAVE_VIEW(GLOBALS->wavearea));
+        gw_wave_view_scroll(GW_WAVE_VIEW(GLOBALS->wavearea));
     }
 #ifdef WAVE_ALLOW_GTK3_GESTURE_EVENT
     if (gesture_in_zoom)
@@ -346,7 +346,7 @@ static
 
     sync_marker();
 
-    gw_wave_view_force_redraw(GW_WAVE_VIEW(GLOBALS->wavearea));
+    gw_wave_view_redraw_rows(GW_WAVE_VIEW(GLOBALS->wavearea));
 
     GLOBALS->old_wvalue = gtk_adjustment_get_value(sadj);
 }
@@ -1835,207 +1835,375 @@ void populateBuffer(GwTrace *t, char *altname, char *buf)
 
 /***************************************************************************/
 
-void MaxSignalLength(void)
+/*
+ * the widths of the signal names and marker values are kept in two multisets, so the signal
+ * pane width is available without measuring every trace.  a trace contributes its name_width
+ * and value_width while its width_epoch matches the current epoch, the sets are rebuilt from
+ * scratch whenever the trace list or the names changed (signalwindow_width_dirty).
+ */
+struct signal_width_set
 {
-    GwTrace *t;
-    int len = 0, maxlen = 0;
-    int vlen = 0, vmaxlen = 0;
-    char buf[2048];
-    char dirty_kick;
-    GwBitVector *bv;
-    GwTrace *tscan;
+    guint *counts; /* number of traces per pixel width */
+    int size;
+    int max;
+};
 
-    DEBUG(printf("signalwindow_width_dirty: %d\n", GLOBALS->signalwindow_width_dirty));
+static guint signal_width_epoch_counter = 0; /* unique across all contexts */
 
-    if ((!GLOBALS->signalwindow_width_dirty) && (GLOBALS->use_nonprop_fonts))
+static void width_set_add(struct signal_width_set *ws, int width)
+{
+    if (width <= 0) {
         return;
+    }
+    if (width > 32767) {
+        width = 32767; /* same limit as signal_pixmap_width */
+    }
 
-    GwMarker *primary_marker = gw_project_get_primary_marker(GLOBALS->project);
+    if (width >= ws->size) {
+        int size = MAX(width + 1, ws->size * 2);
+        if (ws->counts) {
+            ws->counts = realloc_2(ws->counts, size * sizeof(guint));
+            memset(ws->counts + ws->size, 0, (size - ws->size) * sizeof(guint));
+        } else {
+            ws->counts = calloc_2(size, sizeof(guint));
+        }
+        ws->size = size;
+    }
 
-    dirty_kick = GLOBALS->signalwindow_width_dirty;
-    GLOBALS->signalwindow_width_dirty = 0;
+    ws->counts[width]++;
+    if (width > ws->max) {
+        ws->max = width;
+    }
+}
 
-    t = GLOBALS->traces.first;
+static void width_set_remove(struct signal_width_set *ws, int width)
+{
+    if (width <= 0) {
+        return;
+    }
+    if (width > 32767) {
+        width = 32767;
+    }
 
-    while (t) {
-        char *subname = NULL;
-        bv = NULL;
-        tscan = NULL;
+    if ((width < ws->size) && (ws->counts[width])) {
+        ws->counts[width]--;
+        while ((ws->max > 0) && (!ws->counts[ws->max])) {
+            ws->max--;
+        }
+    }
+}
 
-        if (t->flags &
-            (TR_BLANK | TR_ANALOG_BLANK_STRETCH)) /* seek to real xact trace if present... */
-        {
-            int bcnt = 0;
-            tscan = t;
-            while ((tscan) && (tscan = GivePrevTrace(tscan))) {
-                if (!(tscan->flags & (TR_BLANK | TR_ANALOG_BLANK_STRETCH))) {
-                    if (tscan->flags & TR_TTRANSLATED) {
-                        break; /* found it */
-                    } else {
-                        tscan = NULL;
-                    }
-                } else {
-                    bcnt++; /* bcnt is number of blank traces */
-                }
-            }
+static void width_set_clear(struct signal_width_set **ws)
+{
+    if (!*ws) {
+        *ws = calloc_2(1, sizeof(struct signal_width_set));
+    } else if ((*ws)->counts) {
+        memset((*ws)->counts, 0, (*ws)->size * sizeof(guint));
+    }
+    (*ws)->max = 0;
+}
 
-            if ((tscan) && (tscan->vector)) {
-                bv = tscan->n.vec;
-                do {
-                    bv = bv->transaction_chain; /* correlate to blank trace */
-                } while (bv && (bcnt--));
-                if (bv) {
-                    subname = bv->bvname;
-                    if (GLOBALS->hier_max_level)
-                        subname = hier_extract(subname, GLOBALS->hier_max_level);
-                }
-            }
+/* measures str unless it is the same string that was measured for the trace last time */
+static int measure_cached(const char *str, guint *hash, int *width)
+{
+    guint h = g_str_hash(str);
+
+    if ((h != *hash) || (!*width)) {
+        *hash = h;
+        *width = font_engine_string_measure(GLOBALS->signalfont, str);
+    }
+
+    return *width;
+}
+
+/* updates the value width of a trace from value, which may be NULL if no value is shown */
+static void set_trace_value_width(GwTrace *t, gboolean counted, const char *value)
+{
+    int old_width = t->value_width;
+
+    if (value) {
+        measure_cached(value, &t->value_hash, &t->value_width);
+    } else {
+        t->value_hash = 0;
+        t->value_width = 0;
+    }
+
+    if (counted) {
+        if (old_width != t->value_width) {
+            width_set_remove(GLOBALS->signal_value_widths, old_width);
+            width_set_add(GLOBALS->signal_value_widths, t->value_width);
         }
+    } else {
+        width_set_add(GLOBALS->signal_value_widths, t->value_width);
+    }
+}
 
-        populateBuffer(t, subname, buf);
+/*
+ * drops the contribution of a trace which is about to be freed
+ */
+void RemoveSignalLength(GwTrace *t)
+{
+    if ((t->width_epoch) && (t->width_epoch == GLOBALS->signal_width_epoch)) {
+        width_set_remove(GLOBALS->signal_name_widths, t->name_width);
+        width_set_remove(GLOBALS->signal_value_widths, t->value_width);
+        t->width_epoch = 0;
+    }
+}
 
-        if (!bv && (t->flags &
-                    (TR_BLANK | TR_ANALOG_BLANK_STRETCH))) /* for "comment" style blank traces */
-        {
-            if (t->name || subname) {
-                len = font_engine_string_measure(GLOBALS->signalfont, buf);
-                if (len > maxlen)
-                    maxlen = len;
+/* returns the '=' prefixed value of the trace at the marker or NULL */
+static char *marker_value_string(GwTrace *t, GwBitVector *bv, GwTrace *tscan, GwTime marker_pos)
+{
+    char *str, *str2;
+
+    if (bv || t->vector) {
+        GwVectorEnt *v;
+        GwTrace *ts;
+        GwTrace t_temp;
+
+        if (bv) {
+            ts = &t_temp;
+            memcpy(ts, tscan, sizeof(GwTrace));
+            ts->vector = 1;
+            ts->n.vec = bv;
+        } else {
+            ts = t;
+            bv = t->n.vec;
+        }
+
+        v = bsearch_vector(bv, marker_pos - ts->shift);
+        str = convert_ascii(ts, v);
+    } else {
+        GwHistEnt *h_ptr;
+
+        if (!(h_ptr = bsearch_node(t->n.nd, marker_pos - t->shift))) {
+            return NULL;
+        }
+
+        if (!t->n.nd->extvals) {
+            unsigned char h_val = h_ptr->v.h_val;
+
+            str = (char *)calloc_2(1, 3 * sizeof(char));
+            str[0] = '=';
+            if (t->n.nd->vartype == GW_VAR_TYPE_VCD_EVENT) {
+                h_val = (h_ptr->time >= GLOBALS->tims.first) &&
+                                ((marker_pos - GLOBALS->shift_timebase) == h_ptr->time)
+                            ? GW_BIT_1
+                            : GW_BIT_0; /* generate impulse */
             }
 
-            if (t->asciivalue) {
-                free_2(t->asciivalue);
-                t->asciivalue = NULL;
+            if (t->flags & TR_INVERT) {
+                h_val = gw_bit_invert(h_val);
             }
-            t = GiveNextTrace(t);
-        } else if (t->name || subname) {
-            len = font_engine_string_measure(GLOBALS->signalfont, buf);
-            if (len > maxlen)
-                maxlen = len;
-
-            if (gw_marker_is_enabled(primary_marker) && (!(t->flags & TR_EXCLUDE))) {
-                t->asciitime = gw_marker_get_position(primary_marker);
-                if (t->asciivalue) {
-                    free_2(t->asciivalue);
-                }
-                t->asciivalue = NULL;
-
-                if (bv || t->vector) {
-                    char *str, *str2;
-                    GwVectorEnt *v;
-                    GwTrace *ts;
-                    GwTrace t_temp;
-
-                    if (bv) {
-                        ts = &t_temp;
-                        memcpy(ts, tscan, sizeof(GwTrace));
-                        ts->vector = 1;
-                        ts->n.vec = bv;
-                    } else {
-                        ts = t;
-                        bv = t->n.vec;
-                    }
 
-                    v = bsearch_vector(bv, gw_marker_get_position(primary_marker) - ts->shift);
-                    str = convert_ascii(ts, v);
-                    if (str) {
-                        str2 = (char *)malloc_2(strlen(str) + 2);
-                        *str2 = '=';
-                        strcpy(str2 + 1, str);
-                        free_2(str);
-
-                        vlen = font_engine_string_measure(GLOBALS->signalfont, str2);
-                        t->asciivalue = str2;
-                    } else {
-                        vlen = 0;
-                        t->asciivalue = NULL;
-                    }
+            str[1] = gw_bit_to_char(h_val);
+
+            return str;
+        }
+
+        if (h_ptr->flags & GW_HIST_ENT_FLAG_REAL) {
+            if (!(h_ptr->flags & GW_HIST_ENT_FLAG_STRING)) {
+                str = convert_ascii_real(t, &h_ptr->v.h_double);
+            } else {
+                str = convert_ascii_string((char *)h_ptr->v.h_vector);
+            }
+        } else {
+            str = convert_ascii_hist(t, h_ptr);
+        }
+    }
+
+    if (!str) {
+        return NULL;
+    }
+
+    str2 = (char *)malloc_2(strlen(str) + 2);
+    *str2 = '=';
+    strcpy(str2 + 1, str);
+    free_2(str);
+
+    return str2;
+}
+
+/*
+ * finds the transaction vector a blank trace below a TR_TTRANSLATED trace stands for
+ */
+static GwBitVector *find_transaction_vector(GwTrace *t, GwTrace **tscan_out, char **subname)
+{
+    GwBitVector *bv = NULL;
+    GwTrace *tscan = NULL;
+
+    if (t->flags & (TR_BLANK | TR_ANALOG_BLANK_STRETCH)) /* seek to real xact trace if present... */
+    {
+        int bcnt = 0;
+        tscan = t;
+        while ((tscan) && (tscan = GivePrevTrace(tscan))) {
+            if (!(tscan->flags & (TR_BLANK | TR_ANALOG_BLANK_STRETCH))) {
+                if (tscan->flags & TR_TTRANSLATED) {
+                    break; /* found it */
                 } else {
-                    char *str;
-                    GwHistEnt *h_ptr;
-                    if ((h_ptr = bsearch_node(t->n.nd,
-                                              gw_marker_get_position(primary_marker) - t->shift))) {
-                        if (!t->n.nd->extvals) {
-                            unsigned char h_val = h_ptr->v.h_val;
-
-                            str = (char *)calloc_2(1, 3 * sizeof(char));
-                            str[0] = '=';
-                            if (t->n.nd->vartype == GW_VAR_TYPE_VCD_EVENT) {
-                                h_val = (h_ptr->time >= GLOBALS->tims.first) &&
-                                                ((gw_marker_get_position(primary_marker) -
-                                                  GLOBALS->shift_timebase) == h_ptr->time)
-                                            ? GW_BIT_1
-                                            : GW_BIT_0; /* generate impulse */
-                            }
-
-                            if (t->flags & TR_INVERT) {
-                                h_val = gw_bit_invert(h_val);
-                            }
-
-                            str[1] = gw_bit_to_char(h_val);
-
-                            t->asciivalue = str;
-                            vlen = font_engine_string_measure(GLOBALS->signalfont, str);
-                        } else {
-                            char *str2;
-
-                            if (h_ptr->flags & GW_HIST_ENT_FLAG_REAL) {
-                                if (!(h_ptr->flags & GW_HIST_ENT_FLAG_STRING)) {
-                                    str = convert_ascii_real(t, &h_ptr->v.h_double);
-                                } else {
-                                    str = convert_ascii_string((char *)h_ptr->v.h_vector);
-                                }
-                            } else {
-                                str = convert_ascii_vec(t, h_ptr->v.h_vector);
-                            }
-
-                            if (str) {
-                                str2 = (char *)malloc_2(strlen(str) + 2);
-                                *str2 = '=';
-                                strcpy(str2 + 1, str);
-
-                                free_2(str);
-
-                                vlen = font_engine_string_measure(GLOBALS->signalfont, str2);
-                                t->asciivalue = str2;
-                            } else {
-                                vlen = 0;
-                                t->asciivalue = NULL;
-                            }
-                        }
-                    } else {
-                        vlen = 0;
-                        t->asciivalue = NULL;
-                    }
+                    tscan = NULL;
                 }
+            } else {
+                bcnt++; /* bcnt is number of blank traces */
+            }
+        }
 
-                if (vlen > vmaxlen) {
-                    vmaxlen = vlen;
-                }
+        if ((tscan) && (tscan->vector)) {
+            bv = tscan->n.vec;
+            do {
+                bv = bv->transaction_chain; /* correlate to blank trace */
+            } while (bv && (bcnt--));
+            if (bv && subname) {
+                *subname = bv->bvname;
+                if (GLOBALS->hier_max_level)
+                    *subname = hier_extract(*subname, GLOBALS->hier_max_level);
             }
+        }
+    }
+
+    *tscan_out = tscan;
+    return bv;
+}
+
+static void evaluate_trace_value(GwTrace *t, GwBitVector *bv, GwTrace *tscan, GwTime marker_pos)
+{
+    GLOBALS->shift_timebase = t->shift;
+
+    t->asciitime = marker_pos;
+    if (t->asciivalue) {
+        free_2(t->asciivalue);
+    }
+    t->asciivalue = marker_value_string(t, bv, tscan, marker_pos);
+    t->value_generation = GLOBALS->signal_value_generation;
+}
+
+/*
+ * updates the name and value widths of a trace.  values are only evaluated for the rows
+ * on screen, the others keep the width of the value they showed last and are evaluated
+ * by UpdateSigValue() once they are drawn.
+ */
+static void update_trace_widths(GwTrace *t,
+                                gboolean rebuild,
+                                gboolean on_screen,
+                                GwMarker *primary_marker)
+{
+    char buf[2048];
+    char *subname = NULL;
+    GwTrace *tscan;
+    GwBitVector *bv = find_transaction_vector(t, &tscan, &subname);
+    gboolean counted = (!rebuild) && (t->width_epoch == GLOBALS->signal_width_epoch);
 
-            t = GiveNextTrace(t);
+    if (!counted) {
+        if (t->name || subname) {
+            populateBuffer(t, subname, buf);
+            measure_cached(buf, &t->name_hash, &t->name_width);
         } else {
-            t = GiveNextTrace(t);
+            t->name_hash = 0;
+            t->name_width = 0;
         }
+        width_set_add(GLOBALS->signal_name_widths, t->name_width);
+    }
+
+    if (!bv && (t->flags &
+                (TR_BLANK | TR_ANALOG_BLANK_STRETCH))) /* for "comment" style blank traces */
+    {
+        if (t->asciivalue) {
+            free_2(t->asciivalue);
+            t->asciivalue = NULL;
+        }
+        set_trace_value_width(t, counted, NULL);
+    } else if ((t->name || subname) && gw_marker_is_enabled(primary_marker) &&
+               (!(t->flags & TR_EXCLUDE))) {
+        if (on_screen) {
+            evaluate_trace_value(t, bv, tscan, gw_marker_get_position(primary_marker));
+            set_trace_value_width(t, counted, t->asciivalue);
+        } else if (!counted) {
+            width_set_add(GLOBALS->signal_value_widths, t->value_width);
+        }
+    } else {
+        set_trace_value_width(t, counted, NULL);
     }
 
-    GLOBALS->max_signal_name_pixel_width = maxlen;
-    GLOBALS->signal_pixmap_width = maxlen + 6; /* 2 * 3 pixel pad */
+    t->width_epoch = GLOBALS->signal_width_epoch;
+}
+
+static void update_signal_pixmap_width(GwMarker *primary_marker)
+{
+    GLOBALS->max_signal_name_pixel_width = GLOBALS->signal_name_widths->max;
+    GLOBALS->signal_pixmap_width = GLOBALS->max_signal_name_pixel_width + 6; /* 2 * 3 pixel pad */
     if (gw_marker_is_enabled(primary_marker)) {
-        GLOBALS->signal_pixmap_width += (vmaxlen + 6);
+        GLOBALS->signal_pixmap_width += (GLOBALS->signal_value_widths->max + 6);
         if (GLOBALS->signal_pixmap_width > 32767)
             GLOBALS->signal_pixmap_width = 32767; /* fixes X11 protocol limitation crash */
     }
 
+    if (GLOBALS->signal_pixmap_width < 60)
+        GLOBALS->signal_pixmap_width = 60;
+}
+
+void MaxSignalLength(void)
+{
+    GwTrace *t;
+    GwTrace *t_screen = NULL;
+    int num_screen = 0;
+    char dirty_kick;
+    gboolean rebuild;
+
+    DEBUG(printf("signalwindow_width_dirty: %d\n", GLOBALS->signalwindow_width_dirty));
+
+    if ((!GLOBALS->signalwindow_width_dirty) && (GLOBALS->use_nonprop_fonts))
+        return;
+
+    GwMarker *primary_marker = gw_project_get_primary_marker(GLOBALS->project);
+
+    dirty_kick = GLOBALS->signalwindow_width_dirty;
+    GLOBALS->signalwindow_width_dirty = 0;
+
+    /* names only need to be measured again if the traces changed, otherwise only the values do */
+    rebuild = dirty_kick || (!GLOBALS->signal_name_widths) || (!GLOBALS->signal_width_epoch);
+    if (rebuild) {
+        width_set_clear(&GLOBALS->signal_name_widths);
+        width_set_clear(&GLOBALS->signal_value_widths);
+
+        if (!++signal_width_epoch_counter) {
+            signal_width_epoch_counter = 1;
+        }
+        GLOBALS->signal_width_epoch = signal_width_epoch_counter;
+    }
+
+    /* all marker values are stale now, see UpdateSigValue() */
+    GLOBALS->signal_value_generation++;
+
+    if (GLOBALS->signalarea) {
+        t_screen = gw_signal_list_get_trace(GW_SIGNAL_LIST(GLOBALS->signalarea), 0);
+        num_screen = gw_signal_list_get_num_traces_displayable(GW_SIGNAL_LIST(GLOBALS->signalarea));
+    }
+
+    if (rebuild) {
+        int screen_left = 0;
+
+        for (t = GLOBALS->traces.first; t; t = GiveNextTrace(t)) {
+            if (t == t_screen) {
+                screen_left = num_screen;
+            }
+
+            update_trace_widths(t, TRUE, screen_left > 0, primary_marker);
+            screen_left--;
+        }
+    } else {
+        int i;
+
+        for (t = t_screen, i = 0; t && (i < num_screen); t = GiveNextTrace(t), i++) {
+            update_trace_widths(t, FALSE, TRUE, primary_marker);
+        }
+    }
+
+    update_signal_pixmap_width(primary_marker);
+
     GLOBALS->tims.resizemarker2 = GLOBALS->tims.resizemarker;
     GLOBALS->tims.resizemarker = gw_marker_is_enabled(primary_marker)
                                      ? gw_marker_get_position(primary_marker)
                                      : -1; // TODO: don't use sentinel value
 
-    if (GLOBALS->signal_pixmap_width < 60)
-        GLOBALS->signal_pixmap_width = 60;
-
     MaxSignalLength_2(dirty_kick);
 }
 
@@ -2106,132 +2274,37 @@ void MaxSignalLength_2(char dirty_kick)
 
 void UpdateSigValue(GwTrace *t)
 {
-    GwBitVector *bv = NULL;
-    GwTrace *tscan = NULL;
+    GwBitVector *bv;
+    GwTrace *tscan;
 
     GwMarker *primary_marker = gw_project_get_primary_marker(GLOBALS->project);
 
     if (!t)
         return;
-    if ((t->asciivalue) && (t->asciitime == gw_marker_get_position(primary_marker)))
+    if ((t->asciivalue) && (t->asciitime == gw_marker_get_position(primary_marker)) &&
+        (t->value_generation == GLOBALS->signal_value_generation))
         return;
 
-    if (t->flags & (TR_BLANK | TR_ANALOG_BLANK_STRETCH)) /* seek to real xact trace if present... */
-    {
-        int bcnt = 0;
-        tscan = t;
-        while ((tscan) && (tscan = GivePrevTrace(tscan))) {
-            if (!(tscan->flags & (TR_BLANK | TR_ANALOG_BLANK_STRETCH))) {
-                if (tscan->flags & TR_TTRANSLATED) {
-                    break; /* found it */
-                } else {
-                    tscan = NULL;
-                }
-            } else {
-                bcnt++; /* bcnt is number of blank traces */
-            }
-        }
-
-        if ((tscan) && (tscan->vector)) {
-            bv = tscan->n.vec;
-            do {
-                bv = bv->transaction_chain; /* correlate to blank trace */
-            } while (bv && (bcnt--));
-            if (bv) {
-                /* nothing, we just want to set bv */
-            }
-        }
-    }
+    bv = find_transaction_vector(t, &tscan, NULL);
 
     if ((t->name || bv) && (bv || !(t->flags & (TR_BLANK | TR_ANALOG_BLANK_STRETCH)))) {
-        GLOBALS->shift_timebase = t->shift;
         DEBUG(printf("UpdateSigValue: %s\n", t->name));
 
         if (gw_marker_is_enabled(primary_marker) && (!(t->flags & TR_EXCLUDE))) {
-            t->asciitime = gw_marker_get_position(primary_marker);
-            if (t->asciivalue)
-                free_2(t->asciivalue);
-
-            if (bv || t->vector) {
-                char *str, *str2;
-                GwVectorEnt *v;
-                GwTrace *ts;
-                GwTrace t_temp;
-
-                if (bv) {
-                    ts = &t_temp;
-                    memcpy(ts, tscan, sizeof(GwTrace));
-                    ts->vector = 1;
-                    ts->n.vec = bv;
-                } else {
-                    ts = t;
-                    bv = t->n.vec;
-                }
-
-                v = bsearch_vector(bv, gw_marker_get_position(primary_marker) - ts->shift);
-                str = convert_ascii(ts, v);
-                if (str) {
-                    str2 = (char *)malloc_2(strlen(str) + 2);
-                    *str2 = '=';
-                    strcpy(str2 + 1, str);
-                    free_2(str);
-
-                    t->asciivalue = str2;
-                } else {
-                    t->asciivalue = NULL;
-                }
-            } else {
-                char *str;
-                GwHistEnt *h_ptr;
-                if ((h_ptr = bsearch_node(t->n.nd,
-                                          gw_marker_get_position(primary_marker) - t->shift))) {
-                    if (!t->n.nd->extvals) {
-                        unsigned char h_val = h_ptr->v.h_val;
-                        if (t->n.nd->vartype == GW_VAR_TYPE_VCD_EVENT) {
-                            h_val = (h_ptr->time >= GLOBALS->tims.first) &&
-                                            ((gw_marker_get_position(primary_marker) -
-                                              GLOBALS->shift_timebase) == h_ptr->time)
-                                        ? GW_BIT_1
-                                        : GW_BIT_0; /* generate impulse */
-                        }
-
-                        if (t->flags & TR_INVERT) {
-                            h_val = gw_bit_invert(h_val);
-                        }
-
-                        str = (char *)calloc_2(1, 3 * sizeof(char));
-                        str[0] = '=';
-                        str[1] = gw_bit_to_char(h_val);
-
-                        t->asciivalue = str;
-                    } else {
-                        char *str2;
-
-                        if (h_ptr->flags & GW_HIST_ENT_FLAG_REAL) {
-                            if (!(h_ptr->flags & GW_HIST_ENT_FLAG_STRING)) {
-                                str = convert_ascii_real(t, &h_ptr->v.h_double);
-                            } else {
-                                str = convert_ascii_string((char *)h_ptr->v.h_vector);
-                            }
-                        } else {
-                            str = convert_ascii_vec(t, h_ptr->v.h_vector);
-                        }
+            evaluate_trace_value(t, bv, tscan, gw_marker_get_position(primary_marker));
 
-                        if (str) {
-                            str2 = (char *)malloc_2(strlen(str) + 2);
-                            *str2 = '=';
-                            strcpy(str2 + 1, str);
-                            free_2(str);
+            /* rows scrolled into view may widen the value column */
+            if ((GLOBALS->signal_width_epoch) &&
+                (t->width_epoch == GLOBALS->signal_width_epoch)) {
+                int old_max = GLOBALS->signal_value_widths->max;
 
-                            t->asciivalue = str2;
-                        } else {
-                            t->asciivalue = NULL;
-                        }
-                    }
-                } else {
-                    t->asciivalue = NULL;
+                set_trace_value_width(t, TRUE, t->asciivalue);
+                if (GLOBALS->signal_value_widths->max > old_max) {
+                    update_signal_pixmap_width(primary_marker);
                 }
             }
+        } else {
+            GLOBALS->shift_timebase = t->shift;
         }
     }
 }
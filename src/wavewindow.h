@@ -15,6 +15,7 @@ void UpdateSigValue(GwTrace *t);
 void MaxSignalLength(void);
 void MaxSignalLength_2(
     char dirty_kick); /* used to resize but not fully recalculate like MaxSignalLength() */
+void RemoveSignalLength(GwTrace *t);
 
 void populateBuffer(GwTrace *t, char *altname, char *buf);
 void calczoom(double z0);